@@ -92,6 +92,27 @@ if (WIN32)
     list(APPEND LEATHERMAN_DEFINITIONS -DUNICODE -D_UNICODE -DSECURITY_WIN32)
 endif()
 
+# rapidjson selects its SIMD whitespace-skipping and string-scanning
+# kernels at compile time, so they are enabled per build rather than
+# dispatched at runtime. SSE2 is part of the x86_64 baseline and always
+# safe to enable there; SSE4.2 raises the minimum supported CPU and
+# requires an explicit opt-in. Non-x86 targets (e.g. ARM) keep the
+# scalar kernels.
+if (LEATHERMAN_RAPIDJSON_SIMD AND CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+    if (LEATHERMAN_RAPIDJSON_SSE42)
+        include(CheckCXXCompilerFlag)
+        check_cxx_compiler_flag("-msse4.2" LEATHERMAN_CXX_SUPPORTS_SSE42)
+        if (LEATHERMAN_CXX_SUPPORTS_SSE42)
+            set(LEATHERMAN_CXX_FLAGS "-msse4.2 ${LEATHERMAN_CXX_FLAGS}")
+            list(APPEND LEATHERMAN_DEFINITIONS -DRAPIDJSON_SSE42)
+        else()
+            list(APPEND LEATHERMAN_DEFINITIONS -DRAPIDJSON_SSE2)
+        endif()
+    else()
+        list(APPEND LEATHERMAN_DEFINITIONS -DRAPIDJSON_SSE2)
+    endif()
+endif()
+
 # Enforce UTF-8 in Leatherman.Logging; disable deprecated names in Boost.System to avoid warnings on Windows.
 list(APPEND LEATHERMAN_DEFINITIONS -DBOOST_LOG_WITHOUT_WCHAR_T -DBOOST_SYSTEM_NO_DEPRECATED)
 
@@ -0,0 +1,26 @@
+# Converts a compiled gettext catalog (.mo) into a C++ source file that
+# registers the catalog bytes with leatherman::locale during static
+# initialization, so translation needs no filesystem access at runtime.
+# Expects MO_FILE, LANG, DOMAIN, and OUTPUT to be defined.
+file(READ ${MO_FILE} MO_HEX HEX)
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," MO_BYTES "${MO_HEX}")
+file(WRITE ${OUTPUT}
+"// Generated by gettext_embed from ${LANG}.mo. Do not edit.
+#include <leatherman/locale/locale.hpp>
+
+namespace {
+    const unsigned char catalog_data[] = {
+        ${MO_BYTES}
+    };
+
+    struct catalog_registrar {
+        catalog_registrar() {
+            leatherman::locale::register_embedded_catalog(
+                \"${LANG}\",
+                reinterpret_cast<char const*>(catalog_data),
+                sizeof(catalog_data),
+                \"${DOMAIN}\");
+        }
+    } registrar;
+}  // namespace
+")
@@ -126,6 +126,21 @@ macro(add_leatherman_test)
     export_var(LEATHERMAN_TEST_SRCS)
 endmacro()
 
+# Usage: add_leatherman_benchmark(${SOURCES})
+#
+# Adds the listed files to the set which will be built for the
+# leatherman benchmark executable.
+macro(add_leatherman_benchmark)
+    foreach(FILE ${ARGV})
+        if (IS_ABSOLUTE FILE)
+            list(APPEND LEATHERMAN_BENCHMARK_SRCS "${FILE}")
+        else()
+            list(APPEND LEATHERMAN_BENCHMARK_SRCS "${CMAKE_CURRENT_SOURCE_DIR}/${FILE}")
+        endif()
+    endforeach()
+    export_var(LEATHERMAN_BENCHMARK_SRCS)
+endmacro()
+
 
 # Usage: add_leatherman_headers(${DIRECTORIES})
 #
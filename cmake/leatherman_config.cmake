@@ -54,6 +54,9 @@ endmacro()
 macro(add_leatherman_test)
 endmacro()
 
+macro(add_leatherman_benchmark)
+endmacro()
+
 macro(add_leatherman_vendored pkg md5 header_path)
     add_leatherman_includes("${LEATHERMAN_PREFIX}/include/leatherman/vendor")
 endmacro()
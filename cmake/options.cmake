@@ -18,5 +18,10 @@ defoption(LEATHERMAN_USE_LOCALES "Use locales for internationalization" ${USE_BO
 # Provided so it can be disabled temporarily when we don't have gettext built.
 defoption(LEATHERMAN_GETTEXT "Support localization with gettext" ON)
 
+# rapidjson ships vectorized whitespace-skipping and string-scanning
+# kernels; see cflags.cmake for how these options translate to flags.
+defoption(LEATHERMAN_RAPIDJSON_SIMD "Enable SIMD kernels in the vendored rapidjson" ON)
+defoption(LEATHERMAN_RAPIDJSON_SSE42 "Use rapidjson's SSE4.2 kernels (raises the minimum supported CPU)" OFF)
+
 # Map our boost option to the for-realsies one
 set(Boost_USE_STATIC_LIBS ${BOOST_STATIC})
@@ -14,6 +14,18 @@
 #include <boost/nowide/cstdio.hpp>
 #include "export.h"
 
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iosfwd>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 
 namespace leatherman { namespace curl {
 
@@ -81,6 +93,19 @@ namespace leatherman { namespace curl {
          */
         download_temp_file(request const& req, std::string const& file_path, boost::optional<boost::filesystem::perms> perms);
 
+        /**
+         * Constructs a temporary file for a download, optionally resumable.
+         * A resumable temporary file lives at a deterministic path derived
+         * from the destination, reopens any partial contents left by an
+         * earlier attempt, and is kept — not deleted — when the transfer
+         * fails, so a retry can continue from where it died.
+         * @param req The HTTP request.
+         * @param file_path The file path that this temporary file's contents will be written to.
+         * @param perms The (optional) permissions of the downloaded file.
+         * @param resume Whether the temporary file is resumable.
+         */
+        download_temp_file(request const& req, std::string const& file_path, boost::optional<boost::filesystem::perms> perms, bool resume);
+
         ~download_temp_file();
 
         /*
@@ -100,6 +125,22 @@ namespace leatherman { namespace curl {
          */
         void write(response& res);
 
+        /*
+         * Returns the path of the underlying temporary file.
+         */
+        std::string temp_path() const;
+
+        /*
+         * Returns the number of bytes already present from an earlier
+         * attempt; always zero for non-resumable temporary files.
+         */
+        unsigned long long existing_size() const;
+
+        /*
+         * Discards any partial contents, truncating the temporary file.
+         */
+        void reset();
+
      private:
         void close_fp();
         void cleanup();
@@ -107,6 +148,8 @@ namespace leatherman { namespace curl {
         request _req;
         std::string _file_path;
         boost::filesystem::path _temp_path;
+        bool _resume = false;
+        unsigned long long _existing = 0;
     };
 
     /**
@@ -266,12 +309,105 @@ namespace leatherman { namespace curl {
         std::string _temp_path;
     };
 
+    /**
+     * Controls automatic retry of failed transfers performed by a client.
+     * Retries happen inside the perform path, reusing the client's
+     * still-warm connection, with an exponentially growing delay plus a
+     * random jitter between attempts.
+     */
+    struct LEATHERMAN_CURL_EXPORT retry_policy
+    {
+        /**
+         * Stores the maximum number of attempts, including the initial one.
+         */
+        unsigned int max_attempts = 1;
+
+        /**
+         * Stores the delay before the first retry, in milliseconds. The
+         * delay doubles with every subsequent retry.
+         */
+        unsigned int base_delay_ms = 500;
+
+        /**
+         * Stores the upper bound of the random jitter added to each delay,
+         * in milliseconds. Jitter spreads out retries from many clients so
+         * they don't hit a recovering server in lockstep.
+         */
+        unsigned int jitter_ms = 100;
+
+        /**
+         * Stores whether transfers that fail with a connection or transfer
+         * error are retried.
+         */
+        bool retry_on_connection_error = true;
+
+        /**
+         * Stores whether responses with a 5xx status code are retried.
+         */
+        bool retry_on_server_error = false;
+    };
+
+    /**
+     * Groups the transport-level tuning applied to connections made by a
+     * client, so a deployment can configure latency- or throughput-oriented
+     * behavior as one profile instead of option by option.
+     */
+    struct LEATHERMAN_CURL_EXPORT transport_profile
+    {
+        /**
+         * Stores whether Nagle's algorithm is disabled (TCP_NODELAY).
+         * Disabled by default: request/response traffic is latency-bound
+         * and shouldn't wait to coalesce small writes.
+         */
+        bool tcp_nodelay = true;
+
+        /**
+         * Stores the idle time before TCP keepalive probes are sent, in
+         * seconds. Zero (the default) leaves keepalive disabled. Probes
+         * keep warm connections from being dropped by middleboxes during
+         * quiet intervals.
+         */
+        long keepalive_idle_secs = 0;
+
+        /**
+         * Stores the interval between TCP keepalive probes, in seconds.
+         * Only meaningful when keepalive_idle_secs is non-zero.
+         */
+        long keepalive_interval_secs = 60;
+
+        /**
+         * Stores the receive buffer size libcurl is asked to use, in
+         * bytes. Zero keeps libcurl's default.
+         */
+        long receive_buffer_size = 0;
+
+        /**
+         * Stores the download bandwidth cap, in bytes per second. Zero
+         * leaves the rate unlimited. Capping keeps bulk fetches from
+         * starving interactive traffic on constrained links.
+         */
+        long long max_recv_bytes_per_second = 0;
+
+        /**
+         * Stores the upload bandwidth cap, in bytes per second. Zero
+         * leaves the rate unlimited.
+         */
+        long long max_send_bytes_per_second = 0;
+    };
+
     /**
      * Implements a client for HTTP.
      * Note: this class is not thread-safe.
      */
     struct LEATHERMAN_CURL_EXPORT client
     {
+        /**
+         * The type of a response body sink: receives each body chunk as it
+         * arrives and returns the number of bytes consumed. Returning fewer
+         * bytes than were given aborts the transfer.
+         */
+        using body_sink = std::function<size_t(char const*, size_t)>;
+
         /**
          * Constructs an HTTP client.
          */
@@ -297,6 +433,46 @@ namespace leatherman { namespace curl {
          */
         response get(request const& req);
 
+        /**
+         * Performs a GET with the given request, streaming the response body
+         * to a sink. Body chunks flow straight from libcurl's write callback
+         * to the sink instead of accumulating in memory, so the peak memory
+         * use is constant regardless of body size. The returned response
+         * carries the status code and headers; its body is empty.
+         * @param req The HTTP request to perform.
+         * @param sink The sink receiving each body chunk.
+         * @return Returns the HTTP response with an empty body.
+         */
+        response get(request const& req, body_sink const& sink);
+
+        /**
+         * Performs a GET with the given request, streaming the response body
+         * to a stream. The returned response carries the status code and
+         * headers; its body is empty. The transfer is aborted if the stream
+         * enters a failed state.
+         * @param req The HTTP request to perform.
+         * @param sink The stream the body is written to.
+         * @return Returns the HTTP response with an empty body.
+         */
+        response get(request const& req, std::ostream& sink);
+
+        /**
+         * Performs a GET request racing several candidate endpoints.
+         * The first candidate starts immediately and each subsequent one
+         * starts stagger_ms later unless a transfer has already completed;
+         * the response of the first candidate to complete is returned and
+         * the remaining transfers are aborted. A black-holed endpoint thus
+         * costs at most the stagger delay instead of a full connect timeout
+         * plus retry. The request's URL is ignored in favor of the
+         * candidates, a request body, if any, is not sent, and the client's
+         * retry policy does not apply to the individual candidates.
+         * @param urls The candidate endpoint URLs, in preference order.
+         * @param req The HTTP request to perform; supplies the headers, cookies, and timeouts.
+         * @param stagger_ms The delay before starting each successive candidate, in milliseconds. Defaults to 250.
+         * @return Returns the HTTP response of the winning endpoint.
+         */
+        response get_first(std::vector<std::string> const& urls, request const& req, unsigned int stagger_ms = 250);
+
         /**
          * Performs a POST with the given request.
          * @param req The HTTP request to perform.
@@ -337,6 +513,25 @@ namespace leatherman { namespace curl {
                            response& res,
                            boost::optional<boost::filesystem::perms> perms = {});
 
+        /**
+         * Downloads the file from the specified url, resuming a previous
+         * failed attempt when possible. The partial download is kept at a
+         * deterministic path next to the destination together with the
+         * server's ETag; a retry revalidates it with If-Range and continues
+         * with a Range request from the first missing byte, so retrying a
+         * transfer that died near the end costs only the remaining bytes.
+         * If the validator no longer matches — or the server doesn't honor
+         * ranges — the entire file is fetched from scratch.
+         * Throws http_file_download_exception if anything goes wrong.
+         * @param req The HTTP request to perform.
+         * @param file_path The file that the downloaded contents will be written to.
+         * @param perms The file permissions to apply when writing to file_path.
+         *              On Windows this only toggles read-only.
+         */
+        void download_file_resumable(request const& req,
+                                     std::string const& file_path,
+                                     boost::optional<boost::filesystem::perms> perms = {});
+
         /**
          * Sets the path to the CA certificate file.
          * @param cert_file The path to the CA certificate file.
@@ -371,6 +566,100 @@ namespace leatherman { namespace curl {
          */
         void set_supported_protocols(long client_protocols);
 
+        /**
+         * Requests HTTP/2 for requests performed by this client. The
+         * protocol is negotiated via ALPN during the TLS handshake and
+         * falls back to HTTP/1.1 when the server (or the linked libcurl)
+         * doesn't support it. Combined with connection reuse, repeated
+         * requests to the same host then share one multiplexed connection
+         * instead of paying TCP/TLS setup per request.
+         * @param enable Whether to request HTTP/2.
+         */
+        void set_http2(bool enable = true);
+
+        /**
+         * Enables or disables use of the process-wide DNS and TLS session
+         * cache. Clients join the shared cache by default, so hostnames
+         * resolved and TLS sessions established by one client are reused by
+         * every other client in the process instead of being re-resolved and
+         * re-negotiated per instance.
+         * @param use True to join the shared cache, false to keep this client's caches private.
+         */
+        void set_shared_cache(bool use = true);
+
+        /**
+         * Sets the retry policy for transfers performed by this client.
+         * Transfers are not retried by default (a policy of one attempt).
+         * Transfers streaming the response body to a sink are never
+         * retried, since part of the body may already have been handed out.
+         * @param policy The retry policy to apply.
+         */
+        void set_retry_policy(retry_policy policy);
+
+        /**
+         * Enables or disables compressed transfer encoding for requests
+         * performed by this client. When enabled (the default), the content
+         * encodings libcurl supports (e.g. gzip, deflate) are negotiated
+         * with the server and response bodies are transparently
+         * decompressed before reaching the write callbacks. Individual
+         * requests can opt out via request::compression.
+         * @param enable Whether to negotiate compressed transfer encoding.
+         */
+        void set_compression(bool enable = true);
+
+        /**
+         * Sets the directory used as an on-disk response cache for GETs
+         * performed by this client. Cached entries store the response body
+         * along with the server's validators (ETag and Last-Modified);
+         * later GETs of the same URL are sent conditionally with
+         * If-None-Match/If-Modified-Since and a 304 is answered with the
+         * body replayed from disk, so unchanged resources cost a header
+         * exchange instead of a full transfer. Responses without a
+         * validator are never cached, and streaming GETs bypass the cache.
+         * An empty directory (the default) disables caching.
+         * @param cache_dir The directory cached responses are stored in; created on first use.
+         */
+        void set_cache_directory(std::string const& cache_dir);
+
+        /**
+         * Sets the transport tuning profile applied to connections made by
+         * this client.
+         * @param profile The transport profile to apply.
+         */
+        void set_transport_profile(transport_profile profile);
+
+        /**
+         * Establishes a connection to the given URL without issuing a
+         * request (CURLOPT_CONNECT_ONLY). The connection stays in this
+         * client's connection cache, so the first real request to the same
+         * host afterwards skips DNS resolution, the TCP handshake and the
+         * TLS handshake. Intended to be called during idle periods; failure
+         * is not an error, it just means no warm connection.
+         * @param url The URL whose host to connect to.
+         * @return Returns true if a connection was established, false otherwise.
+         */
+        bool preconnect(std::string const& url);
+
+        /**
+         * Escapes the given string for use in a URL.
+         * Results are served from a bounded per-client cache, so
+         * request builders escaping the same node names and query keys
+         * repeatedly pay the libcurl escape (and its allocation) only
+         * the first time each string is seen; the least recently used
+         * entry is evicted when the cache is full.
+         * @param str The string to escape.
+         * @return Returns the URL-escaped string.
+         */
+        std::string escape(std::string const& str);
+
+        /**
+         * Escapes many strings for use in a URL in one batch.
+         * Each string goes through the same cache as escape().
+         * @param strs The strings to escape.
+         * @return Returns the URL-escaped strings, in order.
+         */
+        std::vector<std::string> escape(std::vector<std::string> const& strs);
+
      private:
         client(client const&) = delete;
         client& operator=(client const&) = delete;
@@ -391,11 +680,23 @@ namespace leatherman { namespace curl {
             {
             }
 
+            ~context()
+            {
+                if (body_file) {
+                    fclose(body_file);
+                }
+            }
+
             request const& req;
             response& res;
             size_t read_offset;
             curl_list request_headers;
             std::string response_buffer;
+            // When set, body chunks are handed to this sink instead of
+            // accumulating in the response buffer.
+            body_sink const* sink = nullptr;
+            // Open handle on a file-backed request body; owned by the context.
+            FILE* body_file = nullptr;
         };
 
         std::string _ca_cert;
@@ -404,8 +705,15 @@ namespace leatherman { namespace curl {
         std::string _client_crl;
         std::string _proxy;
         long _client_protocols = CURLPROTO_ALL;
+        bool _http2 = false;
+        bool _use_shared_cache = true;
+        bool _compression = true;
+        retry_policy _retry;
+        std::string _cache_dir;
+        transport_profile _transport;
 
-        response perform(http_method method, request const& req);
+        response perform(http_method method, request const& req, body_sink const* sink = nullptr);
+        LEATHERMAN_CURL_NO_EXPORT response get_with_cache(request const& req);
         void download_file_helper(request const& req,
                                   std::string const& file_path,
                                   boost::optional<response&> res = {},
@@ -417,6 +725,7 @@ namespace leatherman { namespace curl {
         LEATHERMAN_CURL_NO_EXPORT void set_cookies(context& ctx);
         LEATHERMAN_CURL_NO_EXPORT void set_body(context& ctx, http_method method);
         LEATHERMAN_CURL_NO_EXPORT void set_timeouts(context& ctx);
+        LEATHERMAN_CURL_NO_EXPORT void set_transport(context& ctx);
         LEATHERMAN_CURL_NO_EXPORT void set_header_write_callbacks(context& ctx);
         LEATHERMAN_CURL_NO_EXPORT void set_write_callbacks(context& ctx);
         LEATHERMAN_CURL_NO_EXPORT void set_write_callbacks(context& ctx, FILE* fp);
@@ -424,6 +733,10 @@ namespace leatherman { namespace curl {
         LEATHERMAN_CURL_NO_EXPORT void set_ca_info(context& ctx);
         LEATHERMAN_CURL_NO_EXPORT void set_crl_info(context& ctx);
         LEATHERMAN_CURL_NO_EXPORT void set_client_protocols(context& ctx);
+        LEATHERMAN_CURL_NO_EXPORT void set_http_version(context& ctx);
+        LEATHERMAN_CURL_NO_EXPORT void set_share(context& ctx);
+        LEATHERMAN_CURL_NO_EXPORT void set_accept_encoding(context& ctx);
+        LEATHERMAN_CURL_NO_EXPORT void collect_metrics(context& ctx);
         LEATHERMAN_CURL_NO_EXPORT void set_proxy_info(context& ctx);
 
         template <typename ParamType>
@@ -443,10 +756,18 @@ namespace leatherman { namespace curl {
         static size_t write_header(char* buffer, size_t size, size_t count, void* ptr);
         static size_t write_body(char* buffer, size_t size, size_t count, void* ptr);
         static size_t write_file(char *buffer, size_t size, size_t count, void* ptr);
+        static size_t write_file_resumable(char* buffer, size_t size, size_t count, void* ptr);
         static int debug(CURL* handle, curl_infotype type, char* data, size_t size, void* ptr);
 
         curl_handle _handle;
 
+        // The escape cache: most recently used strings at the front of
+        // the order list, the map pointing each raw string at its
+        // escaped form and its position in the list.
+        static const size_t escape_cache_size = 256;
+        std::list<std::string> _escape_order;
+        std::unordered_map<std::string, std::pair<std::string, std::list<std::string>::iterator>> _escape_cache;
+
     protected:
         /**
          * Returns a reference to a cURL handle resource used in the request.
@@ -456,4 +777,249 @@ namespace leatherman { namespace curl {
         curl_handle const& get_handle();
     };
 
+    /**
+     * A thread-safe pool of HTTP clients.
+     * client is not thread-safe, and constructing one per request discards
+     * libcurl's keep-alive connections, TLS session cache and DNS cache with
+     * the handle. client_pool keeps a bounded number of clients alive; each
+     * request checks a client out — reusing its live connections — and
+     * returns it when the request completes. A request blocks while all
+     * clients are checked out.
+     *
+     * Configuration setters affect clients created for later checkouts, so
+     * the pool should be configured before requests are issued through it.
+     */
+    struct LEATHERMAN_CURL_EXPORT client_pool
+    {
+        /**
+         * Constructs a client_pool. Clients are created lazily as requests
+         * demand them, up to the given limit.
+         * @param size The maximum number of clients kept alive by the pool.
+         */
+        explicit client_pool(size_t size = 4);
+
+        /**
+         * Destructs a client_pool. Queued asynchronous requests are drained
+         * before the pool's worker threads exit.
+         */
+        ~client_pool();
+
+        /**
+         * Performs a GET with the given request on a pooled client.
+         * @param req The HTTP request to perform.
+         * @return Returns the HTTP response.
+         */
+        response get(request const& req);
+
+        /**
+         * Performs a POST with the given request on a pooled client.
+         * @param req The HTTP request to perform.
+         * @return Returns the HTTP response.
+         */
+        response post(request const& req);
+
+        /**
+         * Performs a PUT with the given request on a pooled client.
+         * @param req The HTTP request to perform.
+         * @return Returns the HTTP response.
+         */
+        response put(request const& req);
+
+        /**
+         * Performs a GET asynchronously on a pooled client.
+         * Requests are dispatched on the pool's worker threads, at most one
+         * per pooled client; additional requests queue until a client is
+         * free, so in-flight transfers don't cost a blocked caller thread
+         * each.
+         * @param req The HTTP request to perform.
+         * @return Returns a future that yields the HTTP response, or throws
+         *         what the request threw.
+         */
+        std::future<response> get_async(request req);
+
+        /**
+         * Performs a POST asynchronously on a pooled client.
+         * @param req The HTTP request to perform.
+         * @return Returns a future that yields the HTTP response, or throws
+         *         what the request threw.
+         */
+        std::future<response> post_async(request req);
+
+        /**
+         * Performs a PUT asynchronously on a pooled client.
+         * @param req The HTTP request to perform.
+         * @return Returns a future that yields the HTTP response, or throws
+         *         what the request threw.
+         */
+        std::future<response> put_async(request req);
+
+        /**
+         * Performs a GET asynchronously, invoking a callback on completion.
+         * The callback runs on a pool worker thread and receives the
+         * response and, if the request failed, the exception it threw.
+         * @param req The HTTP request to perform.
+         * @param callback The callback to invoke with the response; the
+         *        exception pointer is null on success.
+         */
+        void get_async(request req, std::function<void(response, std::exception_ptr)> callback);
+
+        /**
+         * Performs a POST asynchronously, invoking a callback on completion.
+         * @param req The HTTP request to perform.
+         * @param callback The callback to invoke with the response; the
+         *        exception pointer is null on success.
+         */
+        void post_async(request req, std::function<void(response, std::exception_ptr)> callback);
+
+        /**
+         * Performs a PUT asynchronously, invoking a callback on completion.
+         * @param req The HTTP request to perform.
+         * @param callback The callback to invoke with the response; the
+         *        exception pointer is null on success.
+         */
+        void put_async(request req, std::function<void(response, std::exception_ptr)> callback);
+
+        /**
+         * Downloads the file from the specified url using up to the given
+         * number of parallel ranged requests, for servers that cap
+         * per-connection throughput. The file size is probed with a one-byte
+         * range request; if the server honors ranges, the remaining segments
+         * are fetched concurrently on pooled clients (parallelism is bounded
+         * by the pool size) and written to their offsets in a temporary
+         * file, which is atomically renamed into place as with
+         * client::download_file. A server without range support streams the
+         * whole body through the probe connection instead.
+         * Throws http_file_download_exception if anything goes wrong.
+         * @param req The HTTP request to perform.
+         * @param file_path The file that the downloaded contents will be written to.
+         * @param segments The maximum number of parallel range requests; 1
+         *        downloads on a single pooled client.
+         * @param perms The file permissions to apply when writing to file_path.
+         *              On Windows this only toggles read-only.
+         */
+        void download_file(request const& req,
+                           std::string const& file_path,
+                           size_t segments,
+                           boost::optional<boost::filesystem::perms> perms = {});
+
+        /**
+         * Sets the path to the CA certificate file for pooled clients.
+         * @param cert_file The path to the CA certificate file.
+         */
+        void set_ca_cert(std::string const& cert_file);
+
+        /**
+         * Set client SSL certificate and key for pooled clients.
+         * @param client_cert The path to the client's certificate file.
+         * @param client_key The path to the client's key file.
+         */
+        void set_client_cert(std::string const& client_cert, std::string const& client_key);
+
+        /**
+         * Set client SSL certificate revocation list for pooled clients.
+         * @param client_crl The path to the client's CRL file.
+         */
+        void set_client_crl(std::string const& client_crl);
+
+        /**
+         * Set proxy information for pooled clients.
+         * @param proxy String with following components [scheme]://[hostname]:[port].
+         */
+        void set_proxy(std::string const& proxy);
+
+        /**
+         * Set and limit what protocols pooled clients will support.
+         * @param client_protocols bitmask of CURLPROTO_*
+         */
+        void set_supported_protocols(long client_protocols);
+
+        /**
+         * Requests HTTP/2 for requests performed by pooled clients.
+         * @param enable Whether to request HTTP/2.
+         */
+        void set_http2(bool enable = true);
+
+        /**
+         * Enables or disables use of the process-wide DNS and TLS session
+         * cache for pooled clients.
+         * @param use True to join the shared cache, false to keep the pooled clients' caches private.
+         */
+        void set_shared_cache(bool use = true);
+
+        /**
+         * Sets the retry policy for transfers performed by pooled clients.
+         * @param policy The retry policy to apply.
+         */
+        void set_retry_policy(retry_policy policy);
+
+        /**
+         * Enables or disables compressed transfer encoding for requests
+         * performed by pooled clients.
+         * @param enable Whether to negotiate compressed transfer encoding.
+         */
+        void set_compression(bool enable = true);
+
+        /**
+         * Sets the directory used as an on-disk response cache for GETs
+         * performed by pooled clients.
+         * @param cache_dir The directory cached responses are stored in; created on first use.
+         */
+        void set_cache_directory(std::string const& cache_dir);
+
+        /**
+         * Sets the transport tuning profile for pooled clients.
+         * @param profile The transport profile to apply.
+         */
+        void set_transport_profile(transport_profile profile);
+
+        /**
+         * Warms a pooled client's connection to the given URL without
+         * issuing a request, so the first real request after an idle
+         * period skips connection establishment.
+         * @param url The URL whose host to connect to.
+         * @return Returns true if a connection was established, false otherwise.
+         */
+        bool preconnect(std::string const& url);
+
+        /**
+         * Gets the maximum number of clients kept alive by the pool.
+         * @return Returns the maximum number of clients in the pool.
+         */
+        size_t size() const;
+
+     private:
+        client_pool(client_pool const&) = delete;
+        client_pool& operator=(client_pool const&) = delete;
+
+        LEATHERMAN_CURL_NO_EXPORT std::unique_ptr<client> acquire();
+        LEATHERMAN_CURL_NO_EXPORT void release(std::unique_ptr<client> checked_out);
+        LEATHERMAN_CURL_NO_EXPORT void enqueue(std::function<void()> task);
+        LEATHERMAN_CURL_NO_EXPORT void run_worker();
+        LEATHERMAN_CURL_NO_EXPORT std::future<response> perform_async(response (client_pool::*method)(request const&), request req);
+        LEATHERMAN_CURL_NO_EXPORT void perform_async(response (client_pool::*method)(request const&), request req, std::function<void(response, std::exception_ptr)> callback);
+
+        size_t _size;
+        size_t _created = 0;
+        size_t _idle_workers = 0;
+        bool _shutdown = false;
+        std::vector<std::unique_ptr<client>> _idle;
+        std::vector<std::thread> _threads;
+        std::queue<std::function<void()>> _tasks;
+        std::condition_variable _task_ready;
+        std::string _ca_cert;
+        std::string _client_cert;
+        std::string _client_key;
+        std::string _client_crl;
+        std::string _proxy;
+        long _client_protocols = CURLPROTO_ALL;
+        bool _http2 = false;
+        bool _use_shared_cache = true;
+        bool _compression = true;
+        retry_policy _retry;
+        std::string _cache_dir;
+        transport_profile _transport;
+        mutable std::mutex _mutex;
+        std::condition_variable _available;
+    };
+
 }}  // namespace leatherman::curl
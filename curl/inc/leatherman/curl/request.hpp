@@ -7,6 +7,8 @@
 #include <string>
 #include <map>
 #include <functional>
+#include <utility>
+#include <vector>
 #include "export.h"
 
 namespace leatherman { namespace curl {
@@ -16,6 +18,23 @@ namespace leatherman { namespace curl {
      */
     struct LEATHERMAN_CURL_EXPORT request
     {
+        /**
+         * The type of a callback that supplies the request body on demand.
+         * The callback is given a buffer and the buffer's size, copies up to
+         * that many bytes of body data into it and returns the number of bytes
+         * copied. Returning 0 signals the end of the body.
+         */
+        using body_source = std::function<size_t(char*, size_t)>;
+
+        /**
+         * The type of a callback that repositions a body callback.
+         * The callback is given an absolute offset from the start of the body
+         * and returns whether the next body_source call will produce data
+         * from that offset. libcurl rewinds the body when a redirect or an
+         * authentication retry requires the request to be re-sent.
+         */
+        using body_seeker = std::function<bool(size_t)>;
+
         /**
          * Constructs a HTTP request.
          * @param url The URL for the request.
@@ -42,7 +61,7 @@ namespace leatherman { namespace curl {
         void each_header(std::function<bool(std::string const&, std::string const&)> callback) const;
 
         /**
-         * Gets a header by name.
+         * Gets a header by name. The name comparison is case-insensitive.
          * @param name The header name to get.
          * @return Returns a pointer to the header's value or nullptr if the header is not present.
          */
@@ -87,6 +106,38 @@ namespace leatherman { namespace curl {
          */
         void body(std::string body, std::string content_type);
 
+        /**
+         * Sets the body of the request to be pulled from a callback.
+         * The body is streamed to the server as the callback produces it, so
+         * the full payload never has to be held in memory.
+         * @param source The callback that supplies the body data.
+         * @param size The total size of the body, in bytes.
+         * @param content_type The type of content (sets the Content-Type header).
+         */
+        void body(body_source source, size_t size, std::string content_type);
+
+        /**
+         * Sets the body of the request to be pulled from a callback that can
+         * be repositioned. Without a seeker a redirect or authentication
+         * retry fails the transfer, since the callback alone is forward-only;
+         * with one, libcurl rewinds the body and re-sends it without the
+         * payload ever being buffered in memory.
+         * @param source The callback that supplies the body data.
+         * @param seeker The callback that repositions the body source.
+         * @param size The total size of the body, in bytes.
+         * @param content_type The type of content (sets the Content-Type header).
+         */
+        void body(body_source source, body_seeker seeker, size_t size, std::string content_type);
+
+        /**
+         * Sets the body of the request to be streamed from a file.
+         * The file is read in chunks during the transfer rather than being
+         * buffered in memory, so arbitrarily large files can be uploaded.
+         * @param file_path The path of the file containing the body.
+         * @param content_type The type of content (sets the Content-Type header).
+         */
+        void body_from_file(std::string file_path, std::string content_type);
+
         /**
          * Gets the body of the request.
          * The type of the content is represented by the Content-Type header.
@@ -94,6 +145,31 @@ namespace leatherman { namespace curl {
          */
         std::string const& body() const;
 
+        /**
+         * Gets the callback supplying the request body, if one was set.
+         * @return Returns the body callback; unset when the body is a string or a file.
+         */
+        body_source const& body_callback() const;
+
+        /**
+         * Gets the callback repositioning the request body, if one was set.
+         * @return Returns the body seeker; unset when the body is a string, a
+         *         file, or a forward-only callback.
+         */
+        body_seeker const& body_seek_callback() const;
+
+        /**
+         * Gets the size of a callback-supplied body, in bytes.
+         * @return Returns the size passed when the body callback was set.
+         */
+        size_t body_size() const;
+
+        /**
+         * Gets the path of the file supplying the request body, if one was set.
+         * @return Returns the body file path, or an empty string when the body is not a file.
+         */
+        std::string const& body_path() const;
+
         /**
          * Gets the overall request timeout, in milliseconds.
          * @return Returns the overall request timeout, in milliseconds.
@@ -112,6 +188,21 @@ namespace leatherman { namespace curl {
          */
         long connection_timeout() const;
 
+        /**
+         * Enables or disables compressed transfer encoding for this request.
+         * When enabled (the default), the client negotiates the content
+         * encodings libcurl supports (e.g. gzip, deflate) and transparently
+         * decompresses the response body.
+         * @param enable Whether to negotiate compressed transfer encoding.
+         */
+        void compression(bool enable);
+
+        /**
+         * Gets whether compressed transfer encoding is enabled for this request.
+         * @return Returns true if compressed transfer encoding is enabled or false if not.
+         */
+        bool compression() const;
+
         /**
          * Sets the timeout for connecting to the remote host, in milliseconds.
          * @param value The timeout value, in milliseconds.
@@ -121,9 +212,17 @@ namespace leatherman { namespace curl {
      private:
         std::string _url;
         std::string _body;
+        body_source _body_source;
+        body_seeker _body_seeker;
+        size_t _body_source_size;
+        std::string _body_path;
         long _timeout;
         long _connection_timeout;
-        std::map<std::string, std::string> _headers;
+        bool _compression;
+        // Headers live in a flat vector kept sorted case-insensitively by
+        // name; the handful of headers a request carries makes binary
+        // search over contiguous storage cheaper than a node-based map.
+        std::vector<std::pair<std::string, std::string>> _headers;
         std::map<std::string, std::string> _cookies;
     };
 
@@ -6,11 +6,67 @@
 
 #include <string>
 #include <functional>
-#include <map>
+#include <utility>
+#include <vector>
+#include <cstdint>
 #include "export.h"
 
 namespace leatherman { namespace curl {
 
+    /**
+     * Holds timing and transfer data for a completed request, harvested
+     * from libcurl after the transfer finishes. All times are in seconds
+     * and are measured from the start of the transfer, so successive
+     * phases can be separated by subtraction — e.g. the TLS handshake
+     * cost is appconnect_time - connect_time.
+     */
+    struct LEATHERMAN_CURL_EXPORT transfer_metrics
+    {
+        /**
+         * Stores the time until name resolution completed, in seconds.
+         */
+        double namelookup_time = 0.0;
+
+        /**
+         * Stores the time until the connection to the remote host was
+         * established, in seconds.
+         */
+        double connect_time = 0.0;
+
+        /**
+         * Stores the time until the SSL/TLS handshake completed, in
+         * seconds. Zero for unencrypted transfers.
+         */
+        double appconnect_time = 0.0;
+
+        /**
+         * Stores the time until the first response byte was received, in
+         * seconds.
+         */
+        double starttransfer_time = 0.0;
+
+        /**
+         * Stores the total time of the transfer, in seconds.
+         */
+        double total_time = 0.0;
+
+        /**
+         * Stores the number of body bytes downloaded.
+         */
+        uint64_t downloaded_bytes = 0;
+
+        /**
+         * Stores the number of body bytes uploaded.
+         */
+        uint64_t uploaded_bytes = 0;
+
+        /**
+         * Stores whether the transfer reused an existing connection
+         * rather than creating a new one.
+         */
+        bool reused_connection = false;
+    };
+
     /**
      * Implements the HTTP response.
      */
@@ -35,7 +91,7 @@ namespace leatherman { namespace curl {
         void each_header(std::function<bool(std::string const&, std::string const&)> callback) const;
 
         /**
-         * Gets a header by name.
+         * Gets a header by name. The name comparison is case-insensitive.
          * @param name The header name to get.
          * @return Returns a pointer to the header's value or nullptr if the header is not present.
          */
@@ -59,6 +115,15 @@ namespace leatherman { namespace curl {
          */
         std::string const& body() const;
 
+        /**
+         * Releases the body of the response, returning it by move and
+         * leaving the response's body empty. Use this instead of body()
+         * when the caller consumes the body anyway, to avoid copying a
+         * large body out of the response.
+         * @return Returns the body of the response.
+         */
+        std::string release_body();
+
         /**
          * Sets the status code of the response.
          * @param code The status code of the response.
@@ -71,10 +136,26 @@ namespace leatherman { namespace curl {
          */
         int status_code() const;
 
+        /**
+         * Sets the transfer metrics of the response.
+         * @param metrics The metrics harvested after the transfer.
+         */
+        void metrics(transfer_metrics metrics);
+
+        /**
+         * Gets the transfer metrics of the response.
+         * The metrics are populated by the client once a transfer completes.
+         * @return Returns the transfer metrics of the response.
+         */
+        transfer_metrics const& metrics() const;
+
      private:
         int _status_code;
         std::string _body;
-        std::map<std::string, std::string> _headers;
+        transfer_metrics _metrics;
+        // Headers live in a flat vector kept sorted case-insensitively by
+        // name, mirroring the request's header storage.
+        std::vector<std::pair<std::string, std::string>> _headers;
     };
 
 }}  // namespace leatherman::curl
@@ -1,7 +1,9 @@
 #include <leatherman/curl/client.hpp>
 #include <leatherman/curl/request.hpp>
 #include <leatherman/curl/response.hpp>
+#include <leatherman/util/profiler.hpp>
 #include <leatherman/util/regex.hpp>
+#include <leatherman/util/scope_exit.hpp>
 #include <leatherman/file_util/file.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <boost/utility/string_ref.hpp>
@@ -9,6 +11,10 @@
 #include <boost/nowide/iostream.hpp>
 #include <boost/nowide/fstream.hpp>
 #include <sstream>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -94,17 +100,94 @@ namespace leatherman { namespace curl {
         }
     }
 
+    // Process-wide share handle pooling DNS entries and TLS session tickets
+    // across client instances, so short-lived clients don't re-resolve
+    // hostnames or re-run full TLS handshakes. libcurl requires the caller
+    // to supply locking when a share handle is used from multiple threads.
+    struct curl_shared_cache
+    {
+        static CURLSH* get()
+        {
+            static curl_shared_cache instance;
+            return instance._share;
+        }
+
+     private:
+        curl_shared_cache() :
+            _share(curl_share_init())
+        {
+            if (!_share) {
+                return;
+            }
+            curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lock_data);
+            curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlock_data);
+            curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        }
+
+        ~curl_shared_cache()
+        {
+            if (_share) {
+                curl_share_cleanup(_share);
+            }
+        }
+
+        static void lock_data(CURL*, curl_lock_data data, curl_lock_access, void* userp)
+        {
+            reinterpret_cast<curl_shared_cache*>(userp)->_locks[data].lock();
+        }
+
+        static void unlock_data(CURL*, curl_lock_data data, void* userp)
+        {
+            reinterpret_cast<curl_shared_cache*>(userp)->_locks[data].unlock();
+        }
+
+        CURLSH* _share;
+        std::mutex _locks[CURL_LOCK_DATA_LAST];
+    };
+
     static std::string make_file_err_msg(std::string const& reason) {
         return _("File operation error: {1}", reason);
     }
 
+    // Computes the delay before the given retry, in milliseconds:
+    // exponential backoff on the policy's base delay plus a random jitter.
+    static unsigned int retry_delay(retry_policy const& policy, unsigned int attempt) {
+        auto delay = policy.base_delay_ms;
+        for (unsigned int i = 1; i < attempt; ++i) {
+            delay *= 2;
+        }
+        if (policy.jitter_ms > 0) {
+            static thread_local mt19937 rng { random_device {}() };
+            delay += uniform_int_distribution<unsigned int>(0, policy.jitter_ms)(rng);
+        }
+        return delay;
+    }
+
     download_temp_file::download_temp_file(request const& req, std::string const& file_path, boost::optional<boost::filesystem::perms> perms) :
+      download_temp_file(req, file_path, perms, false)
+    {
+    }
+
+    download_temp_file::download_temp_file(request const& req, std::string const& file_path, boost::optional<boost::filesystem::perms> perms, bool resume) :
       _req(req),
-      _file_path(file_path)
+      _file_path(file_path),
+      _resume(resume)
     {
         try {
-            _temp_path = fs::path(file_path).parent_path() / fs::unique_path("temp_file_%%%%-%%%%-%%%%-%%%%");
-            _fp = boost::nowide::fopen(_temp_path.string().c_str(), "wb");
+            if (_resume) {
+                // A deterministic path, so a retry finds the partial file
+                // left behind by an earlier failed attempt.
+                _temp_path = fs::path(file_path + ".part");
+                boost::system::error_code ec;
+                auto size = fs::file_size(_temp_path, ec);
+                _existing = ec ? 0 : size;
+                _fp = boost::nowide::fopen(_temp_path.string().c_str(), _existing ? "ab" : "wb");
+            } else {
+                _temp_path = fs::path(file_path).parent_path() / fs::unique_path("temp_file_%%%%-%%%%-%%%%-%%%%");
+                _fp = boost::nowide::fopen(_temp_path.string().c_str(), "wb");
+            }
             if (!_fp) {
                 throw http_file_operation_exception(_req, _file_path, make_file_err_msg(_("failed to open temporary file for writing")));
             }
@@ -153,6 +236,21 @@ namespace leatherman { namespace curl {
         res.body(res_body);
     }
 
+    std::string download_temp_file::temp_path() const {
+        return _temp_path.string();
+    }
+
+    unsigned long long download_temp_file::existing_size() const {
+        return _existing;
+    }
+
+    void download_temp_file::reset() {
+        if (_fp && !boost::nowide::freopen(_temp_path.string().c_str(), "wb", _fp)) {
+            throw http_file_operation_exception(_req, _file_path, make_file_err_msg(_("failed to truncate the partial download")));
+        }
+        _existing = 0;
+    }
+
     void download_temp_file::close_fp() {
       fclose(_fp);
       _fp = nullptr;
@@ -162,6 +260,11 @@ namespace leatherman { namespace curl {
         if (_fp) {
             fclose(_fp);
         }
+        // A resumable temporary file is the point of resuming: leave the
+        // partial contents in place for the next attempt.
+        if (_resume) {
+            return;
+        }
         boost::system::error_code ec;
         fs::remove(_temp_path, ec);
         if (ec) {
@@ -189,9 +292,222 @@ namespace leatherman { namespace curl {
 
     response client::get(request const& req)
     {
+        if (!_cache_dir.empty()) {
+            return get_with_cache(req);
+        }
         return perform(http_method::get, req);
     }
 
+    response client::get(request const& req, body_sink const& sink)
+    {
+        return perform(http_method::get, req, &sink);
+    }
+
+    response client::get(request const& req, ostream& sink)
+    {
+        body_sink write = [&](char const* data, size_t size) -> size_t {
+            sink.write(data, size);
+            return sink ? size : 0;
+        };
+        return perform(http_method::get, req, &write);
+    }
+
+    // Derives the file name stem of a URL's cache entry. Hashing keeps the
+    // name filesystem-safe regardless of what characters the URL contains;
+    // the stored URL guards the entry against hash collisions.
+    static string cache_key(string const& url)
+    {
+        ostringstream key;
+        key << hex << std::hash<string>()(url);
+        return key.str();
+    }
+
+    response client::get_with_cache(request const& req)
+    {
+        auto stem = (fs::path(_cache_dir) / cache_key(req.url())).string();
+        auto body_path = stem + ".body";
+        auto meta_path = stem + ".meta";
+
+        // A cache entry's metadata is three lines: the URL, the ETag and
+        // the Last-Modified date, with a blank line standing for a
+        // validator the server didn't send.
+        request actual(req);
+        bool have_entry = false;
+        {
+            string cached_url, etag, last_modified;
+            boost::nowide::ifstream meta(meta_path.c_str());
+            if (meta && fs::exists(body_path)) {
+                getline(meta, cached_url);
+                getline(meta, etag);
+                getline(meta, last_modified);
+                if (cached_url == req.url() && (!etag.empty() || !last_modified.empty())) {
+                    have_entry = true;
+                    if (!etag.empty()) {
+                        actual.add_header("If-None-Match", etag);
+                    }
+                    if (!last_modified.empty()) {
+                        actual.add_header("If-Modified-Since", last_modified);
+                    }
+                }
+            }
+        }
+
+        auto res = perform(http_method::get, actual);
+
+        if (res.status_code() == 304 && have_entry) {
+            string body;
+            if (leatherman::file_util::read(body_path, body)) {
+                LOG_DEBUG("serving {1} from the response cache.", req.url());
+                res.status_code(200);
+                res.body(move(body));
+                return res;
+            }
+            // The cached body disappeared from under us; refetch without
+            // the validators.
+            LOG_WARNING("The cached response body for {1} is missing; refetching.", req.url());
+            return perform(http_method::get, req);
+        }
+
+        if (res.status_code() == 200) {
+            auto tag = res.header("ETag");
+            auto modified = res.header("Last-Modified");
+            if ((tag && !tag->empty()) || (modified && !modified->empty())) {
+                try {
+                    boost::system::error_code ec;
+                    fs::create_directories(_cache_dir, ec);
+                    leatherman::file_util::atomic_write_to_file(res.body(), body_path);
+                    leatherman::file_util::atomic_write_to_file(
+                        req.url() + "\n" + (tag ? *tag : "") + "\n" + (modified ? *modified : "") + "\n", meta_path);
+                } catch (exception const&) {
+                    LOG_WARNING("Failed to store the response for {1} in the cache.", req.url());
+                }
+            }
+        }
+        return res;
+    }
+
+    namespace {
+        // Progress callback used to abort the losing transfers of an
+        // endpoint race once a winner has completed.
+        int race_progress(void* ptr, double, double, double, double)
+        {
+            return static_cast<std::atomic<bool>*>(ptr)->load(std::memory_order_relaxed) ? 1 : 0;
+        }
+    }
+
+    response client::get_first(vector<string> const& urls, request const& req, unsigned int stagger_ms)
+    {
+        if (urls.empty()) {
+            throw http_request_exception(req, _("no candidate endpoints were given"));
+        }
+
+        LTH_PROFILE_SCOPE("curl.race");
+
+        // Configure the shared options once on the client's handle, then
+        // duplicate it per candidate; each duplicate is driven by exactly
+        // one thread, per libcurl's easy-handle threading rule. The header
+        // list built on the base context is referenced by the duplicates,
+        // so the base context must outlive them.
+        response base_res;
+        context base_ctx(req, base_res);
+        curl_easy_reset(_handle);
+        curl_easy_setopt_maybe(base_ctx, CURLOPT_FOLLOWLOCATION, 1);
+        set_method(base_ctx, http_method::get);
+        set_headers(base_ctx);
+        set_cookies(base_ctx);
+        set_timeouts(base_ctx);
+        set_transport(base_ctx);
+        set_ca_info(base_ctx);
+        set_crl_info(base_ctx);
+        set_client_info(base_ctx);
+        set_client_protocols(base_ctx);
+        set_http_version(base_ctx);
+        set_share(base_ctx);
+        set_accept_encoding(base_ctx);
+        set_proxy_info(base_ctx);
+
+        struct candidate
+        {
+            response res;
+            unique_ptr<context> ctx;
+            CURL* handle = nullptr;
+            CURLcode result = CURLE_FAILED_INIT;
+        };
+        vector<candidate> candidates(urls.size());
+        util::scope_exit handle_cleanup([&]() {
+            for (auto& c : candidates) {
+                if (c.handle) {
+                    curl_easy_cleanup(c.handle);
+                }
+            }
+        });
+
+        atomic<bool> done(false);
+        for (size_t i = 0; i < urls.size(); ++i) {
+            auto& c = candidates[i];
+            c.ctx.reset(new context(req, c.res));
+            c.handle = curl_easy_duphandle(_handle);
+            if (!c.handle) {
+                throw http_request_exception(req, _("failed to duplicate cURL handle for endpoint race"));
+            }
+            curl_easy_setopt(c.handle, CURLOPT_URL, urls[i].c_str());
+            curl_easy_setopt(c.handle, CURLOPT_HEADERFUNCTION, write_header);
+            curl_easy_setopt(c.handle, CURLOPT_HEADERDATA, c.ctx.get());
+            curl_easy_setopt(c.handle, CURLOPT_WRITEFUNCTION, write_body);
+            curl_easy_setopt(c.handle, CURLOPT_WRITEDATA, c.ctx.get());
+            curl_easy_setopt(c.handle, CURLOPT_NOPROGRESS, 0);
+            curl_easy_setopt(c.handle, CURLOPT_PROGRESSFUNCTION, race_progress);
+            curl_easy_setopt(c.handle, CURLOPT_PROGRESSDATA, &done);
+        }
+
+        atomic<int> winner(-1);
+        vector<thread> racers;
+        racers.reserve(urls.size());
+        for (size_t i = 0; i < urls.size(); ++i) {
+            racers.emplace_back([&, i]() {
+                // Stagger the start, bailing out early if someone has
+                // already won.
+                auto start_at = chrono::steady_clock::now() + chrono::milliseconds(static_cast<int64_t>(stagger_ms) * static_cast<int64_t>(i));
+                while (i > 0 && chrono::steady_clock::now() < start_at) {
+                    if (done.load(memory_order_relaxed)) {
+                        return;
+                    }
+                    this_thread::sleep_for(chrono::milliseconds(10));
+                }
+                if (done.load(memory_order_relaxed)) {
+                    return;
+                }
+                auto& c = candidates[i];
+                c.result = curl_easy_perform(c.handle);
+                if (c.result == CURLE_OK) {
+                    int expected = -1;
+                    if (winner.compare_exchange_strong(expected, static_cast<int>(i))) {
+                        done.store(true, memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& racer : racers) {
+            racer.join();
+        }
+
+        auto index = winner.load();
+        if (index < 0) {
+            // Every candidate that ran failed; report the first failure.
+            for (auto& c : candidates) {
+                if (c.result != CURLE_FAILED_INIT) {
+                    throw http_request_exception(req, curl_easy_strerror(c.result));
+                }
+            }
+            throw http_request_exception(req, _("no candidate endpoints could be attempted"));
+        }
+
+        auto& won = candidates[static_cast<size_t>(index)];
+        LOG_DEBUG("endpoint {1} won the race (status {2}).", urls[static_cast<size_t>(index)], won.res.status_code());
+        won.res.body(move(won.ctx->response_buffer));
+        return move(won.res);
+    }
+
     response client::post(request const& req)
     {
         return perform(http_method::post, req);
@@ -202,10 +518,12 @@ namespace leatherman { namespace curl {
         return perform(http_method::put, req);
     }
 
-    response client::perform(http_method method, request const& req)
+    response client::perform(http_method method, request const& req, body_sink const* sink)
     {
+        LTH_PROFILE_SCOPE("curl.perform");
         response res;
         context ctx(req, res);
+        ctx.sink = sink;
 
         // Reset the options
         curl_easy_reset(_handle);
@@ -227,18 +545,46 @@ namespace leatherman { namespace curl {
         set_cookies(ctx);
         set_body(ctx, method);
         set_timeouts(ctx);
+        set_transport(ctx);
         set_write_callbacks(ctx);
         set_ca_info(ctx);
         set_crl_info(ctx);
         set_client_info(ctx);
         set_client_protocols(ctx);
+        set_http_version(ctx);
+        set_share(ctx);
+        set_accept_encoding(ctx);
         set_proxy_info(ctx);
 
-        // Perform the request
-        auto result = curl_easy_perform(_handle);
-        if (result != CURLE_OK) {
-            throw http_request_exception(req, curl_easy_strerror(result));
+        // Perform the request, retrying per the configured policy; retries
+        // reuse this handle's still-warm connection.
+        unsigned int attempt = 0;
+        while (true) {
+            ++attempt;
+            auto result = curl_easy_perform(_handle);
+            bool failed = result != CURLE_OK;
+            bool retryable = failed ? _retry.retry_on_connection_error
+                                    : (_retry.retry_on_server_error && res.status_code() >= 500);
+            if (!retryable || attempt >= _retry.max_attempts || ctx.sink) {
+                if (failed) {
+                    throw http_request_exception(req, curl_easy_strerror(result));
+                }
+                break;
+            }
+            auto delay = retry_delay(_retry, attempt);
+            LOG_DEBUG("retrying request in {1} ms (attempt {2} of {3}).", delay, attempt + 1, _retry.max_attempts);
+            this_thread::sleep_for(chrono::milliseconds(delay));
+
+            // Reset the per-attempt state so the retry restarts the transfer
+            // from the beginning.
+            ctx.read_offset = 0;
+            if (ctx.body_file) {
+                rewind(ctx.body_file);
+            }
+            ctx.response_buffer.clear();
+            res = response();
         }
+        collect_metrics(ctx);
 
         LOG_DEBUG("request completed (status {1}).", res.status_code());
 
@@ -273,11 +619,15 @@ namespace leatherman { namespace curl {
         set_url(ctx);
         set_headers(ctx);
         set_timeouts(ctx);
+        set_transport(ctx);
         set_write_callbacks(ctx, temp_file.get_fp());
         set_ca_info(ctx);
         set_crl_info(ctx);
         set_client_info(ctx);
         set_client_protocols(ctx);
+        set_http_version(ctx);
+        set_share(ctx);
+        set_accept_encoding(ctx);
         set_proxy_info(ctx);
 
         // More detailed error messages
@@ -290,6 +640,7 @@ namespace leatherman { namespace curl {
         } else if (result != CURLE_OK) {
             throw http_file_download_exception(req, file_path, _("File download server side error: {1}", errbuf));
         }
+        collect_metrics(ctx);
 
         // Check the status code. If 400+, fill in the response
         LOG_DEBUG("request completed (status {1}).", _res.status_code());
@@ -304,6 +655,106 @@ namespace leatherman { namespace curl {
         }
     }
 
+    // Write-callback state for resumable downloads; lets the first body
+    // chunk distinguish a 206 continuation from a full 200 resend.
+    struct resumable_file_context
+    {
+        response const* res;
+        FILE* fp;
+        std::string temp_path;
+        bool resuming;
+        bool checked;
+    };
+
+    void client::download_file_resumable(request const& req, std::string const& file_path, boost::optional<fs::perms> perms)
+    {
+        response _res;
+        download_temp_file temp_file(req, file_path, perms, true);
+        auto etag_path = temp_file.temp_path() + ".etag";
+
+        // Revalidate a previous partial download with If-Range and ask for
+        // the missing suffix; without a stored validator the partial can't
+        // be trusted and is discarded.
+        request actual(req);
+        string etag;
+        if (temp_file.existing_size() > 0) {
+            if (fs::exists(etag_path) && leatherman::file_util::read(etag_path, etag) && !etag.empty()) {
+                boost::trim(etag);
+                actual.add_header("Range", "bytes=" + to_string(temp_file.existing_size()) + "-");
+                actual.add_header("If-Range", etag);
+            } else {
+                temp_file.reset();
+            }
+        }
+
+        context ctx(actual, _res);
+
+        // Reset the options
+        curl_easy_reset(_handle);
+
+        char errbuf[CURL_ERROR_SIZE] = { '\0' };
+        curl_easy_setopt_maybe(ctx, CURLOPT_NOPROGRESS, 1);
+
+        // Setup the remaining request
+        set_url(ctx);
+        set_headers(ctx);
+        set_timeouts(ctx);
+        set_transport(ctx);
+        set_header_write_callbacks(ctx);
+        resumable_file_context rctx { &_res, temp_file.get_fp(), temp_file.temp_path(), !etag.empty(), false };
+        curl_easy_setopt_maybe(ctx, CURLOPT_WRITEFUNCTION, write_file_resumable);
+        curl_easy_setopt_maybe(ctx, CURLOPT_WRITEDATA, &rctx);
+        set_ca_info(ctx);
+        set_crl_info(ctx);
+        set_client_info(ctx);
+        set_client_protocols(ctx);
+        set_http_version(ctx);
+        set_share(ctx);
+        set_accept_encoding(ctx);
+        set_proxy_info(ctx);
+
+        // More detailed error messages
+        curl_easy_setopt_maybe(ctx, CURLOPT_ERRORBUFFER, errbuf);
+
+        // Perform the request
+        auto result = curl_easy_perform(_handle);
+        if (result != CURLE_OK) {
+            // Persist the validator so the bytes written so far can be
+            // resumed by a retry; the partial file itself is kept by the
+            // temp file's cleanup.
+            auto tag = _res.header("ETag");
+            if (tag && !tag->empty()) {
+                try {
+                    leatherman::file_util::atomic_write_to_file(*tag, etag_path);
+                } catch (exception const&) {
+                    LOG_WARNING("Failed to record the download validator; the partial download won't be resumed.");
+                }
+            }
+            if (result == CURLE_WRITE_ERROR) {
+                throw http_file_operation_exception(req, file_path, make_file_err_msg(_("failed to write to the temporary file during download")));
+            }
+            throw http_file_download_exception(req, file_path, _("File download server side error: {1}", errbuf));
+        }
+        collect_metrics(ctx);
+
+        LOG_DEBUG("request completed (status {1}).", _res.status_code());
+        if (_res.status_code() == 416) {
+            // The stored partial no longer matches a satisfiable range;
+            // discard it so the next attempt starts from scratch.
+            temp_file.reset();
+            boost::system::error_code ec;
+            fs::remove(etag_path, ec);
+            throw http_file_download_exception(req, file_path, _("File download server side error: {1}", _res.status_code()));
+        }
+        if (_res.status_code() >= 400) {
+            throw http_file_download_exception(req, file_path, _("File download server side error: {1}", _res.status_code()));
+        }
+
+        temp_file.write();
+        boost::system::error_code ec;
+        fs::remove(etag_path, ec);
+    }
+
     void client::set_ca_cert(string const& cert_file)
     {
         _ca_cert = cert_file;
@@ -329,6 +780,96 @@ namespace leatherman { namespace curl {
         _client_protocols = client_protocols;
     }
 
+    void client::set_http2(bool enable) {
+        _http2 = enable;
+    }
+
+    void client::set_shared_cache(bool use) {
+        _use_shared_cache = use;
+    }
+
+    void client::set_retry_policy(retry_policy policy) {
+        _retry = policy;
+    }
+
+    void client::set_compression(bool enable) {
+        _compression = enable;
+    }
+
+    void client::set_cache_directory(string const& cache_dir) {
+        _cache_dir = cache_dir;
+    }
+
+    void client::set_transport_profile(transport_profile profile) {
+        _transport = profile;
+    }
+
+    bool client::preconnect(string const& url)
+    {
+        LTH_PROFILE_SCOPE("curl.preconnect");
+        response res;
+        request req(url);
+        context ctx(req, res);
+
+        // Reset the options
+        curl_easy_reset(_handle);
+
+        // Set up just enough to establish the connection; the connection
+        // lands in this handle's connection cache, where the next request
+        // to the same host finds it.
+        set_url(ctx);
+        set_timeouts(ctx);
+        set_transport(ctx);
+        set_ca_info(ctx);
+        set_crl_info(ctx);
+        set_client_info(ctx);
+        set_client_protocols(ctx);
+        set_http_version(ctx);
+        set_share(ctx);
+        set_proxy_info(ctx);
+        curl_easy_setopt_maybe(ctx, CURLOPT_CONNECT_ONLY, 1);
+
+        auto result = curl_easy_perform(_handle);
+        if (result != CURLE_OK) {
+            LOG_DEBUG("preconnect to {1} failed: {2}.", url, curl_easy_strerror(result));
+            return false;
+        }
+        LOG_DEBUG("warmed a connection to {1}.", url);
+        return true;
+    }
+
+    string client::escape(string const& str)
+    {
+        auto it = _escape_cache.find(str);
+        if (it != _escape_cache.end()) {
+            // Move the entry to the front of the order list; the back
+            // is the eviction candidate.
+            _escape_order.splice(_escape_order.begin(), _escape_order, it->second.second);
+            return it->second.first;
+        }
+
+        curl_escaped_string escaped { _handle, str };
+        string result { static_cast<char const*>(escaped) };
+
+        _escape_order.push_front(str);
+        _escape_cache.emplace(str, make_pair(result, _escape_order.begin()));
+        if (_escape_cache.size() > escape_cache_size) {
+            _escape_cache.erase(_escape_order.back());
+            _escape_order.pop_back();
+        }
+        return result;
+    }
+
+    vector<string> client::escape(vector<string> const& strs)
+    {
+        vector<string> escaped;
+        escaped.reserve(strs.size());
+        for (auto const& str : strs) {
+            escaped.push_back(escape(str));
+        }
+        return escaped;
+    }
+
     void client::set_method(context& ctx, http_method method)
     {
         switch (method) {
@@ -387,13 +928,33 @@ namespace leatherman { namespace curl {
         curl_easy_setopt_maybe(ctx, CURLOPT_SEEKFUNCTION, seek_body);
         curl_easy_setopt_maybe(ctx, CURLOPT_SEEKDATA, &ctx);
 
+        curl_off_t body_size = 0;
+        if (!ctx.req.body_path().empty()) {
+            // The body is streamed from the file in chunks by read_body, so
+            // only its size is needed up front.
+            boost::system::error_code ec;
+            auto file_size = fs::file_size(ctx.req.body_path(), ec);
+            if (ec) {
+                throw http_file_operation_exception(ctx.req, ctx.req.body_path(), _("failed to stat request body file."));
+            }
+            ctx.body_file = boost::nowide::fopen(ctx.req.body_path().c_str(), "rb");
+            if (!ctx.body_file) {
+                throw http_file_operation_exception(ctx.req, ctx.req.body_path(), _("failed to open request body file."));
+            }
+            body_size = static_cast<curl_off_t>(file_size);
+        } else if (ctx.req.body_callback()) {
+            body_size = static_cast<curl_off_t>(ctx.req.body_size());
+        } else {
+            body_size = static_cast<curl_off_t>(ctx.req.body().size());
+        }
+
         switch (method) {
             case http_method::post: {
-                curl_easy_setopt_maybe(ctx, CURLOPT_POSTFIELDSIZE_LARGE, ctx.req.body().size());
+                curl_easy_setopt_maybe(ctx, CURLOPT_POSTFIELDSIZE_LARGE, body_size);
                 break;
             }
             case http_method::put: {
-                curl_easy_setopt_maybe(ctx, CURLOPT_INFILESIZE_LARGE, ctx.req.body().size());
+                curl_easy_setopt_maybe(ctx, CURLOPT_INFILESIZE_LARGE, body_size);
                 break;
             }
             default:
@@ -475,11 +1036,106 @@ namespace leatherman { namespace curl {
         curl_easy_setopt_maybe(ctx, CURLOPT_PROTOCOLS, _client_protocols);
     }
 
+    void client::set_http_version(context& ctx) {
+        if (!_http2) {
+            return;
+        }
+#if LIBCURL_VERSION_NUM >= 0x072F00  // 7.47.0: CURL_HTTP_VERSION_2TLS
+        // Negotiated via ALPN; servers without HTTP/2 get HTTP/1.1.
+        curl_easy_setopt_maybe(ctx, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+    }
+
+    void client::set_share(context& ctx) {
+        if (!_use_shared_cache) {
+            return;
+        }
+        auto share = curl_shared_cache::get();
+        if (share) {
+            curl_easy_setopt_maybe(ctx, CURLOPT_SHARE, share);
+        }
+    }
+
+    void client::set_transport(context& ctx) {
+        curl_easy_setopt_maybe(ctx, CURLOPT_TCP_NODELAY, _transport.tcp_nodelay ? 1 : 0);
+        if (_transport.keepalive_idle_secs > 0) {
+#if LIBCURL_VERSION_NUM >= 0x071900  // 7.25.0: CURLOPT_TCP_KEEPALIVE
+            curl_easy_setopt_maybe(ctx, CURLOPT_TCP_KEEPALIVE, 1);
+            curl_easy_setopt_maybe(ctx, CURLOPT_TCP_KEEPIDLE, _transport.keepalive_idle_secs);
+            curl_easy_setopt_maybe(ctx, CURLOPT_TCP_KEEPINTVL, _transport.keepalive_interval_secs);
+#endif
+        }
+        if (_transport.receive_buffer_size > 0) {
+            curl_easy_setopt_maybe(ctx, CURLOPT_BUFFERSIZE, _transport.receive_buffer_size);
+        }
+        if (_transport.max_recv_bytes_per_second > 0) {
+            curl_easy_setopt_maybe(ctx, CURLOPT_MAX_RECV_SPEED_LARGE, static_cast<curl_off_t>(_transport.max_recv_bytes_per_second));
+        }
+        if (_transport.max_send_bytes_per_second > 0) {
+            curl_easy_setopt_maybe(ctx, CURLOPT_MAX_SEND_SPEED_LARGE, static_cast<curl_off_t>(_transport.max_send_bytes_per_second));
+        }
+    }
+
+    void client::set_accept_encoding(context& ctx) {
+        if (!_compression || !ctx.req.compression()) {
+            return;
+        }
+        // An empty string enables every encoding libcurl was built with
+        // (e.g. gzip, deflate); libcurl decompresses the body before it
+        // reaches the write callback.
+#if LIBCURL_VERSION_NUM >= 0x071506  // 7.21.6: CURLOPT_ACCEPT_ENCODING
+        curl_easy_setopt_maybe(ctx, CURLOPT_ACCEPT_ENCODING, "");
+#else
+        curl_easy_setopt_maybe(ctx, CURLOPT_ENCODING, "");
+#endif
+    }
+
+    void client::collect_metrics(context& ctx) {
+        transfer_metrics metrics;
+        double seconds = 0.0;
+        if (curl_easy_getinfo(_handle, CURLINFO_NAMELOOKUP_TIME, &seconds) == CURLE_OK) {
+            metrics.namelookup_time = seconds;
+        }
+        if (curl_easy_getinfo(_handle, CURLINFO_CONNECT_TIME, &seconds) == CURLE_OK) {
+            metrics.connect_time = seconds;
+        }
+        if (curl_easy_getinfo(_handle, CURLINFO_APPCONNECT_TIME, &seconds) == CURLE_OK) {
+            metrics.appconnect_time = seconds;
+        }
+        if (curl_easy_getinfo(_handle, CURLINFO_STARTTRANSFER_TIME, &seconds) == CURLE_OK) {
+            metrics.starttransfer_time = seconds;
+        }
+        if (curl_easy_getinfo(_handle, CURLINFO_TOTAL_TIME, &seconds) == CURLE_OK) {
+            metrics.total_time = seconds;
+        }
+        double bytes = 0.0;
+        if (curl_easy_getinfo(_handle, CURLINFO_SIZE_DOWNLOAD, &bytes) == CURLE_OK && bytes > 0) {
+            metrics.downloaded_bytes = static_cast<uint64_t>(bytes);
+        }
+        if (curl_easy_getinfo(_handle, CURLINFO_SIZE_UPLOAD, &bytes) == CURLE_OK && bytes > 0) {
+            metrics.uploaded_bytes = static_cast<uint64_t>(bytes);
+        }
+        long connects = 0;
+        if (curl_easy_getinfo(_handle, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK) {
+            metrics.reused_connection = connects == 0;
+        }
+        ctx.res.metrics(metrics);
+    }
+
     size_t client::read_body(char* buffer, size_t size, size_t count, void* ptr)
     {
         auto ctx = reinterpret_cast<context*>(ptr);
         size_t requested = size * count;
 
+        if (ctx->body_file) {
+            return fread(buffer, 1, requested, ctx->body_file);
+        }
+
+        auto const& source = ctx->req.body_callback();
+        if (source) {
+            return source(buffer, requested);
+        }
+
         auto const& body = ctx->req.body();
 
         if (requested > (body.size() - ctx->read_offset)) {
@@ -508,6 +1164,29 @@ namespace leatherman { namespace curl {
             return CURL_SEEKFUNC_FAIL;
         }
 
+        if (ctx->body_file) {
+#ifdef _WIN32
+            if (_fseeki64(ctx->body_file, offset, SEEK_SET) != 0) {
+#else
+            if (fseeko(ctx->body_file, offset, SEEK_SET) != 0) {
+#endif
+                return CURL_SEEKFUNC_FAIL;
+            }
+            return CURL_SEEKFUNC_OK;
+        }
+
+        if (ctx->req.body_callback()) {
+            // A seeker makes a pull callback rewindable, so redirects and
+            // auth retries can re-send the body without buffering it.
+            auto const& seeker = ctx->req.body_seek_callback();
+            if (seeker) {
+                return seeker(offset) ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+            }
+            // Forward-only; let libcurl recover some other way (e.g. by
+            // closing and re-opening the connection).
+            return CURL_SEEKFUNC_CANTSEEK;
+        }
+
         ctx->read_offset = offset;
         return CURL_SEEKFUNC_OK;
     }
@@ -548,9 +1227,13 @@ namespace leatherman { namespace curl {
         boost::trim(value);
 
         // If this is the "Content-Length" header, reserve the response buffer as an optimization
-        if (name == "Content-Length") {
+        if (name == "Content-Length" && !ctx->sink) {
             try {
-                ctx->response_buffer.reserve(stoi(value));
+                // Cap the preallocation so a bogus or hostile length can't
+                // commit a huge buffer up front; bodies past the cap fall
+                // back to incremental growth.
+                static const unsigned long long max_preallocation = 64ull * 1024 * 1024;
+                ctx->response_buffer.reserve(static_cast<size_t>(min(stoull(value), max_preallocation)));
             } catch (logic_error&) {
             }
         }
@@ -564,6 +1247,11 @@ namespace leatherman { namespace curl {
         size_t written = size * count;
 
         auto ctx = reinterpret_cast<context*>(ptr);
+        if (ctx->sink) {
+            // Stream the chunk straight to the caller's sink; a short count
+            // aborts the transfer.
+            return written > 0 ? (*ctx->sink)(buffer, written) : written;
+        }
         if (written > 0) {
             ctx->response_buffer.append(buffer, written);
         }
@@ -576,6 +1264,29 @@ namespace leatherman { namespace curl {
         return fwrite(buffer, size, count, reinterpret_cast<FILE*>(ptr));
     }
 
+    size_t client::write_file_resumable(char* buffer, size_t size, size_t count, void* ptr)
+    {
+        auto rctx = reinterpret_cast<resumable_file_context*>(ptr);
+
+        // Don't let an error body corrupt the kept partial file.
+        if (rctx->res->status_code() >= 400) {
+            return size * count;
+        }
+
+        if (!rctx->checked) {
+            rctx->checked = true;
+            // A 200 while resuming means the validator didn't match, or the
+            // server doesn't honor ranges, and the whole entity is being
+            // resent: restart the partial file from scratch.
+            if (rctx->resuming && rctx->res->status_code() == 200) {
+                if (!boost::nowide::freopen(rctx->temp_path.c_str(), "wb", rctx->fp)) {
+                    return 0;
+                }
+            }
+        }
+        return fwrite(buffer, size, count, rctx->fp);
+    }
+
     int client::debug(CURL* handle, curl_infotype type, char* data, size_t size, void* ptr)
     {
         if (type > CURLINFO_DATA_OUT) {
@@ -613,4 +1324,373 @@ namespace leatherman { namespace curl {
     {
         return _handle;
     }
+
+    client_pool::client_pool(size_t size) :
+        _size(size == 0 ? 1 : size)
+    {
+    }
+
+    client_pool::~client_pool()
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            _shutdown = true;
+        }
+        _task_ready.notify_all();
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    response client_pool::get(request const& req)
+    {
+        auto checked_out = acquire();
+        util::scope_exit checkin([&]() { release(move(checked_out)); });
+        return checked_out->get(req);
+    }
+
+    response client_pool::post(request const& req)
+    {
+        auto checked_out = acquire();
+        util::scope_exit checkin([&]() { release(move(checked_out)); });
+        return checked_out->post(req);
+    }
+
+    response client_pool::put(request const& req)
+    {
+        auto checked_out = acquire();
+        util::scope_exit checkin([&]() { release(move(checked_out)); });
+        return checked_out->put(req);
+    }
+
+    future<response> client_pool::get_async(request req)
+    {
+        return perform_async(&client_pool::get, move(req));
+    }
+
+    future<response> client_pool::post_async(request req)
+    {
+        return perform_async(&client_pool::post, move(req));
+    }
+
+    future<response> client_pool::put_async(request req)
+    {
+        return perform_async(&client_pool::put, move(req));
+    }
+
+    void client_pool::get_async(request req, function<void(response, exception_ptr)> callback)
+    {
+        perform_async(&client_pool::get, move(req), move(callback));
+    }
+
+    void client_pool::post_async(request req, function<void(response, exception_ptr)> callback)
+    {
+        perform_async(&client_pool::post, move(req), move(callback));
+    }
+
+    void client_pool::put_async(request req, function<void(response, exception_ptr)> callback)
+    {
+        perform_async(&client_pool::put, move(req), move(callback));
+    }
+
+    future<response> client_pool::perform_async(response (client_pool::*method)(request const&), request req)
+    {
+        auto task = make_shared<packaged_task<response()>>([this, method, req]() {
+            return (this->*method)(req);
+        });
+        auto result = task->get_future();
+        enqueue([task]() { (*task)(); });
+        return result;
+    }
+
+    void client_pool::perform_async(response (client_pool::*method)(request const&), request req, function<void(response, exception_ptr)> callback)
+    {
+        enqueue([this, method, req, callback]() {
+            try {
+                auto res = (this->*method)(req);
+                callback(move(res), nullptr);
+            } catch (...) {
+                callback(response(), current_exception());
+            }
+        });
+    }
+
+    void client_pool::enqueue(function<void()> task)
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            _tasks.emplace(move(task));
+            // Start another worker only when no idle one will pick the task
+            // up; workers are bounded by the pool size, matching the number
+            // of clients that can be checked out concurrently.
+            if (_idle_workers == 0 && _threads.size() < _size) {
+                _threads.emplace_back([this]() { run_worker(); });
+            }
+        }
+        _task_ready.notify_one();
+    }
+
+    void client_pool::run_worker()
+    {
+        unique_lock<mutex> lock(_mutex);
+        while (true) {
+            while (_tasks.empty()) {
+                if (_shutdown) {
+                    return;
+                }
+                ++_idle_workers;
+                _task_ready.wait(lock);
+                --_idle_workers;
+            }
+            auto task = move(_tasks.front());
+            _tasks.pop();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    void client_pool::download_file(request const& req, string const& file_path, size_t segments, boost::optional<fs::perms> perms)
+    {
+        if (segments < 2) {
+            auto checked_out = acquire();
+            util::scope_exit checkin([&]() { release(move(checked_out)); });
+            checked_out->download_file(req, file_path, perms);
+            return;
+        }
+
+        download_temp_file temp_file(req, file_path, perms);
+        FILE* fp = temp_file.get_fp();
+        mutex file_mutex;
+
+        // Positioned write shared by the segment sinks; segments interleave
+        // on the temporary file, so seek+write runs under a lock.
+        auto write_at = [&](unsigned long long offset, char const* data, size_t size) -> bool {
+            lock_guard<mutex> lock(file_mutex);
+#ifdef _WIN32
+            if (_fseeki64(fp, static_cast<long long>(offset), SEEK_SET) != 0) {
+                return false;
+            }
+#else
+            if (fseeko(fp, static_cast<off_t>(offset), SEEK_SET) != 0) {
+                return false;
+            }
+#endif
+            return fwrite(data, 1, size, fp) == size;
+        };
+        auto make_sink = [&](unsigned long long offset) {
+            return [&write_at, offset](char const* data, size_t size) mutable -> size_t {
+                if (!write_at(offset, data, size)) {
+                    return 0;
+                }
+                offset += size;
+                return size;
+            };
+        };
+
+        // Probe with a one-byte range request, streaming the body to the
+        // file: a server honoring ranges answers 206 with the total length
+        // in Content-Range, while one that ignores ranges streams the whole
+        // body through this connection, completing the download here.
+        unsigned long long total = 0;
+        {
+            request probe(req);
+            probe.add_header("Range", "bytes=0-0");
+            client::body_sink sink = make_sink(0);
+            auto checked_out = acquire();
+            util::scope_exit checkin([&]() { release(move(checked_out)); });
+            auto res = checked_out->get(probe, sink);
+            if (res.status_code() >= 400) {
+                throw http_file_download_exception(req, file_path, _("File download server side error: {1}", res.status_code()));
+            }
+            auto content_range = res.status_code() == 206 ? res.header("Content-Range") : nullptr;
+            static boost::regex range_regex("bytes \\d+-\\d+/(\\d+)");
+            if (!content_range || !util::re_search(*content_range, range_regex, &total) || total <= 1) {
+                temp_file.write();
+                return;
+            }
+        }
+
+        // Fetch the remaining bytes with parallel ranged requests dispatched
+        // on the pool's workers, so parallelism is bounded by the pool size.
+        auto chunk = (total - 1 + segments - 1) / segments;
+        vector<future<void>> fetches;
+        for (unsigned long long begin = 1; begin < total; begin += chunk) {
+            auto end = min(begin + chunk, total) - 1;
+            auto task = make_shared<packaged_task<void()>>([this, &req, &file_path, &make_sink, begin, end]() {
+                request segment(req);
+                segment.add_header("Range", "bytes=" + to_string(begin) + "-" + to_string(end));
+                client::body_sink sink = make_sink(begin);
+                auto checked_out = acquire();
+                util::scope_exit checkin([&]() { release(move(checked_out)); });
+                auto res = checked_out->get(segment, sink);
+                if (res.status_code() != 206) {
+                    throw http_file_download_exception(req, file_path, _("File download server side error: {1}", res.status_code()));
+                }
+            });
+            fetches.emplace_back(task->get_future());
+            enqueue([task]() { (*task)(); });
+        }
+
+        // Wait for every segment before touching the temporary file; the
+        // first failure is rethrown once all in-flight segments finish.
+        exception_ptr error;
+        for (auto& fetch : fetches) {
+            try {
+                fetch.get();
+            } catch (...) {
+                if (!error) {
+                    error = current_exception();
+                }
+            }
+        }
+        if (error) {
+            rethrow_exception(error);
+        }
+
+        temp_file.write();
+    }
+
+    void client_pool::set_ca_cert(string const& cert_file)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _ca_cert = cert_file;
+    }
+
+    void client_pool::set_client_cert(string const& client_cert, string const& client_key)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _client_cert = client_cert;
+        _client_key = client_key;
+    }
+
+    void client_pool::set_client_crl(string const& client_crl)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _client_crl = client_crl;
+    }
+
+    void client_pool::set_proxy(string const& proxy)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _proxy = proxy;
+    }
+
+    void client_pool::set_supported_protocols(long client_protocols)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _client_protocols = client_protocols;
+    }
+
+    void client_pool::set_http2(bool enable)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _http2 = enable;
+    }
+
+    void client_pool::set_shared_cache(bool use)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _use_shared_cache = use;
+    }
+
+    void client_pool::set_retry_policy(retry_policy policy)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _retry = policy;
+    }
+
+    void client_pool::set_compression(bool enable)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _compression = enable;
+    }
+
+    void client_pool::set_cache_directory(string const& cache_dir)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _cache_dir = cache_dir;
+    }
+
+    void client_pool::set_transport_profile(transport_profile profile)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _transport = profile;
+    }
+
+    bool client_pool::preconnect(string const& url)
+    {
+        auto checked_out = acquire();
+        util::scope_exit checkin([&]() { release(move(checked_out)); });
+        return checked_out->preconnect(url);
+    }
+
+    size_t client_pool::size() const
+    {
+        lock_guard<mutex> lock(_mutex);
+        return _size;
+    }
+
+    unique_ptr<client> client_pool::acquire()
+    {
+        unique_lock<mutex> lock(_mutex);
+        while (true) {
+            if (!_idle.empty()) {
+                auto checked_out = move(_idle.back());
+                _idle.pop_back();
+                return checked_out;
+            }
+            if (_created < _size) {
+                ++_created;
+                // Construct and configure outside the lock; handle creation
+                // can be slow and other checkouts shouldn't wait on it.
+                auto ca_cert = _ca_cert;
+                auto client_cert = _client_cert;
+                auto client_key = _client_key;
+                auto client_crl = _client_crl;
+                auto proxy = _proxy;
+                auto client_protocols = _client_protocols;
+                auto http2 = _http2;
+                auto use_shared_cache = _use_shared_cache;
+                auto retry = _retry;
+                auto compression = _compression;
+                auto cache_dir = _cache_dir;
+                auto transport = _transport;
+                lock.unlock();
+                unique_ptr<client> checked_out(new client());
+                if (!ca_cert.empty()) {
+                    checked_out->set_ca_cert(ca_cert);
+                }
+                if (!client_cert.empty()) {
+                    checked_out->set_client_cert(client_cert, client_key);
+                }
+                if (!client_crl.empty()) {
+                    checked_out->set_client_crl(client_crl);
+                }
+                if (!proxy.empty()) {
+                    checked_out->set_proxy(proxy);
+                }
+                checked_out->set_supported_protocols(client_protocols);
+                checked_out->set_http2(http2);
+                checked_out->set_shared_cache(use_shared_cache);
+                checked_out->set_retry_policy(retry);
+                checked_out->set_compression(compression);
+                if (!cache_dir.empty()) {
+                    checked_out->set_cache_directory(cache_dir);
+                }
+                checked_out->set_transport_profile(transport);
+                return checked_out;
+            }
+            _available.wait(lock);
+        }
+    }
+
+    void client_pool::release(unique_ptr<client> checked_out)
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            _idle.emplace_back(move(checked_out));
+        }
+        _available.notify_one();
+    }
 }}  // leatherman::curl
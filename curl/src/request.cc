@@ -1,13 +1,33 @@
 #include <leatherman/curl/request.hpp>
 
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+
 using namespace std;
 
 namespace leatherman { namespace curl {
 
+    // HTTP header names compare equal regardless of case.
+    static bool header_name_less(string const& left, string const& right)
+    {
+        return boost::algorithm::ilexicographical_compare(left, right);
+    }
+
+    static vector<pair<string, string>>::iterator find_header_position(vector<pair<string, string>>& headers, string const& name)
+    {
+        return lower_bound(headers.begin(), headers.end(), name,
+            [](pair<string, string> const& entry, string const& name) {
+                return header_name_less(entry.first, name);
+            });
+    }
+
     request::request(string url) :
         _url(move(url)),
+        _body_source_size(0),
         _timeout(0),
-        _connection_timeout(0)
+        _connection_timeout(0),
+        _compression(true)
     {
     }
 
@@ -18,7 +38,12 @@ namespace leatherman { namespace curl {
 
     void request::add_header(string name, string value)
     {
-        _headers.emplace(make_pair(move(name), move(value)));
+        auto it = find_header_position(_headers, name);
+        if (it != _headers.end() && !header_name_less(name, it->first)) {
+            // Keep the first value, matching the previous map behavior.
+            return;
+        }
+        _headers.emplace(it, move(name), move(value));
     }
 
     void request::each_header(function<bool(string const&, string const&)> callback) const
@@ -35,8 +60,8 @@ namespace leatherman { namespace curl {
 
     string* request::header(string const& name)
     {
-        auto header = _headers.find(name);
-        if (header == _headers.end()) {
+        auto header = find_header_position(_headers, name);
+        if (header == _headers.end() || header_name_less(name, header->first)) {
             return nullptr;
         }
         return &header->second;
@@ -44,7 +69,10 @@ namespace leatherman { namespace curl {
 
     void request::remove_header(string const& name)
     {
-        _headers.erase(name);
+        auto header = find_header_position(_headers, name);
+        if (header != _headers.end() && !header_name_less(name, header->first)) {
+            _headers.erase(header);
+        }
     }
 
     void request::add_cookie(string name, string value)
@@ -81,6 +109,40 @@ namespace leatherman { namespace curl {
     void request::body(string body, string content_type)
     {
         _body = move(body);
+        _body_source = nullptr;
+        _body_seeker = nullptr;
+        _body_source_size = 0;
+        _body_path.clear();
+        add_header("Content-Type", move(content_type));
+    }
+
+    void request::body(body_source source, size_t size, string content_type)
+    {
+        _body.clear();
+        _body_source = move(source);
+        _body_seeker = nullptr;
+        _body_source_size = size;
+        _body_path.clear();
+        add_header("Content-Type", move(content_type));
+    }
+
+    void request::body(body_source source, body_seeker seeker, size_t size, string content_type)
+    {
+        _body.clear();
+        _body_source = move(source);
+        _body_seeker = move(seeker);
+        _body_source_size = size;
+        _body_path.clear();
+        add_header("Content-Type", move(content_type));
+    }
+
+    void request::body_from_file(string file_path, string content_type)
+    {
+        _body.clear();
+        _body_source = nullptr;
+        _body_seeker = nullptr;
+        _body_source_size = 0;
+        _body_path = move(file_path);
         add_header("Content-Type", move(content_type));
     }
 
@@ -89,6 +151,26 @@ namespace leatherman { namespace curl {
         return _body;
     }
 
+    request::body_source const& request::body_callback() const
+    {
+        return _body_source;
+    }
+
+    request::body_seeker const& request::body_seek_callback() const
+    {
+        return _body_seeker;
+    }
+
+    size_t request::body_size() const
+    {
+        return _body_source_size;
+    }
+
+    string const& request::body_path() const
+    {
+        return _body_path;
+    }
+
     long request::timeout() const
     {
         return _timeout;
@@ -109,4 +191,14 @@ namespace leatherman { namespace curl {
         _connection_timeout = value < 0 ? 0 : value;
     }
 
+    void request::compression(bool enable)
+    {
+        _compression = enable;
+    }
+
+    bool request::compression() const
+    {
+        return _compression;
+    }
+
 }}  // leatherman::curl
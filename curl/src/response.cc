@@ -1,9 +1,35 @@
 #include <leatherman/curl/response.hpp>
 
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+
 using namespace std;
 
 namespace leatherman { namespace curl {
 
+    // HTTP header names compare equal regardless of case.
+    static bool header_name_less(string const& left, string const& right)
+    {
+        return boost::algorithm::ilexicographical_compare(left, right);
+    }
+
+    static vector<pair<string, string>>::iterator find_header_position(vector<pair<string, string>>& headers, string const& name)
+    {
+        return lower_bound(headers.begin(), headers.end(), name,
+            [](pair<string, string> const& entry, string const& name) {
+                return header_name_less(entry.first, name);
+            });
+    }
+
+    static vector<pair<string, string>>::const_iterator find_header_position(vector<pair<string, string>> const& headers, string const& name)
+    {
+        return lower_bound(headers.begin(), headers.end(), name,
+            [](pair<string, string> const& entry, string const& name) {
+                return header_name_less(entry.first, name);
+            });
+    }
+
     response::response() :
         _status_code(0)
     {
@@ -11,7 +37,12 @@ namespace leatherman { namespace curl {
 
     void response::add_header(string name, string value)
     {
-        _headers.emplace(make_pair(move(name), move(value)));
+        auto it = find_header_position(_headers, name);
+        if (it != _headers.end() && !header_name_less(name, it->first)) {
+            // Keep the first value, matching the previous map behavior.
+            return;
+        }
+        _headers.emplace(it, move(name), move(value));
     }
 
     void response::each_header(function<bool(string const&, string const&)> callback) const
@@ -28,8 +59,8 @@ namespace leatherman { namespace curl {
 
     const string* response::header(string const& name) const
     {
-        auto header = _headers.find(name);
-        if (header == _headers.end()) {
+        auto header = find_header_position(_headers, name);
+        if (header == _headers.end() || header_name_less(name, header->first)) {
             return nullptr;
         }
         return &header->second;
@@ -37,7 +68,10 @@ namespace leatherman { namespace curl {
 
     void response::remove_header(string const& name)
     {
-        _headers.erase(name);
+        auto header = find_header_position(_headers, name);
+        if (header != _headers.end() && !header_name_less(name, header->first)) {
+            _headers.erase(header);
+        }
     }
 
     void response::body(string body)
@@ -45,6 +79,13 @@ namespace leatherman { namespace curl {
         _body = move(body);
     }
 
+    string response::release_body()
+    {
+        string body = move(_body);
+        _body.clear();
+        return body;
+    }
+
     string const& response::body() const
     {
         return _body;
@@ -59,4 +100,14 @@ namespace leatherman { namespace curl {
     {
         _status_code = status;
     }
+
+    void response::metrics(transfer_metrics metrics)
+    {
+        _metrics = metrics;
+    }
+
+    transfer_metrics const& response::metrics() const
+    {
+        return _metrics;
+    }
 }}  // leatherman::curl
@@ -4,13 +4,20 @@
 #include <leatherman/curl/client.hpp>
 #include <leatherman/curl/request.hpp>
 #include <leatherman/curl/response.hpp>
+#include <leatherman/file_util/file.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/nowide/iostream.hpp>
 #include <boost/nowide/fstream.hpp>
 #include <boost/regex.hpp>
 #include <sstream>
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
 #include <map>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
 
 using namespace std;
 namespace fs = boost::filesystem;
@@ -78,6 +85,209 @@ TEST_CASE("curl::client HTTP methods") {
     }
 }
 
+TEST_CASE("curl::client response caching") {
+    mock_client test_client;
+    temp_directory cache_dir;
+    test_client.set_cache_directory(cache_dir.get_dir_name());
+    request test_request {"http://cacheable.com/"};
+
+    SECTION("a response with a validator is stored and replayed on revalidation") {
+        auto first = test_client.get(test_request);
+        REQUIRE(first.status_code() == 200);
+        REQUIRE(first.body() == "cacheable contents");
+
+        // The mock answers the conditional request with a bodiless 304;
+        // the body must come back from the cache.
+        auto second = test_client.get(test_request);
+        REQUIRE(second.status_code() == 200);
+        REQUIRE(second.body() == "cacheable contents");
+    }
+
+    SECTION("a response without a validator is not cached") {
+        request uncacheable_request {"http://valid.com/"};
+        auto resp = test_client.get(uncacheable_request);
+        REQUIRE(resp.status_code() == 200);
+        REQUIRE(fs::is_empty(cache_dir.get_dir_name()));
+    }
+
+    SECTION("the cache is bypassed when no cache directory is configured") {
+        mock_client uncached_client;
+        auto resp = uncached_client.get(test_request);
+        REQUIRE(resp.status_code() == 200);
+        REQUIRE(fs::is_empty(cache_dir.get_dir_name()));
+    }
+}
+
+TEST_CASE("curl::client endpoint racing") {
+    mock_client test_client;
+    request test_request {""};
+
+    SECTION("GET completes over a single candidate endpoint") {
+        auto resp = test_client.get_first({ "http://valid.com/" }, test_request);
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("an HTTP error status still counts as a completed candidate") {
+        auto resp = test_client.get_first({ "http://invalid.com/" }, test_request);
+        REQUIRE(resp.status_code() == 404);
+    }
+
+    SECTION("racing with no candidate endpoints throws") {
+        REQUIRE_THROWS_AS(test_client.get_first({}, test_request), http_request_exception);
+    }
+
+    SECTION("racing throws when every candidate fails to perform") {
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        test_impl->test_failure_mode = curl_impl::error_mode::easy_perform_error;
+        REQUIRE_THROWS_AS(
+            test_client.get_first({ "http://valid.com/", "http://invalid.com/" }, test_request, 0),
+            http_request_exception);
+    }
+}
+
+TEST_CASE("curl::client transport tuning and preconnect") {
+    mock_client test_client;
+    request test_request {"http://valid.com/"};
+
+    SECTION("requests succeed with a transport profile applied") {
+        transport_profile profile;
+        profile.keepalive_idle_secs = 30;
+        profile.receive_buffer_size = 128 * 1024;
+        profile.max_recv_bytes_per_second = 1024 * 1024;
+        test_client.set_transport_profile(profile);
+        auto resp = test_client.get(test_request);
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("preconnect warms a connection without issuing a request") {
+        REQUIRE(test_client.preconnect("http://valid.com/"));
+        auto resp = test_client.get(test_request);
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("a pool can warm connections for its clients") {
+        client_pool pool { 1 };
+        REQUIRE(pool.preconnect("http://valid.com/"));
+        REQUIRE(pool.get(test_request).status_code() == 200);
+    }
+}
+
+TEST_CASE("curl::client URL escaping") {
+    mock_client test_client;
+    CURL* const& handle = test_client.get_handle();
+    auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+
+    SECTION("escapes a string through libcurl") {
+        REQUIRE(test_client.escape("node name") == "escaped:node name");
+    }
+
+    SECTION("repeat escapes are served from the cache") {
+        REQUIRE(test_client.escape("node name") == "escaped:node name");
+        REQUIRE(test_client.escape("node name") == "escaped:node name");
+        REQUIRE(test_impl->escape_calls == 1);
+    }
+
+    SECTION("escapes a batch of strings in order") {
+        auto escaped = test_client.escape(vector<string> { "a b", "c d", "a b" });
+        REQUIRE(escaped.size() == 3u);
+        REQUIRE(escaped[0] == "escaped:a b");
+        REQUIRE(escaped[1] == "escaped:c d");
+        REQUIRE(escaped[2] == "escaped:a b");
+        REQUIRE(test_impl->escape_calls == 2);
+    }
+
+    SECTION("the least recently used entry is evicted when the cache fills") {
+        test_client.escape("first");
+        for (int i = 0; i < 256; ++i) {
+            test_client.escape("filler" + to_string(i));
+        }
+        auto calls = test_impl->escape_calls;
+        test_client.escape("first");
+        REQUIRE(test_impl->escape_calls == calls + 1);
+    }
+
+    SECTION("a cache hit refreshes an entry's position") {
+        test_client.escape("first");
+        for (int i = 0; i < 255; ++i) {
+            test_client.escape("filler" + to_string(i));
+        }
+        // The cache is now full; a hit on the oldest entry should keep
+        // it alive through the next insertion.
+        test_client.escape("first");
+        test_client.escape("one more");
+        auto calls = test_impl->escape_calls;
+        test_client.escape("first");
+        REQUIRE(test_impl->escape_calls == calls);
+    }
+}
+
+TEST_CASE("curl::client_pool HTTP methods") {
+    client_pool pool { 2 };
+    request test_request {"http://valid.com/"};
+
+    SECTION("GET succeeds on a given URL") {
+        auto resp = pool.get(test_request);
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("POST succeeds on a given URL") {
+        auto resp = pool.post(test_request);
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("PUT succeeds on a given URL") {
+        auto resp = pool.put(test_request);
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("sequential requests reuse pooled clients") {
+        for (int i = 0; i < 8; i++) {
+            auto resp = pool.get(test_request);
+            REQUIRE(resp.status_code() == 200);
+        }
+    }
+
+    SECTION("the pool reports its configured size") {
+        REQUIRE(pool.size() == 2u);
+    }
+
+    SECTION("asynchronous requests complete through a future") {
+        auto future_resp = pool.get_async(test_request);
+        auto resp = future_resp.get();
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("multiple asynchronous requests can be in flight") {
+        vector<future<response>> futures;
+        for (int i = 0; i < 8; i++) {
+            futures.emplace_back(pool.get_async(test_request));
+        }
+        for (auto& fut : futures) {
+            REQUIRE(fut.get().status_code() == 200);
+        }
+    }
+
+    SECTION("asynchronous requests can invoke a completion callback") {
+        mutex lock;
+        condition_variable done;
+        bool completed = false;
+        long status = 0;
+        exception_ptr error;
+        pool.get_async(test_request, [&](response resp, exception_ptr err) {
+            lock_guard<mutex> guard(lock);
+            status = resp.status_code();
+            error = err;
+            completed = true;
+            done.notify_one();
+        });
+        unique_lock<mutex> guard(lock);
+        done.wait(guard, [&]() { return completed; });
+        REQUIRE(status == 200);
+        REQUIRE_FALSE(error);
+    }
+}
+
 TEST_CASE("curl::client HTTP request setup") {
     mock_client test_client;
     request test_request {"http://valid.com"};
@@ -109,6 +319,69 @@ TEST_CASE("curl::client HTTP request setup") {
         auto test_impl = reinterpret_cast<curl_impl* const>(handle);
         REQUIRE(test_impl->request_url == "http://valid.com");
     }
+
+#if LIBCURL_VERSION_NUM >= 0x072F00
+    SECTION("HTTP/2 is requested when enabled") {
+        test_client.set_http2();
+        auto resp = test_client.get(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE(test_impl->http_version == CURL_HTTP_VERSION_2TLS);
+    }
+#endif
+
+    SECTION("the HTTP version is left to libcurl's default when HTTP/2 is not enabled") {
+        auto resp = test_client.get(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE(test_impl->http_version == 0);
+    }
+
+    SECTION("handles join the process-wide DNS and TLS session cache by default") {
+        auto resp = test_client.get(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE(test_impl->share != nullptr);
+
+        mock_client other_client;
+        auto other_resp = other_client.get(test_request);
+        CURL* const& other_handle = other_client.get_handle();
+        auto other_impl = reinterpret_cast<curl_impl* const>(other_handle);
+        REQUIRE(other_impl->share == test_impl->share);
+    }
+
+    SECTION("a client can opt out of the shared cache") {
+        test_client.set_shared_cache(false);
+        auto resp = test_client.get(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE(test_impl->share == nullptr);
+    }
+
+    SECTION("compressed transfer encoding is negotiated by default") {
+        auto resp = test_client.get(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE(test_impl->accept_encoding_set);
+        // The empty string asks libcurl for every encoding it supports.
+        REQUIRE(test_impl->accept_encoding == "");
+    }
+
+    SECTION("a client can disable compressed transfer encoding") {
+        test_client.set_compression(false);
+        auto resp = test_client.get(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE_FALSE(test_impl->accept_encoding_set);
+    }
+
+    SECTION("a request can opt out of compressed transfer encoding") {
+        test_request.compression(false);
+        auto resp = test_client.get(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE_FALSE(test_impl->accept_encoding_set);
+    }
 }
 
 TEST_CASE("curl::client header and body writing and reading") {
@@ -168,6 +441,89 @@ TEST_CASE("curl::client header and body writing and reading") {
         REQUIRE(test_impl->read_buffer == "Hello, I am a request body!");
     }
 
+    SECTION("Request body should be streamable from a pull callback") {
+        request test_request {"http://valid.com"};
+        string payload = "Hello, I am a streamed request body!";
+        size_t offset = 0;
+        test_request.body([&](char* buffer, size_t length) {
+            auto chunk = min(length, payload.size() - offset);
+            memcpy(buffer, payload.data() + offset, chunk);
+            offset += chunk;
+            return chunk;
+        }, payload.size(), "message");
+        auto resp = test_client.put(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE(test_impl->read_buffer == payload);
+        REQUIRE(test_request.body().empty());
+    }
+
+    SECTION("Request body should be streamable from a file") {
+        auto body_file = unique_fixture_path().string();
+        leatherman::file_util::atomic_write_to_file("Hello, I am a file-backed request body!", body_file);
+        request test_request {"http://valid.com"};
+        test_request.body_from_file(body_file, "message");
+        auto resp = test_client.put(test_request);
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        REQUIRE(test_impl->read_buffer == "Hello, I am a file-backed request body!");
+        fs::remove(body_file);
+    }
+
+    SECTION("A file-backed body should survive a mid-transfer rewind") {
+        auto body_file = unique_fixture_path().string();
+        leatherman::file_util::atomic_write_to_file("Hello, I am a file-backed request body!", body_file);
+        request test_request {"http://valid.com/"};
+        test_request.body_from_file(body_file, "message");
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        test_impl->rewind_mid_transfer = true;
+        auto resp = test_client.put(test_request);
+        REQUIRE(resp.status_code() == 200);
+        REQUIRE(test_impl->read_buffer == "Hello, I am a file-backed request body!");
+        fs::remove(body_file);
+    }
+
+    SECTION("A callback body with a seeker should survive a mid-transfer rewind") {
+        request test_request {"http://valid.com/"};
+        string payload = "Hello, I am a streamed request body!";
+        size_t offset = 0;
+        bool rewound = false;
+        test_request.body([&](char* buffer, size_t length) {
+            auto chunk = min(length, payload.size() - offset);
+            memcpy(buffer, payload.data() + offset, chunk);
+            offset += chunk;
+            return chunk;
+        }, [&](size_t to) {
+            offset = to;
+            rewound = true;
+            return true;
+        }, payload.size(), "message");
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        test_impl->rewind_mid_transfer = true;
+        auto resp = test_client.put(test_request);
+        REQUIRE(resp.status_code() == 200);
+        REQUIRE(rewound);
+        REQUIRE(test_impl->read_buffer == payload);
+    }
+
+    SECTION("A forward-only callback body should fail the transfer on a rewind") {
+        request test_request {"http://valid.com/"};
+        string payload = "Hello, I am a streamed request body!";
+        size_t offset = 0;
+        test_request.body([&](char* buffer, size_t length) {
+            auto chunk = min(length, payload.size() - offset);
+            memcpy(buffer, payload.data() + offset, chunk);
+            offset += chunk;
+            return chunk;
+        }, payload.size(), "message");
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        test_impl->rewind_mid_transfer = true;
+        REQUIRE_THROWS_AS(test_client.put(test_request), http_request_exception);
+    }
+
     SECTION("Response body should be what is in the data part of the cURL response") {
         CURL* const& handle = test_client.get_handle();
         auto test_impl = reinterpret_cast<curl_impl* const>(handle);
@@ -176,11 +532,37 @@ TEST_CASE("curl::client header and body writing and reading") {
         auto resp = test_client.get(test_request);
         REQUIRE(resp.body() == "Hello, I am a response body!");
     }
+
+    SECTION("Response body should stream to a sink instead of the response") {
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        test_impl->resp_body = "Hello, I am a streamed body!";
+        request test_request {"http://valid.com/"};
+        string streamed;
+        auto resp = test_client.get(test_request, [&](char const* data, size_t size) {
+            streamed.append(data, size);
+            return size;
+        });
+        REQUIRE(streamed == "Hello, I am a streamed body!");
+        REQUIRE(resp.body().empty());
+        REQUIRE(resp.status_code() == 200);
+    }
+
+    SECTION("Response body should stream to an ostream sink") {
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        test_impl->resp_body = "Hello, I am a streamed body!";
+        request test_request {"http://valid.com/"};
+        ostringstream streamed;
+        auto resp = test_client.get(test_request, streamed);
+        REQUIRE(streamed.str() == "Hello, I am a streamed body!");
+        REQUIRE(resp.body().empty());
+    }
 }
 
 TEST_CASE("curl::client cookies") {
     mock_client test_client;
-    request test_request {"http://valid.com"};
+    request test_request {"http://valid.com/"};
 
     SECTION("There should be no cookies in the request by default") {
         auto resp = test_client.get(test_request);
@@ -424,6 +806,172 @@ TEST_CASE("curl::client errors") {
     }
 }
 
+    TEST_CASE("curl::client retry policy") {
+        mock_client test_client;
+        request test_request {"http://valid.com/"};
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        retry_policy policy;
+        policy.max_attempts = 3;
+        policy.base_delay_ms = 1;
+        policy.jitter_ms = 0;
+
+        SECTION("transfers are not retried by default") {
+            test_impl->test_failure_mode = curl_impl::error_mode::easy_perform_error;
+            REQUIRE_THROWS_AS(test_client.get(test_request), http_request_exception);
+            REQUIRE(test_impl->perform_calls == 1);
+        }
+
+        SECTION("a transient connection error is retried until the transfer succeeds") {
+            test_client.set_retry_policy(policy);
+            test_impl->fail_next_performs = 2;
+            auto resp = test_client.get(test_request);
+            REQUIRE(resp.status_code() == 200);
+            REQUIRE(test_impl->perform_calls == 3);
+        }
+
+        SECTION("a persistent connection error is rethrown once the attempts are exhausted") {
+            test_client.set_retry_policy(policy);
+            test_impl->test_failure_mode = curl_impl::error_mode::easy_perform_error;
+            REQUIRE_THROWS_AS(test_client.get(test_request), http_request_exception);
+            REQUIRE(test_impl->perform_calls == 3);
+        }
+
+        SECTION("server errors are retried when the policy opts in") {
+            policy.retry_on_server_error = true;
+            test_client.set_retry_policy(policy);
+            request err_request {"http://server-error.com/"};
+            auto resp = test_client.get(err_request);
+            REQUIRE(resp.status_code() == 503);
+            REQUIRE(test_impl->perform_calls == 3);
+        }
+
+        SECTION("server errors are not retried unless the policy opts in") {
+            test_client.set_retry_policy(policy);
+            request err_request {"http://server-error.com/"};
+            auto resp = test_client.get(err_request);
+            REQUIRE(resp.status_code() == 503);
+            REQUIRE(test_impl->perform_calls == 1);
+        }
+    }
+
+    TEST_CASE("curl::client transfer metrics") {
+        mock_client test_client;
+        request test_request {"http://valid.com"};
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+
+        SECTION("timing data is harvested after a transfer") {
+            test_impl->resp_body = "Hello, I am a response body!";
+            auto resp = test_client.get(test_request);
+            auto const& metrics = resp.metrics();
+            REQUIRE(metrics.namelookup_time == Approx(0.005));
+            REQUIRE(metrics.connect_time == Approx(0.01));
+            REQUIRE(metrics.appconnect_time == Approx(0.02));
+            REQUIRE(metrics.starttransfer_time == Approx(0.03));
+            REQUIRE(metrics.total_time == Approx(0.04));
+            REQUIRE(metrics.downloaded_bytes == 28u);
+            REQUIRE_FALSE(metrics.reused_connection);
+        }
+
+        SECTION("uploaded bytes reflect the request body") {
+            test_request.body("Hello, I am a request body!", "message");
+            auto resp = test_client.put(test_request);
+            REQUIRE(resp.metrics().uploaded_bytes == 27u);
+        }
+
+        SECTION("a transfer on an existing connection is flagged as reused") {
+            test_impl->num_connects = 0;
+            auto resp = test_client.get(test_request);
+            REQUIRE(resp.metrics().reused_connection);
+        }
+    }
+
+    TEST_CASE("curl::client download_file_resumable") {
+        mock_client test_client;
+        temp_directory temp_dir;
+        fs::path temp_dir_path = fs::path(temp_dir.get_dir_name());
+        CURL* const& handle = test_client.get_handle();
+        auto test_impl = reinterpret_cast<curl_impl* const>(handle);
+        std::string url = "https://download.com";
+
+        SECTION("downloads the file when no partial exists") {
+            std::string file_path = (temp_dir_path / "test_file").string();
+            request req(url);
+            test_client.download_file_resumable(req, file_path);
+            std::string contents;
+            REQUIRE(leatherman::file_util::read(file_path, contents));
+            REQUIRE(contents == "successfully downloaded file");
+            REQUIRE_FALSE(fs::exists(file_path + ".part"));
+        }
+
+        SECTION("a partial with a stored validator is revalidated with Range and If-Range") {
+            std::string file_path = (temp_dir_path / "test_file").string();
+            leatherman::file_util::atomic_write_to_file("partial data", file_path + ".part");
+            leatherman::file_util::atomic_write_to_file("\"etag-value\"", file_path + ".part.etag");
+            request req(url);
+            test_client.download_file_resumable(req, file_path);
+
+            // The mock answers 200 without range support, so the partial is
+            // discarded and the whole entity is written.
+            std::string contents;
+            REQUIRE(leatherman::file_util::read(file_path, contents));
+            REQUIRE(contents == "successfully downloaded file");
+            REQUIRE_FALSE(fs::exists(file_path + ".part.etag"));
+
+            // Both conditional headers should have been sent.
+            std::map<std::string, std::string> headers;
+            for (auto header = test_impl->header; header; header = header->next) {
+                std::string data = header->data;
+                auto pos = data.find(": ");
+                if (pos != std::string::npos) {
+                    headers.emplace(data.substr(0, pos), data.substr(pos + 2));
+                }
+            }
+            REQUIRE(headers.count("Range") == 1);
+            REQUIRE(headers["Range"] == "bytes=12-");
+            REQUIRE(headers.count("If-Range") == 1);
+            REQUIRE(headers["If-Range"] == "\"etag-value\"");
+        }
+
+        SECTION("a partial without a stored validator is discarded") {
+            std::string file_path = (temp_dir_path / "test_file").string();
+            leatherman::file_util::atomic_write_to_file("partial data", file_path + ".part");
+            request req(url);
+            test_client.download_file_resumable(req, file_path);
+            std::string contents;
+            REQUIRE(leatherman::file_util::read(file_path, contents));
+            REQUIRE(contents == "successfully downloaded file");
+            REQUIRE_FALSE(test_impl->header);
+        }
+    }
+
+    TEST_CASE("curl::client_pool download_file") {
+        client_pool pool { 2 };
+        temp_directory temp_dir;
+        fs::path temp_dir_path = fs::path(temp_dir.get_dir_name());
+        std::string url = "https://download.com";
+
+        SECTION("a single segment delegates to a pooled client") {
+            std::string file_path = (temp_dir_path / "test_file").string();
+            request req(url);
+            pool.download_file(req, file_path, 1);
+            REQUIRE(fs::exists(file_path));
+            std::string contents;
+            REQUIRE(leatherman::file_util::read(file_path, contents));
+            REQUIRE(contents == "successfully downloaded file");
+        }
+
+        SECTION("a server without range support downloads through the probe connection") {
+            // The mock answers the range probe with a plain 200 and no
+            // Content-Range, exercising the single-connection fallback.
+            std::string file_path = (temp_dir_path / "test_file").string();
+            request req(url);
+            pool.download_file(req, file_path, 4);
+            REQUIRE(fs::exists(file_path));
+        }
+    }
+
     TEST_CASE("curl::client download_file") {
         mock_client test_client;
         temp_directory temp_dir;
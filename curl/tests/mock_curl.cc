@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <array>
 #include <algorithm>
+#include <set>
 #include "mock_curl.hpp"
 
 using namespace std;
@@ -46,11 +47,23 @@ CURLcode curl_global_init(long flags)
 }
 
 /*
- * Reclaim memory obtained from a libcurl call by deleting
- * a mock curl object.
+ * Strings handed out by the mock curl_easy_escape, so curl_free can
+ * tell them apart from mock curl objects.
+ */
+static set<void*> escaped_strings;
+
+/*
+ * Reclaim memory obtained from a libcurl call, either a string from
+ * curl_easy_escape or a mock curl object.
  */
 void curl_free(void *p)
 {
+    auto it = escaped_strings.find(p);
+    if (it != escaped_strings.end()) {
+        escaped_strings.erase(it);
+        delete [] reinterpret_cast<char*>(p);
+        return;
+    }
     delete reinterpret_cast<curl_impl*>(p);
 }
 
@@ -64,13 +77,31 @@ void curl_easy_cleanup(CURL * handle)
 }
 
 /*
- * Mock implementation of curl_easy_escape which simply returns a
- * nullptr. URL encoding the given string is not necessary for
- * testing.
+ * Duplicate a libcurl easy handle. The mock implementation copies the
+ * mock curl object; per-transfer counters are reset on the copy.
+ */
+CURL *curl_easy_duphandle(CURL * handle)
+{
+    auto h = reinterpret_cast<curl_impl*>(handle);
+    auto copy = new curl_impl(*h);
+    copy->perform_calls = 0;
+    return reinterpret_cast<CURL*>(copy);
+}
+
+/*
+ * Mock implementation of curl_easy_escape. Real URL encoding is not
+ * necessary for testing, so it returns a marked copy of the input and
+ * counts the calls, which lets tests observe escape caching.
  */
 char *curl_easy_escape(CURL * curl, const char * string, int length)
 {
-    return nullptr;
+    auto h = reinterpret_cast<curl_impl*>(curl);
+    ++h->escape_calls;
+    std::string escaped = "escaped:" + std::string(string, length);
+    auto result = new char[escaped.size() + 1];
+    memcpy(result, escaped.c_str(), escaped.size() + 1);
+    escaped_strings.insert(result);
+    return result;
 }
 
 /*
@@ -160,6 +191,14 @@ CURLcode curl_easy_setopt(CURL *handle, CURLoption option, ...)
             }
             h->read_data = va_arg(vl, void*);
             break;
+        case CURLOPT_SEEKFUNCTION:
+            // Set client::seek_body as the function to be called for mock curl to rewind the request body.
+            h->seek_function = va_arg(vl, int (*)(void*, curl_off_t, int));
+            break;
+        case CURLOPT_SEEKDATA:
+            // Pointer to the context passed to the SEEKFUNCTION callback.
+            h->seek_data = va_arg(vl, void*);
+            break;
         case CURLOPT_URL:
             // Set the mock curl URL as the URL specified in the request.
             if (h->test_failure_mode == curl_impl::error_mode::set_url_error) {
@@ -261,6 +300,17 @@ CURLcode curl_easy_setopt(CURL *handle, CURLoption option, ...)
             }
             h->protocols = va_arg(vl, long);
             break;
+
+        case CURLOPT_HTTP_VERSION:
+            h->http_version = va_arg(vl, long);
+            break;
+        case CURLOPT_SHARE:
+            h->share = va_arg(vl, void*);
+            break;
+        case CURLOPT_ACCEPT_ENCODING:
+            h->accept_encoding_set = true;
+            h->accept_encoding = va_arg(vl, char*);
+            break;
         case CURLOPT_ERRORBUFFER:
             h->errbuf = va_arg(vl, char*); 
             break;
@@ -278,6 +328,11 @@ CURLcode curl_easy_setopt(CURL *handle, CURLoption option, ...)
 CURLcode curl_easy_perform(CURL * easy_handle)
 {
     auto h = reinterpret_cast<curl_impl*>(easy_handle);
+    h->perform_calls++;
+    if (h->fail_next_performs > 0) {
+        h->fail_next_performs--;
+        return CURLE_COULDNT_CONNECT;
+    }
     if (h->test_failure_mode == curl_impl::error_mode::easy_perform_write_error) {
         return CURLE_WRITE_ERROR;
     }
@@ -298,6 +353,44 @@ CURLcode curl_easy_perform(CURL * easy_handle)
         while ((bytes_returned = h->read_function(buf, 1, 10, h->read_data))) {
             h->read_buffer.append(buf, bytes_returned);
         }
+
+        /*
+         * Simulate the body re-send that a redirect or auth retry triggers:
+         * ask the seek callback to rewind and read the body over again.
+         */
+        if (h->rewind_mid_transfer) {
+            if (!h->seek_function || h->seek_function(h->seek_data, 0, SEEK_SET) != CURL_SEEKFUNC_OK) {
+                return CURLE_SEND_FAIL_REWIND;
+            }
+            h->read_buffer.clear();
+            while ((bytes_returned = h->read_function(buf, 1, 10, h->read_data))) {
+                h->read_buffer.append(buf, bytes_returned);
+            }
+        }
+    }
+
+    /*
+     * A cacheable resource: returns 200 with an ETag, or 304 with no body
+     * when the request revalidates with a matching If-None-Match header.
+     */
+    if (h->request_url == "http://cacheable.com/") {
+        bool revalidated = false;
+        for (auto entry = h->header; entry; entry = entry->next) {
+            if (entry->data && string(entry->data) == "If-None-Match: \"mock-etag\"") {
+                revalidated = true;
+            }
+        }
+        if (h->write_header) {
+            string header_content = revalidated
+                ? "HTTP/1.1 304 NOT MODIFIED\nETag: \"mock-etag\""
+                : "HTTP/1.1 200 OK\nETag: \"mock-etag\"";
+            h->write_header(&header_content[0], 1, header_content.size(), h->header_context);
+        }
+        if (!revalidated && h->write_body) {
+            string body_content = "cacheable contents";
+            h->write_body(&body_content[0], 1, body_content.size(), h->body_context);
+        }
+        return CURLE_OK;
     }
 
     static const array<string, 3> VALID_URLS{{
@@ -328,6 +421,15 @@ CURLcode curl_easy_perform(CURL * easy_handle)
             h->write_header(&header_content[0], 1, header_content.size(), h->header_context);
         } else if (h->request_url == "http://invalid-header.com/") {
             string header_content = "This is an invalid header";
+            h->write_header(&header_content[0], 1, header_content.size(), h->header_context);
+        } else if (h->request_url == "http://server-error.com/") {
+            string header_content = "HTTP/1.1 503 SERVICE UNAVAILABLE\n"
+                                    "Connection: keep-alive\n"
+                                    "Date: Thu, 16 Jul 2015 18:41:08 GMT\n"
+                                    "Content-Type: text/html;charset=UTF-8\n"
+                                    "Server: Jetty(7.x.y-SNAPSHOT)\n"
+                                    "Via: 1.1 vegur";
+
             h->write_header(&header_content[0], 1, header_content.size(), h->header_context);
         } else {
             string header_content = "HTTP/1.1 404 NOT FOUND\n"
@@ -392,6 +494,8 @@ const char *curl_easy_strerror(CURLcode errornum)
             return "cURL failed with: CURLE_OUT_OF_MEMORY";
         case CURLE_UNKNOWN_OPTION:
             return "cURL failed with CURLE_UNKNOWN_OPTION";
+        case CURLE_SEND_FAIL_REWIND:
+            return "cURL failed with: CURLE_SEND_FAIL_REWIND";
         default:
             return nullptr;
     }
@@ -406,6 +510,77 @@ void curl_global_cleanup(void)
 {
 }
 
+/*
+ * Report transfer information for an easy handle. The mock
+ * implementation returns the canned statistics stored on the mock curl
+ * object; transfer sizes are derived from the buffers the mock actually
+ * read and wrote.
+ */
+CURLcode curl_easy_getinfo(CURL *handle, CURLINFO info, ...)
+{
+    auto h = reinterpret_cast<curl_impl*>(handle);
+    va_list vl;
+    va_start(vl, info);
+    switch (info) {
+        case CURLINFO_NAMELOOKUP_TIME:
+            *va_arg(vl, double*) = h->namelookup_time;
+            break;
+        case CURLINFO_CONNECT_TIME:
+            *va_arg(vl, double*) = h->connect_time;
+            break;
+        case CURLINFO_APPCONNECT_TIME:
+            *va_arg(vl, double*) = h->appconnect_time;
+            break;
+        case CURLINFO_STARTTRANSFER_TIME:
+            *va_arg(vl, double*) = h->starttransfer_time;
+            break;
+        case CURLINFO_TOTAL_TIME:
+            *va_arg(vl, double*) = h->total_time;
+            break;
+        case CURLINFO_SIZE_DOWNLOAD:
+            *va_arg(vl, double*) = static_cast<double>(h->resp_body.size());
+            break;
+        case CURLINFO_SIZE_UPLOAD:
+            *va_arg(vl, double*) = static_cast<double>(h->read_buffer.size());
+            break;
+        case CURLINFO_NUM_CONNECTS:
+            *va_arg(vl, long*) = h->num_connects;
+            break;
+        default:
+            break;
+    }
+    va_end(vl);
+    return CURLE_OK;
+}
+
+/*
+ * Create a share handle. The mock implementation hands out a single
+ * static object so tests can assert that every easy handle joined the
+ * same process-wide cache.
+ */
+CURLSH *curl_share_init()
+{
+    static int global_share;
+    return reinterpret_cast<CURLSH*>(&global_share);
+}
+
+/*
+ * Unimplemented, as the mock share handle holds no real caches to
+ * configure.
+ */
+CURLSHcode curl_share_setopt(CURLSH * share, CURLSHoption option, ...)
+{
+    return CURLSHE_OK;
+}
+
+/*
+ * Unimplemented, as the mock share handle is a static object.
+ */
+CURLSHcode curl_share_cleanup(CURLSH * share)
+{
+    return CURLSHE_OK;
+}
+
 /*
  * Add a string to an slist. If list already includes curl_slist
  * objects, we must traverse the linked list to append the new
@@ -58,9 +58,34 @@ struct curl_impl
     std::function<size_t(char*, size_t, size_t, void*)> read_function;
     void* read_data; // Where to read the request body from
 
+    // Pointer for client::seek_body as a callback function in curl_easy_setopt
+    std::function<int(void*, curl_off_t, int)> seek_function;
+    void* seek_data; // Context to pass to the seek callback
+
+    // When set, perform reads the body once, asks the seek callback to
+    // rewind to the start and reads it again, simulating the re-send
+    // libcurl does on a redirect or an authentication retry.
+    bool rewind_mid_transfer = false;
+
     std::string request_url, cookie, cacert, client_cert, client_key, client_crl, proxy;
     long protocols;
     long connect_timeout;
+    long http_version = 0;
+    void* share = nullptr; // Share handle this easy handle joined, if any
+    bool accept_encoding_set = false; // Whether CURLOPT_ACCEPT_ENCODING was set
+    std::string accept_encoding;
+
+    // Canned transfer statistics returned from curl_easy_getinfo
+    double namelookup_time = 0.005;
+    double connect_time = 0.01;
+    double appconnect_time = 0.02;
+    double starttransfer_time = 0.03;
+    double total_time = 0.04;
+    long num_connects = 1;
+
+    int perform_calls = 0;      // Number of times curl_easy_perform has run
+    int escape_calls = 0;       // Number of times curl_easy_escape has run
+    int fail_next_performs = 0; // Fail this many upcoming performs with CURLE_COULDNT_CONNECT
     http_method method = http_method::get;
 
     curl_slist* header; // List of custom request headers to be passed to the server
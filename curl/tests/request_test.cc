@@ -20,6 +20,15 @@ TEST_CASE("curl::request") {
         REQUIRE(*(header) == "header_value");
     }
 
+    SECTION("Header lookup should be case-insensitive") {
+        test_request.add_header("Header-Name", "header_value");
+        auto header = test_request.header("header-name");
+        REQUIRE(header);
+        REQUIRE(*(header) == "header_value");
+        test_request.remove_header("HEADER-NAME");
+        REQUIRE(test_request.header("Header-Name") == nullptr);
+    }
+
     SECTION("Headers should be removable from the request") {
         test_request.add_header("header_name", "header_value");
         test_request.remove_header("header_name");
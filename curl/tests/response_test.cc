@@ -20,6 +20,13 @@ TEST_CASE("curl::response") {
         REQUIRE(*(header) == "header_value");
     }
 
+    SECTION("Header lookup should be case-insensitive") {
+        test_response.add_header("Content-Type", "text/html");
+        auto header = test_response.header("content-type");
+        REQUIRE(header);
+        REQUIRE(*(header) == "text/html");
+    }
+
     SECTION("Headers should be removable from the response") {
         test_response.add_header("header_name", "header_value");
         test_response.remove_header("header_name");
@@ -50,6 +57,13 @@ TEST_CASE("curl::response") {
         REQUIRE(body == "Hello, I am a response body!");
     }
 
+    SECTION("Releasing the body moves it out and leaves the response empty") {
+        test_response.body("Hello, I am a response body!");
+        auto body = test_response.release_body();
+        REQUIRE(body == "Hello, I am a response body!");
+        REQUIRE(test_response.body().empty());
+    }
+
     SECTION("Status code should be addable and retrievable") {
         test_response.status_code(200);
         auto code = test_response.status_code();
@@ -7,6 +7,9 @@
 #include <string>
 #include <stdexcept>
 #include <initializer_list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace leatherman { namespace dynamic_library {
 
@@ -64,6 +67,15 @@ namespace leatherman { namespace dynamic_library {
          * @return Returns the already loaded library if found or an unloaded library if not found.
          */
         static dynamic_library find_by_pattern(std::string const& pattern);
+        /**
+         * Finds already loaded libraries for several file name regex patterns.
+         * The loaded-module scan is shared across the patterns where the
+         * platform allows, so this is cheaper than repeated find_by_pattern
+         * calls.
+         * @param patterns The regex patterns of the libraries to find.
+         * @return Returns one library per pattern, in order; a pattern with no match yields an unloaded library.
+         */
+        static std::vector<dynamic_library> find_by_patterns(std::initializer_list<std::string> patterns);
         /**
          * Finds an already loaded library by symbol.
          * @param symbol The symbol to find.
@@ -81,6 +93,20 @@ namespace leatherman { namespace dynamic_library {
          */
         bool load(std::string const& name, bool global = false);
 
+        /**
+         * Loads the given dynamic library through the process-wide registry.
+         * The registry is keyed by the given name and by the loader's
+         * resolved path, so two subsystems loading the same library -
+         * even under different spellings - share one handle and one
+         * symbol cache, and repeated loads are hash hits instead of
+         * dynamic linker walks. The library closes when the last shared
+         * handle is released; the registry itself keeps nothing alive.
+         * @param name The name of the library to load.
+         * @param global True if the library's symbols should be globally available for symbol resolution.
+         * @return Returns the shared library handle, or an empty pointer if the library could not be loaded.
+         */
+        static std::shared_ptr<dynamic_library const> load_shared(std::string const& name, bool global = false);
+
         /**
          * Determines if the library is loaded.
          * @return Returns true if the library is loaded or false if it is not.
@@ -113,10 +139,25 @@ namespace leatherman { namespace dynamic_library {
          */
         void* find_symbol(std::string const& name, bool throw_if_missing = false, std::string const& alias = {}) const;
 
+        /**
+         * Finds several symbols in the library by name.
+         * Results are returned in the order the names were given.
+         * Resolved addresses are cached on the library, so consumers
+         * importing many symbols - or re-resolving the same symbol per
+         * use - only pay the loader lookup once per name.
+         * @param names The names of the symbols to find.
+         * @param throw_if_missing If true, throws an exception if any symbol is missing. If false, missing symbols resolve to nullptr.
+         * @return Returns each symbol's address, in order; nullptr for symbols not found.
+         */
+        std::vector<void*> find_symbols(std::initializer_list<std::string> names, bool throw_if_missing = false) const;
+
      private:
+        std::string resolved_path() const;
+
         void* _handle;
         std::string _name;
         bool _first_load;
+        mutable std::unordered_map<std::string, void*> _symbol_cache;
     };
 
 }}  // namespace leatherman::load_library
@@ -1,4 +1,5 @@
 #include <leatherman/dynamic_library/dynamic_library.hpp>
+#include <mutex>
 
 using namespace std;
 
@@ -33,12 +34,76 @@ namespace leatherman { namespace dynamic_library {
         _handle = other._handle;
         _name = other._name;
         _first_load = other._first_load;
+        _symbol_cache = move(other._symbol_cache);
         other._handle = nullptr;
         other._name.clear();
         other._first_load = false;
+        other._symbol_cache.clear();
         return *this;
     }
 
+    // The process-wide registry of shared library handles, keyed by
+    // requested name and resolved path. Entries are weak so the
+    // registry never extends a library's lifetime; a stale entry is
+    // replaced on the next load of that name.
+    static mutex g_registry_mutex;
+    static unordered_map<string, weak_ptr<dynamic_library>> g_registry;
+
+    shared_ptr<dynamic_library const> dynamic_library::load_shared(string const& name, bool global)
+    {
+        lock_guard<mutex> lock(g_registry_mutex);
+        auto it = g_registry.find(name);
+        if (it != g_registry.end()) {
+            auto existing = it->second.lock();
+            if (existing) {
+                return existing;
+            }
+        }
+
+        auto library = make_shared<dynamic_library>();
+        if (!library->load(name, global)) {
+            return {};
+        }
+
+        // The same library may already be registered under another
+        // spelling; the resolved path unifies them. If it is, drop the
+        // duplicate reference and alias this name to the shared handle.
+        auto resolved = library->resolved_path();
+        if (!resolved.empty() && resolved != name) {
+            auto rit = g_registry.find(resolved);
+            if (rit != g_registry.end()) {
+                auto existing = rit->second.lock();
+                if (existing) {
+                    g_registry[name] = existing;
+                    return existing;
+                }
+            }
+            g_registry[resolved] = library;
+        }
+        g_registry[name] = library;
+        return library;
+    }
+
+    vector<dynamic_library> dynamic_library::find_by_patterns(initializer_list<string> patterns)
+    {
+        vector<dynamic_library> libraries;
+        libraries.reserve(patterns.size());
+        for (auto const& pattern : patterns) {
+            libraries.push_back(find_by_pattern(pattern));
+        }
+        return libraries;
+    }
+
+    vector<void*> dynamic_library::find_symbols(initializer_list<string> names, bool throw_if_missing) const
+    {
+        vector<void*> symbols;
+        symbols.reserve(names.size());
+        for (auto const& name : names) {
+            symbols.push_back(find_symbol(name, throw_if_missing));
+        }
+        return symbols;
+    }
+
     bool dynamic_library::loaded() const
     {
         return _handle != nullptr;
@@ -1,16 +1,104 @@
 #include <leatherman/dynamic_library/dynamic_library.hpp>
 #include <leatherman/logging/logging.hpp>
+#include <leatherman/util/regex.hpp>
 #include <dlfcn.h>
+#ifdef __linux__
+#include <link.h>
+#include <memory>
+#include <mutex>
+#endif
 
 using namespace std;
+using namespace leatherman::util;
 namespace lth_locale = leatherman::locale;
 
 namespace leatherman { namespace dynamic_library {
 
+#ifdef __linux__
+    namespace {
+
+        // A snapshot of the names of the process's loaded modules,
+        // keyed by glibc's load/unload event counters. Repeated
+        // pattern searches reuse the snapshot and only rescan the link
+        // map after a dlopen or dlclose has changed it.
+        struct module_snapshot
+        {
+            unsigned long long adds = 0;
+            unsigned long long subs = 0;
+            vector<string> names;
+        };
+
+        int probe_generation(struct dl_phdr_info* info, size_t, void* data)
+        {
+            auto snapshot = static_cast<module_snapshot*>(data);
+            snapshot->adds = info->dlpi_adds;
+            snapshot->subs = info->dlpi_subs;
+            // The counters are the same on every entry; stop after the first.
+            return 1;
+        }
+
+        int collect_modules(struct dl_phdr_info* info, size_t, void* data)
+        {
+            auto snapshot = static_cast<module_snapshot*>(data);
+            snapshot->adds = info->dlpi_adds;
+            snapshot->subs = info->dlpi_subs;
+            if (info->dlpi_name && *info->dlpi_name) {
+                snapshot->names.emplace_back(info->dlpi_name);
+            }
+            return 0;
+        }
+
+        static shared_ptr<module_snapshot> g_modules;
+        static mutex g_modules_mutex;
+
+        shared_ptr<module_snapshot const> loaded_modules()
+        {
+            module_snapshot generation;
+            dl_iterate_phdr(probe_generation, &generation);
+
+            auto cached = atomic_load(&g_modules);
+            if (cached && cached->adds == generation.adds && cached->subs == generation.subs) {
+                return cached;
+            }
+
+            auto fresh = make_shared<module_snapshot>();
+            dl_iterate_phdr(collect_modules, fresh.get());
+            lock_guard<mutex> lock(g_modules_mutex);
+            atomic_store(&g_modules, fresh);
+            return fresh;
+        }
+
+    }  // namespace
+#endif  // __linux__
+
     dynamic_library dynamic_library::find_by_pattern(std::string const& pattern)
     {
-        // POSIX doesn't have this capability
+#ifdef __linux__
+        dynamic_library library;
+        auto modules = loaded_modules();
+        boost::regex rx(pattern);
+        for (auto const& name : modules->names) {
+            if (!re_search(name, rx)) {
+                continue;
+            }
+            // RTLD_NOLOAD only takes a new reference if the module is
+            // still loaded; it may have gone away since the scan.
+            void* handle = dlopen(name.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+            if (handle) {
+                LOG_DEBUG("library {1} found from pattern {2}", name, pattern);
+                library._handle = handle;
+                library._name = name;
+                library._first_load = false;
+                return library;
+            }
+            LOG_DEBUG("library {1} found from pattern {2}, but unloaded before a handle was acquired", name, pattern);
+        }
+        LOG_DEBUG("no loaded libraries found matching pattern {1}", pattern);
+        return library;
+#else
+        // Other POSIX platforms have no portable way to walk the loaded modules.
         return dynamic_library();
+#endif
     }
 
     dynamic_library dynamic_library::find_by_symbol(std::string const& symbol)
@@ -60,10 +148,34 @@ namespace leatherman { namespace dynamic_library {
         }
         _name.clear();
         _first_load = false;
+        _symbol_cache.clear();
+    }
+
+    string dynamic_library::resolved_path() const
+    {
+#ifdef __linux__
+        // The link map holds the path the loader actually resolved,
+        // which unifies the spellings a library can be loaded under.
+        if (_handle) {
+            struct link_map* map = nullptr;
+            if (dlinfo(_handle, RTLD_DI_LINKMAP, &map) == 0 && map && map->l_name && *map->l_name) {
+                return map->l_name;
+            }
+        }
+#endif
+        return _name;
     }
 
     void* dynamic_library::find_symbol(string const& name, bool throw_if_missing, string const& alias) const
     {
+        // Serve repeat lookups from the cache; only successful
+        // resolutions are cached, so missing-symbol behavior is
+        // unchanged.
+        auto it = _symbol_cache.find(name);
+        if (it != _symbol_cache.end()) {
+            return it->second;
+        }
+
         if (!_handle) {
             if (throw_if_missing) {
                 throw missing_import_exception("library is not loaded.");
@@ -83,6 +195,8 @@ namespace leatherman { namespace dynamic_library {
             } else {
                 LOG_DEBUG("symbol {1} not found in library {2}.", name.c_str(), _name.c_str());
             }
+        } else {
+            _symbol_cache.emplace(name, symbol);
         }
         return symbol;
     }
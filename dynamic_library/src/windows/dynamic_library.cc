@@ -98,10 +98,34 @@ namespace leatherman { namespace dynamic_library {
         }
         _name.clear();
         _first_load = false;
+        _symbol_cache.clear();
+    }
+
+    string dynamic_library::resolved_path() const
+    {
+        // The module file name is the path the loader actually
+        // resolved, which unifies the spellings a library can be
+        // loaded under.
+        if (_handle) {
+            wchar_t buffer[MAX_PATH];
+            auto length = GetModuleFileNameW(static_cast<HMODULE>(_handle), buffer, MAX_PATH);
+            if (length > 0 && length < MAX_PATH) {
+                return boost::nowide::narrow(wstring(buffer, length));
+            }
+        }
+        return _name;
     }
 
     void* dynamic_library::find_symbol(string const& name, bool throw_if_missing, string const& alias) const
     {
+        // Serve repeat lookups from the cache; only successful
+        // resolutions are cached, so missing-symbol behavior is
+        // unchanged.
+        auto it = _symbol_cache.find(name);
+        if (it != _symbol_cache.end()) {
+            return it->second;
+        }
+
         if (!_handle) {
             if (throw_if_missing) {
                 throw missing_import_exception(_("library is not loaded"));
@@ -121,7 +145,9 @@ namespace leatherman { namespace dynamic_library {
             } else {
                 LOG_DEBUG("symbol {1} not found in library {2}.", name.c_str(), _name.c_str());
             }
+            return nullptr;
         }
+        _symbol_cache.emplace(name, reinterpret_cast<void*>(symbol));
         return reinterpret_cast<void *>(symbol);
     }
 
@@ -28,6 +28,42 @@ TEST_CASE("dynamic_library::load and dynamic_library::close", "[dyn-lib]") {
     }
 }
 
+TEST_CASE("dynamic_library::load_shared", "[dyn-lib]") {
+    SECTION("repeated loads share one handle") {
+        auto first = dynamic_library::load_shared(lib_path);
+        REQUIRE(first);
+        REQUIRE(first->loaded());
+
+        auto second = dynamic_library::load_shared(lib_path);
+        REQUIRE(second == first);
+    }
+
+    SECTION("shared handles resolve symbols through one cache") {
+        auto lib = dynamic_library::load_shared(lib_path);
+        REQUIRE(lib);
+        auto symbol = lib->find_symbol("hello");
+        REQUIRE(symbol);
+        REQUIRE(dynamic_library::load_shared(lib_path)->find_symbol("hello") == symbol);
+    }
+
+    SECTION("a failed load registers nothing") {
+        REQUIRE_FALSE(dynamic_library::load_shared("no_such_library"));
+        REQUIRE_FALSE(dynamic_library::load_shared("no_such_library"));
+    }
+
+    SECTION("the library closes when the last handle is released") {
+        {
+            auto lib = dynamic_library::load_shared(lib_path2);
+            REQUIRE(lib);
+        }
+        // A registry entry outliving its handles is stale, not shared;
+        // the next load is a fresh one.
+        auto lib = dynamic_library::load_shared(lib_path2);
+        REQUIRE(lib);
+        REQUIRE(lib->loaded());
+    }
+}
+
 TEST_CASE("dynamic_library::find_symbol", "[dyn-lib]"){
     dynamic_library lib;
     REQUIRE(lib.load(lib_path));
@@ -46,6 +82,54 @@ TEST_CASE("dynamic_library::find_symbol", "[dyn-lib]"){
         REQUIRE(lib2.load(lib_path2));
         REQUIRE(lib2.find_symbol("not_here", false, "goodbye"));
     }
+
+    SECTION("should serve repeat lookups from the symbol cache") {
+        auto first = lib.find_symbol("hello");
+        REQUIRE(first);
+        REQUIRE(lib.find_symbol("hello") == first);
+    }
+}
+
+#ifdef __linux__
+TEST_CASE("dynamic_library::find_by_pattern", "[dyn-lib]"){
+    dynamic_library lib;
+    REQUIRE(lib.load(lib_path));
+
+    SECTION("should find an already loaded library") {
+        auto found = dynamic_library::find_by_pattern("libtest\\.so");
+        REQUIRE(found.loaded());
+        REQUIRE_FALSE(found.first_load());
+        REQUIRE(found.find_symbol("hello"));
+    }
+
+    SECTION("should not find libraries that are not loaded") {
+        auto found = dynamic_library::find_by_pattern("no_such_library");
+        REQUIRE_FALSE(found.loaded());
+    }
+
+    SECTION("should share one scan across multiple patterns") {
+        auto found = dynamic_library::find_by_patterns({"libtest\\.so", "no_such_library"});
+        REQUIRE(found.size() == 2u);
+        REQUIRE(found[0].loaded());
+        REQUIRE_FALSE(found[1].loaded());
+    }
+}
+#endif
+
+TEST_CASE("dynamic_library::find_symbols", "[dyn-lib]"){
+    dynamic_library lib;
+    REQUIRE(lib.load(lib_path));
+
+    SECTION("should resolve symbols in order, with nullptr for missing ones") {
+        auto symbols = lib.find_symbols({"hello", "not_here"});
+        REQUIRE(symbols.size() == 2u);
+        REQUIRE(symbols[0]);
+        REQUIRE_FALSE(symbols[1]);
+    }
+
+    SECTION("should throw when requested for a missing symbol") {
+        REQUIRE_THROWS(lib.find_symbols({"hello", "not_here"}, true));
+    }
 }
 
 TEST_CASE("dynamic_library::dyanmic_library(dynamic_library && other)", "[dyn-lib]") {
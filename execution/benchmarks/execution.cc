@@ -0,0 +1,95 @@
+/**
+ * @file
+ * Measures process-spawn throughput and per-spawn latency across the
+ * option combinations that pick different launch and capture paths:
+ * the default (vfork-style) spawn vs the thread_safe fork, stdin
+ * present or absent, buffered capture vs line callbacks, varying
+ * output sizes and descriptor limits. Run by hand when measuring a
+ * change to the spawn path; standard POSIX utilities stand in for a
+ * bundled helper binary.
+ */
+#include <leatherman/execution/execution.hpp>
+#include <benchmark.hpp>
+
+#include <sys/resource.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::execution;
+using leatherman::util::option_set;
+
+namespace {
+
+    const size_t warmup = 5;
+    const size_t iterations = 200;
+
+    const option_set<execution_options> default_options = {
+        execution_options::trim_output,
+        execution_options::merge_environment,
+        execution_options::redirect_stderr_to_null
+    };
+
+    void spawn(string const& name, function<void()> one_spawn)
+    {
+        auto t = leatherman::benchmark::measure(warmup, iterations, one_spawn);
+        leatherman::benchmark::report(name, 1, t);
+    }
+
+}  // namespace
+
+LEATHERMAN_BENCHMARK(execution)
+{
+    spawn("no-op spawn", []() {
+        execute("true", 0, default_options);
+    });
+
+    auto thread_safe = default_options;
+    thread_safe.set(execution_options::thread_safe);
+    spawn("thread_safe fork", [&]() {
+        execute("true", 0, thread_safe);
+    });
+
+    spawn("stdin present", []() {
+        execute("cat", {}, "hello benchmark\n", 0, default_options);
+    });
+
+    spawn("buffered 100 lines", []() {
+        execute("seq", { "100" }, 0, default_options);
+    });
+
+    spawn("buffered 10k lines", []() {
+        execute("seq", { "10000" }, 0, default_options);
+    });
+
+    spawn("callbacks 10k lines", []() {
+        size_t lines = 0;
+        each_line("seq", { "10000" }, [&](string&) {
+            ++lines;
+            return true;
+        });
+    });
+
+    // Spawn cost scales with the descriptor table on platforms where
+    // inherited descriptors are closed one by one; measure a small and
+    // a large soft limit to expose that.
+    struct rlimit saved;
+    if (getrlimit(RLIMIT_NOFILE, &saved) == 0) {
+        for (rlim_t limit : { static_cast<rlim_t>(256), static_cast<rlim_t>(4096) }) {
+            struct rlimit adjusted = saved;
+            if (limit > saved.rlim_max) {
+                continue;
+            }
+            adjusted.rlim_cur = limit;
+            if (setrlimit(RLIMIT_NOFILE, &adjusted) != 0) {
+                continue;
+            }
+            spawn("no-op spawn, " + to_string(limit) + " fds", []() {
+                execute("true", 0, default_options);
+            });
+        }
+        setrlimit(RLIMIT_NOFILE, &saved);
+    }
+}
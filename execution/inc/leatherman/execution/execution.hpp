@@ -8,7 +8,9 @@
 #include <leatherman/util/option_set.hpp>
 #include <boost/optional.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/utility/string_ref.hpp>
 
+#include <array>
 #include <string>
 #include <vector>
 #include <map>
@@ -16,6 +18,10 @@
 #include <utility>
 #include <stdexcept>
 #include <functional>
+#include <future>
+#include <iosfwd>
+#include <chrono>
+#include <memory>
 
 namespace lth_util = leatherman::util;
 
@@ -86,6 +92,11 @@ namespace leatherman { namespace execution {
          * Allow standard input to be unread, rather than failing if it is ignored.
          */
         allow_stdin_unread = (1 << 12),
+        /**
+         * Collect timing and resource usage statistics for the execution.
+         * When set, the returned result carries a result_stats instance.
+         */
+        collect_statistics = (1 << 13),
         /**
          * A combination of all throw options.
          */
@@ -216,6 +227,103 @@ namespace leatherman { namespace execution {
         size_t _pid;
     };
 
+    /**
+     * Timing and resource usage statistics for a single execution.
+     * Collected only when the collect_statistics execution option is set.
+     * Durations are measured on a steady clock; CPU times and maximum RSS
+     * come from the operating system's accounting of the reaped child
+     * (wait4 on POSIX platforms).
+     */
+    struct result_stats
+    {
+        /**
+         * Time from entering execute to the child process being created.
+         */
+        std::chrono::microseconds spawn_time {0};
+        /**
+         * Time from entering execute to the child being reaped.
+         */
+        std::chrono::microseconds wall_time {0};
+        /**
+         * Time from entering execute to the first byte of output on either
+         * stream; zero if the child produced no output.
+         */
+        std::chrono::microseconds first_output_time {0};
+        /**
+         * Bytes read from the child's stdout. Output routed straight to a
+         * descriptor sink (the no-trim file fast path) is not counted.
+         */
+        uint64_t stdout_bytes = 0;
+        /**
+         * Bytes read from the child's stderr (if not redirected).
+         */
+        uint64_t stderr_bytes = 0;
+        /**
+         * The child's maximum resident set size, in kilobytes; zero where
+         * the platform does not report it.
+         */
+        uint64_t max_rss_kb = 0;
+        /**
+         * CPU time the child spent in user mode.
+         */
+        std::chrono::microseconds user_cpu {0};
+        /**
+         * CPU time the child spent in kernel mode.
+         */
+        std::chrono::microseconds system_cpu {0};
+    };
+
+    /**
+     * Aggregated statistics for one executable, collected by the opt-in
+     * command statistics registry.
+     */
+    struct command_stats
+    {
+        /**
+         * The number of buckets in the latency histogram.
+         */
+        static const size_t histogram_buckets = 16;
+        /**
+         * The number of times the executable was run.
+         */
+        uint64_t count = 0;
+        /**
+         * The number of runs that did not succeed.
+         */
+        uint64_t failures = 0;
+        /**
+         * Wall time accumulated across all runs.
+         */
+        std::chrono::microseconds total_wall_time {0};
+        /**
+         * Latency histogram with power-of-two millisecond buckets: bucket 0
+         * counts runs under 1 ms, bucket k runs of [2^(k-1), 2^k) ms, and
+         * the last bucket everything slower.
+         */
+        std::array<uint64_t, histogram_buckets> latency_histogram {{0}};
+    };
+
+    /**
+     * Enables or disables the command statistics registry. Disabled by
+     * default; when enabled, every execute() aggregates per-executable run
+     * counts, failure counts, cumulative wall time, and a latency histogram,
+     * so slow external commands surface from the library itself without
+     * wrapping call sites. Disabling the registry also clears it.
+     * @param enable Whether to enable command statistics. Defaults to true.
+     */
+    void enable_command_statistics(bool enable = true);
+
+    /**
+     * Takes a snapshot of the aggregated command statistics.
+     * @return Returns the statistics keyed by resolved executable path.
+     */
+    std::map<std::string, command_stats> command_statistics_snapshot();
+
+    /**
+     * Clears all aggregated command statistics.
+     */
+    void reset_command_statistics();
+
     /**
      * Encapsulates return value from executing a process.
      */
@@ -246,6 +354,36 @@ namespace leatherman { namespace execution {
          * The process ID
          */
         size_t pid = 0;
+        /**
+         * Timing and resource usage statistics; only populated when the
+         * collect_statistics execution option is set.
+         */
+        std::shared_ptr<result_stats const> stats;
+    };
+
+    /**
+     * Describes how execute() should capture child output.
+     * With a capture policy, streams are accumulated as raw bytes (binary
+     * safe, no line splitting) and the in-memory capture is bounded: the
+     * head of the stream is kept up to half the cap and the tail is kept
+     * in a ring buffer of the remaining capacity, so runaway children
+     * cannot exhaust the supervisor's memory. When data is dropped, a
+     * marker noting the number of dropped bytes separates head and tail.
+     */
+    struct capture_policy
+    {
+        /**
+         * The maximum number of bytes kept in memory per stream; 0 means unbounded.
+         */
+        size_t max_bytes = 0;
+        /**
+         * If not empty, the full stdout stream is also written to this file.
+         */
+        std::string spill_file;
+        /**
+         * If not empty, the full stderr stream is also written to this file.
+         */
+        std::string error_spill_file;
     };
 
     /**
@@ -266,6 +404,25 @@ namespace leatherman { namespace execution {
      */
     std::string expand_command(std::string const& command, std::vector<std::string> const& directories = lth_util::environment::search_paths(), bool expand = true);
 
+    /**
+     * Enables or disables caching of executable resolution in which() and expand_command().
+     * Caching is off by default. When enabled, a successful resolution is remembered, keyed
+     * on the file and the search directories, and later calls become a hash lookup plus a
+     * single stat of the resolved file instead of a stat per search path. A cached entry is
+     * dropped when the resolved file's modification time changes; failed resolutions are
+     * never cached, so newly installed commands are always picked up.
+     * Disabling the cache also clears it.
+     * @param enable Whether to enable resolution caching. Defaults to true.
+     */
+    void enable_resolution_caching(bool enable = true);
+
+    /**
+     * Clears any cached executable resolutions.
+     * Call this if search paths or the files on them have changed in a way that
+     * modification times cannot detect, e.g. after leatherman::util::environment::reload_search_paths().
+     */
+    void clear_resolution_cache();
+
     /**
      * Executes the given program.
      * @param file The name or path of the program to execute.
@@ -342,6 +499,72 @@ namespace leatherman { namespace execution {
         uint32_t timeout = 0,
         lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
 
+    /**
+     * Executes the given program, streaming stdin from a pull callback.
+     * The callback is invoked whenever the child has drained the previous chunk
+     * and must fill the given buffer with the next chunk of input, returning
+     * false (or an empty buffer) when the input is exhausted. Input is fed to
+     * the child incrementally, so arbitrarily large payloads can be streamed
+     * with only one chunk in memory at a time.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param input_source The callback that produces successive chunks of stdin for the child process.
+     * @param environment The environment variables to pass to the child process.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns a result struct.
+     */
+    result execute(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::function<bool(std::string&)> input_source,
+        std::map<std::string, std::string> const& environment,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given program, streaming stdin from the given stream.
+     * Input is read from the stream and fed to the child incrementally, so
+     * arbitrarily large payloads (e.g. a file opened with an ifstream) can be
+     * streamed with only one chunk in memory at a time.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param input_stream The stream to read stdin for the child process from; it must outlive the execution.
+     * @param environment The environment variables to pass to the child process.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns a result struct.
+     */
+    result execute(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::istream& input_stream,
+        std::map<std::string, std::string> const& environment,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given program, capturing output under the given policy.
+     * Output is accumulated binary safe (no line splitting or line callbacks)
+     * and bounded in memory as described on capture_policy.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param input A string to place on stdin for the child process before reading output.
+     * @param environment The environment variables to pass to the child process.
+     * @param capture The output capture policy.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns a result struct.
+     */
+    result execute(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::string const& input,
+        std::map<std::string, std::string> const& environment,
+        capture_policy const& capture,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
     /**
      * Executes the given program by calling a specified callback that receives the pid of the program's process.
      * @param file The name or path of the program to execute.
@@ -363,8 +586,10 @@ namespace leatherman { namespace execution {
         lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
 
     /**
-     * Executes the given program by writing the output of stdout and stderr to specified files. The output
-     * is processed line-by-line, so binary data isn't supported.
+     * Executes the given program by writing the output of stdout and stderr to specified files. When
+     * trim_output is requested the output is processed line-by-line, so binary data isn't supported;
+     * without it, the output is copied to the files verbatim (on Linux via splice, without passing
+     * through userspace), so binary data is preserved.
      * @param file The name or path of the program to execute.
      * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
      * @param input A string to place on stdin for the child process before reading output.
@@ -390,13 +615,14 @@ namespace leatherman { namespace execution {
         lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
 
     /**
-     * Executes the given program by writing the output of stdout and stderr to specified files. The output
-     * is processed line-by-line, so binary data isn't supported.
+     * Executes the given program by writing the output of stdout and stderr to specified files. When
+     * trim_output is requested the output is processed line-by-line, so binary data isn't supported;
+     * without it, the output is copied to the files verbatim (on Linux via splice, without passing
+     * through userspace), so binary data is preserved.
      * @param file The name or path of the program to execute.
      * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
      * @param input A string to place on stdin for the child process before reading output.
      * @param out_file The file where the output on stdout will be written.
-     * @param err_file The file where the output on stderr will be written.
      * @param environment The environment variables to pass to the child process.
      * @param pid_callback The callback that is called with the pid of the child process.
      * @param timeout The timeout, in seconds.
@@ -419,6 +645,234 @@ namespace leatherman { namespace execution {
         boost::optional<boost::filesystem::perms> perms,
         lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
 
+    /**
+     * Executes the given program, teeing output to files and line callbacks.
+     * Each line read from the child is written to the corresponding file and
+     * handed to the corresponding callback in the same pass, so an audit copy
+     * on disk and live line processing share one set of pipe reads. A callback
+     * returning false stops processing and closes the child's output stream;
+     * lines already read are still in the files.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param input A string to place on stdin for the child process before reading output.
+     * @param out_file The file where the output on stdout will be written.
+     * @param err_file The file where the output on stderr will be written, or empty to buffer stderr in the result struct.
+     * @param environment The environment variables to pass to the child process.
+     * @param stdout_callback The callback that is called with each line of output on stdout.
+     * @param stderr_callback The callback that is called with each line of output on stderr. Ignored when err_file is empty.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options. Defaults to trimming output and merging the environment.
+     * @return Returns a result struct that will not contain the output of the streams for which a file was specified.
+     *
+     * Throws an execution_exception error in case it fails to open a file.
+     */
+    result execute_tee(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::string const& input,
+        std::string const& out_file,
+        std::string const& err_file,
+        std::map<std::string, std::string> const& environment,
+        std::function<bool(std::string&)> stdout_callback,
+        std::function<bool(std::string&)> stderr_callback,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
+
+    /**
+     * Executes the given program asynchronously on a shared supervisor pool.
+     * Executions are supervised by a bounded set of shared threads rather than one
+     * caller thread blocked per child, so many commands can be in flight at once.
+     * @param file The name or path of the program to execute.
+     * @param timeout The timeout, in seconds.  Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns a future that yields the result struct, or the exception thrown by the execution.
+     */
+    std::future<result> execute_async(
+        std::string const& file,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given program asynchronously on a shared supervisor pool.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param timeout The timeout, in seconds.  Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns a future that yields the result struct, or the exception thrown by the execution.
+     */
+    std::future<result> execute_async(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given program asynchronously on a shared supervisor pool.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param input A string to place on stdin for the child process before reading output.
+     * @param environment The environment variables to pass to the child process.
+     * @param timeout The timeout, in seconds.  Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns a future that yields the result struct, or the exception thrown by the execution.
+     */
+    std::future<result> execute_async(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::string const& input,
+        std::map<std::string, std::string> const& environment,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given program asynchronously and invokes a callback with the result.
+     * The callback runs on a shared supervisor thread; exceptions thrown by the execution
+     * (e.g. with throw_on_failure set) are logged and swallowed, so prefer the future
+     * returning overloads when using throwing options.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param on_complete The callback that is called with the result struct once the child has exited.
+     * @param timeout The timeout, in seconds.  Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     */
+    void execute_async(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::function<void(result)> on_complete,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Describes one command of a batch execution.
+     */
+    struct command_spec
+    {
+        /**
+         * The name or path of the program to execute.
+         */
+        std::string file;
+        /**
+         * The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+         */
+        std::vector<std::string> arguments;
+        /**
+         * A string to place on stdin for the child process before reading output.
+         */
+        std::string input;
+        /**
+         * The environment variables to pass to the child process.
+         */
+        std::map<std::string, std::string> environment;
+    };
+
+    /**
+     * A prepared execution context for running the same command repeatedly.
+     * The executable is resolved against the search paths once at
+     * construction, and the arguments, environment, and options live on the
+     * context, so repeated executions skip the per-call PATH search and the
+     * argument and environment copies made by the plain execute overloads.
+     * The resolved path is re-validated (a single stat) on each execution.
+     */
+    class exec_context
+    {
+     public:
+        /**
+         * Constructs an execution context, resolving the executable.
+         * @param file The name or path of the program to execute.
+         * @param arguments The arguments to pass to the program.
+         * @param environment The environment variables to pass to the child process.
+         * @param options The execution options.
+         */
+        explicit exec_context(
+            std::string file,
+            std::vector<std::string> arguments = {},
+            std::map<std::string, std::string> environment = {},
+            lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+        /**
+         * Gets the name or path the context was constructed with.
+         * @return Returns the name or path of the program.
+         */
+        std::string const& file() const;
+
+        /**
+         * Gets the resolved path of the executable.
+         * @return Returns the full path, or the original file if it could not be resolved.
+         */
+        std::string const& executable() const;
+
+        /**
+         * Gets the arguments passed to the program.
+         * @return Returns the arguments.
+         */
+        std::vector<std::string> const& arguments() const;
+
+        /**
+         * Gets the environment variables passed to the child process.
+         * @return Returns the environment variables.
+         */
+        std::map<std::string, std::string> const& environment() const;
+
+        /**
+         * Gets the execution options.
+         * @return Returns the execution options.
+         */
+        lth_util::option_set<execution_options> const& options() const;
+
+     private:
+        std::string _file;
+        std::string _executable;
+        std::vector<std::string> _arguments;
+        std::map<std::string, std::string> _environment;
+        lth_util::option_set<execution_options> _options;
+    };
+
+    /**
+     * Executes the given prepared context.
+     * @param context The prepared execution context.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @return Returns a result struct.
+     */
+    result execute(exec_context const& context, uint32_t timeout = 0);
+
+    /**
+     * Executes the given commands on the shared supervisor pool with at most
+     * max_parallelism children in flight at once, and blocks until all of them
+     * have completed. A command that throws (e.g. with throw_on_failure set)
+     * yields a result with success set to false, the exception message in
+     * error, and an exit code of -1.
+     * @param commands The commands to execute.
+     * @param max_parallelism The maximum number of children in flight at once. Zero means the number of hardware threads.
+     * @param timeout The timeout for each command, in seconds.  Defaults to no timeout.
+     * @param options The execution options applied to each command.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns the result structs in the same order as the given commands.
+     */
+    std::vector<result> execute_batch(
+        std::vector<command_spec> const& commands,
+        size_t max_parallelism,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
+    /**
+     * Executes the given commands on the shared supervisor pool with at most
+     * max_parallelism children in flight at once, invoking a callback with each
+     * result as its command completes, and blocks until all of them have completed.
+     * The callback runs on a supervisor thread, so it must be thread-safe; results
+     * arrive in completion order, with the index of the command they belong to.
+     * @param commands The commands to execute.
+     * @param on_complete The callback that is called with a command's index and result as each child exits.
+     * @param max_parallelism The maximum number of children in flight at once. Zero means the number of hardware threads.
+     * @param timeout The timeout for each command, in seconds.  Defaults to no timeout.
+     * @param options The execution options applied to each command.  Defaults to trimming output, merging the environment, and redirecting stderr to null.
+     * @return Returns the result structs in the same order as the given commands.
+     */
+    std::vector<result> execute_batch(
+        std::vector<command_spec> const& commands,
+        std::function<void(size_t, result const&)> on_complete,
+        size_t max_parallelism,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment, execution_options::redirect_stderr_to_null });
+
     /**
      * Executes the given program and returns each line of output.
      * @param file The name or path of the program to execute.
@@ -473,6 +927,52 @@ namespace leatherman { namespace execution {
         uint32_t timeout = 0,
         lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
 
+    /**
+     * Executes the given program and passes each line of output as a non-owning view.
+     * Unlike each_line(), lines are handed to the callbacks as views into an internal
+     * buffer that is reused between lines, so no per-line heap allocation is made.
+     * A view is only valid for the duration of the callback; copy it out (e.g. with
+     * to_string()) to keep the line beyond that.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param stdout_callback The callback that is called with a view of each line of output on stdout.
+     * @param stderr_callback The callback that is called with a view of each line of output on stderr. If nullptr, implies redirect_stderr_to_null unless redirect_stderr_to_stdout is set in options.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output and merging the environment.
+     * @return Returns true if the execution succeeded or false if it did not.
+     */
+    bool each_line_view(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::function<bool(boost::string_ref)> stdout_callback,
+        std::function<bool(boost::string_ref)> stderr_callback = nullptr,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
+
+    /**
+     * Executes the given program and passes each line of output as a non-owning view.
+     * Unlike each_line(), lines are handed to the callbacks as views into an internal
+     * buffer that is reused between lines, so no per-line heap allocation is made.
+     * A view is only valid for the duration of the callback; copy it out (e.g. with
+     * to_string()) to keep the line beyond that.
+     * @param file The name or path of the program to execute.
+     * @param arguments The arguments to pass to the program. On Windows they will be quoted as needed for spaces.
+     * @param environment The environment variables to pass to the child process.
+     * @param stdout_callback The callback that is called with a view of each line of output on stdout.
+     * @param stderr_callback The callback that is called with a view of each line of output on stderr. If nullptr, implies redirect_stderr_to_null unless redirect_stderr_to_stdout is set in options.
+     * @param timeout The timeout, in seconds. Defaults to no timeout.
+     * @param options The execution options.  Defaults to trimming output and merging the environment.
+     * @return Returns true if the execution succeeded or false if it did not.
+     */
+    bool each_line_view(
+        std::string const& file,
+        std::vector<std::string> const& arguments,
+        std::map<std::string, std::string> const& environment,
+        std::function<bool(boost::string_ref)> stdout_callback,
+        std::function<bool(boost::string_ref)> stderr_callback = nullptr,
+        uint32_t timeout = 0,
+        lth_util::option_set<execution_options> const& options = { execution_options::trim_output, execution_options::merge_environment });
+
     /**
      * Processes stdout and stderror streams of a child process.
      * @param trim True if output should be trimmed or false if not.
@@ -487,4 +987,33 @@ namespace leatherman { namespace execution {
             std::function<bool(std::string&)> const& stderr_callback,
             std::function<void(std::function<bool(std::string const&)>, std::function<bool(std::string const&)>)> const& read_streams);
 
+    /**
+     * Processes stdout and stderr streams of a child process, splitting lines as
+     * non-owning views into a reused buffer.
+     * @param trim True if output should be trimmed or false if not.
+     * @param stdout_callback The callback to use when a line is read for stdout.
+     * @param stderr_callback The callback to use when a line is read for stderr.
+     * @param read_streams The callback that is called to read stdout and stderr streams.
+     * @return Returns a tuple of stdout and stderr output.  If stdout_callback or stderr_callback is given, it will return empty strings.
+     */
+    std::tuple<std::string, std::string> process_streams(
+            bool trim,
+            std::function<bool(boost::string_ref)> const& stdout_callback,
+            std::function<bool(boost::string_ref)> const& stderr_callback,
+            std::function<void(std::function<bool(std::string const&)>, std::function<bool(std::string const&)>)> const& read_streams);
+
+    /**
+     * Processes stdout and stderr streams of a child process under a capture policy.
+     * Data is accumulated as raw bytes, without line splitting, and bounded in
+     * memory as described on capture_policy.
+     * @param trim True if output should be trimmed or false if not.
+     * @param capture The output capture policy.
+     * @param read_streams The callback that is called to read stdout and stderr streams.
+     * @return Returns a tuple of the captured stdout and stderr output.
+     */
+    std::tuple<std::string, std::string> process_streams(
+            bool trim,
+            capture_policy const& capture,
+            std::function<void(std::function<bool(std::string const&)>, std::function<bool(std::string const&)>)> const& read_streams);
+
 }}  // namespace leatherman::execution
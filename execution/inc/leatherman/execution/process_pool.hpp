@@ -0,0 +1,127 @@
+/**
+ * @file
+ * Declares a pool of persistent shell workers for repeated command execution.
+ */
+#pragma once
+
+#include <leatherman/execution/execution.hpp>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace leatherman { namespace execution {
+
+#ifndef _WIN32
+
+    /**
+     * A pool of persistent system shell (command_shell) workers.
+     * Workers are spawned once and kept alive; commands are dispatched to an
+     * idle worker over its stdin and the output is read back from its stdout,
+     * amortizing the fork+exec+dynamic-link cost of execute() across
+     * invocations of short-lived shell commands.
+     *
+     * Caveats compared to execute(): commands run in a long-lived shell, so
+     * shell state (variables, working directory) persists between commands
+     * dispatched to the same worker; stderr is merged into stdout; and the
+     * output is expected to be line-oriented text.
+     *
+     * Dispatching is thread safe; a call blocks while all workers are busy.
+     */
+    class process_pool
+    {
+    public:
+        /**
+         * Constructs a process_pool and spawns its workers.
+         * @param size The number of shell workers to keep alive.
+         */
+        explicit process_pool(size_t size = 4);
+
+        /**
+         * Destructs a process_pool, terminating its workers.
+         */
+        ~process_pool();
+
+        /**
+         * Prevents the process_pool from being copied.
+         */
+        process_pool(process_pool const&) = delete;
+
+        /**
+         * Prevents the process_pool from being copied.
+         * @returns Returns this process_pool.
+         */
+        process_pool& operator=(process_pool const&) = delete;
+
+        /**
+         * Dispatches a command to an idle worker and waits for it to complete.
+         * The worker is respawned if the command times out or exits the shell.
+         * @param command The shell command to run.
+         * @param timeout The timeout, in seconds.  Defaults to no timeout.
+         * @return Returns a result struct; stderr is merged into the output and
+         *         the error member is always empty.
+         */
+        result run(std::string const& command, uint32_t timeout = 0);
+
+        /**
+         * Gets the number of workers in the pool.
+         * @return Returns the number of workers in the pool.
+         */
+        size_t size() const;
+
+    private:
+        struct worker;
+
+        worker* acquire();
+        void release(worker* w);
+        static void spawn_worker(worker& w);
+        static void terminate_worker(worker& w);
+        static void write_command(worker& w, std::string const& message);
+        static result read_result(worker& w, uint32_t timeout);
+
+        std::vector<std::unique_ptr<worker>> _workers;
+        mutable std::mutex _mutex;
+        std::condition_variable _available;
+    };
+
+    /**
+     * A single persistent system shell (command_shell) session.
+     * Every snippet dispatched through run() executes in the same long-lived
+     * shell child, so state set by one snippet — variables, working
+     * directory, functions — is visible to the next, like lines typed into
+     * an interactive shell. Shell startup (including profile parsing on
+     * platforms that do it) is paid once for the session rather than per
+     * snippet.
+     *
+     * The same framing caveats as process_pool apply: stderr is merged into
+     * stdout and output is expected to be line-oriented text. A snippet that
+     * times out or exits the shell causes the session to be respawned, which
+     * discards accumulated shell state.
+     */
+    class shell_session
+    {
+    public:
+        /**
+         * Constructs a shell_session, spawning its shell child.
+         */
+        shell_session();
+
+        /**
+         * Runs a script snippet in the session's shell and waits for it to
+         * complete.
+         * @param command The shell snippet to run.
+         * @param timeout The timeout, in seconds.  Defaults to no timeout.
+         * @return Returns a result struct; stderr is merged into the output
+         *         and the error member is always empty.
+         */
+        result run(std::string const& command, uint32_t timeout = 0);
+
+    private:
+        process_pool _pool;
+    };
+
+#endif  // !_WIN32
+
+}}  // namespace leatherman::execution
@@ -5,10 +5,22 @@
 #include <boost/filesystem.hpp>
 #include <boost/optional.hpp>
 #include <boost/nowide/fstream.hpp>
+#ifndef _WIN32
+#include <leatherman/util/posix/scoped_descriptor.hpp>
+#include <fcntl.h>
+#endif
 #include <cstdlib>
 #include <cstdio>
+#include <istream>
 #include <sstream>
 #include <cstring>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -82,15 +94,148 @@ namespace leatherman { namespace execution {
             return;
         }
 
-        ostringstream command_line;
-        command_line << file;
+        // Size the buffer up front so assembling the command line is a
+        // single allocation rather than ostringstream growth.
+        auto length = file.size();
+        if (arguments) {
+            for (auto const& argument : *arguments) {
+                length += 1 + argument.size();
+            }
+        }
 
+        string command_line;
+        command_line.reserve(length);
+        command_line += file;
         if (arguments) {
             for (auto const& argument : *arguments) {
-                command_line << ' ' << argument;
+                command_line += ' ';
+                command_line += argument;
             }
         }
-        LOG_DEBUG("executing command: {1}", command_line.str());
+        LOG_DEBUG("executing command: {1}", command_line);
+    }
+
+    // Caches successful executable resolutions so that repeated which()
+    // and expand_command() calls for the same commands become a hash
+    // lookup plus a single stat of the resolved file, instead of a stat
+    // per search path. Entries are keyed on the file name and a hash of
+    // the search directories (so a changed PATH misses naturally) and
+    // are invalidated when the resolved file's modification time
+    // changes. Failed resolutions are never cached, so a newly
+    // installed command is always picked up.
+    class resolution_cache
+    {
+     public:
+        static resolution_cache& instance()
+        {
+            static resolution_cache cache;
+            return cache;
+        }
+
+        void enable(bool enabled)
+        {
+            lock_guard<mutex> lock(_mutex);
+            _enabled = enabled;
+            _entries.clear();
+        }
+
+        void clear()
+        {
+            lock_guard<mutex> lock(_mutex);
+            _entries.clear();
+        }
+
+        bool lookup(string const& file, vector<string> const& directories, bool expand, string& result)
+        {
+            unique_lock<mutex> lock(_mutex);
+            if (!_enabled) {
+                return false;
+            }
+            auto it = _entries.find(key(file, expand));
+            if (it == _entries.end() || it->second.directories_hash != hash_directories(directories)) {
+                return false;
+            }
+            auto entry = it->second;
+            lock.unlock();
+
+            // Revalidate the resolved file with a single stat
+            boost::system::error_code ec;
+            auto mtime = fs::last_write_time(entry.path, ec);
+            if (ec || mtime != entry.mtime) {
+                lock.lock();
+                _entries.erase(key(file, expand));
+                return false;
+            }
+            result = move(entry.path);
+            return true;
+        }
+
+        void store(string const& file, vector<string> const& directories, bool expand, string const& result)
+        {
+            if (result.empty()) {
+                return;
+            }
+            boost::system::error_code ec;
+            auto mtime = fs::last_write_time(result, ec);
+            if (ec) {
+                return;
+            }
+            lock_guard<mutex> lock(_mutex);
+            if (!_enabled) {
+                return;
+            }
+            _entries[key(file, expand)] = entry { hash_directories(directories), result, mtime };
+        }
+
+     private:
+        struct entry
+        {
+            size_t directories_hash;
+            string path;
+            time_t mtime;
+        };
+
+        static string key(string const& file, bool expand)
+        {
+            // The expand flag affects resolution, so it is part of the key
+            return file + (expand ? '\x01' : '\x02');
+        }
+
+        static size_t hash_directories(vector<string> const& directories)
+        {
+            hash<string> hasher;
+            size_t seed = directories.size();
+            for (auto const& dir : directories) {
+                // Standard hash combining (as in boost::hash_combine)
+                seed ^= hasher(dir) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+
+        mutex _mutex;
+        bool _enabled = false;
+        unordered_map<string, entry> _entries;
+    };
+
+    void enable_resolution_caching(bool enable)
+    {
+        resolution_cache::instance().enable(enable);
+    }
+
+    void clear_resolution_cache()
+    {
+        resolution_cache::instance().clear();
+    }
+
+    // Used by the platform implementations of which()
+    bool resolution_cache_lookup(string const& file, vector<string> const& directories, bool expand, string& result)
+    {
+        return resolution_cache::instance().lookup(file, directories, expand, result);
+    }
+
+    void resolution_cache_store(string const& file, vector<string> const& directories, bool expand, string const& result)
+    {
+        resolution_cache::instance().store(file, directories, expand, result);
     }
 
     string expand_command(string const& command, vector<string> const& directories, bool expand)
@@ -151,7 +296,80 @@ namespace leatherman { namespace execution {
         function<bool(string&)> const& stdout_callback,
         function<bool(string&)> const& stderr_callback,
         option_set<execution_options> const& options,
-        uint32_t timeout);
+        uint32_t timeout,
+        capture_policy const* capture = nullptr,
+        int out_fd = -1,
+        int err_fd = -1,
+        function<bool(string&)> const* input_source = nullptr,
+        function<bool(boost::string_ref)> const* stdout_view_callback = nullptr,
+        function<bool(boost::string_ref)> const* stderr_view_callback = nullptr);
+
+    // The command statistics registry: opt-in, process-wide aggregation of
+    // per-executable run counts, failures, wall time, and a latency
+    // histogram. The platform execute implementations call the recording
+    // hooks below; when disabled, the cost is one relaxed atomic load.
+    namespace {
+        struct command_stats_registry
+        {
+            mutex lock;
+            unordered_map<string, command_stats> entries;
+        };
+
+        atomic<bool> g_command_stats_enabled(false);
+
+        command_stats_registry& command_stats_instance()
+        {
+            static command_stats_registry registry;
+            return registry;
+        }
+    }
+
+    bool command_statistics_enabled()
+    {
+        return g_command_stats_enabled.load(memory_order_relaxed);
+    }
+
+    void record_command_stats(string const& executable, chrono::microseconds wall_time, bool success)
+    {
+        auto ms = static_cast<uint64_t>(wall_time.count() / 1000);
+        size_t bucket = 0;
+        while (ms > 0 && bucket + 1 < command_stats::histogram_buckets) {
+            ms >>= 1;
+            ++bucket;
+        }
+
+        auto& registry = command_stats_instance();
+        lock_guard<mutex> guard(registry.lock);
+        auto& entry = registry.entries[executable];
+        ++entry.count;
+        if (!success) {
+            ++entry.failures;
+        }
+        entry.total_wall_time += wall_time;
+        ++entry.latency_histogram[bucket];
+    }
+
+    void enable_command_statistics(bool enable)
+    {
+        g_command_stats_enabled.store(enable, memory_order_relaxed);
+        if (!enable) {
+            reset_command_statistics();
+        }
+    }
+
+    map<string, command_stats> command_statistics_snapshot()
+    {
+        auto& registry = command_stats_instance();
+        lock_guard<mutex> guard(registry.lock);
+        return map<string, command_stats>(registry.entries.begin(), registry.entries.end());
+    }
+
+    void reset_command_statistics()
+    {
+        auto& registry = command_stats_instance();
+        lock_guard<mutex> guard(registry.lock);
+        registry.entries.clear();
+    }
 
     static void setup_execute(function<bool(string&)>& stderr_callback, option_set<execution_options>& options)
     {
@@ -228,6 +446,42 @@ namespace leatherman { namespace execution {
         return execute(file, &arguments, &input, &environment, nullptr, nullptr, stderr_callback, actual_options, timeout);
     }
 
+    result execute(
+        string const& file,
+        vector<string> const& arguments,
+        // cppcheck-suppress passedByValue
+        function<bool(string&)> input_source,
+        map<string, string> const& environment,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        auto actual_options = options;
+        function<bool(string&)> stderr_callback;
+        setup_execute(stderr_callback, actual_options);
+        return execute(file, &arguments, nullptr, &environment, nullptr, nullptr, stderr_callback, actual_options, timeout,
+                       nullptr, -1, -1, &input_source);
+    }
+
+    result execute(
+        string const& file,
+        vector<string> const& arguments,
+        istream& input_stream,
+        map<string, string> const& environment,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        return execute(file, arguments, function<bool(string&)>([&](string& buffer) {
+            buffer.resize(65536);
+            input_stream.read(&buffer[0], buffer.size());
+            auto count = input_stream.gcount();
+            if (count <= 0) {
+                return false;
+            }
+            buffer.resize(static_cast<size_t>(count));
+            return true;
+        }), environment, timeout, options);
+    }
+
     result execute(
         string const& file,
         vector<string> const& arguments,
@@ -258,6 +512,20 @@ namespace leatherman { namespace execution {
         return execute(file, arguments, input, out_file, err_file, environment, pid_callback, timeout, {}, options);
     }
 
+    result execute(
+        string const& file,
+        vector<string> const& arguments,
+        string const& input,
+        map<string, string> const& environment,
+        capture_policy const& capture,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        // Line callbacks don't apply under a capture policy, so the
+        // stderr debug-logging setup is skipped here.
+        return execute(file, &arguments, &input, &environment, nullptr, nullptr, nullptr, options, timeout, &capture);
+    }
+
     result execute(
         // cppcheck-suppress funcArgOrderDifferent
         std::string const& file,
@@ -278,6 +546,46 @@ namespace leatherman { namespace execution {
         boost::nowide::ofstream out_stream;
         boost::nowide::ofstream err_stream;
 
+#ifndef _WIN32
+        // Fast path: without trimming there is no line processing to do, so
+        // the destination descriptors are handed to the platform layer and
+        // pipe data is moved to them without a line scan (on Linux entirely
+        // in-kernel via splice).
+        if (!options[execution_options::trim_output]) {
+            auto open_sink = [&](string const& path) {
+                int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+                if (fd == -1) {
+                    throw execution_exception(_("failed to open output file {1}", path));
+                }
+                return lth_util::posix::scoped_descriptor(fd);
+            };
+
+            auto out = open_sink(out_file);
+            boost::system::error_code ec;
+            if (perms) {
+                fs::permissions(out_file, *perms, ec);
+                if (ec) {
+                    throw execution_exception(_("failed to modify permissions on output file {1} to {2,num,oct}: {3}", out_file, *perms, ec.message()));
+                }
+            }
+
+            lth_util::posix::scoped_descriptor err;
+            if (!err_file.empty()) {
+                err = open_sink(err_file);
+                if (perms) {
+                    fs::permissions(err_file, *perms, ec);
+                    if (ec) {
+                        throw execution_exception(_("failed to modify permissions on error file {1} to {2,num,oct}: {3}", err_file, *perms, ec.message()));
+                    }
+                }
+            }
+
+            auto env = environment.empty() ? nullptr : &environment;
+            return execute(file, &arguments, &input, env, pid_callback, nullptr, nullptr, actual_options, timeout,
+                           nullptr, out, err_file.empty() ? -1 : static_cast<int>(err));
+        }
+#endif
+
         out_stream.open(out_file.c_str(), std::ios::binary);
         if (!out_stream.is_open()) {
             throw execution_exception(_("failed to open output file {1}", out_file));
@@ -322,6 +630,334 @@ namespace leatherman { namespace execution {
         return execute(file, &arguments, &input, env, pid_callback, stdout_callback, stderr_callback, actual_options, timeout);
     }
 
+    result execute_tee(
+        string const& file,
+        vector<string> const& arguments,
+        string const& input,
+        string const& out_file,
+        string const& err_file,
+        map<string, string> const& environment,
+        // cppcheck-suppress passedByValue
+        function<bool(string&)> stdout_callback,
+        // cppcheck-suppress passedByValue
+        function<bool(string&)> stderr_callback,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        auto actual_options = options;
+        boost::nowide::ofstream out_stream;
+        boost::nowide::ofstream err_stream;
+
+        out_stream.open(out_file.c_str(), std::ios::binary);
+        if (!out_stream.is_open()) {
+            throw execution_exception(_("failed to open output file {1}", out_file));
+        }
+
+        // Fan each line out to the file and the callback in one pass; the
+        // pipe is read once and both consumers see the same lines.
+        function<bool(string&)> tee_stdout = [&](string& line) {
+            out_stream << line << "\n";
+            return stdout_callback ? stdout_callback(line) : true;
+        };
+
+        function<bool(string&)> tee_stderr;
+        if (err_file.empty()) {
+            setup_execute(tee_stderr, actual_options);
+        } else {
+            err_stream.open(err_file.c_str(), std::ios::binary);
+            if (!err_stream.is_open()) {
+                throw execution_exception(_("failed to open error file {1}", err_file));
+            }
+            tee_stderr = [&](string& line) {
+                err_stream << line << "\n";
+                return stderr_callback ? stderr_callback(line) : true;
+            };
+        }
+
+        auto env = environment.empty() ? nullptr : &environment;
+        return execute(file, &arguments, &input, env, nullptr, tee_stdout, tee_stderr, actual_options, timeout);
+    }
+
+    // Shared supervisor backing execute_async: a bounded set of threads
+    // drains a queue of pending executions, so concurrent callers share
+    // supervisor threads instead of parking one caller thread per child.
+    // Threads are started lazily, only when there is a backlog and no
+    // idle worker, and are joined when the process exits.
+    class async_supervisor
+    {
+     public:
+        static async_supervisor& instance()
+        {
+            static async_supervisor supervisor;
+            return supervisor;
+        }
+
+        void enqueue(function<void()> task)
+        {
+            {
+                unique_lock<mutex> lock(_mutex);
+                _tasks.emplace(move(task));
+                if (_idle == 0 && _workers.size() < _limit) {
+                    _workers.emplace_back(&async_supervisor::run, this);
+                }
+            }
+            _signal.notify_one();
+        }
+
+     private:
+        async_supervisor() :
+            _limit(max(4u, thread::hardware_concurrency()))
+        {
+        }
+
+        ~async_supervisor()
+        {
+            {
+                unique_lock<mutex> lock(_mutex);
+                _done = true;
+            }
+            _signal.notify_all();
+            for (auto& worker : _workers) {
+                worker.join();
+            }
+        }
+
+        void run()
+        {
+            unique_lock<mutex> lock(_mutex);
+            while (true) {
+                ++_idle;
+                _signal.wait(lock, [this] { return _done || !_tasks.empty(); });
+                --_idle;
+                // Pending executions are drained even on shutdown, so
+                // that no returned future is left broken.
+                if (_tasks.empty()) {
+                    return;
+                }
+                auto task = move(_tasks.front());
+                _tasks.pop();
+                lock.unlock();
+                task();
+                lock.lock();
+            }
+        }
+
+        mutex _mutex;
+        condition_variable _signal;
+        queue<function<void()>> _tasks;
+        vector<thread> _workers;
+        size_t _idle = 0;
+        size_t _limit;
+        bool _done = false;
+    };
+
+    static future<result> enqueue_execution(function<result()> execution)
+    {
+        auto task = make_shared<packaged_task<result()>>(move(execution));
+        auto future = task->get_future();
+        async_supervisor::instance().enqueue([task]() { (*task)(); });
+        return future;
+    }
+
+    future<result> execute_async(
+        string const& file,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        return enqueue_execution([=]() {
+            return execute(file, timeout, options);
+        });
+    }
+
+    future<result> execute_async(
+        string const& file,
+        vector<string> const& arguments,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        return enqueue_execution([=]() {
+            return execute(file, arguments, timeout, options);
+        });
+    }
+
+    future<result> execute_async(
+        string const& file,
+        vector<string> const& arguments,
+        string const& input,
+        map<string, string> const& environment,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        return enqueue_execution([=]() {
+            return execute(file, arguments, input, environment, timeout, options);
+        });
+    }
+
+    void execute_async(
+        string const& file,
+        vector<string> const& arguments,
+        // cppcheck-suppress passedByValue
+        function<void(result)> on_complete,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        async_supervisor::instance().enqueue([=]() {
+            try {
+                on_complete(execute(file, arguments, timeout, options));
+            } catch (exception const& ex) {
+                LOG_ERROR("asynchronous execution of {1} failed: {2}", file, ex.what());
+            }
+        });
+    }
+
+    exec_context::exec_context(
+        string file,
+        vector<string> arguments,
+        map<string, string> environment,
+        option_set<execution_options> const& options) :
+            _file(move(file)),
+            _arguments(move(arguments)),
+            _environment(move(environment)),
+            _options(options)
+    {
+        // Resolve once; execution re-validates the resolved path with a
+        // single stat instead of searching the PATH again. Fall back to
+        // the original file so a failed resolution is reported against
+        // the name the caller used.
+        _executable = which(_file);
+        if (_executable.empty()) {
+            _executable = _file;
+        }
+    }
+
+    string const& exec_context::file() const
+    {
+        return _file;
+    }
+
+    string const& exec_context::executable() const
+    {
+        return _executable;
+    }
+
+    vector<string> const& exec_context::arguments() const
+    {
+        return _arguments;
+    }
+
+    map<string, string> const& exec_context::environment() const
+    {
+        return _environment;
+    }
+
+    option_set<execution_options> const& exec_context::options() const
+    {
+        return _options;
+    }
+
+    result execute(exec_context const& context, uint32_t timeout)
+    {
+        auto actual_options = context.options();
+        function<bool(string&)> stderr_callback;
+        setup_execute(stderr_callback, actual_options);
+        return execute(context.executable(),
+                       context.arguments().empty() ? nullptr : &context.arguments(),
+                       nullptr,
+                       context.environment().empty() ? nullptr : &context.environment(),
+                       nullptr, nullptr, stderr_callback, actual_options, timeout);
+    }
+
+    vector<result> execute_batch(
+        vector<command_spec> const& commands,
+        // cppcheck-suppress passedByValue
+        function<void(size_t, result const&)> on_complete,
+        size_t max_parallelism,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        if (max_parallelism == 0) {
+            max_parallelism = max(1u, thread::hardware_concurrency());
+        }
+
+        // Everything the supervisor tasks touch lives in shared state: a
+        // task enqueued beyond the number of commands may only start after
+        // the caller has already been signaled and returned.
+        struct batch_state
+        {
+            vector<command_spec> commands;
+            function<void(size_t, result const&)> on_complete;
+            uint32_t timeout;
+            option_set<execution_options> options;
+            mutex lock;
+            condition_variable finished;
+            vector<result> results;
+            size_t next = 0;
+            size_t completed = 0;
+        };
+        auto state = make_shared<batch_state>();
+        state->commands = commands;
+        state->on_complete = move(on_complete);
+        state->timeout = timeout;
+        state->options = options;
+        state->results.assign(commands.size(), result(false, "", "", -1, 0));
+
+        // Each task claims pending commands one at a time until none are
+        // left, so the number of tasks bounds the number of children in
+        // flight at once.
+        auto worker = [state]() {
+            while (true) {
+                size_t index;
+                {
+                    lock_guard<mutex> lock(state->lock);
+                    if (state->next >= state->commands.size()) {
+                        return;
+                    }
+                    index = state->next++;
+                }
+
+                auto const& command = state->commands[index];
+                result res(false, "", "", -1, 0);
+                try {
+                    res = execute(command.file, command.arguments, command.input, command.environment, state->timeout, state->options);
+                } catch (exception const& ex) {
+                    LOG_ERROR("batch execution of {1} failed: {2}", command.file, ex.what());
+                    res.error = ex.what();
+                }
+                if (state->on_complete) {
+                    try {
+                        state->on_complete(index, res);
+                    } catch (exception const& ex) {
+                        LOG_ERROR("batch completion callback failed: {1}", ex.what());
+                    }
+                }
+
+                lock_guard<mutex> lock(state->lock);
+                state->results[index] = move(res);
+                if (++state->completed == state->commands.size()) {
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        auto tasks = min(max_parallelism, commands.size());
+        for (size_t i = 0; i < tasks; ++i) {
+            async_supervisor::instance().enqueue(worker);
+        }
+
+        unique_lock<mutex> lock(state->lock);
+        state->finished.wait(lock, [&] { return state->completed == state->commands.size(); });
+        return move(state->results);
+    }
+
+    vector<result> execute_batch(
+        vector<command_spec> const& commands,
+        size_t max_parallelism,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        return execute_batch(commands, nullptr, max_parallelism, timeout, options);
+    }
+
     static void setup_each_line(function<bool(string&)>& stdout_callback, function<bool(string&)>& stderr_callback, option_set<execution_options>& options)
     {
         // If not given a stdout callback, use a no-op one to prevent execute from buffering stdout (also logs for debug level)
@@ -384,6 +1020,162 @@ namespace leatherman { namespace execution {
         return execute(file, &arguments, nullptr, &environment, nullptr, stdout_callback, stderr_callback, actual_options, timeout).success;
     }
 
+    // Equivalent of process_data for view callbacks: lines wholly contained
+    // in the data just read are passed as views into it without copying;
+    // only a line spanning reads goes through the carry buffer, which is
+    // reused between lines.
+    // Trims whitespace from both ends of a buffer by adjusting bounds and
+    // erasing, so a large output is never reallocated or duplicated; at
+    // worst a leading-whitespace erase shifts the retained bytes down.
+    static void trim_in_place(string& buffer)
+    {
+        static const char whitespace[] = " \t\r\n\f\v";
+        auto last = buffer.find_last_not_of(whitespace);
+        if (last == string::npos) {
+            buffer.clear();
+            return;
+        }
+        buffer.erase(last + 1);
+        auto first = buffer.find_first_not_of(whitespace);
+        if (first > 0) {
+            buffer.erase(0, first);
+        }
+    }
+
+    static bool process_data_view(bool trim, string const& data, string& buffer, string const& logger, function<bool(boost::string_ref)> const& callback)
+    {
+        // Do nothing if nothing was read
+        if (data.empty()) {
+            return true;
+        }
+
+        // If given no callback, buffer the entire output
+        if (!callback) {
+            buffer.append(data);
+            return true;
+        }
+
+        size_t start = 0;
+        while (true) {
+            auto nl = data.find('\n', start);
+            if (nl == string::npos) {
+                break;
+            }
+
+            boost::string_ref line;
+            if (buffer.empty()) {
+                line = boost::string_ref(data.data() + start, nl - start);
+            } else {
+                // Complete the line carried over from the previous read
+                buffer.append(data, start, nl - start);
+                line = boost::string_ref(buffer);
+            }
+            start = nl + 1;
+
+            if (trim) {
+                while (!line.empty() && isspace(static_cast<unsigned char>(line.front()))) {
+                    line.remove_prefix(1);
+                }
+                while (!line.empty() && isspace(static_cast<unsigned char>(line.back()))) {
+                    line.remove_suffix(1);
+                }
+
+                // Skip empty lines only if trimming output.
+                // Otherwise we want to include empty lines to remain honest to the original output.
+                if (line.empty()) {
+                    buffer.clear();
+                    continue;
+                }
+            }
+
+#ifdef _WIN32
+            // Remove leading or trailing carriage returns. We don't want them during callbacks.
+            while (!line.empty() && line.front() == '\r') {
+                line.remove_prefix(1);
+            }
+            while (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+#endif
+
+            // Log the line to the output logger
+            if (LOG_IS_DEBUG_ENABLED()) {
+                log(logger, log_level::debug, 0, line.to_string());
+            }
+
+            // Pass the line to the callback
+            bool finished = !callback(line);
+
+            // Clear the carry buffer for the next iteration
+            buffer.clear();
+
+            // Break out if finished processing
+            if (finished) {
+                return false;
+            }
+        }
+
+        // Save the new trailing data
+        buffer.append(data, start, data.size() - start);
+        return true;
+    }
+
+    static void setup_each_line_view(function<bool(boost::string_ref)>& stdout_callback, function<bool(boost::string_ref)>& stderr_callback, option_set<execution_options>& options)
+    {
+        // If not given a stdout callback, use a no-op one to prevent execute from buffering stdout (also logs for debug level)
+        if (!stdout_callback) {
+            stdout_callback = ([&](boost::string_ref) {
+                return true;
+            });
+        }
+        // If given no stderr callback and not redirecting to stdout, redirect stderr to null when not debug log level
+        if (!stderr_callback && !options[execution_options::redirect_stderr_to_stdout]) {
+            if (LOG_IS_DEBUG_ENABLED()) {
+                // Use a do-nothing callback so that stderr is logged
+                stderr_callback = ([&](boost::string_ref) {
+                    return true;
+                });
+                options.clear(execution_options::redirect_stderr_to_null);
+            } else {
+                // Not debug level, redirect to null
+                options.set(execution_options::redirect_stderr_to_null);
+            }
+        }
+    }
+
+    bool each_line_view(
+        string const& file,
+        vector<string> const& arguments,
+        // cppcheck-suppress passedByValue
+        function<bool(boost::string_ref)> stdout_callback,
+        // cppcheck-suppress passedByValue
+        function<bool(boost::string_ref)> stderr_callback,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        auto actual_options = options;
+        setup_each_line_view(stdout_callback, stderr_callback, actual_options);
+        return execute(file, &arguments, nullptr, nullptr, nullptr, nullptr, nullptr, actual_options, timeout,
+                       nullptr, -1, -1, nullptr, &stdout_callback, &stderr_callback).success;
+    }
+
+    bool each_line_view(
+        string const& file,
+        vector<string> const& arguments,
+        map<string, string> const& environment,
+        // cppcheck-suppress passedByValue
+        function<bool(boost::string_ref)> stdout_callback,
+        // cppcheck-suppress passedByValue
+        function<bool(boost::string_ref)> stderr_callback,
+        uint32_t timeout,
+        option_set<execution_options> const& options)
+    {
+        auto actual_options = options;
+        setup_each_line_view(stdout_callback, stderr_callback, actual_options);
+        return execute(file, &arguments, nullptr, &environment, nullptr, nullptr, nullptr, actual_options, timeout,
+                       nullptr, -1, -1, nullptr, &stdout_callback, &stderr_callback).success;
+    }
+
     static bool process_data(bool trim, string const& data, string& buffer, string const& logger, function<bool(string&)> const& callback)
     {
         // Do nothing if nothing was read
@@ -452,6 +1244,111 @@ namespace leatherman { namespace execution {
         return true;
     }
 
+    // Accumulates raw stream data under a capture policy: the head of the
+    // stream is kept up to half the cap, the tail is kept in a ring buffer
+    // of the remaining capacity, and the full stream is optionally spilled
+    // to a file.
+    class bounded_capture
+    {
+     public:
+        bounded_capture(size_t max_bytes, string const& spill_file) :
+            _max(max_bytes)
+        {
+            if (!spill_file.empty()) {
+                _spill.open(spill_file.c_str(), std::ios::binary);
+                if (!_spill.is_open()) {
+                    throw execution_exception(_("failed to open spill file {1}", spill_file));
+                }
+            }
+        }
+
+        void append(string const& data)
+        {
+            if (_spill.is_open()) {
+                _spill.write(data.data(), data.size());
+            }
+            if (_max == 0) {
+                _head.append(data);
+                return;
+            }
+
+            size_t head_capacity = (_max + 1) / 2;
+            size_t offset = 0;
+            if (_head.size() < head_capacity) {
+                auto take = min(data.size(), head_capacity - _head.size());
+                _head.append(data, 0, take);
+                offset = take;
+            }
+
+            // Ring-buffer the rest as the stream's tail
+            auto tail_capacity = _max - head_capacity;
+            if (tail_capacity == 0) {
+                _dropped += data.size() - offset;
+                return;
+            }
+            while (offset < data.size()) {
+                if (_tail.size() < tail_capacity) {
+                    auto take = min(data.size() - offset, tail_capacity - _tail.size());
+                    _tail.append(data, offset, take);
+                    offset += take;
+                } else {
+                    auto take = min(data.size() - offset, tail_capacity - _tail_pos);
+                    _tail.replace(_tail_pos, take, data, offset, take);
+                    _tail_pos = (_tail_pos + take) % tail_capacity;
+                    _dropped += take;
+                    offset += take;
+                }
+            }
+        }
+
+        // Consumes the capture: the head buffer is moved out rather than
+        // copied, so an unbounded capture doesn't duplicate the entire
+        // output just to return it.
+        string str(bool trim)
+        {
+            string result = move(_head);
+            _head.clear();
+            if (_dropped) {
+                result += _("\n... {1} bytes of output dropped ...\n", _dropped);
+                result += _tail.substr(_tail_pos);
+                result += _tail.substr(0, _tail_pos);
+            } else {
+                // The tail never wrapped, so it's in order
+                result += _tail;
+            }
+            if (trim) {
+                trim_in_place(result);
+            }
+            return result;
+        }
+
+     private:
+        size_t _max;
+        string _head;
+        string _tail;
+        size_t _tail_pos = 0;
+        size_t _dropped = 0;
+        boost::nowide::ofstream _spill;
+    };
+
+    tuple<string, string> process_streams(bool trim, capture_policy const& capture, function<void(function<bool(string const&)>, function<bool(string const&)>)> const& read_streams)
+    {
+        bounded_capture stdout_capture(capture.max_bytes, capture.spill_file);
+        bounded_capture stderr_capture(capture.max_bytes, capture.error_spill_file);
+
+        read_streams(
+            [&](string const& data) {
+                stdout_capture.append(data);
+                return true;
+            },
+            [&](string const& data) {
+                stderr_capture.append(data);
+                return true;
+            });
+
+        return make_tuple(stdout_capture.str(trim), stderr_capture.str(trim));
+    }
+
     tuple<string, string> process_streams(bool trim, function<bool(string&)> const& stdout_callback, function<bool(string&)> const& stderr_callback, function<void(function<bool(string const&)>, function<bool(string const&)>)> const& read_streams)
     {
         // Get a special logger used specifically for child process output
@@ -481,8 +1378,8 @@ namespace leatherman { namespace execution {
 
         // Log the result and do a final callback if needed.
         if (trim) {
-            boost::trim(stdout_buffer);
-            boost::trim(stderr_buffer);
+            trim_in_place(stdout_buffer);
+            trim_in_place(stderr_buffer);
         }
         // Log the last line of output for stdout
         if (!stdout_buffer.empty()) {
@@ -507,4 +1404,59 @@ namespace leatherman { namespace execution {
         return make_tuple(move(stdout_buffer), move(stderr_buffer));
     }
 
+    tuple<string, string> process_streams(bool trim, function<bool(boost::string_ref)> const& stdout_callback, function<bool(boost::string_ref)> const& stderr_callback, function<void(function<bool(string const&)>, function<bool(string const&)>)> const& read_streams)
+    {
+        // Get a special logger used specifically for child process output
+        static const string stdout_logger = "|";
+        static const string stderr_logger = "!!!";
+
+        // Buffers for all of the output or partial line output
+        string stdout_buffer;
+        string stderr_buffer;
+
+        // Read the streams
+        read_streams(
+            [&](string const& data) {
+                if (!process_data_view(trim, data, stdout_buffer, stdout_logger, stdout_callback)) {
+                    LOG_DEBUG("completed processing output: closing child pipes.");
+                    return false;
+                }
+                return true;
+            },
+            [&](string const& data) {
+                if (!process_data_view(trim, data, stderr_buffer, stderr_logger, stderr_callback)) {
+                    LOG_DEBUG("completed processing output: closing child pipes.");
+                    return false;
+                }
+                return true;
+            });
+
+        // Log the result and do a final callback if needed.
+        if (trim) {
+            trim_in_place(stdout_buffer);
+            trim_in_place(stderr_buffer);
+        }
+        // Log the last line of output for stdout
+        if (!stdout_buffer.empty()) {
+            if (LOG_IS_DEBUG_ENABLED()) {
+                log(stdout_logger, log_level::debug, 0, stdout_buffer);
+            }
+            if (stdout_callback) {
+                stdout_callback(boost::string_ref(stdout_buffer));
+                stdout_buffer.clear();
+            }
+        }
+        // Log the last line of output for stderr
+        if (!stderr_buffer.empty()) {
+            if (LOG_IS_DEBUG_ENABLED()) {
+                log(stderr_logger, log_level::debug, 0, stderr_buffer);
+            }
+            if (stderr_callback) {
+                stderr_callback(boost::string_ref(stderr_buffer));
+                stderr_buffer.clear();
+            }
+        }
+        return make_tuple(move(stdout_buffer), move(stderr_buffer));
+    }
+
 }}  // namespace leatherman::execution
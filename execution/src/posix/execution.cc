@@ -1,5 +1,6 @@
 #include <leatherman/execution/execution.hpp>
 #include <leatherman/file_util/directory.hpp>
+#include <leatherman/util/profiler.hpp>
 #include <leatherman/util/scope_exit.hpp>
 #include <leatherman/util/posix/scoped_descriptor.hpp>
 #include <leatherman/logging/logging.hpp>
@@ -7,14 +8,27 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
 
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <sys/time.h>
+#include <sys/resource.h>
 #include <fcntl.h>
 #include <signal.h>
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+#include <sys/event.h>
+#endif
+
 #include "platform.hpp"
 
 // Mark string for translation (alias for leatherman::locale::format)
@@ -36,6 +50,10 @@ namespace leatherman { namespace execution {
 
     void log_execution(string const& file, vector<string> const* arguments);
 
+    // Hooks into the command statistics registry (see src/execution.cc).
+    bool command_statistics_enabled();
+    void record_command_stats(string const& executable, chrono::microseconds wall_time, bool success);
+
     const char *const command_shell = "sh";
     const char *const command_args = "-c";
 
@@ -68,13 +86,6 @@ namespace leatherman { namespace execution {
 #endif  // OPEN_MAX
     }
 
-    static volatile bool command_timedout = false;
-
-    static void timer_handler(int signal)
-    {
-        command_timedout = true;
-    }
-
     string format_error(string const& message, int error)
     {
         if (message.empty()) {
@@ -160,8 +171,17 @@ namespace leatherman { namespace execution {
         return contains(data, "builtin");
     }
 
+    // Defined in execution.cc
+    bool resolution_cache_lookup(string const& file, vector<string> const& directories, bool expand, string& result);
+    void resolution_cache_store(string const& file, vector<string> const& directories, bool expand, string const& result);
+
     string which(string const& file, vector<string> const& directories, bool expand)
     {
+        string cached;
+        if (resolution_cache_lookup(file, directories, expand, cached)) {
+            return cached;
+        }
+
         // if it is builtin, just return it
         if ( !expand && is_builtin(file) ) {
             return file;
@@ -178,6 +198,7 @@ namespace leatherman { namespace execution {
         for (auto const& dir : directories) {
             path p = path(dir) / file;
             if (is_regular_file(p, ec) && is_executable(p.c_str())) {
+                resolution_cache_store(file, directories, expand, p.string());
                 return p.string();
             }
         }
@@ -205,19 +226,309 @@ namespace leatherman { namespace execution {
         {
         }
 
+        // cppcheck-suppress passedByValue
+        pipe(string pipe_name, scoped_descriptor desc, int sink_fd) :
+            name(move(pipe_name)),
+            descriptor(move(desc)),
+            read(true),
+            sink(sink_fd)
+        {
+        }
+
         const string name;
         scoped_descriptor descriptor;
         string buffer;
         function<bool(string const&)> callback;
         bool read;
+        // When set, data read from the pipe is forwarded to this
+        // descriptor instead of being handed to the callback.
+        int sink = -1;
+        // When set on a write pipe, the buffer is refilled from this
+        // callback as the child drains it; the callback returning false
+        // or leaving the buffer empty ends the input.
+        function<bool(string&)> source;
+        // The current read size; doubled up to a 256 KB ceiling each time a
+        // read fills the buffer, so chatty commands keep small reads while
+        // bulk producers amortize the syscall cost.
+        size_t read_size = 4096;
     };
 
+    // The outcome of one i/o attempt on a ready pipe.
+    enum class pipe_io
+    {
+        // Data was transferred, or the operation should be retried.
+        progressed,
+        // The pipe was closed and its descriptor released.
+        closed,
+        // A read callback signaled that processing is complete.
+        finished
+    };
+
+    // Forwards data from a pipe directly to its sink descriptor without
+    // any line processing. On Linux this moves the data in-kernel with
+    // splice(2); elsewhere (or when the sink does not support splicing,
+    // e.g. certain filesystems) it falls back to a plain copy-through.
+    static pipe_io do_sink_io(pipe& pipe)
+    {
+#ifdef __linux__
+        static bool splice_supported = true;
+        if (splice_supported) {
+            auto count = splice(pipe.descriptor, nullptr, pipe.sink, nullptr, 256 * 1024, SPLICE_F_MOVE);
+            if (count < 0) {
+                if (errno == EINTR || errno == EAGAIN) {
+                    return pipe_io::progressed;
+                } else if (errno != EINVAL) {
+                    throw execution_exception(_("{1} pipe i/o failed: {2}", pipe.name, format_error()));
+                }
+                // EINVAL: the sink can't be spliced to; use the copy-through path
+                splice_supported = false;
+            } else if (count == 0) {
+                pipe.descriptor = {};
+                return pipe_io::closed;
+            } else {
+                return pipe_io::progressed;
+            }
+        }
+#endif
+        char buffer[65536];
+        auto count = read(pipe.descriptor, buffer, sizeof(buffer));
+        if (count < 0) {
+            if (errno == EINTR) {
+                return pipe_io::progressed;
+            }
+            throw execution_exception(_("{1} pipe i/o failed: {2}", pipe.name, format_error()));
+        } else if (count == 0) {
+            pipe.descriptor = {};
+            return pipe_io::closed;
+        }
+        ssize_t written = 0;
+        while (written < count) {
+            auto result = write(pipe.sink, buffer + written, count - written);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw execution_exception(_("failed to write {1} output to file: {2}", pipe.name, format_error()));
+            }
+            written += result;
+        }
+        return pipe_io::progressed;
+    }
+
+    static pipe_io do_pipe_io(pipe& pipe, bool allow_stdin_unread)
+    {
+        if (pipe.read && pipe.sink != -1) {
+            return do_sink_io(pipe);
+        }
+
+        if (pipe.read) {
+            pipe.buffer.resize(pipe.read_size);
+        } else if (pipe.source && pipe.buffer.empty()) {
+            // Pull the next chunk of input; an exhausted source ends stdin
+            if (!pipe.source(pipe.buffer) || pipe.buffer.empty()) {
+                pipe.descriptor = {};
+                return pipe_io::closed;
+            }
+        }
+
+        // There is data to read/write
+        auto count = pipe.read ?
+            read(pipe.descriptor, &pipe.buffer[0], pipe.buffer.size()) :
+            write(pipe.descriptor, pipe.buffer.c_str(), pipe.buffer.size());
+        if (count < 0) {
+            if (allow_stdin_unread && !pipe.read && errno == EPIPE) {
+                // Input pipe was closed prematurely due to process exit, log and let it go.
+                LOG_DEBUG("{1} pipe i/o was closed early, process may have ignored input.", pipe.name);
+                pipe.descriptor = {};
+                return pipe_io::closed;
+            } else if (errno == EINTR) {
+                // Interrupted by signal
+                LOG_DEBUG("{1} pipe i/o was interrupted and will be retried.", pipe.name);
+                return pipe_io::progressed;
+            }
+            throw execution_exception(_("{1} pipe i/o failed: {2}", pipe.name, format_error()));
+        } else if (count == 0) {
+            // Pipe has closed
+            pipe.descriptor = {};
+            return pipe_io::closed;
+        }
+
+        if (pipe.read) {
+            // A full buffer suggests more data is queued; grow the next read
+            if (static_cast<size_t>(count) == pipe.read_size && pipe.read_size < 256 * 1024) {
+                pipe.read_size *= 2;
+            }
+            // Call the callback
+            pipe.buffer.resize(count);
+            if (!pipe.callback(pipe.buffer)) {
+                // Callback signaled that we're done
+                return pipe_io::finished;
+            }
+        } else {
+            // Register written data
+            pipe.buffer.erase(0, count);
+        }
+        return pipe_io::progressed;
+    }
+
+#if defined(__linux__)
+    // epoll backend: descriptors are registered once instead of
+    // rebuilding fd_sets on every iteration, there is no FD_SETSIZE
+    // ceiling, and timeouts are driven by a one-shot timerfd so an
+    // idle wait does not wake until the child produces data, the
+    // command times out, or a signal arrives.
+    static void rw_from_child(pid_t child, array<pipe, 3>& pipes, uint32_t timeout, bool allow_stdin_unread)
+    {
+        scoped_descriptor epoll_fd(epoll_create1(EPOLL_CLOEXEC));
+        if (epoll_fd == -1) {
+            throw execution_exception(format_error(_("failed to create epoll instance for child i/o")));
+        }
+
+        int active = 0;
+        for (auto& pipe : pipes) {
+            if (pipe.descriptor == -1) {
+                continue;
+            }
+            epoll_event event = {};
+            event.events = pipe.read ? EPOLLIN : EPOLLOUT;
+            event.data.ptr = &pipe;
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe.descriptor, &event) == -1) {
+                throw execution_exception(_("failed to register {1} pipe for child i/o: {2}", pipe.name, format_error()));
+            }
+            ++active;
+        }
+
+        scoped_descriptor timer(-1);
+        if (timeout) {
+            timer = scoped_descriptor(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC));
+            if (timer == -1) {
+                throw execution_exception(format_error(_("failed to create timer for command timeout")));
+            }
+            itimerspec expiration = {};
+            expiration.it_value.tv_sec = static_cast<time_t>(timeout);
+            if (timerfd_settime(timer, 0, &expiration, nullptr) == -1) {
+                throw execution_exception(format_error(_("failed to arm timer for command timeout")));
+            }
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            // A null pointer marks the timer descriptor
+            event.data.ptr = nullptr;
+            if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer, &event) == -1) {
+                throw execution_exception(format_error(_("failed to register timer for command timeout")));
+            }
+        }
+
+        array<epoll_event, 4> events;
+        while (active > 0) {
+            int count = epoll_wait(epoll_fd, events.data(), events.size(), -1);
+            if (count == -1) {
+                if (errno != EINTR) {
+                    throw execution_exception(format_error(_("epoll_wait call failed waiting for child i/o")));
+                }
+                // Interrupted by signal
+                LOG_DEBUG("epoll_wait call was interrupted and will be retried.");
+                continue;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                if (!events[i].data.ptr) {
+                    // The timeout timer fired
+                    // cppcheck-suppress zerodivcond - http://trac.cppcheck.net/ticket/5402
+                    throw timeout_exception(_("command timed out after {1} seconds.", timeout), static_cast<size_t>(child));
+                }
+                auto& pipe = *static_cast<struct pipe*>(events[i].data.ptr);
+                if (pipe.descriptor == -1) {
+                    continue;
+                }
+                switch (do_pipe_io(pipe, allow_stdin_unread)) {
+                    case pipe_io::closed:
+                        // Closing the descriptor removed it from the epoll set
+                        --active;
+                        break;
+                    case pipe_io::finished:
+                        return;
+                    case pipe_io::progressed:
+                        break;
+                }
+            }
+        }
+    }
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+    // kqueue backend, equivalent to the epoll one above; timeouts are
+    // driven by a one-shot EVFILT_TIMER event.
+    static void rw_from_child(pid_t child, array<pipe, 3>& pipes, uint32_t timeout, bool allow_stdin_unread)
+    {
+        scoped_descriptor queue(kqueue());
+        if (queue == -1) {
+            throw execution_exception(format_error(_("failed to create kqueue for child i/o")));
+        }
+
+        array<struct kevent, 4> changes;
+        size_t num_changes = 0;
+        int active = 0;
+        for (auto& pipe : pipes) {
+            if (pipe.descriptor == -1) {
+                continue;
+            }
+            EV_SET(&changes[num_changes++], pipe.descriptor, pipe.read ? EVFILT_READ : EVFILT_WRITE, EV_ADD, 0, 0, &pipe);
+            ++active;
+        }
+        if (timeout) {
+            // One-shot timer; the data unit defaults to milliseconds
+            EV_SET(&changes[num_changes++], 1, EVFILT_TIMER, EV_ADD | EV_ONESHOT, 0, static_cast<int64_t>(timeout) * 1000, nullptr);
+        }
+        if (kevent(queue, changes.data(), num_changes, nullptr, 0, nullptr) == -1) {
+            throw execution_exception(format_error(_("failed to register child i/o events with kqueue")));
+        }
+
+        array<struct kevent, 4> events;
+        while (active > 0) {
+            int count = kevent(queue, nullptr, 0, events.data(), events.size(), nullptr);
+            if (count == -1) {
+                if (errno != EINTR) {
+                    throw execution_exception(format_error(_("kevent call failed waiting for child i/o")));
+                }
+                // Interrupted by signal
+                LOG_DEBUG("kevent call was interrupted and will be retried.");
+                continue;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                if (events[i].filter == EVFILT_TIMER) {
+                    // The timeout timer fired
+                    // cppcheck-suppress zerodivcond - http://trac.cppcheck.net/ticket/5402
+                    throw timeout_exception(_("command timed out after {1} seconds.", timeout), static_cast<size_t>(child));
+                }
+                auto& pipe = *static_cast<struct pipe*>(events[i].udata);
+                if (pipe.descriptor == -1) {
+                    continue;
+                }
+                switch (do_pipe_io(pipe, allow_stdin_unread)) {
+                    case pipe_io::closed:
+                        // Closing the descriptor removed it from the kqueue
+                        --active;
+                        break;
+                    case pipe_io::finished:
+                        return;
+                    case pipe_io::progressed:
+                        break;
+                }
+            }
+        }
+    }
+#else
+    // select() fallback for platforms without epoll or kqueue; the
+    // timeout is a per-execution deadline handed to select directly, so
+    // an idle wait does not wake until the child produces data, the
+    // command times out, or a signal arrives.
     static void rw_from_child(pid_t child, array<pipe, 3>& pipes, uint32_t timeout, bool allow_stdin_unread)
     {
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(timeout);
+
         // Each pipe is a tuple of descriptor, buffer to use to read data, and a callback to call when data is read
         // The input pair is a descriptor and text to write to it
         fd_set read_set, write_set;
-        while (!command_timedout) {
+        while (true) {
             FD_ZERO(&read_set);
             FD_ZERO(&write_set);
 
@@ -232,10 +543,6 @@ namespace leatherman { namespace execution {
                 if (pipe.descriptor > max) {
                     max = pipe.descriptor;
                 }
-
-                if (pipe.read) {
-                    pipe.buffer.resize(4096);
-                }
             }
 
             if (max == -1) {
@@ -243,9 +550,17 @@ namespace leatherman { namespace execution {
                 return;
             }
 
-            // If using a timeout, timeout after 500ms to check whether or not the command itself timed out
+            // If using a timeout, wait no longer than the time remaining until the deadline
             timeval read_timeout = {};
-            read_timeout.tv_usec = 500000;
+            if (timeout) {
+                auto remaining = chrono::duration_cast<chrono::microseconds>(deadline - chrono::steady_clock::now()).count();
+                if (remaining <= 0) {
+                    // cppcheck-suppress zerodivcond - http://trac.cppcheck.net/ticket/5402
+                    throw timeout_exception(_("command timed out after {1} seconds.", timeout), static_cast<size_t>(child));
+                }
+                read_timeout.tv_sec = static_cast<decltype(read_timeout.tv_sec)>(remaining / 1000000);
+                read_timeout.tv_usec = static_cast<decltype(read_timeout.tv_usec)>(remaining % 1000000);
+            }
             int result = select(max + 1, &read_set, &write_set, nullptr, timeout ? &read_timeout : nullptr);
             if (result == -1) {
                 if (errno != EINTR) {
@@ -255,55 +570,22 @@ namespace leatherman { namespace execution {
                 LOG_DEBUG("select call was interrupted and will be retried.");
                 continue;
             } else if (result == 0) {
-                // Read timeout, try again
-                continue;
+                // The deadline passed while waiting
+                // cppcheck-suppress zerodivcond - http://trac.cppcheck.net/ticket/5402
+                throw timeout_exception(_("command timed out after {1} seconds.", timeout), static_cast<size_t>(child));
             }
 
             for (auto& pipe : pipes) {
                 if (pipe.descriptor == -1 || !FD_ISSET(pipe.descriptor, pipe.read ? &read_set : &write_set)) {
                     continue;
                 }
-
-                // There is data to read/write
-                auto count = pipe.read ?
-                    read(pipe.descriptor, &pipe.buffer[0], pipe.buffer.size()) :
-                    write(pipe.descriptor, pipe.buffer.c_str(), pipe.buffer.size());
-                if (count < 0) {
-                    if (allow_stdin_unread && !pipe.read && errno == EPIPE) {
-                        // Input pipe was closed prematurely due to process exit, log and let it go.
-                        LOG_DEBUG("{1} pipe i/o was closed early, process may have ignored input.", pipe.name);
-                        pipe.descriptor = {};
-                        continue;
-                    } else if (errno == EINTR) {
-                        // Interrupted by signal
-                        LOG_DEBUG("{1} pipe i/o was interrupted and will be retried.", pipe.name);
-                        continue;
-                    }
-                    throw execution_exception(_("{1} pipe i/o failed: {2}", pipe.name, format_error()));
-                } else if (count == 0) {
-                    // Pipe has closed
-                    pipe.descriptor = {};
-                    continue;
-                }
-
-                if (pipe.read) {
-                    // Call the callback
-                    pipe.buffer.resize(count);
-                    if (!pipe.callback(pipe.buffer)) {
-                        // Callback signaled that we're done
-                        return;
-                    }
-                } else {
-                    // Register written data
-                    pipe.buffer.erase(0, count);
+                if (do_pipe_io(pipe, allow_stdin_unread) == pipe_io::finished) {
+                    return;
                 }
             }
         }
-
-        // Should only reach here if the command timed out
-        // cppcheck-suppress zerodivcond - http://trac.cppcheck.net/ticket/5402
-        throw timeout_exception(_("command timed out after {1} seconds.", timeout), static_cast<size_t>(child));
     }
+#endif
 
     static void do_exec_child(int in_fd, int out_fd, int err_fd, uint64_t max_fd, char const* program, char const** argv, char const** envp)
     {
@@ -343,23 +625,35 @@ namespace leatherman { namespace execution {
 #ifdef HAS_CLOSEFROM
         closefrom(STDERR_FILENO + 1);
 #else
-        uint64_t fd;
-        const char* fdpath = "/proc/self/fd";
-        std::list<uint64_t> fd_list;
-
-        if (is_directory(fdpath)) {
-            for (const directory_entry& dent : directory_iterator(fdpath)) {
-                fd = atol(dent.path().filename().c_str());
-                if (fd >= (STDERR_FILENO + 1)) {
-                    fd_list.push_back(fd);
+        bool descriptors_closed = false;
+#if defined(__linux__) && defined(SYS_close_range)
+        // A single close_range syscall covers the whole range and is
+        // O(open descriptors) in the kernel regardless of the nofile
+        // limit; it's also vfork-safe (no heap, no libc state), unlike
+        // the directory walk below. Called via syscall(2) since the
+        // glibc wrapper is newer than some of our build roots. Fails
+        // with ENOSYS on pre-5.9 kernels; fall back to the walk there.
+        descriptors_closed = syscall(SYS_close_range, static_cast<unsigned int>(STDERR_FILENO + 1), ~0u, 0u) == 0;
+#endif
+        if (!descriptors_closed) {
+            uint64_t fd;
+            const char* fdpath = "/proc/self/fd";
+            std::list<uint64_t> fd_list;
+
+            if (is_directory(fdpath)) {
+                for (const directory_entry& dent : directory_iterator(fdpath)) {
+                    fd = atol(dent.path().filename().c_str());
+                    if (fd >= (STDERR_FILENO + 1)) {
+                        fd_list.push_back(fd);
+                    }
+                }
+                for (auto fd : fd_list) {
+                    close(fd);
+                }
+            } else {
+                for (uint64_t i = (STDERR_FILENO + 1); i < max_fd; ++i) {
+                    close(i);
                 }
-            }
-            for (auto fd : fd_list) {
-                close(fd);
-            }
-        } else {
-            for (uint64_t i = (STDERR_FILENO + 1); i < max_fd; ++i) {
-                close(i);
             }
         }
 #endif  // HAS_CLOSEFROM
@@ -401,7 +695,7 @@ namespace leatherman { namespace execution {
 
     // Helper function that creates a vector of environment variables in the format of key=value
     // Also handles merging of environment and defaulting LC_ALL and LANG to C
-    static vector<string> create_environment(map<string, string> const* environment, bool merge, bool inherit)
+    static vector<string> build_environment(map<string, string> const* environment, bool merge, bool inherit)
     {
         vector<string> result;
 
@@ -442,6 +736,40 @@ namespace leatherman { namespace execution {
         return result;
     }
 
+    // Returns the environment block for a child process. When no per-call
+    // variables are given the flattened block is fully determined by the
+    // parent environment, so it is cached and handed out as shared state;
+    // rebuilding it on every exec costs an allocation per variable. The
+    // cache is invalidated when the environment generation counter changes,
+    // i.e. whenever the environment is modified through leatherman::util::environment.
+    static shared_ptr<vector<string> const> create_environment(map<string, string> const* environment, bool merge, bool inherit)
+    {
+        if (environment && !environment->empty()) {
+            return make_shared<vector<string> const>(build_environment(environment, merge, inherit));
+        }
+
+        static struct
+        {
+            mutex lock;
+            size_t generation = 0;
+            shared_ptr<vector<string> const> blocks[4];
+        } cache;
+
+        lock_guard<mutex> lock(cache.lock);
+        auto generation = environment::generation();
+        if (generation != cache.generation) {
+            for (auto& block : cache.blocks) {
+                block.reset();
+            }
+            cache.generation = generation;
+        }
+        auto& block = cache.blocks[(merge ? 2 : 0) + (inherit ? 1 : 0)];
+        if (!block) {
+            block = make_shared<vector<string> const>(build_environment(nullptr, merge, inherit));
+        }
+        return block;
+    }
+
     result execute(
         string const& file,
         vector<string> const* arguments,
@@ -451,8 +779,33 @@ namespace leatherman { namespace execution {
         function<bool(string&)> const& stdout_callback,
         function<bool(string&)> const& stderr_callback,
         option_set<execution_options> const& options,
-        uint32_t timeout)
+        uint32_t timeout,
+        capture_policy const* capture,
+        int out_fd,
+        int err_fd,
+        function<bool(string&)> const* input_source,
+        function<bool(boost::string_ref)> const* stdout_view_callback,
+        function<bool(boost::string_ref)> const* stderr_view_callback)
     {
+        LTH_PROFILE_SCOPE("execution.execute");
+
+        // Statistics collection is opt-in; start the clock before executable
+        // resolution so spawn latency includes the PATH search and pipe setup.
+        unique_ptr<result_stats> stats;
+        chrono::steady_clock::time_point stats_start;
+        if (options[execution_options::collect_statistics]) {
+            stats.reset(new result_stats());
+            stats_start = chrono::steady_clock::now();
+        }
+
+        // When the command statistics registry is enabled, time every
+        // execution regardless of the collect_statistics option.
+        bool record_stats = command_statistics_enabled();
+        chrono::steady_clock::time_point record_start;
+        if (record_stats) {
+            record_start = chrono::steady_clock::now();
+        }
+
         // Search for the executable
         string executable = which(file);
         log_execution(executable.empty() ? file : executable, arguments);
@@ -464,6 +817,17 @@ namespace leatherman { namespace execution {
             return {false, "", "", 127, 0};
         }
 
+        // Best-effort enlargement of a pipe's kernel buffer: fewer wakeups
+        // and syscalls when the child moves a lot of data. Failure (e.g.
+        // exceeding the unprivileged pipe-max-size limit) keeps the default.
+        auto enlarge_pipe = [](int fd) {
+#ifdef F_SETPIPE_SZ
+            fcntl(fd, F_SETPIPE_SZ, 256 * 1024);
+#else
+            static_cast<void>(fd);
+#endif
+        };
+
         // Create the pipes for stdin/stdout redirection
         int pipes[2];
         if (::pipe(pipes) < 0) {
@@ -471,12 +835,14 @@ namespace leatherman { namespace execution {
         }
         scoped_descriptor stdin_read(pipes[0]);
         scoped_descriptor stdin_write(pipes[1]);
+        enlarge_pipe(stdin_write);
 
         if (::pipe(pipes) < 0) {
             throw execution_exception(format_error(_("failed to allocate pipe for stdout redirection")));
         }
         scoped_descriptor stdout_read(pipes[0]);
         scoped_descriptor stdout_write(pipes[1]);
+        enlarge_pipe(stdout_read);
 
         // Redirect stderr to stdout, null, or to the pipe to read
         scoped_descriptor stderr_read(-1);
@@ -494,6 +860,7 @@ namespace leatherman { namespace execution {
             }
             stderr_read = scoped_descriptor(pipes[0]);
             stderr_write = scoped_descriptor(pipes[1]);
+            enlarge_pipe(stderr_read);
             child_stderr = stderr_write;
         }
 
@@ -502,7 +869,7 @@ namespace leatherman { namespace execution {
         auto variables = create_environment(environment,
                                             options[execution_options::merge_environment],
                                             options[execution_options::inherit_locale]);
-        auto envp = to_exec_arg(&variables);
+        auto envp = to_exec_arg(variables.get());
 
         // Create the child
         pid_t child = create_child(options,
@@ -510,8 +877,22 @@ namespace leatherman { namespace execution {
                                    get_max_descriptor_limit(),
                                    executable.c_str(), args.data(), envp.data());
 
+        if (stats) {
+            stats->spawn_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+        }
+
+#if defined(__linux__) && defined(SYS_pidfd_open) && defined(P_PIDFD)
+        // Acquire a pidfd for the child so it can be reaped through the
+        // descriptor: waitid on a pidfd can never target a recycled pid,
+        // so a host application reaping children from another thread
+        // (e.g. a stray wait(-1) in a SIGCHLD handler) cannot redirect
+        // our reap to somebody else's child. pidfd_open fails with
+        // ENOSYS before kernel 5.3; the waitpid path below covers that.
+        scoped_descriptor child_pidfd(static_cast<int>(syscall(SYS_pidfd_open, child, 0)));
+#endif
+
         // Close the unused descriptors
-        if (!input) {
+        if (!input && !input_source) {
             stdin_write.release();
         }
         stdin_read.release();
@@ -524,12 +905,37 @@ namespace leatherman { namespace execution {
         bool success = false;
         bool signaled = false;
         int status = 0;
+        struct rusage child_usage {};
         scope_exit reaper([&]() {
             if (kill_child) {
                 kill(-child, SIGKILL);
             }
-            // Wait for the child to exit
-            while (waitpid(child, &status, 0) == -1) {
+#if defined(__linux__) && defined(SYS_pidfd_open) && defined(P_PIDFD)
+            // Prefer the race-free pidfd reap; the wait4 path is kept for
+            // statistics collection since waitid does not report rusage.
+            if (!stats && child_pidfd != -1) {
+                siginfo_t info = {};
+                while (waitid(P_PIDFD, static_cast<id_t>(static_cast<int>(child_pidfd)), &info, WEXITED) == -1) {
+                    if (errno == EINTR) {
+                        LOG_DEBUG(format_error(_("waitid was interrupted by a signal, retrying")));
+                        continue;
+                    }
+                    LOG_DEBUG(format_error(_("waitid failed")));
+                    return;
+                }
+                if (info.si_code == CLD_EXITED) {
+                    status = static_cast<char>(info.si_status);
+                    success = status == 0;
+                } else if (info.si_code == CLD_KILLED || info.si_code == CLD_DUMPED) {
+                    signaled = true;
+                    status = static_cast<char>(info.si_status);
+                }
+                return;
+            }
+#endif
+            // Wait for the child to exit; when collecting statistics, use
+            // wait4 so the child's resource usage is harvested with the reap.
+            while ((stats ? wait4(child, &status, 0, &child_usage) : waitpid(child, &status, 0)) == -1) {
                 if ( errno == EINTR ) {
                     LOG_DEBUG(format_error(_("waitpid was interrupted by a signal, retrying")));
                     continue;
@@ -550,29 +956,10 @@ namespace leatherman { namespace execution {
             }
         });
 
-        // Set up an interval timer for timeouts
-        // Note: OSX doesn't implement POSIX per-process timers, so we're stuck with the obsolete POSIX timers API
-        scope_exit timer_reset;
-        if (timeout) {
-            struct sigaction sa = {};
-            sa.sa_handler = timer_handler;
-            if (sigaction(SIGALRM, &sa, nullptr) == -1) {
-                throw execution_exception(format_error(_("sigaction failed while setting up timeout")));
-            }
-
-            itimerval timer = {};
-            timer.it_value.tv_sec = static_cast<decltype(timer.it_interval.tv_sec)>(timeout);
-            if (setitimer(ITIMER_REAL, &timer, nullptr) == -1) {
-                throw execution_exception(format_error(_("setitimer failed while setting up timeout")));
-            }
-
-            // Set the resource to disable the timer
-            timer_reset = scope_exit([&]() {
-                itimerval timer = {};
-                setitimer(ITIMER_REAL, &timer, nullptr);
-                command_timedout = false;
-            });
-        }
+        // Timeouts are per-execution deadlines handled inside rw_from_child
+        // (timerfd on Linux, EVFILT_TIMER on kqueue platforms, and the select
+        // timeout otherwise), so no process-wide interval timer or SIGALRM
+        // handler is needed and concurrent timed executions don't interfere.
 
         // Execute the PID callback
         if (pid_callback) {
@@ -585,15 +972,50 @@ namespace leatherman { namespace execution {
         // It provides two callbacks of its own to call when there's data available on stdout/stderr
         // We return from the lambda when all data has been read
         string output, error;
-        tie(output, error) = process_streams(options[execution_options::trim_output], stdout_callback, stderr_callback, [&](function<bool(string const&)> const& process_stdout, function<bool(string const&)> const& process_stderr) {
+        auto read_streams = [&](function<bool(string const&)> const& process_stdout, function<bool(string const&)> const& process_stderr) {
+            // When collecting statistics, interpose on the stream callbacks to
+            // record time-to-first-output and per-stream byte counts. Output
+            // routed straight to a descriptor sink bypasses these callbacks
+            // and is not counted.
+            function<bool(string const&)> counted_stdout, counted_stderr;
+            if (stats) {
+                counted_stdout = [&](string const& data) {
+                    if (stats->first_output_time.count() == 0) {
+                        stats->first_output_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+                    }
+                    stats->stdout_bytes += data.size();
+                    return process_stdout(data);
+                };
+                counted_stderr = [&](string const& data) {
+                    if (stats->first_output_time.count() == 0) {
+                        stats->first_output_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+                    }
+                    stats->stderr_bytes += data.size();
+                    return process_stderr(data);
+                };
+            }
             array<pipe, 3> pipes = { {
-                pipe("stdout", move(stdout_read), process_stdout),
-                pipe("stderr", move(stderr_read), process_stderr),
-                input ? pipe("stdin", move(stdin_write), *input) : pipe("", {}, "")
+                out_fd == -1 ? pipe("stdout", move(stdout_read), stats ? counted_stdout : process_stdout) : pipe("stdout", move(stdout_read), out_fd),
+                err_fd == -1 ? pipe("stderr", move(stderr_read), stats ? counted_stderr : process_stderr) : pipe("stderr", move(stderr_read), err_fd),
+                input || input_source ? pipe("stdin", move(stdin_write), input ? *input : string()) : pipe("", {}, "")
             }};
+            if (input_source) {
+                pipes[2].source = *input_source;
+            }
 
             rw_from_child(child, pipes, timeout, options[execution_options::allow_stdin_unread]);
-        });
+        };
+        if (capture) {
+            tie(output, error) = process_streams(options[execution_options::trim_output], *capture, read_streams);
+        } else if (stdout_view_callback || stderr_view_callback) {
+            static const function<bool(boost::string_ref)> no_view_callback;
+            tie(output, error) = process_streams(options[execution_options::trim_output],
+                                                 stdout_view_callback ? *stdout_view_callback : no_view_callback,
+                                                 stderr_view_callback ? *stderr_view_callback : no_view_callback,
+                                                 read_streams);
+        } else {
+            tie(output, error) = process_streams(options[execution_options::trim_output], stdout_callback, stderr_callback, read_streams);
+        }
 
         // Close the read pipes
         // If the child hasn't sent all the data yet, this may signal SIGPIPE on next write
@@ -604,12 +1026,28 @@ namespace leatherman { namespace execution {
         kill_child = false;
         reaper.invoke();
 
+        if (stats) {
+            stats->wall_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+            // ru_maxrss is in kilobytes on most platforms, but bytes on macOS.
+#ifdef __APPLE__
+            stats->max_rss_kb = static_cast<uint64_t>(child_usage.ru_maxrss) / 1024;
+#else
+            stats->max_rss_kb = static_cast<uint64_t>(child_usage.ru_maxrss);
+#endif
+            stats->user_cpu = chrono::microseconds(static_cast<int64_t>(child_usage.ru_utime.tv_sec) * 1000000 + child_usage.ru_utime.tv_usec);
+            stats->system_cpu = chrono::microseconds(static_cast<int64_t>(child_usage.ru_stime.tv_sec) * 1000000 + child_usage.ru_stime.tv_usec);
+        }
+
         if (signaled) {
             LOG_DEBUG("process was signaled with signal {1}.", status);
         } else {
             LOG_DEBUG("process exited with status code {1}.", status);
         }
 
+        if (record_stats) {
+            record_command_stats(executable, chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - record_start), success);
+        }
+
         // Throw exception if needed
         if (!success) {
             if (!signaled && status != 0 && options[execution_options::throw_on_nonzero_exit]) {
@@ -619,7 +1057,9 @@ namespace leatherman { namespace execution {
                 throw child_signal_exception(_("child process was terminated by signal ({1}).", status), status, move(output), move(error));
             }
         }
-        return {success, move(output), move(error), status, static_cast<size_t>(child)};
+        result res{success, move(output), move(error), status, static_cast<size_t>(child)};
+        res.stats = shared_ptr<result_stats const>(stats.release());
+        return res;
     }
 
 }}  // namespace leatherman::execution
@@ -2,11 +2,79 @@
 #include <leatherman/locale/locale.hpp>
 #include "../platform.hpp"
 
+#ifdef HAS_POSIX_SPAWN_CLOSEFROM
+#include <spawn.h>
+#endif
+
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
 
 namespace leatherman { namespace execution {
 
+#ifdef HAS_POSIX_SPAWN_CLOSEFROM
+    pid_t create_child(leatherman::util::option_set<execution_options> const& options,
+                       int in_fd, int out_fd, int err_fd, uint64_t max_fd,
+                       char const* program, char const** argv, char const** envp)
+    {
+        // Launch via posix_spawn: everything the fork path did by hand
+        // (process group, descriptor redirection, closing inherited
+        // descriptors) maps onto spawn attributes and file actions.
+        // Unlike fork, spawning does not scale with the parent's
+        // address space, and unlike vfork it is safe to call from
+        // multithreaded processes, so the thread_safe option no longer
+        // selects a slower path.
+        posix_spawnattr_t attrs;
+        posix_spawn_file_actions_t actions;
+        int error = posix_spawnattr_init(&attrs);
+        if (error == 0) {
+            error = posix_spawn_file_actions_init(&actions);
+            if (error != 0) {
+                posix_spawnattr_destroy(&attrs);
+            }
+        }
+        if (error != 0) {
+            throw execution_exception(format_error(_("failed to initialize posix_spawn attributes"), error));
+        }
+
+        // Put the child in its own process group; this will be used by
+        // the parent if we need to kill the process and its children
+        if (error == 0) {
+            error = posix_spawnattr_setpgroup(&attrs, 0);
+        }
+        if (error == 0) {
+            error = posix_spawnattr_setflags(&attrs, POSIX_SPAWN_SETPGROUP);
+        }
+
+        // Redirect stdin, stdout, and stderr, then close all open file
+        // descriptors above stderr
+        if (error == 0) {
+            error = posix_spawn_file_actions_adddup2(&actions, in_fd, STDIN_FILENO);
+        }
+        if (error == 0) {
+            error = posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO);
+        }
+        if (error == 0) {
+            error = posix_spawn_file_actions_adddup2(&actions, err_fd, STDERR_FILENO);
+        }
+        if (error == 0) {
+            error = posix_spawn_file_actions_addclosefrom_np(&actions, STDERR_FILENO + 1);
+        }
+
+        pid_t pid = -1;
+        if (error == 0) {
+            error = posix_spawn(&pid, program, &actions, &attrs,
+                                const_cast<char* const*>(argv), const_cast<char* const*>(envp));
+        }
+
+        posix_spawn_file_actions_destroy(&actions);
+        posix_spawnattr_destroy(&attrs);
+
+        if (error != 0) {
+            throw execution_exception(format_error(_("failed to spawn child process"), error));
+        }
+        return pid;
+    }
+#else
     pid_t create_child(leatherman::util::option_set<execution_options> const& options,
                        int in_fd, int out_fd, int err_fd, uint64_t max_fd,
                        char const* program, char const** argv, char const** envp)
@@ -26,5 +94,6 @@ namespace leatherman { namespace execution {
 
         return pid;
     }
+#endif  // HAS_POSIX_SPAWN_CLOSEFROM
 
 }}  // namespace leatherman::execution
@@ -0,0 +1,247 @@
+#include <leatherman/execution/process_pool.hpp>
+#include <leatherman/util/posix/scoped_descriptor.hpp>
+#include <leatherman/util/scope_exit.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <leatherman/locale/locale.hpp>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#include "platform.hpp"
+
+// Mark string for translation (alias for leatherman::locale::format)
+using leatherman::locale::_;
+
+using namespace std;
+using namespace leatherman::util;
+using namespace leatherman::util::posix;
+using namespace leatherman::logging;
+
+// Declare environ for OSX
+extern char** environ;
+
+namespace leatherman { namespace execution {
+
+    // Delimits the exit status a worker reports after each command; chosen
+    // because it cannot appear in line-oriented text output.
+    static const char status_sentinel = '\x01';
+
+    struct process_pool::worker
+    {
+        pid_t pid = -1;
+        scoped_descriptor input;
+        scoped_descriptor output;
+        bool busy = false;
+    };
+
+    void process_pool::spawn_worker(worker& w)
+    {
+        string shell = which(command_shell);
+        if (shell.empty()) {
+            throw execution_exception(_("{1} was not found on the PATH.", command_shell));
+        }
+
+        int pipes[2];
+        if (::pipe(pipes) < 0) {
+            throw execution_exception(format_error(_("failed to allocate pipe for worker stdin")));
+        }
+        scoped_descriptor stdin_read(pipes[0]);
+        scoped_descriptor stdin_write(pipes[1]);
+
+        if (::pipe(pipes) < 0) {
+            throw execution_exception(format_error(_("failed to allocate pipe for worker stdout")));
+        }
+        scoped_descriptor stdout_read(pipes[0]);
+        scoped_descriptor stdout_write(pipes[1]);
+
+        auto open_max = sysconf(_SC_OPEN_MAX);
+        char const* argv[] = { command_shell, nullptr };
+
+        // A non-interactive shell executes commands as they arrive on its
+        // stdin, which is exactly the dispatch loop we need; its stderr is
+        // merged into the stdout pipe.
+        w.pid = create_child({}, stdin_read, stdout_write, stdout_write,
+                             open_max > 0 ? static_cast<uint64_t>(open_max) : 256,
+                             shell.c_str(), argv, const_cast<char const**>(environ));
+        w.input = move(stdin_write);
+        w.output = move(stdout_read);
+
+        LOG_DEBUG("spawned shell worker {1}.", w.pid);
+    }
+
+    void process_pool::terminate_worker(worker& w)
+    {
+        if (w.pid == -1) {
+            return;
+        }
+
+        // The worker runs in its own process group, so this also kills
+        // whatever command it may still be running.
+        kill(-w.pid, SIGKILL);
+        while (waitpid(w.pid, nullptr, 0) == -1 && errno == EINTR);
+
+        w.pid = -1;
+        w.input.release();
+        w.output.release();
+    }
+
+    void process_pool::write_command(worker& w, string const& message)
+    {
+        size_t written = 0;
+        while (written < message.size()) {
+            auto count = write(w.input, message.data() + written, message.size() - written);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw execution_exception(_("failed to dispatch command to shell worker: {1}", format_error()));
+            }
+            written += count;
+        }
+    }
+
+    result process_pool::read_result(worker& w, uint32_t timeout)
+    {
+        string buffer;
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(timeout);
+
+        while (true) {
+            int wait_ms = -1;
+            if (timeout) {
+                auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+                if (remaining <= 0) {
+                    // cppcheck-suppress zerodivcond - http://trac.cppcheck.net/ticket/5402
+                    throw timeout_exception(_("command timed out after {1} seconds.", timeout), static_cast<size_t>(w.pid));
+                }
+                wait_ms = static_cast<int>(remaining);
+            }
+
+            pollfd poll_fd = { w.output, POLLIN, 0 };
+            auto ready = poll(&poll_fd, 1, wait_ms);
+            if (ready == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw execution_exception(format_error(_("poll call failed waiting for shell worker output")));
+            } else if (ready == 0) {
+                // cppcheck-suppress zerodivcond - http://trac.cppcheck.net/ticket/5402
+                throw timeout_exception(_("command timed out after {1} seconds.", timeout), static_cast<size_t>(w.pid));
+            }
+
+            char chunk[4096];
+            auto count = read(w.output, chunk, sizeof(chunk));
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw execution_exception(_("failed to read shell worker output: {1}", format_error()));
+            } else if (count == 0) {
+                // The dispatched command exited the shell
+                throw execution_exception(_("shell worker exited unexpectedly."));
+            }
+            buffer.append(chunk, count);
+
+            // The worker reports "<output>\x01<status>\x01\n" once the command completes
+            if (buffer.size() < 2 || buffer[buffer.size() - 1] != '\n' || buffer[buffer.size() - 2] != status_sentinel) {
+                continue;
+            }
+            auto start = buffer.rfind(status_sentinel, buffer.size() - 3);
+            if (start == string::npos) {
+                continue;
+            }
+
+            int status = stoi(buffer.substr(start + 1, buffer.size() - 2 - start - 1));
+            string output = buffer.substr(0, start);
+            if (!output.empty() && output.back() == '\n') {
+                output.pop_back();
+            }
+            return { status == 0, move(output), "", status, static_cast<size_t>(w.pid) };
+        }
+    }
+
+    process_pool::process_pool(size_t size)
+    {
+        if (size == 0) {
+            size = 1;
+        }
+        for (size_t i = 0; i < size; i++) {
+            unique_ptr<worker> w(new worker());
+            spawn_worker(*w);
+            _workers.push_back(move(w));
+        }
+    }
+
+    process_pool::~process_pool()
+    {
+        for (auto& w : _workers) {
+            terminate_worker(*w);
+        }
+    }
+
+    result process_pool::run(string const& command, uint32_t timeout)
+    {
+        auto w = acquire();
+        scope_exit releaser([&]() { release(w); });
+
+        // The format string carries the sentinel bytes literally, so only
+        // the portable \n escape is left for the shell's printf to expand.
+        static const string status_report =
+            string("printf '") + status_sentinel + "%d" + status_sentinel + "\\n' $?\n";
+
+        try {
+            write_command(*w, command + "\n" + status_report);
+            return read_result(*w, timeout);
+        } catch (...) {
+            // Leave no partial state behind: replace the worker before
+            // handing it back to the pool.
+            terminate_worker(*w);
+            spawn_worker(*w);
+            throw;
+        }
+    }
+
+    size_t process_pool::size() const
+    {
+        lock_guard<mutex> lock(_mutex);
+        return _workers.size();
+    }
+
+    process_pool::worker* process_pool::acquire()
+    {
+        unique_lock<mutex> lock(_mutex);
+        while (true) {
+            for (auto& w : _workers) {
+                if (!w->busy) {
+                    w->busy = true;
+                    return w.get();
+                }
+            }
+            _available.wait(lock);
+        }
+    }
+
+    void process_pool::release(worker* w)
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            w->busy = false;
+        }
+        _available.notify_one();
+    }
+
+    shell_session::shell_session() :
+        _pool(1)
+    {
+    }
+
+    result shell_session::run(string const& command, uint32_t timeout)
+    {
+        return _pool.run(command, timeout);
+    }
+
+}}  // namespace leatherman::execution
@@ -39,7 +39,7 @@ using namespace std;
 
 namespace leatherman { namespace execution {
 
-    static int activate_new_contract_template(void)
+    static int configure_contract_template(void)
     {
         int tmpl_fd;
         int err;
@@ -64,11 +64,6 @@ namespace leatherman { namespace execution {
             goto close_fail;
         }
 
-        // Now make this the active template for this process
-        if ((err = ct_tmpl_activate(tmpl_fd)) != 0) {
-            goto close_fail;
-        }
-
         return tmpl_fd;
 
     close_fail:
@@ -77,6 +72,25 @@ namespace leatherman { namespace execution {
         throw execution_exception(format_error(_("failed to create process contract template"), err));
     }
 
+    static int activate_contract_template(void)
+    {
+        // The template configuration never varies between spawns, so the
+        // configured descriptor is opened once per process and reused;
+        // activating it (and clearing it after the fork) is the only
+        // per-spawn contract work left. If configuration fails the
+        // exception propagates and initialization is retried on the next
+        // spawn.
+        static const int tmpl_fd = configure_contract_template();
+        int err;
+
+        // Make the cached template the active template for this thread
+        if ((err = ct_tmpl_activate(tmpl_fd)) != 0) {
+            throw execution_exception(format_error(_("failed to activate process contract template"), err));
+        }
+
+        return tmpl_fd;
+    }
+
     static int deactivate_contract_template(int tmpl_fd)
     {
         // WARNING: this function is potentially called from a vfork'd child
@@ -89,12 +103,9 @@ namespace leatherman { namespace execution {
             return 0;
         }
 
-        // Deactivate the template
-        int err = ct_tmpl_clear(tmpl_fd);
-
-        close(tmpl_fd);
-
-        return err;
+        // Deactivate the template. The descriptor is cached for the
+        // lifetime of the process, so it is not closed here.
+        return ct_tmpl_clear(tmpl_fd);
     }
 
     // Lookup the latest child process contract ID
@@ -160,8 +171,8 @@ namespace leatherman { namespace execution {
                        char const* program, char const** argv, char const** envp)
     {
         bool detach = options[execution_options::create_detached_process];
-        // Create a new process contract template & activate it
-        int tmpl_fd = detach ? activate_new_contract_template() : -1;
+        // Activate the cached process contract template
+        int tmpl_fd = detach ? activate_contract_template() : -1;
         int err;
 
         // Fork the child process
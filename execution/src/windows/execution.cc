@@ -1,5 +1,6 @@
 #include <leatherman/execution/execution.hpp>
 #include <leatherman/util/environment.hpp>
+#include <leatherman/util/profiler.hpp>
 #include <leatherman/util/scope_exit.hpp>
 #include <leatherman/util/windows/scoped_handle.hpp>
 #include <leatherman/util/scoped_env.hpp>
@@ -18,6 +19,8 @@
 #include <sstream>
 #include <cstring>
 #include <random>
+#include <chrono>
+#include <memory>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -34,6 +37,10 @@ namespace leatherman { namespace execution {
 
     void log_execution(string const& file, vector<string> const* arguments);
 
+    // Hooks into the command statistics registry (see src/execution.cc).
+    bool command_statistics_enabled();
+    void record_command_stats(string const& executable, chrono::microseconds wall_time, bool success);
+
     const char *const command_shell = "cmd.exe";
     const char *const command_args = "/c";
 
@@ -72,6 +79,10 @@ namespace leatherman { namespace execution {
         return isfile;
     }
 
+    // Defined in execution.cc
+    bool resolution_cache_lookup(string const& file, vector<string> const& directories, bool expand, string& result);
+    void resolution_cache_store(string const& file, vector<string> const& directories, bool expand, string const& result);
+
     string which(string const& file, vector<string> const& directories, bool expand)
     {
         // On Windows is not supported to turn off command expansion by setting expand to false
@@ -79,6 +90,11 @@ namespace leatherman { namespace execution {
             LOG_ERROR("Unsupported argument on Windows expand with value false");
             throw std::invalid_argument("Unsupported argument on Windows");
         }
+
+        string cached;
+        if (resolution_cache_lookup(file, directories, expand, cached)) {
+            return cached;
+        }
         // On Windows, everything has execute permission; Ruby determined
         // executability based on extension {com, exe, bat, cmd}. We'll do the
         // same check here using extpath_helper.
@@ -103,11 +119,13 @@ namespace leatherman { namespace execution {
                 for (auto const&ext : helper.ext_paths()) {
                     pext.replace_extension(ext);
                     if (is_executable(pext)) {
+                        resolution_cache_store(file, directories, expand, pext.string());
                         return pext.string();
                     }
                 }
             }
             if (is_executable(p, &helper)) {
+                resolution_cache_store(file, directories, expand, p.string());
                 return p.string();
             }
         }
@@ -252,6 +270,10 @@ namespace leatherman { namespace execution {
         bool read;
         string buffer;
         function<bool(string const&)> callback;
+        // When set on a write pipe, the buffer is refilled from this
+        // callback as the child drains it; the callback returning false
+        // or leaving the buffer empty ends the input.
+        function<bool(string&)> source;
 
      private:
         void init()
@@ -267,6 +289,17 @@ namespace leatherman { namespace execution {
         }
     };
 
+    // Services all of a child's pipes from the calling thread using
+    // overlapped I/O: reads and writes are issued asynchronously and a single
+    // WaitForMultipleObjects call blocks on the per-pipe events plus the
+    // timeout timer, so no threads are spawned per pipe. Concurrency across
+    // children is handled above this layer: execute_async and execute_batch
+    // run executions on the bounded supervisor pool, which caps the number of
+    // threads parked here regardless of how many commands are in flight. An
+    // I/O completion port shared across children would only pay off if
+    // execute() itself became an event-driven state machine; with the
+    // supervisor pool in place the thread count no longer scales with child
+    // count, which was the motivation for that design.
     static void rw_from_child(DWORD child, array<pipe, 3>& pipes, uint32_t timeout, HANDLE timer, bool convert_newlines)
     {
         vector<HANDLE> wait_handles;
@@ -290,6 +323,12 @@ namespace leatherman { namespace execution {
                     if (pipe.read) {
                         // Read the data
                         pipe.buffer.resize(4096);
+                    } else if (pipe.source && pipe.buffer.empty()) {
+                        // Pull the next chunk of input; an exhausted source ends stdin
+                        if (!pipe.source(pipe.buffer) || pipe.buffer.empty()) {
+                            pipe.handle = {};
+                            break;
+                        }
                     }
 
                     DWORD count = 0;
@@ -422,8 +461,38 @@ namespace leatherman { namespace execution {
         function<bool(string&)> const& stdout_callback,
         function<bool(string&)> const& stderr_callback,
         option_set<execution_options> const& options,
-        uint32_t timeout)
+        uint32_t timeout,
+        capture_policy const* capture,
+        int out_fd,
+        int err_fd,
+        function<bool(string&)> const* input_source,
+        function<bool(boost::string_ref)> const* stdout_view_callback,
+        function<bool(boost::string_ref)> const* stderr_view_callback)
     {
+        LTH_PROFILE_SCOPE("execution.execute");
+
+        // Descriptor sinks are a POSIX-only fast path; the portable
+        // frontend never passes them on Windows.
+        (void)out_fd;
+        (void)err_fd;
+
+        // Statistics collection is opt-in; start the clock before executable
+        // resolution so spawn latency includes the PATH search and pipe setup.
+        unique_ptr<result_stats> stats;
+        chrono::steady_clock::time_point stats_start;
+        if (options[execution_options::collect_statistics]) {
+            stats.reset(new result_stats());
+            stats_start = chrono::steady_clock::now();
+        }
+
+        // When the command statistics registry is enabled, time every
+        // execution regardless of the collect_statistics option.
+        bool record_stats = command_statistics_enabled();
+        chrono::steady_clock::time_point record_start;
+        if (record_stats) {
+            record_start = chrono::steady_clock::now();
+        }
+
         // Since we use a job object in the windows world, we want to
         // be sure we're not in a job object, or at least able to
         // break our processes out if we are in one.
@@ -598,7 +667,7 @@ namespace leatherman { namespace execution {
         }
 
         // Release unused pipes, to avoid any races in process completion.
-        if (!input) {
+        if (!input && !input_source) {
             stdInWr.release();
         }
         stdInRd.release();
@@ -608,6 +677,10 @@ namespace leatherman { namespace execution {
         scoped_handle hProcess(procInfo.hProcess);
         scoped_handle hThread(procInfo.hThread);
 
+        if (stats) {
+            stats->spawn_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+        }
+
         // Use a Job Object to group any child processes spawned by the CreateProcess invocation, so we can
         // easily stop them in case of a timeout.
         bool create_job_object = use_job_object && !options[execution_options::create_detached_process];
@@ -662,16 +735,49 @@ namespace leatherman { namespace execution {
         }
 
         string output, error;
-        tie(output, error) = process_streams(options[execution_options::trim_output], stdout_callback, stderr_callback, [&](function<bool(string const&)> const& process_stdout, function<bool(string const&)> const& process_stderr) {
+        auto read_streams = [&](function<bool(string const&)> const& process_stdout, function<bool(string const&)> const& process_stderr) {
+            // When collecting statistics, interpose on the stream callbacks to
+            // record time-to-first-output and per-stream byte counts.
+            function<bool(string const&)> counted_stdout, counted_stderr;
+            if (stats) {
+                counted_stdout = [&](string const& data) {
+                    if (stats->first_output_time.count() == 0) {
+                        stats->first_output_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+                    }
+                    stats->stdout_bytes += data.size();
+                    return process_stdout(data);
+                };
+                counted_stderr = [&](string const& data) {
+                    if (stats->first_output_time.count() == 0) {
+                        stats->first_output_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+                    }
+                    stats->stderr_bytes += data.size();
+                    return process_stderr(data);
+                };
+            }
             // Read the child output
             array<pipe, 3> pipes = { {
-                input ? pipe("stdin", move(stdInWr), *input) : pipe("stdin", {}, ""),
-                pipe("stdout", move(stdOutRd), process_stdout),
-                pipe("stderr", move(stdErrRd), process_stderr)
+                input || input_source ? pipe("stdin", move(stdInWr), input ? *input : string()) : pipe("stdin", {}, ""),
+                pipe("stdout", move(stdOutRd), stats ? counted_stdout : process_stdout),
+                pipe("stderr", move(stdErrRd), stats ? counted_stderr : process_stderr)
             } };
+            if (input_source) {
+                pipes[0].source = *input_source;
+            }
 
             rw_from_child(procInfo.dwProcessId, pipes, timeout, timer, options[execution_options::convert_newlines]);
-        });
+        };
+        if (capture) {
+            tie(output, error) = process_streams(options[execution_options::trim_output], *capture, read_streams);
+        } else if (stdout_view_callback || stderr_view_callback) {
+            static const function<bool(boost::string_ref)> no_view_callback;
+            tie(output, error) = process_streams(options[execution_options::trim_output],
+                                                 stdout_view_callback ? *stdout_view_callback : no_view_callback,
+                                                 stderr_view_callback ? *stderr_view_callback : no_view_callback,
+                                                 read_streams);
+        } else {
+            tie(output, error) = process_streams(options[execution_options::trim_output], stdout_callback, stderr_callback, read_streams);
+        }
 
         HANDLE handles[2] = { hProcess, timer };
         auto wait_result = WaitForMultipleObjects(timeout ? 2 : 1, handles, FALSE, INFINITE);
@@ -694,10 +800,32 @@ namespace leatherman { namespace execution {
 
         LOG_DEBUG("process exited with exit code {1}.", exit_code);
 
+        if (record_stats) {
+            record_command_stats(executable, chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - record_start), exit_code == 0);
+        }
+
         if (exit_code != 0 && options[execution_options::throw_on_nonzero_exit]) {
             throw child_exit_exception(_("child process returned non-zero exit status."), exit_code, output, error);
         }
-        return {exit_code == 0, move(output), move(error), static_cast<int>(exit_code), static_cast<size_t>(procInfo.dwProcessId)};
+
+        if (stats) {
+            stats->wall_time = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - stats_start);
+            // Harvest CPU times from the process handle; FILETIME values are
+            // in 100-nanosecond units. Maximum RSS is not reported here.
+            FILETIME creation_time, exit_time, kernel_time, user_time;
+            if (GetProcessTimes(hProcess, &creation_time, &exit_time, &kernel_time, &user_time)) {
+                auto to_microseconds = [](FILETIME const& ft) {
+                    auto ticks = (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+                    return chrono::microseconds(ticks / 10);
+                };
+                stats->user_cpu = to_microseconds(user_time);
+                stats->system_cpu = to_microseconds(kernel_time);
+            }
+        }
+
+        result res{exit_code == 0, move(output), move(error), static_cast<int>(exit_code), static_cast<size_t>(procInfo.dwProcessId)};
+        res.stats = shared_ptr<result_stats const>(stats.release());
+        return res;
     }
 
 }}  // namespace leatherman::execution
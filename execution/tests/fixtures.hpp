@@ -0,0 +1,2 @@
+#define EXEC_TESTS_DIRECTORY "/root/repo/execution/tests"
+#define CMAKE_BIN_DIRECTORY "/root/repo/_gate_build/bin"
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 #include <leatherman/execution/execution.hpp>
+#include <leatherman/execution/process_pool.hpp>
 #include <leatherman/util/scope_exit.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -11,6 +12,7 @@
 #include "../log_capture.hpp"
 #include "../lth_cat.hpp"
 #include <stdlib.h>
+#include <sstream>
 #include <sys/types.h>
 #include <sys/wait.h>
 
@@ -78,6 +80,53 @@ SCENARIO("searching for programs with execution::which") {
             );
         }
     }
+    GIVEN("resolution caching is enabled") {
+        enable_resolution_caching();
+        scope_exit disabler([]() { enable_resolution_caching(false); });
+        WHEN("the same file is resolved repeatedly") {
+            THEN("the resolution is stable") {
+                for (int i = 0; i < 3; ++i) {
+                    REQUIRE(
+                        which("facts", { EXEC_TESTS_DIRECTORY "/fixtures" }) ==
+                        EXEC_TESTS_DIRECTORY "/fixtures/facts"
+                    );
+                }
+            }
+        }
+        WHEN("the search directories change") {
+            THEN("the cached entry for the old directories is not returned") {
+                REQUIRE(
+                    which("facts", { EXEC_TESTS_DIRECTORY "/fixtures" }) ==
+                    EXEC_TESTS_DIRECTORY "/fixtures/facts"
+                );
+                REQUIRE(which("facts", { EXEC_TESTS_DIRECTORY "/fixtures/ls" }) == "");
+            }
+        }
+        WHEN("a file that could not be resolved appears") {
+            string dir(EXEC_TESTS_DIRECTORY "/fixtures/which_cache");
+            fs::create_directory(dir);
+            scope_exit cleaner([&]() { fs::remove_all(dir); });
+            REQUIRE(which("late_arrival", { dir }) == "");
+            boost::nowide::ofstream(dir + "/late_arrival") << "#! /bin/sh\n";
+            fs::permissions(dir + "/late_arrival", fs::owner_all);
+            THEN("it is resolved despite the earlier failure") {
+                REQUIRE(which("late_arrival", { dir }) == dir + "/late_arrival");
+            }
+        }
+        WHEN("the cache is cleared") {
+            THEN("resolution still succeeds") {
+                REQUIRE(
+                    which("facts", { EXEC_TESTS_DIRECTORY "/fixtures" }) ==
+                    EXEC_TESTS_DIRECTORY "/fixtures/facts"
+                );
+                clear_resolution_cache();
+                REQUIRE(
+                    which("facts", { EXEC_TESTS_DIRECTORY "/fixtures" }) ==
+                    EXEC_TESTS_DIRECTORY "/fixtures/facts"
+                );
+            }
+        }
+    }
 }
 
 SCENARIO("expanding command paths with execution::expand_command") {
@@ -189,6 +238,19 @@ SCENARIO("executing commands with execution::execute") {
                 REQUIRE(variables["LANG"] == "C");
             }
         }
+        WHEN("the environment changes between executions") {
+            auto exec = execute("env");
+            REQUIRE(exec.success);
+            REQUIRE(get_variables(exec.output).count("TEST_GENERATION_VARIABLE") == 0);
+            THEN("the merged environment reflects the change despite caching") {
+                scoped_env test_var("TEST_GENERATION_VARIABLE", "TEST_GENERATION_VALUE");
+                exec = execute("env");
+                REQUIRE(exec.success);
+                auto variables = get_variables(exec.output);
+                REQUIRE(variables.count("TEST_GENERATION_VARIABLE") == 1);
+                REQUIRE(variables["TEST_GENERATION_VARIABLE"] == "TEST_GENERATION_VALUE");
+            }
+        }
         WHEN("requested to override the environment") {
             scoped_env test_var("TEST_INHERITED_VARIABLE", "TEST_INHERITED_VALUE");
             auto exec = execute("env", {}, { {"TEST_VARIABLE1", "TEST_VALUE1" }, {"TEST_VARIABLE2", "TEST_VALUE2" }}, 0, { execution_options::trim_output });
@@ -286,6 +348,29 @@ SCENARIO("executing commands with execution::execute") {
             REQUIRE(exec.error == "hello\ngoodbye\n");
             REQUIRE(exec.exit_code == 0);
         }
+        WHEN("streaming input from a pull callback") {
+            int chunks = 0;
+            auto exec = execute("cat", {}, function<bool(string&)>([&](string& buffer) {
+                if (chunks == 5) {
+                    return false;
+                }
+                buffer = to_string(chunks++) + "\n";
+                return true;
+            }), {}, 0, { execution_options::trim_output, execution_options::merge_environment });
+            THEN("the chunks are delivered to the child in order") {
+                REQUIRE(exec.success);
+                REQUIRE(chunks == 5);
+                REQUIRE(exec.output == "0\n1\n2\n3\n4");
+            }
+        }
+        WHEN("streaming input from a stream") {
+            istringstream input_stream(lth_cat::overwhelm + "hello\n" + lth_cat::overwhelm + "goodbye\n");
+            auto exec = execute("cat", {}, input_stream, {}, 0, { execution_options::trim_output, execution_options::merge_environment });
+            THEN("the entire stream is delivered to the child") {
+                REQUIRE(exec.success);
+                REQUIRE(exec.output == lth_cat::overwhelm + "hello\n" + lth_cat::overwhelm + "goodbye");
+            }
+        }
         WHEN("requested to write stdout to file") {
             string out_file(spool_dir + "/stdout_test.out");
             auto exec = execute(EXEC_TESTS_DIRECTORY "/fixtures/error_message", {}, "", out_file);
@@ -370,6 +455,20 @@ SCENARIO("executing commands with execution::execute") {
                 REQUIRE(exec.error.empty());
             }
         }
+        WHEN("requested to write a large amount of stdout to file without trim") {
+            string out_file(spool_dir + "/stdout_large.out");
+            auto exec = execute(CMAKE_BIN_DIRECTORY "/lth_cat", { "overwhelm" }, "hello\ngoodbye",
+                                out_file, "", {}, nullptr, 0, { execution_options::merge_environment });
+            REQUIRE(fs::exists(out_file));
+            THEN("the file contains the exact bytes the child wrote") {
+                auto output = get_file_content("stdout_large.out");
+                REQUIRE(output == lth_cat::overwhelm+"hello\n"+lth_cat::overwhelm+"goodbye\n"+lth_cat::overwhelm);
+            }
+            THEN("the returned results are correct and stdout was not buffered") {
+                REQUIRE(exec.success);
+                REQUIRE(exec.output.empty());
+            }
+        }
         WHEN("requested to write stderr to a file in a directory that does not exist") {
             string out_file(spool_dir + "/good.out");
             string err_file(spool_dir + "/spam/eggs/bad.err");
@@ -465,6 +564,25 @@ SCENARIO("executing commands with execution::execute") {
                 }
             }
         }
+        WHEN("executed concurrently with different timeouts") {
+            THEN("each execution honors its own deadline") {
+                auto timed_execute = [](uint32_t timeout) {
+                    return async(launch::async, [timeout]() {
+                        try {
+                            execute("sh", { EXEC_TESTS_DIRECTORY "/fixtures/execution/sleep.sh" }, timeout);
+                        } catch (timeout_exception const&) {
+                            return true;
+                        } catch (exception const&) {
+                        }
+                        return false;
+                    });
+                };
+                auto first = timed_execute(1);
+                auto second = timed_execute(2);
+                REQUIRE(first.get());
+                REQUIRE(second.get());
+            }
+        }
     }
     GIVEN("stderr is redirected to null") {
         WHEN("using a debug log level") {
@@ -494,6 +612,338 @@ SCENARIO("executing commands with execution::execute") {
     }
 }
 
+SCENARIO("executing commands with a capture policy") {
+    std::string spool_dir { EXEC_TESTS_DIRECTORY "/capture_spool" };
+    if (!fs::exists(spool_dir) && !fs::create_directories(spool_dir)) {
+        FAIL("failed to create spool directory");
+    }
+    scope_exit spool_cleaner([spool_dir]() { fs::remove_all(spool_dir); });
+    GIVEN("an unbounded policy") {
+        THEN("the full output should be captured") {
+            capture_policy capture;
+            auto exec = execute("sh", { "-c", "seq 1 5" }, "", {}, capture);
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "1\n2\n3\n4\n5");
+        }
+        THEN("binary output should be captured unmodified") {
+            capture_policy capture;
+            auto exec = execute("sh", { "-c", "printf 'a\\0b'" }, "", {}, capture, 0, { execution_options::merge_environment });
+            REQUIRE(exec.success);
+            auto expected = string("a\0b", 3);
+            REQUIRE(exec.output == expected);
+        }
+    }
+    GIVEN("a bounded policy") {
+        THEN("the head and tail of a runaway stream should be kept") {
+            capture_policy capture;
+            capture.max_bytes = 64;
+            auto exec = execute("sh", { "-c", "seq 1 2000" }, "", {}, capture);
+            REQUIRE(exec.success);
+            REQUIRE(exec.output.size() < 200u);
+            REQUIRE(boost::starts_with(exec.output, "1\n2\n"));
+            REQUIRE(boost::ends_with(exec.output, "2000"));
+            REQUIRE(exec.output.find("bytes of output dropped") != string::npos);
+        }
+        THEN("output below the cap should be unaffected") {
+            capture_policy capture;
+            capture.max_bytes = 4096;
+            auto exec = execute("sh", { "-c", "seq 1 5" }, "", {}, capture);
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "1\n2\n3\n4\n5");
+        }
+    }
+    GIVEN("a policy with a spill file") {
+        THEN("the full stream should be spilled while memory stays bounded") {
+            capture_policy capture;
+            capture.max_bytes = 64;
+            capture.spill_file = spool_dir + "/out.bin";
+            auto exec = execute("sh", { "-c", "seq 1 2000" }, "", {}, capture);
+            REQUIRE(exec.success);
+            REQUIRE(exec.output.size() < 200u);
+
+            boost::nowide::ifstream strm(capture.spill_file.c_str(), std::ios::binary);
+            string spilled((istreambuf_iterator<char>(strm)), (istreambuf_iterator<char>()));
+            REQUIRE(boost::starts_with(spilled, "1\n2\n"));
+            REQUIRE(boost::ends_with(spilled, "2000\n"));
+        }
+    }
+}
+
+SCENARIO("executing commands with execution::execute_async") {
+    GIVEN("a command that succeeds") {
+        THEN("the future should yield the result") {
+            auto future = execute_async("cat", { EXEC_TESTS_DIRECTORY "/fixtures/ls/file3.txt" });
+            auto exec = future.get();
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "file3");
+            REQUIRE(exec.exit_code == 0);
+        }
+        THEN("multiple executions can be in flight at once") {
+            vector<future<result>> futures;
+            for (int i = 0; i < 8; i++) {
+                futures.emplace_back(execute_async("cat", { EXEC_TESTS_DIRECTORY "/fixtures/ls/file3.txt" }));
+            }
+            for (auto& future : futures) {
+                auto exec = future.get();
+                REQUIRE(exec.success);
+                REQUIRE(exec.output == "file3");
+            }
+        }
+        THEN("input and environment should be passed to the child") {
+            auto future = execute_async("env", {}, "", { {"TEST_ASYNC_VARIABLE", "TEST_ASYNC_VALUE"} });
+            auto exec = future.get();
+            REQUIRE(exec.success);
+            REQUIRE(exec.output.find("TEST_ASYNC_VARIABLE=TEST_ASYNC_VALUE") != string::npos);
+        }
+        THEN("the completion callback should receive the result") {
+            promise<result> delivered;
+            execute_async("cat", { EXEC_TESTS_DIRECTORY "/fixtures/ls/file3.txt" }, [&](result r) {
+                delivered.set_value(move(r));
+            });
+            auto exec = delivered.get_future().get();
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "file3");
+        }
+    }
+    GIVEN("a command that fails") {
+        WHEN("default options are used") {
+            THEN("the future should yield a failure result") {
+                auto exec = execute_async("ls", { "does_not_exist" }).get();
+                REQUIRE_FALSE(exec.success);
+                REQUIRE(exec.exit_code > 0);
+            }
+        }
+        WHEN("the throw_on_nonzero_exit option is used") {
+            THEN("the future should rethrow the exception") {
+                auto future = execute_async("ls", { "does_not_exist" }, 0, { execution_options::trim_output, execution_options::merge_environment, execution_options::throw_on_nonzero_exit });
+                REQUIRE_THROWS_AS(future.get(), child_exit_exception);
+            }
+        }
+    }
+}
+
+SCENARIO("executing commands with execution::process_pool") {
+    GIVEN("a pool with a single worker") {
+        process_pool pool { 1 };
+        REQUIRE(pool.size() == 1u);
+        THEN("a command's output and exit code should be returned") {
+            auto exec = pool.run("echo hello");
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "hello");
+            REQUIRE(exec.exit_code == 0);
+        }
+        THEN("the worker should be reused across commands") {
+            auto first = pool.run("echo first");
+            auto second = pool.run("echo second");
+            REQUIRE(first.output == "first");
+            REQUIRE(second.output == "second");
+            REQUIRE(first.pid == second.pid);
+        }
+        THEN("a failing command should report its exit code") {
+            auto exec = pool.run("false");
+            REQUIRE_FALSE(exec.success);
+            REQUIRE(exec.exit_code == 1);
+        }
+        THEN("a command that exits the shell should respawn the worker") {
+            REQUIRE_THROWS_AS(pool.run("exit 0"), execution_exception);
+            auto exec = pool.run("echo recovered");
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "recovered");
+        }
+        THEN("a command that times out should throw and respawn the worker") {
+            REQUIRE_THROWS_AS(pool.run("sleep 60", 1), timeout_exception);
+            auto exec = pool.run("echo recovered");
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "recovered");
+        }
+    }
+    GIVEN("a pool with several workers") {
+        process_pool pool { 2 };
+        THEN("commands can be dispatched from multiple threads") {
+            vector<future<result>> futures;
+            for (int i = 0; i < 8; i++) {
+                futures.emplace_back(async(launch::async, [&pool, i]() {
+                    return pool.run("echo " + to_string(i));
+                }));
+            }
+            for (int i = 0; i < 8; i++) {
+                auto exec = futures[i].get();
+                REQUIRE(exec.success);
+                REQUIRE(exec.output == to_string(i));
+            }
+        }
+    }
+}
+
+SCENARIO("executing script snippets with execution::shell_session") {
+    GIVEN("a shell session") {
+        shell_session session;
+        THEN("a snippet's output and exit code should be returned") {
+            auto exec = session.run("echo hello");
+            REQUIRE(exec.success);
+            REQUIRE(exec.output == "hello");
+            REQUIRE(exec.exit_code == 0);
+        }
+        THEN("shell state should persist between snippets") {
+            auto first = session.run("TEST_SESSION_VARIABLE=persisted");
+            REQUIRE(first.success);
+            auto second = session.run("echo \"$TEST_SESSION_VARIABLE\"");
+            REQUIRE(second.success);
+            REQUIRE(second.output == "persisted");
+        }
+        THEN("a changed working directory should persist between snippets") {
+            auto first = session.run("cd /");
+            REQUIRE(first.success);
+            auto second = session.run("pwd");
+            REQUIRE(second.success);
+            REQUIRE(second.output == "/");
+        }
+    }
+}
+
+SCENARIO("executing commands with execution::execute_batch") {
+    GIVEN("a batch of commands") {
+        vector<command_spec> commands;
+        for (int i = 0; i < 8; i++) {
+            commands.push_back({ "echo", { to_string(i) }, "", {} });
+        }
+        THEN("the results are returned in command order") {
+            auto results = execute_batch(commands, 4);
+            REQUIRE(results.size() == 8u);
+            for (int i = 0; i < 8; i++) {
+                REQUIRE(results[i].success);
+                REQUIRE(results[i].output == to_string(i));
+            }
+        }
+        THEN("a completion callback receives each result as it completes") {
+            mutex lock;
+            vector<pair<size_t, string>> completed;
+            auto results = execute_batch(commands, [&](size_t index, result const& res) {
+                lock_guard<mutex> guard(lock);
+                completed.push_back({ index, res.output });
+            }, 2);
+            REQUIRE(results.size() == 8u);
+            REQUIRE(completed.size() == 8u);
+            sort(completed.begin(), completed.end());
+            for (size_t i = 0; i < 8u; i++) {
+                REQUIRE(completed[i].first == i);
+                REQUIRE(completed[i].second == to_string(i));
+            }
+        }
+    }
+    GIVEN("a batch containing failing commands") {
+        vector<command_spec> commands = {
+            { "echo", { "hello" }, "", {} },
+            { "false", {}, "", {} },
+            { "does_not_exist", {}, "", {} }
+        };
+        THEN("each result reflects its own command") {
+            auto results = execute_batch(commands, 3);
+            REQUIRE(results.size() == 3u);
+            REQUIRE(results[0].success);
+            REQUIRE(results[0].output == "hello");
+            REQUIRE_FALSE(results[1].success);
+            REQUIRE(results[1].exit_code == 1);
+            REQUIRE_FALSE(results[2].success);
+            REQUIRE(results[2].exit_code == 127);
+        }
+    }
+    GIVEN("a batch with input on stdin") {
+        vector<command_spec> commands = {
+            { "cat", {}, "hello\ngoodbye", {} },
+            { CMAKE_BIN_DIRECTORY "/lth_cat", { "prefix" }, "spam\neggs", { { "TEST_VARIABLE", "unused" } } }
+        };
+        THEN("the input is delivered to each child") {
+            auto results = execute_batch(commands, 2, 0, { execution_options::trim_output, execution_options::merge_environment });
+            REQUIRE(results.size() == 2u);
+            REQUIRE(results[0].success);
+            REQUIRE(results[0].output == "hello\ngoodbye");
+            REQUIRE(results[1].success);
+            REQUIRE(results[1].output == lth_cat::prefix + "spam\neggs");
+        }
+    }
+    GIVEN("an empty batch") {
+        THEN("an empty result set is returned") {
+            REQUIRE(execute_batch({}, 4).empty());
+        }
+    }
+}
+
+SCENARIO("teeing output to files and callbacks with execution::execute_tee") {
+    std::string spool_dir { EXEC_TESTS_DIRECTORY "/tee_spool" };
+    if (!fs::exists(spool_dir) && !fs::create_directories(spool_dir)) {
+        FAIL("failed to create spool directory");
+    }
+    scope_exit spool_cleaner([spool_dir]() { fs::remove_all(spool_dir); });
+
+    GIVEN("a command producing output on stdout and stderr") {
+        string out_file(spool_dir + "/tee_test.out");
+        string err_file(spool_dir + "/tee_test.err");
+        vector<string> out_lines, err_lines;
+        auto exec = execute_tee(EXEC_TESTS_DIRECTORY "/fixtures/error_message", {}, "", out_file, err_file, {},
+                                [&](string& line) { out_lines.push_back(line); return true; },
+                                [&](string& line) { err_lines.push_back(line); return true; });
+        THEN("each line reaches both the file and the callback") {
+            REQUIRE(exec.success);
+            boost::nowide::ifstream out_stream(out_file.c_str());
+            string file_content((istreambuf_iterator<char>(out_stream)), istreambuf_iterator<char>());
+            REQUIRE(file_content == "foo=bar\nsome more stuff\n");
+            REQUIRE(out_lines.size() == 2u);
+            REQUIRE(out_lines[0] == "foo=bar");
+            REQUIRE(out_lines[1] == "some more stuff");
+            boost::nowide::ifstream err_stream(err_file.c_str());
+            string err_content((istreambuf_iterator<char>(err_stream)), istreambuf_iterator<char>());
+            REQUIRE(err_content == "error message!\n");
+            REQUIRE(err_lines.size() == 1u);
+            REQUIRE(err_lines[0] == "error message!");
+        }
+    }
+    GIVEN("no error file") {
+        string out_file(spool_dir + "/tee_only_out.out");
+        vector<string> out_lines;
+        auto exec = execute_tee("echo", { "hello" }, "", out_file, "", {},
+                                [&](string& line) { out_lines.push_back(line); return true; }, nullptr);
+        THEN("stdout is teed and stderr is buffered") {
+            REQUIRE(exec.success);
+            REQUIRE(out_lines.size() == 1u);
+            REQUIRE(out_lines[0] == "hello");
+            REQUIRE(fs::exists(out_file));
+        }
+    }
+}
+
+SCENARIO("executing commands with a prepared execution::exec_context") {
+    GIVEN("a context for a command with arguments") {
+        exec_context context("echo", { "hello", "world" });
+        THEN("the executable is resolved at construction") {
+            REQUIRE_FALSE(context.executable().empty());
+            REQUIRE(context.executable()[0] == '/');
+        }
+        THEN("the context can be executed repeatedly") {
+            for (int i = 0; i < 3; i++) {
+                auto res = execute(context);
+                REQUIRE(res.success);
+                REQUIRE(res.output == "hello world");
+            }
+        }
+    }
+    GIVEN("a context with environment variables") {
+        exec_context context(CMAKE_BIN_DIRECTORY "/lth_cat", {}, { { "TEST_VARIABLE", "TEST_VALUE" } });
+        THEN("the environment is passed to the child") {
+            auto res = execute(context);
+            REQUIRE(res.success);
+        }
+    }
+    GIVEN("a context for a nonexistent command") {
+        exec_context context("does_not_exist_anywhere");
+        THEN("execution fails with exit code 127") {
+            auto res = execute(context);
+            REQUIRE_FALSE(res.success);
+            REQUIRE(res.exit_code == 127);
+        }
+    }
+}
+
 SCENARIO("executing commands with execution::each_line") {
     GIVEN("a command that succeeds") {
         THEN("each line of output should be returned") {
@@ -744,3 +1194,120 @@ SCENARIO("executing commands with execution::each_line") {
         }
     }
 }
+
+SCENARIO("executing commands with execution::each_line_view") {
+    GIVEN("a command that succeeds") {
+        THEN("each line of output should be passed as a view") {
+            vector<string> lines;
+            bool success = each_line_view("cat", { EXEC_TESTS_DIRECTORY "/fixtures/ls/file4.txt" }, [&](boost::string_ref line) {
+                lines.push_back(line.to_string());
+                return true;
+            });
+            REQUIRE(success);
+            REQUIRE(lines.size() == 4u);
+            REQUIRE(lines[0] == "line1");
+            REQUIRE(lines[1] == "line2");
+            REQUIRE(lines[2] == "line3");
+            REQUIRE(lines[3] == "line4");
+        }
+        WHEN("output stops when false is returned from callback") {
+            vector<string> lines;
+            bool success = each_line_view("cat", { EXEC_TESTS_DIRECTORY "/fixtures/ls/file4.txt" }, [&](boost::string_ref line) {
+                lines.push_back(line.to_string());
+                return false;
+            });
+            REQUIRE(success);
+            REQUIRE(lines.size() == 1u);
+            REQUIRE(lines[0] == "line1");
+        }
+        WHEN("passing environment variables") {
+            bool found = false;
+            bool success = each_line_view("env", {}, { {"TEST_VIEW_VARIABLE", "TEST_VIEW_VALUE" } }, [&](boost::string_ref line) {
+                if (line == "TEST_VIEW_VARIABLE=TEST_VIEW_VALUE") {
+                    found = true;
+                }
+                return true;
+            });
+            REQUIRE(success);
+            THEN("the child environment should contain the given variables") {
+                REQUIRE(found);
+            }
+        }
+    }
+    GIVEN("a command that fails") {
+        WHEN("default options are used") {
+            auto success = each_line_view("ls", { "does_not_exist" }, [](boost::string_ref) {
+                return true;
+            });
+            THEN("no output should be returned") {
+                REQUIRE_FALSE(success);
+            }
+        }
+    }
+}
+
+SCENARIO("aggregating commands in the statistics registry") {
+    enable_command_statistics();
+    scope_exit disabler([]() { enable_command_statistics(false); });
+
+    GIVEN("a mix of successful and failing executions") {
+        auto echo_path = which("echo");
+        execute("echo", { "hello" });
+        execute("echo", { "world" });
+        execute("false");
+        THEN("the snapshot aggregates per executable") {
+            auto snapshot = command_statistics_snapshot();
+            REQUIRE(snapshot.count(echo_path) == 1u);
+            auto const& echo_stats = snapshot[echo_path];
+            REQUIRE(echo_stats.count == 2u);
+            REQUIRE(echo_stats.failures == 0u);
+            REQUIRE(echo_stats.total_wall_time.count() > 0);
+            uint64_t histogram_total = 0;
+            for (auto bucket : echo_stats.latency_histogram) {
+                histogram_total += bucket;
+            }
+            REQUIRE(histogram_total == 2u);
+            auto const& false_stats = snapshot[which("false")];
+            REQUIRE(false_stats.count == 1u);
+            REQUIRE(false_stats.failures == 1u);
+        }
+        THEN("resetting clears the registry") {
+            reset_command_statistics();
+            REQUIRE(command_statistics_snapshot().empty());
+        }
+    }
+    GIVEN("a disabled registry") {
+        enable_command_statistics(false);
+        execute("echo", { "hello" });
+        THEN("nothing is recorded") {
+            REQUIRE(command_statistics_snapshot().empty());
+        }
+    }
+}
+
+SCENARIO("collecting execution statistics") {
+    GIVEN("a command that produces output") {
+        WHEN("requested to collect statistics") {
+            auto exec = execute("cat", { EXEC_TESTS_DIRECTORY "/fixtures/ls/file3.txt" }, 0,
+                { execution_options::trim_output, execution_options::merge_environment, execution_options::collect_statistics });
+            REQUIRE(exec.success);
+            THEN("the result carries populated statistics") {
+                REQUIRE(exec.stats);
+                REQUIRE(exec.stats->spawn_time.count() > 0);
+                REQUIRE(exec.stats->wall_time >= exec.stats->spawn_time);
+                REQUIRE(exec.stats->first_output_time >= exec.stats->spawn_time);
+                REQUIRE(exec.stats->first_output_time <= exec.stats->wall_time);
+                REQUIRE(exec.stats->stdout_bytes == 5u);
+                REQUIRE(exec.stats->stderr_bytes == 0u);
+                REQUIRE(exec.stats->max_rss_kb > 0u);
+            }
+        }
+        WHEN("not requested to collect statistics") {
+            auto exec = execute("cat", { EXEC_TESTS_DIRECTORY "/fixtures/ls/file3.txt" });
+            THEN("the result carries no statistics") {
+                REQUIRE(exec.success);
+                REQUIRE_FALSE(exec.stats);
+            }
+        }
+    }
+}
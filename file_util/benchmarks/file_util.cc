@@ -0,0 +1,131 @@
+/**
+ * @file
+ * Measures file_util I/O: read and each_line across file sizes,
+ * atomic_write_to_file, and directory enumeration across file counts.
+ * Reads run warm by default; set LEATHERMAN_BENCHMARK_COLD to drop
+ * the benchmark files from the page cache before every read, which
+ * approximates first-touch behavior on slow storage. Run by hand when
+ * measuring a change to the I/O helpers.
+ */
+#include <leatherman/file_util/file.hpp>
+#include <leatherman/file_util/directory.hpp>
+#include <benchmark.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/cstdlib.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::file_util;
+namespace fs = boost::filesystem;
+
+namespace {
+
+    bool cold_cache()
+    {
+        static bool cold = boost::nowide::getenv("LEATHERMAN_BENCHMARK_COLD") != nullptr;
+        return cold;
+    }
+
+    // Asks the kernel to drop the file's pages, so the next read
+    // faults them back in. Best effort; a no-op where unsupported.
+    void drop_from_cache(string const& path)
+    {
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+#endif
+    }
+
+    string make_file(fs::path const& dir, string const& name, size_t size)
+    {
+        string contents;
+        contents.reserve(size);
+        while (contents.size() < size) {
+            contents += "a line of file contents for the benchmark corpus\n";
+        }
+        contents.resize(size);
+        auto path = (dir / name).string();
+        atomic_write_to_file(contents, path);
+        return path;
+    }
+
+}  // namespace
+
+LEATHERMAN_BENCHMARK(file_util)
+{
+    auto dir = fs::temp_directory_path() / fs::unique_path("lth_bench_%%%%-%%%%");
+    fs::create_directories(dir);
+
+    // read and each_line across file sizes. 1 GB is representative of
+    // the worst case in the field but too slow for a default run;
+    // scale iterations down as sizes go up.
+    const vector<size_t> sizes = { 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+    for (auto size : sizes) {
+        auto label = size >= 1024 * 1024 ? to_string(size / (1024 * 1024)) + "MB"
+                                         : to_string(size / 1024) + "KB";
+        auto path = make_file(dir, "read_" + label, size);
+        size_t iterations = size >= 1024 * 1024 ? 50 : 2000;
+
+        auto t = leatherman::benchmark::measure(5, iterations, [&]() {
+            if (cold_cache()) {
+                drop_from_cache(path);
+            }
+            string contents;
+            read(path, contents);
+        });
+        leatherman::benchmark::report("read " + label, 1, t);
+
+        t = leatherman::benchmark::measure(5, iterations, [&]() {
+            if (cold_cache()) {
+                drop_from_cache(path);
+            }
+            size_t lines = 0;
+            each_line(path, [&](string&) {
+                ++lines;
+                return true;
+            });
+        });
+        leatherman::benchmark::report("each_line " + label, 1, t);
+    }
+
+    auto write_path = (dir / "write_target").string();
+    auto t = leatherman::benchmark::measure(5, 500, [&]() {
+        atomic_write_to_file(string(64 * 1024, 'x'), write_path);
+    });
+    leatherman::benchmark::report("atomic_write 64KB", 1, t);
+
+    // Directory enumeration across file counts. 100k files is the
+    // field's worst case; 10k keeps the default run quick.
+    for (size_t count : { static_cast<size_t>(10), static_cast<size_t>(1000), static_cast<size_t>(10000) }) {
+        auto subdir = dir / ("enum_" + to_string(count));
+        fs::create_directories(subdir);
+        for (size_t i = 0; i < count; ++i) {
+            atomic_write_to_file("x", (subdir / ("file_" + to_string(i))).string());
+        }
+
+        size_t iterations = count >= 10000 ? 20 : 200;
+        t = leatherman::benchmark::measure(2, iterations, [&]() {
+            size_t seen = 0;
+            each_file(subdir.string(), [&](string const&) {
+                ++seen;
+                return true;
+            });
+        });
+        leatherman::benchmark::report("each_file " + to_string(count), 1, t);
+    }
+
+    boost::system::error_code ec;
+    fs::remove_all(dir, ec);
+}
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <functional>
+#include <cstddef>
 
 namespace leatherman { namespace file_util {
 
@@ -17,6 +18,15 @@ namespace leatherman { namespace file_util {
      */
     void each_file(std::string const& directory, std::function<bool(std::string const&)> const& callback, std::string const& pattern = {});
 
+    /**
+     * Recursively enumerates the files that match the given pattern in the given directory tree.
+     * Descends into every subdirectory without following symlinks.
+     * @param directory The directory to search for the files.
+     * @param callback The callback to invoke when a matching file is found.
+     * @param pattern The pattern to filter the file names by.  If empty, all files are passed.
+     */
+    void each_file_recursive(std::string const& directory, std::function<bool(std::string const&)> const& callback, std::string const& pattern = {});
+
     /**
      * Enumerates the subdirectories in the given directory.
      * @param directory The directory to search for the subdirectories.
@@ -25,4 +35,28 @@ namespace leatherman { namespace file_util {
      */
     void each_subdirectory(std::string const& directory, std::function<bool(std::string const&)> const& callback, std::string const& pattern = {});
 
+    /**
+     * Recursively enumerates the subdirectories in the given directory tree.
+     * Descends into every subdirectory without following symlinks.
+     * @param directory The directory to search for the subdirectories.
+     * @param callback The callback to invoke when a matching subdirectory is found.
+     * @param pattern The pattern to filter the subdirectory names by.  If empty, all subdirectories are passed.
+     */
+    void each_subdirectory_recursive(std::string const& directory, std::function<bool(std::string const&)> const& callback, std::string const& pattern = {});
+
+    /**
+     * Recursively enumerates the files in the given directory tree using
+     * a pool of threads. Each worker pulls a directory from a shared
+     * queue, visits its files, and queues its subdirectories for the
+     * pool, so independent subtrees are scanned in parallel. Symlinks
+     * are not followed and no order is guaranteed. The callback is
+     * invoked concurrently from multiple threads and must be thread
+     * safe; returning false stops the walk, though entries already being
+     * processed by other workers may still be delivered.
+     * @param directory The directory to search for the files.
+     * @param callback The callback to invoke when a file is found.
+     * @param threads The number of worker threads to use.
+     */
+    void walk_parallel(std::string const& directory, std::function<bool(std::string const&)> const& callback, std::size_t threads = 4);
+
 }}  // namespace leatherman::file_util
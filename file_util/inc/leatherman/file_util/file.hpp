@@ -6,10 +6,17 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/optional.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/utility/string_ref.hpp>
 
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace leatherman { namespace file_util {
 
@@ -21,6 +28,47 @@ namespace leatherman { namespace file_util {
      */
     bool each_line(std::string const& path, std::function<bool(std::string &)> callback);
 
+    /**
+     * Reads each line from the given file without per-line allocation.
+     * The file is read in large blocks and split in place; the callback
+     * receives a view into the read buffer that is only valid for the
+     * duration of the call, so copy the line if it must outlive it. Like
+     * each_line, the terminating newline is not part of the line and the
+     * final line is delivered whether or not it ends with one.
+     * @param path The path to the file to read.
+     * @param callback The callback function that is passed a view of each line in the file.
+     * @return Returns true if the file was opened successfully or false if it was not.
+     */
+    bool each_line_view(std::string const& path, std::function<bool(boost::string_ref)> callback);
+
+    /**
+     * Reads each line from the given file, resuming at the given offset.
+     * Unlike each_line, only complete, newline-terminated lines are
+     * delivered: a trailing line still missing its newline is left
+     * unconsumed, so a later call from the returned offset delivers it
+     * whole once it has been finished. The offset is advanced past the
+     * last delivered line, making incremental consumers - a tailer
+     * re-scanning a growing log, say - read only newly appended bytes.
+     * @param path The path to the file to read.
+     * @param offset The byte offset to resume at; updated to the offset to resume the next call at.
+     * @param callback The callback function that is passed each line in the file.
+     * @return Returns true if the file was opened successfully or false if it was not.
+     */
+    bool each_line(std::string const& path, std::uintmax_t& offset, std::function<bool(std::string &)> callback);
+
+    /**
+     * Reads each line from the given file, resuming at the given offset,
+     * without per-line allocation. Combines the view delivery of
+     * each_line_view with the resumption semantics of the offset
+     * overload of each_line: only complete lines are delivered and the
+     * offset is advanced past the last one.
+     * @param path The path to the file to read.
+     * @param offset The byte offset to resume at; updated to the offset to resume the next call at.
+     * @param callback The callback function that is passed a view of each line in the file.
+     * @return Returns true if the file was opened successfully or false if it was not.
+     */
+    bool each_line_view(std::string const& path, std::uintmax_t& offset, std::function<bool(boost::string_ref)> callback);
+
     /**
      * Reads the entire contents of the given file into a string.
      * @param path The path of the file to read.
@@ -36,12 +84,119 @@ namespace leatherman { namespace file_util {
      */
     bool read(std::string const& path, std::string& contents);
 
+    /**
+     * Reads the entire contents of many files in one batch.
+     * On Linux the reads are submitted together through io_uring when
+     * the kernel supports it, collapsing the per-file read syscalls
+     * into a few ring submissions; elsewhere, or when io_uring is
+     * unavailable, the files are read one by one.
+     * @param paths The paths of the files to read.
+     * @return Returns one entry per path, in order; a file that cannot be read yields an empty string, as read does.
+     */
+    std::vector<std::string> read_many(std::vector<std::string> const& paths);
+
+    /**
+     * Provides a read-only, zero-copy view of a file's contents.
+     * The file is memory mapped, so the contents are not copied through
+     * a stream buffer into a string; when mapping fails (for example for
+     * empty files or filesystems without mmap support) the contents are
+     * read the buffered way instead, so the view is always usable once
+     * open returns true. The view is invalidated if the underlying file
+     * is truncated while mapped.
+     */
+    class mapped_file
+    {
+     public:
+        /**
+         * Constructs an empty view; use open to attach it to a file.
+         */
+        mapped_file() = default;
+
+        /**
+         * Constructs a view of the given file.
+         * @param path The path of the file to view.
+         */
+        explicit mapped_file(std::string const& path);
+
+        /**
+         * Opens the given file, replacing any current view.
+         * @param path The path of the file to view.
+         * @return Returns true if the contents are viewable or false if the file is not readable.
+         */
+        bool open(std::string const& path);
+
+        /**
+         * @return Returns a pointer to the start of the file contents, or nullptr if no file is open.
+         */
+        char const* data() const;
+
+        /**
+         * @return Returns the size of the file contents in bytes.
+         */
+        std::size_t size() const;
+
+        /**
+         * @return Returns the file contents copied into a string.
+         */
+        std::string string() const;
+
+     private:
+        boost::interprocess::file_mapping _mapping;
+        boost::interprocess::mapped_region _region;
+        std::string _fallback;
+        bool _open = false;
+    };
+
     /**
      *@return Returns true if the specified file exists and can
      *      be read by the current process.
      */
     bool file_readable(const std::string &file_path);
 
+    /**
+     * The result of a readability check.
+     */
+    enum class file_status {
+        missing,     ///< The path does not exist.
+        unreadable,  ///< The path exists but cannot be read as a file; directories count as unreadable.
+        readable     ///< The path is a file the current process can read.
+    };
+
+    /**
+     * Checks whether the given path is a readable file without opening
+     * it. The check costs an access(2) permission probe and a minimal
+     * stat (statx with only the type requested, where available)
+     * instead of file_readable's full open/close cycle.
+     * @param path The path to check.
+     * @return Returns the path's status.
+     */
+    file_status check_readable(std::string const& path);
+
+    /**
+     * Checks many paths in one batch, for screening large candidate
+     * sets without a loop of open attempts.
+     * @param paths The paths to check.
+     * @return Returns one status per path, in order.
+     */
+    std::vector<file_status> check_many(std::vector<std::string> const& paths);
+
+    /**
+     * Copies a file without dragging its bytes through userspace.
+     * On Linux the copy is first attempted as a reflink, which clones
+     * multi-gigabyte files at metadata speed on filesystems that
+     * support it (XFS, Btrfs), and otherwise through copy_file_range,
+     * which keeps the transfer inside the kernel; elsewhere the
+     * platform's native copy is used (CopyFileExW on Windows). The
+     * copy lands in a temporary file that is renamed into place, so a
+     * destination that already exists is replaced atomically and
+     * readers never observe a partial copy.
+     * @param source The path of the file to copy.
+     * @param destination The final destination and name of the copy.
+     *
+     * Throws an error in case the file cannot be copied.
+     */
+    void copy_file(std::string const& source, std::string const& destination);
+
     /**
      * Writes content to a temporary file in the specified mode, then
      * renames the file to the desired path. If the file already exists,
@@ -62,18 +217,117 @@ namespace leatherman { namespace file_util {
      * renames the file to the desired path. If the file already exists,
      * its previous content will be deleted, so appending is not
      * possible.
+     * On Linux the content is written to an anonymous O_TMPFILE file
+     * preallocated to the content size and linked into place, so no
+     * temporary directory entry is ever created.
      * @param text The content to be written
      * @param file_path The final destination and name of the file
      * @param perms The file permissions to apply to the file.
      *              On Windows this only toggles read-only.
      * @param mode The mode in which to write the file
+     * @param sync Whether to sync the content to disk before the file
+     *             is moved into place, so a crash cannot leave the
+     *             destination pointing at empty content. Ignored on
+     *             Windows.
      *
      * Throws an error in case it fails to open the file to write.
      */
     void atomic_write_to_file(const std::string &text,
                               const std::string &file_path,
                               boost::optional<boost::filesystem::perms> perms,
-                              std::ios_base::openmode mode);
+                              std::ios_base::openmode mode,
+                              bool sync = false);
+
+    /**
+     * Produces a file incrementally with atomic_write_to_file's
+     * commit semantics. Appended data accumulates in a large user-space
+     * buffer and is written to a temporary file whenever the buffer
+     * fills; commit moves the temporary file into place, so readers
+     * never observe a partially written file and the content is never
+     * materialized in memory as a whole. A writer destructed without
+     * commit removes the temporary file.
+     */
+    class streaming_file_writer
+    {
+     public:
+        /**
+         * Constructs a writer for the given file.
+         * @param file_path The final destination and name of the file.
+         * @param buffer_size The size of the append buffer in bytes.
+         *
+         * Throws an error in case it fails to open the temporary file to write.
+         */
+        explicit streaming_file_writer(std::string file_path, std::size_t buffer_size = 1024 * 1024);
+
+        /**
+         * Destructs the writer, discarding the temporary file unless
+         * commit was called.
+         */
+        ~streaming_file_writer();
+
+        /**
+         * Appends data to the file.
+         * @param data The data to append.
+         */
+        void append(boost::string_ref data);
+
+        /**
+         * Writes any buffered data to the temporary file.
+         */
+        void flush();
+
+        /**
+         * Flushes and moves the temporary file into place.
+         * No further appends are allowed after commit.
+         * @param sync Whether to sync the content to disk before the file is moved into place. Ignored on Windows.
+         */
+        void commit(bool sync = false);
+
+     private:
+        std::string _file_path;
+        std::string _tmp_path;
+        std::string _buffer;
+        std::size_t _buffer_size;
+        bool _committed = false;
+        boost::nowide::ofstream _stream;
+    };
+
+    /**
+     * Writes many files efficiently in one batch.
+     * Queued files are grouped by directory and written in parallel by a
+     * small pool of threads, each through the atomic_write_to_file path.
+     * Durability is deferred to a single barrier: instead of syncing
+     * every file, flush syncs each touched directory once after all
+     * writes have landed.
+     */
+    class batch_writer
+    {
+     public:
+        /**
+         * Constructs a batch writer.
+         * @param threads The number of writer threads used by flush.
+         */
+        explicit batch_writer(std::size_t threads = 4);
+
+        /**
+         * Queues a file to be written by the next flush.
+         * @param path The final destination and name of the file.
+         * @param content The content to be written.
+         */
+        void add(std::string path, std::string content);
+
+        /**
+         * Writes all queued files and clears the queue.
+         * Failures are logged and do not stop the remaining writes.
+         * @param sync Whether to sync the touched directories to disk after all writes have landed. Ignored on Windows.
+         * @return Returns the number of files successfully written.
+         */
+        std::size_t flush(bool sync = false);
+
+     private:
+        std::size_t _threads;
+        std::vector<std::pair<std::string, std::string>> _pending;
+    };
 
     /**
      * Expands a leading tilde to the user's home directory
@@ -88,6 +342,9 @@ namespace leatherman { namespace file_util {
     std::string shell_quote(std::string path);
 
     /**
+     * The resolved home directory is cached, so repeated calls do not
+     * hit the environment; the cache refreshes itself when the
+     * environment is mutated through util::environment.
      * @return Returns the home path for the current platform.
      */
     std::string get_home_path();
@@ -0,0 +1,125 @@
+/**
+ * @file
+ * Declares a watcher that reports file modifications.
+ */
+#pragma once
+
+#include <boost/utility/string_ref.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace leatherman { namespace file_util {
+
+    /**
+     * Watches files and invokes a callback when they change.
+     * On Linux changes are delivered by inotify, so watching costs no
+     * I/O between modifications; elsewhere the watcher falls back to
+     * polling the file's modification time at the given interval. A
+     * file replaced by rename (as atomic_write_to_file does) is
+     * reported like an in-place modification. Callbacks are invoked
+     * from the watcher's own thread and must not block it for long.
+     */
+    class file_watcher
+    {
+     public:
+        /**
+         * Constructs a file watcher.
+         * @param poll_interval How often the fallback poller checks for
+         *        changes; on Linux this only bounds how quickly the
+         *        watcher notices a stop or a new watch.
+         */
+        explicit file_watcher(std::chrono::milliseconds poll_interval = std::chrono::milliseconds(1000));
+
+        /**
+         * Destructs the file watcher, stopping its thread.
+         */
+        ~file_watcher();
+
+        /**
+         * Watches the given file for modification.
+         * @param path The path of the file to watch.
+         * @param callback The callback to invoke with the path when the file changes.
+         */
+        void add(std::string const& path, std::function<void(std::string const&)> callback);
+
+        /**
+         * Stops watching the given file.
+         * @param path The path passed to add.
+         */
+        void remove(std::string const& path);
+
+     private:
+        struct watch
+        {
+            std::function<void(std::string const&)> callback;
+            std::time_t mtime;
+        };
+
+        void run();
+
+        std::map<std::string, watch> _watches;
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::thread _thread;
+        std::chrono::milliseconds _interval;
+        bool _stop = false;
+#ifdef __linux__
+        int _inotify_fd = -1;
+        std::map<int, std::string> _watched_dirs;
+        std::map<std::string, int> _dir_descriptors;
+
+        void watch_parent(std::string const& path);
+#endif
+    };
+
+    /**
+     * Tails a file through a file_watcher, delivering only newly
+     * appended lines. The follower reads from its current offset with
+     * the resumable each_line_view whenever the watcher reports a
+     * change, so a growing log is never re-scanned from byte zero; a
+     * file that shrinks - truncated or rotated - is read again from the
+     * start. Lines are delivered from the watcher's thread with
+     * each_line_view's semantics: views valid only for the callback's
+     * duration, and only complete, newline-terminated lines.
+     */
+    class line_follower
+    {
+     public:
+        /**
+         * Constructs a follower and delivers any lines already past the
+         * given offset before new changes are followed.
+         * @param watcher The watcher to follow changes through; it must outlive the follower.
+         * @param path The path of the file to tail.
+         * @param callback The callback to invoke with each appended line; returning false skips the rest of that read, not later ones.
+         * @param offset The byte offset to start from, e.g. one saved by a previous follower.
+         */
+        line_follower(file_watcher& watcher, std::string path,
+                      std::function<bool(boost::string_ref)> callback,
+                      std::uintmax_t offset = 0);
+
+        /**
+         * Destructs the follower, stopping delivery.
+         */
+        ~line_follower();
+
+        /**
+         * @return Returns the current offset, suitable for resuming a later follower where this one stopped.
+         */
+        std::uintmax_t offset() const;
+
+     private:
+        struct state;
+
+        file_watcher& _watcher;
+        std::shared_ptr<state> _state;
+    };
+
+}}  // namespace leatherman::file_util
@@ -0,0 +1,64 @@
+/**
+ * @file
+ * Declares utility functions for hashing file contents.
+ */
+#pragma once
+
+#include <boost/utility/string_ref.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace leatherman { namespace file_util {
+
+    /**
+     * Computes a fast 64-bit content hash incrementally.
+     * The hash is XXH64, which digests at close to memory bandwidth:
+     * its inner loop runs four independent multiply-rotate lanes that
+     * the compiler vectorizes on targets with SIMD multipliers. It is a
+     * content integrity hash, not a cryptographic one - use it to
+     * detect corruption and change, not tampering. The digest matches
+     * the reference XXH64 value on little-endian platforms.
+     */
+    class hasher
+    {
+     public:
+        /**
+         * Constructs a hasher.
+         * @param seed The seed, folded into the digest; two hashers with different seeds disagree on all content.
+         */
+        explicit hasher(std::uint64_t seed = 0);
+
+        /**
+         * Digests the next piece of content. Splitting content across
+         * updates at any boundary yields the same digest as one update.
+         * @param data The content to digest.
+         */
+        void update(boost::string_ref data);
+
+        /**
+         * @return Returns the digest of the content updated so far; further updates may follow.
+         */
+        std::uint64_t digest() const;
+
+     private:
+        std::uint64_t _accumulators[4];
+        std::uint64_t _total = 0;
+        std::uint64_t _seed;
+        char _buffer[32];
+        std::size_t _buffered = 0;
+    };
+
+    /**
+     * Hashes the entire contents of the given file in a single pass.
+     * The file is fed to the hasher through a memory mapping, so the
+     * contents are never copied into an intermediate string the way a
+     * read-then-hash pass copies them.
+     * @param path The path of the file to hash.
+     * @param digest The returned digest, equal to a hasher's digest of the contents.
+     * @param seed The seed passed to the hasher.
+     * @return Returns true if the digest was computed or false if the file is not readable.
+     */
+    bool hash_file(std::string const& path, std::uint64_t& digest, std::uint64_t seed = 0);
+
+}}  // namespace leatherman::file_util
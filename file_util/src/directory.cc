@@ -1,6 +1,17 @@
 #include <leatherman/file_util/directory.hpp>
 #include <leatherman/util/regex.hpp>
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
 
 using namespace std;
 using namespace boost::filesystem;
@@ -8,18 +19,92 @@ using namespace leatherman::util;
 
 namespace leatherman { namespace file_util {
 
-    static void each(string const& directory, file_type type, function<bool(string const&)> const& callback, string const& pattern)
+#ifndef _WIN32
+    // Walks a directory with readdir, classifying entries from d_type so
+    // enumeration is one getdents stream; only entries reported as
+    // DT_UNKNOWN (and symlinks, which the boost iterator also followed
+    // when classifying) cost a stat. Returns false when the callback
+    // stopped the walk.
+    static bool walk(string const& directory, file_type type, function<bool(string const&)> const& callback,
+                     boost::regex const& regex, bool recursive)
+    {
+        DIR* dir = opendir(directory.c_str());
+        if (!dir) {
+            return true;
+        }
+
+        while (auto entry = readdir(dir)) {
+            string name = entry->d_name;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            auto path = directory + "/" + name;
+
+            bool is_dir = false;
+            bool is_file = false;
+            bool recurse_into = false;
+            switch (entry->d_type) {
+                case DT_DIR:
+                    is_dir = true;
+                    recurse_into = true;
+                    break;
+                case DT_REG:
+                    is_file = true;
+                    break;
+                case DT_LNK:
+                case DT_UNKNOWN: {
+                    // Classify by following the link, as the boost
+                    // iterator's status() did, but never recurse through
+                    // a symlink to avoid cycles.
+                    struct stat st;
+                    if (stat(path.c_str(), &st) != 0) {
+                        continue;
+                    }
+                    is_dir = S_ISDIR(st.st_mode);
+                    is_file = S_ISREG(st.st_mode);
+                    recurse_into = is_dir && entry->d_type != DT_LNK;
+                    break;
+                }
+                default:
+                    break;
+            }
+
+            bool matches = (type == regular_file) ? is_file : is_dir;
+            if (matches && (regex.empty() || re_search(name, regex))) {
+                if (!callback(path)) {
+                    closedir(dir);
+                    return false;
+                }
+            }
+            if (recursive && recurse_into) {
+                if (!walk(path, type, callback, regex, true)) {
+                    closedir(dir);
+                    return false;
+                }
+            }
+        }
+        closedir(dir);
+        return true;
+    }
+
+    static void each(string const& directory, file_type type, function<bool(string const&)> const& callback, string const& pattern, bool recursive)
     {
         boost::regex regex;
         if (!pattern.empty()) {
             regex = pattern;
         }
 
+        walk(directory, type, callback, regex, recursive);
+    }
+#else
+    static bool each_level(string const& directory, file_type type, function<bool(string const&)> const& callback,
+                           boost::regex const& regex, bool recursive)
+    {
         // Attempt to iterate the directory
         boost::system::error_code ec;
         directory_iterator it = directory_iterator(directory, ec);
         if (ec) {
-            return;
+            return true;
         }
 
         // Call the callback for any matching entries
@@ -27,25 +112,124 @@ namespace leatherman { namespace file_util {
         for (; it != end; ++it) {
             ec.clear();
             auto status = it->status(ec);
-            if (ec || (status.type() != type)) {
+            if (ec) {
                 continue;
             }
-            if (regex.empty() || re_search(it->path().filename().string(), regex)) {
+            if (status.type() == type &&
+                (regex.empty() || re_search(it->path().filename().string(), regex))) {
                 if (!callback(it->path().string())) {
-                    break;
+                    return false;
+                }
+            }
+            if (recursive && status.type() == directory_file && !is_symlink(it->symlink_status())) {
+                if (!each_level(it->path().string(), type, callback, regex, true)) {
+                    return false;
                 }
             }
         }
+        return true;
     }
 
+    static void each(string const& directory, file_type type, function<bool(string const&)> const& callback, string const& pattern, bool recursive)
+    {
+        boost::regex regex;
+        if (!pattern.empty()) {
+            regex = pattern;
+        }
+
+        each_level(directory, type, callback, regex, recursive);
+    }
+#endif
+
     void each_file(string const& directory, function<bool(string const&)> const& callback, string const& pattern)
     {
-        each(directory, regular_file, callback, pattern);
+        each(directory, regular_file, callback, pattern, false);
+    }
+
+    void each_file_recursive(string const& directory, function<bool(string const&)> const& callback, string const& pattern)
+    {
+        each(directory, regular_file, callback, pattern, true);
     }
 
     void each_subdirectory(string const& directory, function<bool(string const&)> const& callback, string const& pattern)
     {
-        each(directory, directory_file, callback, pattern);
+        each(directory, directory_file, callback, pattern, false);
+    }
+
+    void each_subdirectory_recursive(string const& directory, function<bool(string const&)> const& callback, string const& pattern)
+    {
+        each(directory, directory_file, callback, pattern, true);
+    }
+
+    void walk_parallel(string const& directory, function<bool(string const&)> const& callback, size_t threads)
+    {
+        if (threads == 0) {
+            threads = 1;
+        }
+
+        // Shared queue of directories still to be scanned. A worker
+        // counts as busy while it holds a directory, so the walk is done
+        // when the queue is empty and no worker is busy; the last worker
+        // to go idle wakes the others so they can exit.
+        deque<string> pending { directory };
+        mutex queue_mutex;
+        condition_variable queue_cv;
+        size_t busy = 0;
+        atomic<bool> stopped {false};
+
+        auto worker = [&]() {
+            unique_lock<mutex> lock(queue_mutex);
+            while (true) {
+                while (pending.empty() && busy != 0 && !stopped) {
+                    queue_cv.wait(lock);
+                }
+                if (pending.empty() || stopped) {
+                    queue_cv.notify_all();
+                    return;
+                }
+                auto current = move(pending.front());
+                pending.pop_front();
+                ++busy;
+                lock.unlock();
+
+                vector<string> subdirectories;
+                each_file(current, [&](string const& path) {
+                    if (!callback(path)) {
+                        stopped = true;
+                        return false;
+                    }
+                    return !stopped;
+                });
+                if (!stopped) {
+                    each_subdirectory(current, [&](string const& path) {
+                        // Like the recursive walkers, never descend
+                        // through a symlink, which could cycle.
+                        if (!is_symlink(symlink_status(path))) {
+                            subdirectories.push_back(path);
+                        }
+                        return !stopped;
+                    });
+                }
+
+                lock.lock();
+                --busy;
+                for (auto& subdirectory : subdirectories) {
+                    pending.emplace_back(move(subdirectory));
+                }
+                if (!subdirectories.empty() || (pending.empty() && busy == 0) || stopped) {
+                    queue_cv.notify_all();
+                }
+            }
+        };
+
+        vector<thread> pool;
+        for (size_t i = 1; i < threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& member : pool) {
+            member.join();
+        }
     }
 
 }}  // namespace leatherman::file_util
@@ -2,9 +2,34 @@
 #include <boost/nowide/fstream.hpp>
 #include <boost/nowide/cenv.hpp>
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <cstring>
+#include <map>
 #include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#if defined(SYS_io_uring_setup) && defined(SYS_io_uring_enter)
+#define LEATHERMAN_USE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#endif
+#endif
 #include <leatherman/logging/logging.hpp>
 #include <leatherman/locale/locale.hpp>
+#include <leatherman/util/environment.hpp>
+#include <memory>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -17,17 +42,92 @@ namespace boost_error = boost::system::errc;
 namespace boost_file = boost::filesystem;
 
     bool each_line(string const& path, function<bool(string &)> callback) {
-        boost::nowide::ifstream in(path.c_str());
+        // Compatibility wrapper over the chunked scanner. The string is
+        // reused across lines, so in the steady state there is no
+        // per-line allocation either.
+        string line;
+        return each_line_view(path, [&](boost::string_ref view) {
+            line.assign(view.data(), view.size());
+            return callback(line);
+        });
+    }
+
+    // Reads the stream in large blocks and splits lines in place; only
+    // a line spanning a block boundary is copied into the carry buffer.
+    // When consumed is given, it is advanced past each delivered line
+    // and the trailing partial line is withheld rather than delivered,
+    // so a later scan resuming at *consumed picks it up whole; when it
+    // is null, the trailing line is delivered without its newline.
+    static void scan_lines(boost::nowide::ifstream& in,
+                           function<bool(boost::string_ref)>& callback,
+                           uintmax_t* consumed) {
+        vector<char> buffer(256 * 1024);
+        string carry;
+        while (in) {
+            in.read(buffer.data(), buffer.size());
+            auto count = static_cast<size_t>(in.gcount());
+            if (count == 0) {
+                break;
+            }
+            size_t begin = 0;
+            while (begin < count) {
+                auto found = memchr(buffer.data() + begin, '\n', count - begin);
+                if (!found) {
+                    break;
+                }
+                auto end = static_cast<size_t>(static_cast<char const*>(found) - buffer.data());
+                boost::string_ref line;
+                if (carry.empty()) {
+                    line = boost::string_ref(buffer.data() + begin, end - begin);
+                } else {
+                    carry.append(buffer.data() + begin, end - begin);
+                    line = boost::string_ref(carry);
+                }
+                if (consumed) {
+                    *consumed += line.size() + 1;
+                }
+                auto keep_going = callback(line);
+                carry.clear();
+                if (!keep_going) {
+                    return;
+                }
+                begin = end + 1;
+            }
+            carry.append(buffer.data() + begin, count - begin);
+        }
+        if (!consumed && !carry.empty()) {
+            callback(boost::string_ref(carry));
+        }
+    }
+
+    bool each_line_view(string const& path, function<bool(boost::string_ref)> callback) {
+        boost::nowide::ifstream in(path.c_str(), ios::in | ios::binary);
         if (!in) {
             return false;
         }
+        scan_lines(in, callback, nullptr);
+        return true;
+    }
 
+    bool each_line(string const& path, uintmax_t& offset, function<bool(string &)> callback) {
         string line;
-        while (getline(in, line)) {
-            if (!callback(line)) {
-                break;
-            }
+        return each_line_view(path, offset, [&](boost::string_ref view) {
+            line.assign(view.data(), view.size());
+            return callback(line);
+        });
+    }
+
+    bool each_line_view(string const& path, uintmax_t& offset, function<bool(boost::string_ref)> callback) {
+        boost::nowide::ifstream in(path.c_str(), ios::in | ios::binary);
+        if (!in) {
+            return false;
+        }
+        if (offset != 0) {
+            in.seekg(static_cast<streamoff>(offset));
         }
+        auto consumed = offset;
+        scan_lines(in, callback, &consumed);
+        offset = consumed;
         return true;
     }
 
@@ -50,23 +150,368 @@ namespace boost_file = boost::filesystem;
         return true;
     }
 
+#ifdef LEATHERMAN_USE_IO_URING
+    // A minimal io_uring wrapper: just enough ring state to submit
+    // batches of reads and reap their completions. Set up once per
+    // read_many call; if the kernel lacks io_uring, init fails and the
+    // caller reads the files one by one instead.
+    namespace {
+        struct io_ring
+        {
+            int ring_fd = -1;
+            unsigned* sq_head = nullptr;
+            unsigned* sq_tail = nullptr;
+            unsigned sq_mask = 0;
+            unsigned* sq_array = nullptr;
+            io_uring_sqe* sqes = nullptr;
+            unsigned* cq_head = nullptr;
+            unsigned* cq_tail = nullptr;
+            unsigned cq_mask = 0;
+            io_uring_cqe* cqes = nullptr;
+            unsigned entries = 0;
+
+            void* sq_ptr = MAP_FAILED;
+            size_t sq_len = 0;
+            void* cq_ptr = MAP_FAILED;
+            size_t cq_len = 0;
+            void* sqe_ptr = MAP_FAILED;
+            size_t sqe_len = 0;
+
+            bool init(unsigned wanted)
+            {
+                io_uring_params params;
+                memset(&params, 0, sizeof(params));
+                ring_fd = syscall(SYS_io_uring_setup, wanted, &params);
+                if (ring_fd < 0) {
+                    return false;
+                }
+                entries = params.sq_entries;
+
+                sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+                cq_len = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+                sqe_len = params.sq_entries * sizeof(io_uring_sqe);
+                sq_ptr = mmap(nullptr, sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+                cq_ptr = mmap(nullptr, cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+                sqe_ptr = mmap(nullptr, sqe_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+                if (sq_ptr == MAP_FAILED || cq_ptr == MAP_FAILED || sqe_ptr == MAP_FAILED) {
+                    return false;
+                }
+
+                auto sq_base = static_cast<char*>(sq_ptr);
+                sq_head = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+                sq_tail = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+                sq_mask = *reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+                sq_array = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+                sqes = static_cast<io_uring_sqe*>(sqe_ptr);
+
+                auto cq_base = static_cast<char*>(cq_ptr);
+                cq_head = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+                cq_tail = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+                cq_mask = *reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+                cqes = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+                return true;
+            }
+
+            void push_read(int fd, void* buffer, unsigned length, uint64_t user_data)
+            {
+                auto tail = *sq_tail;
+                auto& sqe = sqes[tail & sq_mask];
+                memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = IORING_OP_READ;
+                sqe.fd = fd;
+                sqe.addr = reinterpret_cast<uint64_t>(buffer);
+                sqe.len = length;
+                sqe.off = 0;
+                sqe.user_data = user_data;
+                sq_array[tail & sq_mask] = tail & sq_mask;
+                __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+            }
+
+            bool submit_and_wait(unsigned submitted)
+            {
+                auto rc = syscall(SYS_io_uring_enter, ring_fd, submitted, submitted, IORING_ENTER_GETEVENTS, nullptr, 0);
+                return rc >= 0;
+            }
+
+            bool pop(io_uring_cqe& completion)
+            {
+                auto head = *cq_head;
+                if (head == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+                    return false;
+                }
+                completion = cqes[head & cq_mask];
+                __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+
+            ~io_ring()
+            {
+                if (sq_ptr != MAP_FAILED) {
+                    munmap(sq_ptr, sq_len);
+                }
+                if (cq_ptr != MAP_FAILED) {
+                    munmap(cq_ptr, cq_len);
+                }
+                if (sqe_ptr != MAP_FAILED) {
+                    munmap(sqe_ptr, sqe_len);
+                }
+                if (ring_fd != -1) {
+                    close(ring_fd);
+                }
+            }
+        };
+    }
+
+    static bool read_many_uring(vector<string> const& paths, vector<string>& contents)
+    {
+        io_ring ring;
+        if (!ring.init(64)) {
+            return false;
+        }
+
+        // Submit the reads in batches of the ring size. Opens stay
+        // synchronous - their latency is dwarfed by the reads - and the
+        // whole file is read into a buffer sized from fstat.
+        for (size_t begin = 0; begin < paths.size(); begin += ring.entries) {
+            auto end = min(begin + ring.entries, paths.size());
+            vector<int> fds(end - begin, -1);
+            unsigned submitted = 0;
+            for (auto index = begin; index < end; ++index) {
+                int fd = ::open(paths[index].c_str(), O_RDONLY | O_CLOEXEC);
+                if (fd == -1) {
+                    continue;
+                }
+                struct stat st;
+                if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+                    ::close(fd);
+                    continue;
+                }
+                fds[index - begin] = fd;
+                contents[index].resize(st.st_size);
+                if (st.st_size == 0) {
+                    continue;
+                }
+                ring.push_read(fd, &contents[index][0], contents[index].size(), index);
+                ++submitted;
+            }
+
+            if (submitted != 0 && !ring.submit_and_wait(submitted)) {
+                for (auto fd : fds) {
+                    if (fd != -1) {
+                        ::close(fd);
+                    }
+                }
+                return false;
+            }
+            io_uring_cqe completion;
+            while (ring.pop(completion)) {
+                auto index = static_cast<size_t>(completion.user_data);
+                auto& content = contents[index];
+                if (completion.res < 0) {
+                    content.clear();
+                } else if (static_cast<size_t>(completion.res) < content.size()) {
+                    // A short read is rare for a regular file; finish it
+                    // with pread rather than resubmitting.
+                    auto done = static_cast<size_t>(completion.res);
+                    while (done < content.size()) {
+                        auto count = ::pread(fds[index - begin], &content[0] + done, content.size() - done, done);
+                        if (count <= 0) {
+                            content.resize(done);
+                            break;
+                        }
+                        done += count;
+                    }
+                }
+            }
+            for (auto fd : fds) {
+                if (fd != -1) {
+                    ::close(fd);
+                }
+            }
+        }
+        return true;
+    }
+#endif  // LEATHERMAN_USE_IO_URING
+
+    vector<string> read_many(vector<string> const& paths)
+    {
+        vector<string> contents(paths.size());
+#ifdef LEATHERMAN_USE_IO_URING
+        static const bool uring_works = []() {
+            io_ring probe;
+            return probe.init(1);
+        }();
+        if (uring_works && read_many_uring(paths, contents)) {
+            return contents;
+        }
+#endif
+        for (size_t index = 0; index < paths.size(); ++index) {
+            read(paths[index], contents[index]);
+        }
+        return contents;
+    }
+
+    mapped_file::mapped_file(std::string const& path) {
+        open(path);
+    }
+
+    bool mapped_file::open(std::string const& path) {
+        _region = boost::interprocess::mapped_region();
+        _mapping = boost::interprocess::file_mapping();
+        _fallback.clear();
+        _open = false;
+
+        try {
+            _mapping = boost::interprocess::file_mapping(path.c_str(), boost::interprocess::read_only);
+            _region = boost::interprocess::mapped_region(_mapping, boost::interprocess::read_only);
+            _open = true;
+        } catch (boost::interprocess::interprocess_exception const&) {
+            // Empty files and filesystems without mmap support cannot be
+            // mapped; fall back to a buffered read.
+            _mapping = boost::interprocess::file_mapping();
+            _open = read(path, _fallback);
+        }
+        return _open;
+    }
+
+    char const* mapped_file::data() const {
+        if (!_open) {
+            return nullptr;
+        }
+        if (_region.get_address()) {
+            return static_cast<char const*>(_region.get_address());
+        }
+        return _fallback.data();
+    }
+
+    size_t mapped_file::size() const {
+        if (_region.get_address()) {
+            return _region.get_size();
+        }
+        return _fallback.size();
+    }
+
+    std::string mapped_file::string() const {
+        if (!_open || size() == 0) {
+            return {};
+        }
+        return std::string(data(), size());
+    }
+
     bool file_readable(const std::string &file_path) {
-        bool exists { false };
         if (file_path.empty()) {
             LOG_WARNING("file path is an empty string");
-        } else {
+            return false;
+        }
+        return check_readable(file_path) == file_status::readable;
+    }
+
+    file_status check_readable(std::string const& path) {
+#ifndef _WIN32
+        // A permission probe plus a minimal stat to exclude
+        // directories; neither opens the file.
+        if (::access(path.c_str(), R_OK) != 0) {
+            return errno == EACCES ? file_status::unreadable : file_status::missing;
+        }
+#if defined(__linux__) && defined(STATX_TYPE)
+        struct statx stx;
+        if (::statx(AT_FDCWD, path.c_str(), AT_STATX_DONT_SYNC, STATX_TYPE, &stx) == 0) {
+            return S_ISDIR(stx.stx_mode) ? file_status::unreadable : file_status::readable;
+        }
+#endif
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0) {
+            return file_status::missing;
+        }
+        return S_ISDIR(st.st_mode) ? file_status::unreadable : file_status::readable;
+#else
+        boost::system::error_code ec;
+        auto status = boost_file::status(path.c_str(), ec);
+        if (!boost_file::exists(status)) {
+            return file_status::missing;
+        }
+        if (boost_file::is_directory(status)) {
+            return file_status::unreadable;
+        }
+        boost::nowide::ifstream file_stream(path.c_str());
+        return file_stream.good() ? file_status::readable : file_status::unreadable;
+#endif
+    }
+
+    vector<file_status> check_many(vector<string> const& paths) {
+        vector<file_status> statuses;
+        statuses.reserve(paths.size());
+        for (auto const& path : paths) {
+            statuses.push_back(check_readable(path));
+        }
+        return statuses;
+    }
+
+#ifdef __linux__
+    // Fast path for Linux: clone the file with FICLONE where the
+    // filesystem supports reflinks, and otherwise move the bytes with
+    // copy_file_range, which never lifts them into userspace. Returns
+    // false when neither is available, in which case the caller falls
+    // back to the portable copy.
+    static bool copy_file_linux(const std::string &source, const std::string &tmp_path) {
+        int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+        if (in == -1) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(in, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(in);
+            return false;
+        }
+        int out = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                         st.st_mode & 07777);
+        if (out == -1) {
+            ::close(in);
+            return false;
+        }
+
+        bool ok = false;
+#ifdef FICLONE
+        ok = ::ioctl(out, FICLONE, in) == 0;
+#endif
+#ifdef SYS_copy_file_range
+        if (!ok) {
+            auto remaining = st.st_size;
+            ok = true;
+            while (remaining > 0) {
+                auto count = syscall(SYS_copy_file_range, in, nullptr, out, nullptr,
+                                     static_cast<size_t>(remaining), 0u);
+                if (count <= 0) {
+                    ok = false;
+                    break;
+                }
+                remaining -= count;
+            }
+        }
+#endif
+        ::close(in);
+        ::close(out);
+        if (!ok) {
+            ::unlink(tmp_path.c_str());
+        }
+        return ok;
+    }
+#endif
+
+    void copy_file(const std::string &source, const std::string &destination) {
+        std::string tmp_path = destination + "~";
+#ifdef __linux__
+        if (!copy_file_linux(source, tmp_path))
+#endif
+        {
             boost::system::error_code ec;
-            boost_file::file_status status = boost_file::status(file_path.c_str(), ec);
-            if (boost_file::exists(status) && !boost_file::is_directory(status)) {
-                boost::nowide::ifstream file_stream(file_path.c_str());
-                exists = file_stream.good();
-                file_stream.close();
-            } else {
-                LOG_DEBUG("Error reading file: {1}", ec.message());
-                exists = false;
+            boost_file::remove(tmp_path, ec);
+            boost_file::copy_file(source, tmp_path, ec);
+            if (ec) {
+                throw boost_file::filesystem_error { _("failed to copy {1} to {2}", source, destination), ec };
             }
         }
-        return exists;
+        boost_file::rename(tmp_path, destination);
     }
 
     void atomic_write_to_file(const std::string &text,
@@ -75,10 +520,80 @@ namespace boost_file = boost::filesystem;
         atomic_write_to_file(text, file_path, {}, mode);
     }
 
+#if defined(__linux__) && defined(O_TMPFILE)
+    // Fast path for Linux: the content goes to an anonymous O_TMPFILE
+    // file preallocated to its final size, then is linked into place, so
+    // no temporary directory entry is ever created. Returns false when
+    // the fast path is unavailable (e.g. a filesystem without O_TMPFILE
+    // support), in which case the caller falls back to the named
+    // temporary file.
+    static bool atomic_write_linux(const std::string &text,
+                                   const std::string &file_path,
+                                   boost::optional<boost_file::perms> perms,
+                                   bool sync) {
+        auto dir = boost_file::path(file_path).parent_path().string();
+        if (dir.empty()) {
+            dir = ".";
+        }
+
+        int fd = ::open(dir.c_str(), O_TMPFILE | O_WRONLY | O_CLOEXEC, 0666);
+        if (fd == -1) {
+            return false;
+        }
+
+        bool ok = true;
+        if (perms) {
+            ok = ::fchmod(fd, static_cast<mode_t>(*perms) & 07777) == 0;
+        }
+        if (ok && !text.empty()) {
+            // Preallocation is best effort; not all filesystems support it.
+            ::fallocate(fd, 0, 0, text.size());
+            size_t written = 0;
+            while (written < text.size()) {
+                auto count = ::write(fd, text.data() + written, text.size() - written);
+                if (count < 0) {
+                    ok = false;
+                    break;
+                }
+                written += count;
+            }
+        }
+        if (ok && sync) {
+            ok = ::fdatasync(fd) == 0;
+        }
+
+        if (ok) {
+            // Link the anonymous file into place via /proc, which needs
+            // no extra privileges. linkat cannot replace an existing
+            // file, so on EEXIST fall back to linking to the usual
+            // temporary name and renaming over the destination.
+            auto proc_path = "/proc/self/fd/" + to_string(fd);
+            if (::linkat(AT_FDCWD, proc_path.c_str(), AT_FDCWD, file_path.c_str(), AT_SYMLINK_FOLLOW) != 0) {
+                if (errno != EEXIST) {
+                    ok = false;
+                } else {
+                    std::string tmp_name = file_path + "~";
+                    ::unlink(tmp_name.c_str());
+                    ok = ::linkat(AT_FDCWD, proc_path.c_str(), AT_FDCWD, tmp_name.c_str(), AT_SYMLINK_FOLLOW) == 0 &&
+                         ::rename(tmp_name.c_str(), file_path.c_str()) == 0;
+                }
+            }
+        }
+        ::close(fd);
+        return ok;
+    }
+#endif
+
     void atomic_write_to_file(const std::string &text,
                               const std::string &file_path,
                               boost::optional<boost_file::perms> perms,
-                              std::ios_base::openmode mode) {
+                              std::ios_base::openmode mode,
+                              bool sync) {
+#if defined(__linux__) && defined(O_TMPFILE)
+        if (atomic_write_linux(text, file_path, perms, sync)) {
+            return;
+        }
+#endif
         boost::nowide::ofstream ofs;
         std::string tmp_name = file_path + "~";
         ofs.open(tmp_name.c_str(), mode);
@@ -94,9 +609,148 @@ namespace boost_file = boost::filesystem;
 
         ofs << text;
         ofs.close();
+#ifndef _WIN32
+        if (sync) {
+            int fd = ::open(tmp_name.c_str(), O_WRONLY);
+            if (fd != -1) {
+                ::fsync(fd);
+                ::close(fd);
+            }
+        }
+#endif
         boost_file::rename(tmp_name.data(), file_path.data());
     }
 
+    streaming_file_writer::streaming_file_writer(std::string file_path, size_t buffer_size) :
+        _file_path(move(file_path)),
+        _tmp_path(_file_path + "~"),
+        _buffer_size(buffer_size == 0 ? 1 : buffer_size) {
+        _buffer.reserve(_buffer_size);
+        _stream.open(_tmp_path.c_str(), ios::binary);
+        if (!_stream.is_open()) {
+            throw boost_file::filesystem_error { _("failed to open {1}", _file_path),
+                                                        boost_error::make_error_code(
+                                                                boost_error::io_error) };
+        }
+    }
+
+    streaming_file_writer::~streaming_file_writer() {
+        if (!_committed) {
+            _stream.close();
+            boost::system::error_code ec;
+            boost_file::remove(_tmp_path, ec);
+        }
+    }
+
+    void streaming_file_writer::append(boost::string_ref data) {
+        // Large appends bypass the buffer; anything else is coalesced
+        // until the buffer fills.
+        if (data.size() >= _buffer_size) {
+            flush();
+            _stream.write(data.data(), data.size());
+            return;
+        }
+        if (_buffer.size() + data.size() > _buffer_size) {
+            flush();
+        }
+        _buffer.append(data.data(), data.size());
+    }
+
+    void streaming_file_writer::flush() {
+        if (!_buffer.empty()) {
+            _stream.write(_buffer.data(), _buffer.size());
+            _buffer.clear();
+        }
+    }
+
+    void streaming_file_writer::commit(bool sync) {
+        flush();
+        _stream.close();
+#ifndef _WIN32
+        if (sync) {
+            int fd = ::open(_tmp_path.c_str(), O_WRONLY);
+            if (fd != -1) {
+                ::fsync(fd);
+                ::close(fd);
+            }
+        }
+#endif
+        boost_file::rename(_tmp_path, _file_path);
+        _committed = true;
+    }
+
+    batch_writer::batch_writer(size_t threads) :
+        _threads(threads == 0 ? 1 : threads) {
+    }
+
+    void batch_writer::add(std::string path, std::string content) {
+        _pending.emplace_back(move(path), move(content));
+    }
+
+    size_t batch_writer::flush(bool sync) {
+        // Group the queued files by directory so each worker writes
+        // whole directories, keeping renames and the final directory
+        // syncs local to one thread.
+        map<string, vector<pair<string, string> const*>> by_directory;
+        for (auto const& entry : _pending) {
+            auto dir = boost_file::path(entry.first).parent_path().string();
+            if (dir.empty()) {
+                dir = ".";
+            }
+            by_directory[dir].push_back(&entry);
+        }
+
+        vector<map<string, vector<pair<string, string> const*>>::const_iterator> directories;
+        for (auto it = by_directory.begin(); it != by_directory.end(); ++it) {
+            directories.push_back(it);
+        }
+
+        atomic<size_t> next {0};
+        atomic<size_t> written {0};
+        auto worker = [&]() {
+            while (true) {
+                auto index = next.fetch_add(1);
+                if (index >= directories.size()) {
+                    break;
+                }
+                for (auto entry : directories[index]->second) {
+                    try {
+                        atomic_write_to_file(entry->second, entry->first, {}, ios::binary);
+                        ++written;
+                    } catch (exception const& ex) {
+                        LOG_WARNING("failed to write {1}: {2}", entry->first, ex.what());
+                    }
+                }
+#ifndef _WIN32
+                if (sync) {
+                    // One sync per directory makes every rename in it
+                    // durable at once, instead of a sync per file.
+                    int fd = ::open(directories[index]->first.c_str(), O_RDONLY);
+                    if (fd != -1) {
+                        ::fsync(fd);
+                        ::close(fd);
+                    }
+                }
+#endif
+            }
+        };
+
+        auto num_threads = min(_threads, directories.size());
+        vector<thread> threads;
+        for (size_t i = 1; i < num_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+        if (!directories.empty()) {
+            worker();
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        _pending.clear();
+        return written.load();
+    }
+
     std::string tilde_expand(std::string path) {
         if (path[0] == '~' && (path.size() == 1 || path[1] == '/')) {
             auto result = get_home_path();
@@ -112,7 +766,23 @@ namespace boost_file = boost::filesystem;
         return ss.str();
     }
 
+    // The resolved home directory, cached against the environment
+    // generation it was read at. Refreshed via a new snapshot rather
+    // than in place so concurrent readers always see a complete entry.
+    struct home_cache
+    {
+        size_t generation;
+        string path;
+    };
+    static shared_ptr<home_cache const> g_home_cache;
+
     std::string get_home_path() {
+        auto generation = util::environment::generation();
+        auto cached = atomic_load(&g_home_cache);
+        if (cached && cached->generation == generation) {
+            return cached->path;
+        }
+
         #ifdef _WIN32
             auto home_var = "USERPROFILE";
             auto result = boost::nowide::getenv(home_var);
@@ -120,12 +790,15 @@ namespace boost_file = boost::filesystem;
             auto home_var = "HOME";
             auto result = boost::nowide::getenv(home_var);
         #endif
-        if (result){
-            return result;
+        auto entry = make_shared<home_cache>();
+        entry->generation = generation;
+        if (result) {
+            entry->path = result;
         } else {
             LOG_WARNING("{1} has not been set", home_var);
-            return "";
         }
+        atomic_store(&g_home_cache, shared_ptr<home_cache const>(move(entry)));
+        return result ? result : "";
     }
 
 }}  // namespace leatherman::file_util
@@ -0,0 +1,224 @@
+#include <leatherman/file_util/file_watcher.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <boost/filesystem.hpp>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace leatherman { namespace file_util {
+
+namespace boost_file = boost::filesystem;
+
+    // Returns the file's modification time, or 0 when it cannot be read.
+    static time_t modification_time(string const& path)
+    {
+        boost::system::error_code ec;
+        auto mtime = boost_file::last_write_time(path, ec);
+        return ec ? 0 : mtime;
+    }
+
+    file_watcher::file_watcher(chrono::milliseconds poll_interval) :
+        _interval(poll_interval)
+    {
+#ifdef __linux__
+        _inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_inotify_fd == -1) {
+            LOG_WARNING("failed to initialize inotify; falling back to polling");
+        }
+#endif
+        _thread = thread([this]() { run(); });
+    }
+
+    file_watcher::~file_watcher()
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_all();
+        _thread.join();
+#ifdef __linux__
+        if (_inotify_fd != -1) {
+            close(_inotify_fd);
+        }
+#endif
+    }
+
+    void file_watcher::add(string const& path, function<void(string const&)> callback)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _watches[path] = watch { move(callback), modification_time(path) };
+#ifdef __linux__
+        if (_inotify_fd != -1) {
+            watch_parent(path);
+        }
+#endif
+    }
+
+    void file_watcher::remove(string const& path)
+    {
+        lock_guard<mutex> lock(_mutex);
+        _watches.erase(path);
+    }
+
+#ifdef __linux__
+    // Watches the file's parent directory rather than the file itself,
+    // so a file replaced by rename - the usual way configuration is
+    // rewritten - keeps being watched; events are filtered back to the
+    // watched paths by name. Called with the mutex held.
+    void file_watcher::watch_parent(string const& path)
+    {
+        auto dir = boost_file::path(path).parent_path().string();
+        if (dir.empty()) {
+            dir = ".";
+        }
+        if (_dir_descriptors.count(dir)) {
+            return;
+        }
+        auto wd = inotify_add_watch(_inotify_fd, dir.c_str(),
+                                    IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB);
+        if (wd == -1) {
+            LOG_WARNING("failed to watch directory {1}", dir);
+            return;
+        }
+        _dir_descriptors[dir] = wd;
+        _watched_dirs[wd] = dir;
+    }
+#endif
+
+    void file_watcher::run()
+    {
+#ifdef __linux__
+        if (_inotify_fd != -1) {
+            vector<char> buffer(16 * 1024);
+            while (true) {
+                struct pollfd pfd { _inotify_fd, POLLIN, 0 };
+                poll(&pfd, 1, static_cast<int>(_interval.count()));
+
+                unique_lock<mutex> lock(_mutex);
+                if (_stop) {
+                    return;
+                }
+                if (!(pfd.revents & POLLIN)) {
+                    continue;
+                }
+                auto count = ::read(_inotify_fd, buffer.data(), buffer.size());
+                for (ssize_t offset = 0; offset < count;) {
+                    auto event = reinterpret_cast<struct inotify_event const*>(buffer.data() + offset);
+                    offset += sizeof(struct inotify_event) + event->len;
+                    if (event->len == 0) {
+                        continue;
+                    }
+                    auto dir = _watched_dirs.find(event->wd);
+                    if (dir == _watched_dirs.end()) {
+                        continue;
+                    }
+                    auto path = dir->second == "." ? string(event->name) : dir->second + "/" + event->name;
+                    auto it = _watches.find(path);
+                    if (it == _watches.end()) {
+                        continue;
+                    }
+                    auto callback = it->second.callback;
+                    lock.unlock();
+                    callback(path);
+                    lock.lock();
+                    if (_stop) {
+                        return;
+                    }
+                }
+            }
+        }
+#endif
+        // Polling fallback: wake up every interval and compare
+        // modification times.
+        unique_lock<mutex> lock(_mutex);
+        while (!_stop) {
+            _cv.wait_for(lock, _interval);
+            if (_stop) {
+                return;
+            }
+            vector<pair<string, function<void(string const&)>>> changed;
+            for (auto& entry : _watches) {
+                auto mtime = modification_time(entry.first);
+                if (mtime != entry.second.mtime) {
+                    entry.second.mtime = mtime;
+                    changed.emplace_back(entry.first, entry.second.callback);
+                }
+            }
+            lock.unlock();
+            for (auto const& entry : changed) {
+                entry.second(entry.first);
+            }
+            lock.lock();
+        }
+    }
+
+    // The follower's state is shared with the watch callback so a
+    // change reported just as the follower is destructed finds it
+    // stopped instead of dangling; the mutex also serializes reads when
+    // the watcher coalesces changes poorly.
+    struct line_follower::state
+    {
+        std::mutex mutex;
+        std::string path;
+        std::function<bool(boost::string_ref)> callback;
+        std::uintmax_t offset;
+        bool stopped = false;
+
+        void poll()
+        {
+            lock_guard<std::mutex> lock(mutex);
+            if (stopped) {
+                return;
+            }
+            boost::system::error_code ec;
+            auto size = boost_file::file_size(path, ec);
+            if (!ec && size < offset) {
+                // The file shrank, so it was truncated or rotated;
+                // whatever replaced it starts over at byte zero.
+                offset = 0;
+            }
+            each_line_view(path, offset, callback);
+        }
+    };
+
+    line_follower::line_follower(file_watcher& watcher, string path,
+                                 function<bool(boost::string_ref)> callback,
+                                 uintmax_t offset) :
+        _watcher(watcher),
+        _state(make_shared<state>())
+    {
+        _state->path = std::move(path);
+        _state->callback = std::move(callback);
+        _state->offset = offset;
+
+        // Start following before the initial catch-up read, so a write
+        // landing between the two is reported rather than missed.
+        auto shared = _state;
+        _watcher.add(_state->path, [shared](string const&) { shared->poll(); });
+        _state->poll();
+    }
+
+    line_follower::~line_follower()
+    {
+        {
+            lock_guard<mutex> lock(_state->mutex);
+            _state->stopped = true;
+        }
+        _watcher.remove(_state->path);
+    }
+
+    uintmax_t line_follower::offset() const
+    {
+        lock_guard<mutex> lock(_state->mutex);
+        return _state->offset;
+    }
+
+}}  // namespace leatherman::file_util
@@ -0,0 +1,143 @@
+#include <leatherman/file_util/hash.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <cstring>
+
+using namespace std;
+
+namespace leatherman { namespace file_util {
+
+    // XXH64 (https://github.com/Cyan4973/xxHash), implemented from the
+    // specification. The stripe loop keeps four accumulators with no
+    // dependencies between them, so it runs one multiply per lane per
+    // cycle once vectorized.
+    static const uint64_t PRIME64_1 = 11400714785074694791ULL;
+    static const uint64_t PRIME64_2 = 14029467366897019727ULL;
+    static const uint64_t PRIME64_3 = 1609587929392839161ULL;
+    static const uint64_t PRIME64_4 = 9650029242287828579ULL;
+    static const uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+    static inline uint64_t rotate_left(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static inline uint64_t read64(char const* data)
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static inline uint32_t read32(char const* data)
+    {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static inline uint64_t round64(uint64_t accumulator, uint64_t lane)
+    {
+        return rotate_left(accumulator + lane * PRIME64_2, 31) * PRIME64_1;
+    }
+
+    static inline uint64_t merge_round(uint64_t digest, uint64_t accumulator)
+    {
+        return (digest ^ round64(0, accumulator)) * PRIME64_1 + PRIME64_4;
+    }
+
+    hasher::hasher(uint64_t seed) :
+        _seed(seed)
+    {
+        _accumulators[0] = seed + PRIME64_1 + PRIME64_2;
+        _accumulators[1] = seed + PRIME64_2;
+        _accumulators[2] = seed;
+        _accumulators[3] = seed - PRIME64_1;
+    }
+
+    void hasher::update(boost::string_ref data)
+    {
+        _total += data.size();
+
+        // Finish a stripe left partial by the previous update first.
+        if (_buffered != 0) {
+            auto wanted = min(sizeof(_buffer) - _buffered, data.size());
+            memcpy(_buffer + _buffered, data.data(), wanted);
+            _buffered += wanted;
+            data.remove_prefix(wanted);
+            if (_buffered < sizeof(_buffer)) {
+                return;
+            }
+            for (size_t lane = 0; lane < 4; ++lane) {
+                _accumulators[lane] = round64(_accumulators[lane], read64(_buffer + lane * 8));
+            }
+            _buffered = 0;
+        }
+
+        while (data.size() >= sizeof(_buffer)) {
+            for (size_t lane = 0; lane < 4; ++lane) {
+                _accumulators[lane] = round64(_accumulators[lane], read64(data.data() + lane * 8));
+            }
+            data.remove_prefix(sizeof(_buffer));
+        }
+
+        if (!data.empty()) {
+            memcpy(_buffer, data.data(), data.size());
+            _buffered = data.size();
+        }
+    }
+
+    uint64_t hasher::digest() const
+    {
+        uint64_t digest;
+        if (_total >= sizeof(_buffer)) {
+            digest = rotate_left(_accumulators[0], 1) + rotate_left(_accumulators[1], 7) +
+                     rotate_left(_accumulators[2], 12) + rotate_left(_accumulators[3], 18);
+            for (auto accumulator : _accumulators) {
+                digest = merge_round(digest, accumulator);
+            }
+        } else {
+            digest = _seed + PRIME64_5;
+        }
+        digest += _total;
+
+        auto remaining = _buffer;
+        auto count = _buffered;
+        while (count >= 8) {
+            digest = rotate_left(digest ^ round64(0, read64(remaining)), 27) * PRIME64_1 + PRIME64_4;
+            remaining += 8;
+            count -= 8;
+        }
+        if (count >= 4) {
+            digest = rotate_left(digest ^ read32(remaining) * PRIME64_1, 23) * PRIME64_2 + PRIME64_3;
+            remaining += 4;
+            count -= 4;
+        }
+        while (count > 0) {
+            digest = rotate_left(digest ^ static_cast<unsigned char>(*remaining) * PRIME64_5, 11) * PRIME64_1;
+            ++remaining;
+            --count;
+        }
+
+        digest ^= digest >> 33;
+        digest *= PRIME64_2;
+        digest ^= digest >> 29;
+        digest *= PRIME64_3;
+        digest ^= digest >> 32;
+        return digest;
+    }
+
+    bool hash_file(string const& path, uint64_t& digest, uint64_t seed)
+    {
+        mapped_file contents;
+        if (!contents.open(path)) {
+            return false;
+        }
+        hasher hash { seed };
+        if (contents.size() != 0) {
+            hash.update(boost::string_ref(contents.data(), contents.size()));
+        }
+        digest = hash.digest();
+        return true;
+    }
+
+}}  // namespace leatherman::file_util
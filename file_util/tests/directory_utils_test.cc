@@ -3,6 +3,8 @@
 #include <leatherman/file_util/directory.hpp>
 #include "fixtures.hpp"
 #include <boost/filesystem.hpp>
+#include <atomic>
+#include <mutex>
 
 using namespace leatherman::file_util;
 
@@ -85,3 +87,105 @@ TEST_CASE("file_util::each_subdirectory", "[utils]") {
         REQUIRE(count == 1);
     }
 }
+
+TEST_CASE("file_util::each_file_recursive", "[utils]") {
+    temp_directory directory;
+    atomic_write_to_file("top\n", directory.get_dir_name() + "/top");
+    boost::filesystem::create_directories(directory.get_dir_name() + "/sub/nested");
+    atomic_write_to_file("sub\n", directory.get_dir_name() + "/sub/inner");
+    atomic_write_to_file("nested\n", directory.get_dir_name() + "/sub/nested/deep");
+
+    SECTION("files in nested directories should be visited") {
+        std::set<std::string> file_contents;
+        each_file_recursive(directory.get_dir_name(), [&file_contents](std::string const &path) {
+            file_contents.insert(read(path));
+            return true;
+        });
+        REQUIRE(file_contents.size() == 3u);
+        REQUIRE(file_contents.find("top\n") != file_contents.end());
+        REQUIRE(file_contents.find("sub\n") != file_contents.end());
+        REQUIRE(file_contents.find("nested\n") != file_contents.end());
+    }
+
+    SECTION("the pattern is matched against file names at any depth") {
+        std::string content = "N/A";
+        each_file_recursive(directory.get_dir_name(), [&content](std::string const &path) {
+            return !read(path, content);
+        }, "deep");
+        REQUIRE(content == "nested\n");
+    }
+
+    SECTION("a false callback stops the walk") {
+        int count = 0;
+        each_file_recursive(directory.get_dir_name(), [&count](std::string const& path) {
+            count++;
+            return false;
+        });
+        REQUIRE(count == 1);
+    }
+}
+
+TEST_CASE("file_util::each_subdirectory_recursive", "[utils]") {
+    temp_directory directory;
+    boost::filesystem::create_directories(directory.get_dir_name() + "/sub/nested");
+    boost::filesystem::create_directory(directory.get_dir_name() + "/other");
+
+    SECTION("nested subdirectories should be visited") {
+        int counter = 0;
+        each_subdirectory_recursive(directory.get_dir_name(), [&counter](std::string const &path) {
+            counter++;
+            return true;
+        });
+        REQUIRE(counter == 3);
+    }
+
+    SECTION("can find nested directories that match a pattern") {
+        int counter = 0;
+        each_subdirectory_recursive(directory.get_dir_name(), [&counter](std::string const &path) {
+            counter++;
+            return true;
+        }, "nested");
+        REQUIRE(counter == 1);
+    }
+}
+
+TEST_CASE("file_util::walk_parallel", "[utils]") {
+    temp_directory directory;
+    atomic_write_to_file("top\n", directory.get_dir_name() + "/top");
+    boost::filesystem::create_directories(directory.get_dir_name() + "/sub/nested");
+    atomic_write_to_file("sub\n", directory.get_dir_name() + "/sub/inner");
+    atomic_write_to_file("nested\n", directory.get_dir_name() + "/sub/nested/deep");
+
+    SECTION("files in nested directories should be visited") {
+        std::mutex mutex;
+        std::set<std::string> file_contents;
+        walk_parallel(directory.get_dir_name(), [&](std::string const &path) {
+            auto content = read(path);
+            std::lock_guard<std::mutex> lock(mutex);
+            file_contents.insert(content);
+            return true;
+        });
+        REQUIRE(file_contents.size() == 3u);
+        REQUIRE(file_contents.find("top\n") != file_contents.end());
+        REQUIRE(file_contents.find("sub\n") != file_contents.end());
+        REQUIRE(file_contents.find("nested\n") != file_contents.end());
+    }
+
+    SECTION("it works with a single thread") {
+        std::atomic<int> count {0};
+        walk_parallel(directory.get_dir_name(), [&](std::string const &path) {
+            count++;
+            return true;
+        }, 1);
+        REQUIRE(count == 3);
+    }
+
+    SECTION("a false callback stops the walk") {
+        std::atomic<int> count {0};
+        walk_parallel(directory.get_dir_name(), [&](std::string const &path) {
+            count++;
+            return false;
+        }, 1);
+        REQUIRE(count == 1);
+    }
+}
@@ -1,5 +1,6 @@
 #include <catch.hpp>
 #include <leatherman/file_util/file.hpp>
+#include <leatherman/util/environment.hpp>
 #include "fixtures.hpp"
 #include <boost/filesystem.hpp>
 
@@ -11,12 +12,29 @@ using namespace leatherman::file_util;
 
 TEST_CASE("file_util::tilde_expand", "[utils]") {
 
+    // Set through util::environment so the cached home directory
+    // refreshes.
 #ifdef _WIN32
-    _putenv("USERPROFILE=/testhome");
+    leatherman::util::environment::set("USERPROFILE", "/testhome");
 #else
-    setenv("HOME", "/testhome", 1);
+    leatherman::util::environment::set("HOME", "/testhome");
 #endif
 
+    SECTION("the home directory lookup is cached") {
+        REQUIRE(get_home_path() == "/testhome");
+#ifdef _WIN32
+        leatherman::util::environment::set("USERPROFILE", "/otherhome");
+#else
+        leatherman::util::environment::set("HOME", "/otherhome");
+#endif
+        REQUIRE(get_home_path() == "/otherhome");
+#ifdef _WIN32
+        leatherman::util::environment::set("USERPROFILE", "/testhome");
+#else
+        leatherman::util::environment::set("HOME", "/testhome");
+#endif
+    }
+
     SECTION("empty path should be empty") {
         REQUIRE(tilde_expand("") == "");
     }
@@ -109,6 +127,43 @@ TEST_CASE("lth_file::file_readable", "[utils]") {
     }
 }
 
+TEST_CASE("file_util::check_readable", "[utils]") {
+    SECTION("a readable file is reported as readable") {
+        temp_file file("content");
+        REQUIRE(check_readable(file.get_file_name()) == file_status::readable);
+    }
+
+    SECTION("a nonexistent path is reported as missing") {
+        REQUIRE(check_readable(unique_fixture_path().string()) == file_status::missing);
+    }
+
+    SECTION("a directory is reported as unreadable") {
+        temp_directory dir;
+        REQUIRE(check_readable(dir.get_dir_name()) == file_status::unreadable);
+    }
+}
+
+TEST_CASE("file_util::check_many", "[utils]") {
+    SECTION("statuses are returned per path, in order") {
+        temp_directory dir;
+        temp_file file("content");
+        std::vector<std::string> paths {
+            file.get_file_name(),
+            unique_fixture_path().string(),
+            dir.get_dir_name()
+        };
+
+        auto statuses = check_many(paths);
+        REQUIRE(statuses == std::vector<file_status>({ file_status::readable,
+                                                       file_status::missing,
+                                                       file_status::unreadable }));
+    }
+
+    SECTION("an empty batch yields an empty result") {
+        REQUIRE(check_many({}).empty());
+    }
+}
+
 TEST_CASE("lth_file::atomic_write_to_file", "[utils]") {
     SECTION("it can write to a regular file, ensure it exists, and delete it") {
         auto file_path = unique_fixture_path().string();
@@ -127,6 +182,13 @@ TEST_CASE("lth_file::atomic_write_to_file", "[utils]") {
         REQUIRE(read(file.get_file_name()) == "test");
     }
 
+    SECTION("can write durably") {
+        auto file_path = unique_fixture_path().string();
+        atomic_write_to_file("test\n", file_path, {}, std::ios::binary, true);
+        REQUIRE(read(file_path) == "test\n");
+        boost::filesystem::remove(file_path);
+    }
+
 #ifndef _WIN32
     SECTION("can write a file with permissions") {
         auto file_path = unique_fixture_path().string();
@@ -163,6 +225,197 @@ TEST_CASE("file_util::read", "[utils]") {
     }
 }
 
+TEST_CASE("file_util::read_many", "[utils]") {
+
+    SECTION("an empty batch yields an empty result") {
+        REQUIRE(read_many({}).empty());
+    }
+
+    SECTION("contents are returned in path order") {
+        temp_file first("first\n"), second("second\n"), third("third\n");
+        auto contents = read_many({first.get_file_name(), second.get_file_name(), third.get_file_name()});
+        REQUIRE(contents == std::vector<std::string>({"first\n", "second\n", "third\n"}));
+    }
+
+    SECTION("an unreadable file yields an empty string") {
+        temp_file file("present\n");
+        auto contents = read_many({"does_not_exist", file.get_file_name()});
+        REQUIRE(contents == std::vector<std::string>({"", "present\n"}));
+    }
+
+    SECTION("batches larger than the ring are read completely") {
+        temp_directory directory;
+        std::vector<std::string> paths;
+        for (int i = 0; i < 150; ++i) {
+            auto path = directory.get_dir_name() + "/file" + std::to_string(i);
+            atomic_write_to_file("content " + std::to_string(i), path);
+            paths.push_back(path);
+        }
+        auto contents = read_many(paths);
+        REQUIRE(contents.size() == paths.size());
+        for (int i = 0; i < 150; ++i) {
+            REQUIRE(contents[i] == "content " + std::to_string(i));
+        }
+    }
+}
+
+TEST_CASE("file_util::mapped_file", "[utils]") {
+
+    SECTION("opening a nonexistent file fails") {
+        mapped_file file;
+        REQUIRE_FALSE(file.open("does_not_exist"));
+        REQUIRE(file.data() == nullptr);
+        REQUIRE(file.size() == 0u);
+        REQUIRE(file.string() == "");
+    }
+
+    SECTION("it provides a view of the file contents") {
+        auto file_path = unique_fixture_path().string();
+        atomic_write_to_file("mapped contents\n", file_path);
+        mapped_file file(file_path);
+        REQUIRE(file.data() != nullptr);
+        REQUIRE(file.size() == 16u);
+        REQUIRE(file.string() == "mapped contents\n");
+        boost::filesystem::remove(file_path);
+    }
+
+    SECTION("an empty file falls back to an empty view") {
+        auto file_path = unique_fixture_path().string();
+        atomic_write_to_file("", file_path);
+        mapped_file file;
+        REQUIRE(file.open(file_path));
+        REQUIRE(file.size() == 0u);
+        REQUIRE(file.string() == "");
+        boost::filesystem::remove(file_path);
+    }
+
+    SECTION("reopening replaces the view") {
+        auto first_path = unique_fixture_path().string();
+        auto second_path = unique_fixture_path().string();
+        atomic_write_to_file("first\n", first_path);
+        atomic_write_to_file("second\n", second_path);
+        mapped_file file(first_path);
+        REQUIRE(file.open(second_path));
+        REQUIRE(file.string() == "second\n");
+        boost::filesystem::remove(first_path);
+        boost::filesystem::remove(second_path);
+    }
+}
+
+TEST_CASE("file_util::streaming_file_writer", "[utils]") {
+
+    SECTION("appended data lands in the destination on commit") {
+        auto file_path = unique_fixture_path().string();
+        streaming_file_writer writer(file_path);
+        writer.append("first ");
+        writer.append("second\n");
+        REQUIRE_FALSE(file_readable(file_path));
+        writer.commit();
+        REQUIRE(read(file_path) == "first second\n");
+        boost::filesystem::remove(file_path);
+    }
+
+    SECTION("appends larger than the buffer are written through") {
+        auto file_path = unique_fixture_path().string();
+        std::string big(64, 'x');
+        streaming_file_writer writer(file_path, 16);
+        writer.append("small ");
+        writer.append(big);
+        writer.append(" tail");
+        writer.commit(true);
+        REQUIRE(read(file_path) == "small " + big + " tail");
+        boost::filesystem::remove(file_path);
+    }
+
+    SECTION("an uncommitted writer leaves nothing behind") {
+        auto file_path = unique_fixture_path().string();
+        {
+            streaming_file_writer writer(file_path);
+            writer.append("discarded");
+        }
+        REQUIRE_FALSE(file_readable(file_path));
+        REQUIRE_FALSE(file_readable(file_path + "~"));
+    }
+
+    SECTION("committing replaces an existing file") {
+        temp_file file("old content");
+        streaming_file_writer writer(file.get_file_name());
+        writer.append("new content");
+        writer.commit();
+        REQUIRE(read(file.get_file_name()) == "new content");
+    }
+}
+
+TEST_CASE("file_util::batch_writer", "[utils]") {
+
+    SECTION("flushing an empty batch writes nothing") {
+        batch_writer writer;
+        REQUIRE(writer.flush() == 0u);
+    }
+
+    SECTION("all queued files are written") {
+        temp_directory first_dir, second_dir;
+        batch_writer writer(2);
+        writer.add(first_dir.get_dir_name() + "/a.txt", "content a");
+        writer.add(first_dir.get_dir_name() + "/b.txt", "content b");
+        writer.add(second_dir.get_dir_name() + "/c.txt", "content c");
+        REQUIRE(writer.flush() == 3u);
+        REQUIRE(read(first_dir.get_dir_name() + "/a.txt") == "content a");
+        REQUIRE(read(first_dir.get_dir_name() + "/b.txt") == "content b");
+        REQUIRE(read(second_dir.get_dir_name() + "/c.txt") == "content c");
+    }
+
+    SECTION("a failed write does not stop the rest of the batch") {
+        temp_directory dir;
+        batch_writer writer;
+        writer.add("/nonexistent_directory/a.txt", "content a");
+        writer.add(dir.get_dir_name() + "/b.txt", "content b");
+        REQUIRE(writer.flush() == 1u);
+        REQUIRE(read(dir.get_dir_name() + "/b.txt") == "content b");
+    }
+
+    SECTION("the queue is cleared by flush") {
+        temp_directory dir;
+        batch_writer writer;
+        writer.add(dir.get_dir_name() + "/a.txt", "content a");
+        REQUIRE(writer.flush(true) == 1u);
+        REQUIRE(writer.flush() == 0u);
+    }
+}
+
+TEST_CASE("file_util::copy_file", "[utils]") {
+
+    SECTION("the copy has the source's contents") {
+        temp_directory dir;
+        std::string content(512 * 1024, 'x');
+        content += "tail";
+        auto source = dir.get_dir_name() + "/source.bin";
+        auto destination = dir.get_dir_name() + "/copy.bin";
+        atomic_write_to_file(content, source);
+
+        copy_file(source, destination);
+        REQUIRE(read(destination) == content);
+        REQUIRE(read(source) == content);
+    }
+
+    SECTION("an existing destination is replaced") {
+        temp_directory dir;
+        auto source = dir.get_dir_name() + "/source.txt";
+        auto destination = dir.get_dir_name() + "/copy.txt";
+        atomic_write_to_file("new content", source);
+        atomic_write_to_file("old content", destination);
+
+        copy_file(source, destination);
+        REQUIRE(read(destination) == "new content");
+    }
+
+    SECTION("copying a nonexistent source throws") {
+        temp_directory dir;
+        REQUIRE_THROWS(copy_file(dir.get_dir_name() + "/missing",
+                                 dir.get_dir_name() + "/copy"));
+    }
+}
+
 TEST_CASE("file_util::each_line", "[utils]") {
 
     SECTION("trying to read a nonexistent file returns false") {
@@ -193,3 +446,137 @@ TEST_CASE("file_util::each_line", "[utils]") {
         REQUIRE(lines[0] == "test1");
     }
 }
+
+TEST_CASE("file_util::each_line_view", "[utils]") {
+
+    SECTION("trying to read a nonexistent file returns false") {
+        REQUIRE_FALSE(each_line_view("does_not_exist", [](boost::string_ref) {
+            FAIL("should not be called");
+            return true;
+        }));
+    }
+
+    SECTION("views are delivered for each line") {
+        temp_file file("test1\ntest2\ntest3\n");
+        int i = 0;
+        REQUIRE(each_line_view(file.get_file_name(), [&i](boost::string_ref line) {
+            i++;
+            return line == ("test" + std::to_string(i));
+        }));
+        REQUIRE(i == 3);
+    }
+
+    SECTION("a final line without a newline is delivered") {
+        temp_file file("first\nlast");
+        std::vector<std::string> lines;
+        REQUIRE(each_line_view(file.get_file_name(), [&](boost::string_ref line) {
+            lines.emplace_back(line.data(), line.size());
+            return true;
+        }));
+        REQUIRE(lines == std::vector<std::string>({"first", "last"}));
+    }
+
+    SECTION("empty lines are delivered") {
+        temp_file file("first\n\nthird\n");
+        std::vector<std::string> lines;
+        REQUIRE(each_line_view(file.get_file_name(), [&](boost::string_ref line) {
+            lines.emplace_back(line.data(), line.size());
+            return true;
+        }));
+        REQUIRE(lines == std::vector<std::string>({"first", "", "third"}));
+    }
+
+    SECTION("a callback that returns false stops the scan") {
+        temp_file file("test1\ntest2\ntest3\n");
+        int i = 0;
+        REQUIRE(each_line_view(file.get_file_name(), [&](boost::string_ref) {
+            i++;
+            return false;
+        }));
+        REQUIRE(i == 1);
+    }
+}
+
+TEST_CASE("file_util::each_line_view - resuming at an offset", "[utils]") {
+
+    SECTION("trying to read a nonexistent file returns false") {
+        std::uintmax_t offset = 0;
+        REQUIRE_FALSE(each_line_view("does_not_exist", offset, [](boost::string_ref) {
+            FAIL("should not be called");
+            return true;
+        }));
+        REQUIRE(offset == 0u);
+    }
+
+    SECTION("the offset advances past the delivered lines") {
+        temp_file file("first\nsecond\n");
+        std::uintmax_t offset = 0;
+        std::vector<std::string> lines;
+        REQUIRE(each_line_view(file.get_file_name(), offset, [&](boost::string_ref line) {
+            lines.emplace_back(line.data(), line.size());
+            return true;
+        }));
+        REQUIRE(lines == std::vector<std::string>({"first", "second"}));
+        REQUIRE(offset == 13u);
+    }
+
+    SECTION("a second call from the offset delivers only appended lines") {
+        temp_file file("first\n");
+        std::uintmax_t offset = 0;
+        REQUIRE(each_line_view(file.get_file_name(), offset, [](boost::string_ref) {
+            return true;
+        }));
+
+        boost::nowide::ofstream appender(file.get_file_name().c_str(),
+                                         std::ios::binary | std::ios::app);
+        appender << "second\n";
+        appender.close();
+
+        std::vector<std::string> lines;
+        REQUIRE(each_line_view(file.get_file_name(), offset, [&](boost::string_ref line) {
+            lines.emplace_back(line.data(), line.size());
+            return true;
+        }));
+        REQUIRE(lines == std::vector<std::string>({"second"}));
+        REQUIRE(offset == 13u);
+    }
+
+    SECTION("a trailing partial line is withheld until completed") {
+        temp_file file("first\npart");
+        std::uintmax_t offset = 0;
+        std::vector<std::string> lines;
+        REQUIRE(each_line_view(file.get_file_name(), offset, [&](boost::string_ref line) {
+            lines.emplace_back(line.data(), line.size());
+            return true;
+        }));
+        REQUIRE(lines == std::vector<std::string>({"first"}));
+        REQUIRE(offset == 6u);
+
+        boost::nowide::ofstream appender(file.get_file_name().c_str(),
+                                         std::ios::binary | std::ios::app);
+        appender << "ial\n";
+        appender.close();
+
+        REQUIRE(each_line_view(file.get_file_name(), offset, [&](boost::string_ref line) {
+            lines.emplace_back(line.data(), line.size());
+            return true;
+        }));
+        REQUIRE(lines == std::vector<std::string>({"first", "partial"}));
+    }
+
+    SECTION("a callback that returns false leaves the offset resumable") {
+        temp_file file("test1\ntest2\ntest3\n");
+        std::uintmax_t offset = 0;
+        REQUIRE(each_line_view(file.get_file_name(), offset, [](boost::string_ref) {
+            return false;
+        }));
+        REQUIRE(offset == 6u);
+
+        std::vector<std::string> lines;
+        REQUIRE(each_line(file.get_file_name(), offset, [&](std::string& line) {
+            lines.emplace_back(std::move(line));
+            return true;
+        }));
+        REQUIRE(lines == std::vector<std::string>({"test2", "test3"}));
+    }
+}
@@ -0,0 +1,118 @@
+#include <catch.hpp>
+#include <leatherman/file_util/file.hpp>
+#include <leatherman/file_util/file_watcher.hpp>
+#include "fixtures.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace leatherman::file_util;
+
+// Waits up to five seconds for the condition to become true, so the
+// tests tolerate scheduling delays without a fixed sleep.
+static bool eventually(std::function<bool()> condition)
+{
+    for (int i = 0; i < 500; ++i) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return condition();
+}
+
+TEST_CASE("file_util::file_watcher", "[utils]") {
+    temp_directory directory;
+    auto path = directory.get_dir_name() + "/watched.conf";
+    atomic_write_to_file("original\n", path);
+
+    file_watcher watcher{std::chrono::milliseconds(50)};
+
+    SECTION("a modification invokes the callback with the path") {
+        std::atomic<int> changes {0};
+        std::string reported;
+        watcher.add(path, [&](std::string const& changed) {
+            reported = changed;
+            changes++;
+        });
+        atomic_write_to_file("updated\n", path);
+        REQUIRE(eventually([&]() { return changes > 0; }));
+        REQUIRE(reported == path);
+    }
+
+    SECTION("a removed watch no longer fires") {
+        std::atomic<int> changes {0};
+        watcher.add(path, [&](std::string const&) {
+            changes++;
+        });
+        watcher.remove(path);
+        atomic_write_to_file("updated\n", path);
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        REQUIRE(changes == 0);
+    }
+
+    SECTION("other files in the directory do not fire the watch") {
+        std::atomic<int> changes {0};
+        watcher.add(path, [&](std::string const&) {
+            changes++;
+        });
+        atomic_write_to_file("other\n", directory.get_dir_name() + "/other.conf");
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        REQUIRE(changes == 0);
+    }
+}
+
+TEST_CASE("file_util::line_follower", "[utils]") {
+    temp_directory directory;
+    auto path = directory.get_dir_name() + "/followed.log";
+    atomic_write_to_file("one\n", path);
+
+    file_watcher watcher{std::chrono::milliseconds(50)};
+
+    std::mutex mutex;
+    std::vector<std::string> lines;
+    auto record = [&](boost::string_ref line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lines.emplace_back(line.data(), line.size());
+        return true;
+    };
+    auto recorded = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return lines;
+    };
+
+    SECTION("existing lines are delivered, then only appended ones") {
+        line_follower follower{watcher, path, record};
+        REQUIRE(eventually([&]() { return recorded().size() == 1u; }));
+
+        atomic_write_to_file("one\ntwo\nthree\n", path);
+        REQUIRE(eventually([&]() { return recorded().size() == 3u; }));
+        REQUIRE(recorded() == std::vector<std::string>({"one", "two", "three"}));
+        REQUIRE(follower.offset() == 14u);
+    }
+
+    SECTION("a saved offset resumes where an earlier follower stopped") {
+        std::uintmax_t saved = 0;
+        {
+            line_follower follower{watcher, path, record};
+            REQUIRE(eventually([&]() { return recorded().size() == 1u; }));
+            saved = follower.offset();
+        }
+        atomic_write_to_file("one\ntwo\n", path);
+
+        line_follower follower{watcher, path, record, saved};
+        REQUIRE(eventually([&]() { return recorded().size() == 2u; }));
+        REQUIRE(recorded() == std::vector<std::string>({"one", "two"}));
+    }
+
+    SECTION("a file that shrinks is read again from the start") {
+        line_follower follower{watcher, path, record};
+        REQUIRE(eventually([&]() { return recorded().size() == 1u; }));
+
+        atomic_write_to_file("z\n", path);
+        REQUIRE(eventually([&]() { return recorded().size() == 2u; }));
+        REQUIRE(recorded() == std::vector<std::string>({"one", "z"}));
+    }
+}
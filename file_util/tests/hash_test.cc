@@ -0,0 +1,75 @@
+#include <catch.hpp>
+#include <leatherman/file_util/hash.hpp>
+#include "fixtures.hpp"
+#include <string>
+
+using namespace leatherman::file_util;
+
+// Digests a string in one update.
+static std::uint64_t hash_of(std::string const& content, std::uint64_t seed = 0)
+{
+    hasher hash {seed};
+    hash.update(content);
+    return hash.digest();
+}
+
+TEST_CASE("file_util::hasher", "[utils]") {
+
+    SECTION("known digests match the XXH64 reference values") {
+        REQUIRE(hash_of("") == 0xEF46DB3751D8E999ULL);
+        REQUIRE(hash_of("abc") == 0x44BC2CF5AD770999ULL);
+    }
+
+    SECTION("the seed changes the digest") {
+        REQUIRE(hash_of("abc", 1) != hash_of("abc"));
+    }
+
+    SECTION("splitting the content across updates does not change the digest") {
+        std::string content;
+        for (int i = 0; i < 100; ++i) {
+            content += "line " + std::to_string(i) + "\n";
+        }
+        auto expected = hash_of(content);
+
+        for (size_t split : {1u, 7u, 31u, 32u, 33u, 64u, 100u}) {
+            hasher hash {};
+            for (size_t begin = 0; begin < content.size(); begin += split) {
+                hash.update(boost::string_ref(content).substr(begin, split));
+            }
+            REQUIRE(hash.digest() == expected);
+        }
+    }
+
+    SECTION("the digest can be read between updates") {
+        hasher hash {};
+        hash.update("ab");
+        REQUIRE(hash.digest() == hash_of("ab"));
+        hash.update("c");
+        REQUIRE(hash.digest() == hash_of("abc"));
+    }
+}
+
+TEST_CASE("file_util::hash_file", "[utils]") {
+
+    SECTION("hashing a nonexistent file returns false") {
+        std::uint64_t digest;
+        REQUIRE_FALSE(hash_file("does_not_exist", digest));
+    }
+
+    SECTION("the digest equals a hasher's digest of the contents") {
+        std::string content(100 * 1024, 'x');
+        content += "tail";
+        temp_file file(content);
+
+        std::uint64_t digest;
+        REQUIRE(hash_file(file.get_file_name(), digest));
+        REQUIRE(digest == hash_of(content));
+    }
+
+    SECTION("an empty file hashes like empty content") {
+        temp_file file("");
+        std::uint64_t digest;
+        REQUIRE(hash_file(file.get_file_name(), digest));
+        REQUIRE(digest == hash_of(""));
+    }
+}
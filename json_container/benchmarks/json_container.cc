@@ -0,0 +1,119 @@
+/**
+ * @file
+ * Measures JsonContainer parse, serialization, access and copy/move
+ * performance. Run by hand when measuring a change to the container;
+ * each operation runs over a small, a wide (3k-key) and a deep corpus
+ * so regressions in any shape of document show up.
+ */
+#include <leatherman/json_container/json_container.hpp>
+#include <benchmark.hpp>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::json_container;
+
+namespace {
+
+    // The corpora are generated rather than checked in: the shapes are
+    // what matter and generating them keeps the repository small.
+    string small_corpus()
+    {
+        return "{\"module\":\"storage\",\"result\":true,\"duration\":0.42,"
+               "\"tags\":[\"a\",\"b\",\"c\"],\"metadata\":{\"version\":3}}";
+    }
+
+    string wide_corpus()
+    {
+        ostringstream buffer;
+        buffer << "{";
+        for (int i = 0; i < 3000; ++i) {
+            if (i > 0) {
+                buffer << ",";
+            }
+            buffer << "\"key_" << i << "\":" << i;
+        }
+        buffer << "}";
+        return buffer.str();
+    }
+
+    string deep_corpus()
+    {
+        string document;
+        for (int i = 0; i < 100; ++i) {
+            document += "{\"nested\":";
+        }
+        document += "42";
+        for (int i = 0; i < 100; ++i) {
+            document += "}";
+        }
+        return document;
+    }
+
+    const size_t warmup = 100;
+    const size_t iterations = 2000;
+
+    void run(string const& name, string const& corpus)
+    {
+        auto parse = leatherman::benchmark::measure(warmup, iterations, [&]() {
+            JsonContainer parsed { corpus };
+        });
+        leatherman::benchmark::report(name + " parse", 1, parse);
+
+        JsonContainer document { corpus };
+        auto serialize = leatherman::benchmark::measure(warmup, iterations, [&]() {
+            document.toString();
+        });
+        leatherman::benchmark::report(name + " toString", 1, serialize);
+
+        auto copy = leatherman::benchmark::measure(warmup, iterations, [&]() {
+            JsonContainer copied { document };
+        });
+        leatherman::benchmark::report(name + " copy", 1, copy);
+
+        auto move_roundtrip = leatherman::benchmark::measure(warmup, iterations, [&]() {
+            JsonContainer moved { std::move(document) };
+            document = std::move(moved);
+        });
+        leatherman::benchmark::report(name + " move", 1, move_roundtrip);
+    }
+
+}  // namespace
+
+LEATHERMAN_BENCHMARK(json_container)
+{
+    run("small", small_corpus());
+    run("wide", wide_corpus());
+    run("deep", deep_corpus());
+
+    // Access patterns on the wide document: single keys, a nested
+    // path, and a full keys() sweep.
+    JsonContainer wide { wide_corpus() };
+    auto get = leatherman::benchmark::measure(warmup, iterations, [&]() {
+        wide.get<int>("key_1500");
+    });
+    leatherman::benchmark::report("wide get", 1, get);
+
+    auto set = leatherman::benchmark::measure(warmup, iterations, [&]() {
+        wide.set<int>("key_1500", 7);
+    });
+    leatherman::benchmark::report("wide set", 1, set);
+
+    auto keys = leatherman::benchmark::measure(warmup, iterations / 10, [&]() {
+        wide.keys();
+    });
+    leatherman::benchmark::report("wide keys", 1, keys);
+
+    JsonContainer nested { "{\"a\":{\"b\":{\"c\":{\"d\":1}}}}" };
+    auto nested_get = leatherman::benchmark::measure(warmup, iterations, [&]() {
+        nested.get<int>({ "a", "b", "c", "d" });
+    });
+    leatherman::benchmark::report("nested get", 1, nested_get);
+
+    auto nested_set = leatherman::benchmark::measure(warmup, iterations, [&]() {
+        nested.set<int>({ "a", "b", "c", "d" }, 7);
+    });
+    leatherman::benchmark::report("nested set", 1, nested_set);
+}
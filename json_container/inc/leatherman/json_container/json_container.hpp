@@ -1,6 +1,8 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <iterator>
 #include <cstdarg>
 #include <iostream>
 #include <tuple>
@@ -14,7 +16,9 @@ using leatherman::locale::_;
 // Forward declarations for rapidjson
 namespace rapidjson {
     class CrtAllocator;
+    template <typename BaseAllocator> class MemoryPoolAllocator;
     template <typename Encoding, typename Allocator> class GenericValue;
+    template <typename Encoding, typename Allocator> struct GenericMember;
     template <typename CharType> struct UTF8;
     template <typename Encoding, typename Allocator, typename StackAllocator> class GenericDocument;
 }  // namespace rapidjson
@@ -23,6 +27,11 @@ namespace leatherman { namespace json_container {
     // Constants
     constexpr size_t DEFAULT_LEFT_PADDING { 4 };
 
+    /// Longest string value that gets interned when string interning
+    /// is enabled; longer values are assumed to be unique payloads
+    /// that would only bloat the intern table.
+    constexpr size_t INTERN_VALUE_MAX_LENGTH { 64 };
+
     // Errors
 
     /// Parent error class.
@@ -59,6 +68,66 @@ namespace leatherman { namespace json_container {
 
     enum DataType { Object, Array, String, Int, Bool, Double, Null };
 
+    /// Options for the parsing constructors, combinable with bitwise
+    /// or. The defaults of the bundled rapidjson parser are fast float
+    /// parsing and recursive descent; these flags let an ingest path
+    /// pick a different speed/strictness point.
+    enum class ParseOptions : unsigned {
+        none = 0,
+
+        /// Parse numbers with full 17-digit round-trip precision
+        /// instead of the (faster) default conversion.
+        full_precision = 1,
+
+        /// Parse iteratively rather than by recursion, bounding stack
+        /// use on deeply nested untrusted inputs.
+        iterative = 2,
+    };
+
+    inline ParseOptions operator|(ParseOptions a, ParseOptions b) {
+        return static_cast<ParseOptions>(static_cast<unsigned>(a)
+                                         | static_cast<unsigned>(b));
+    }
+
+    inline bool operator&(ParseOptions a, ParseOptions b) {
+        return (static_cast<unsigned>(a) & static_cast<unsigned>(b)) != 0;
+    }
+
+    /// Tag type used to select the in situ (destructive) parsing
+    /// constructor overload.
+    struct in_situ_t {};
+
+    /// Tag value used to select the in situ (destructive) parsing
+    /// constructor overload.
+    const in_situ_t in_situ {};
+
+    /**
+     * A non-owning view of a string value stored inside a
+     * JsonContainer, for zero-copy access via get<JsonStringView>.
+     * The view aliases document memory: it is invalidated by any
+     * mutation of the container and must not outlive it. Equivalent
+     * to std::string_view, which is not available in C++11.
+     */
+    struct JsonStringView {
+        /// Pointer to the string data; not necessarily null terminated
+        /// at size bytes (values may contain embedded nulls).
+        const char* data;
+
+        /// Length of the string in bytes.
+        size_t size;
+
+        /// Returns an owning copy of the viewed string.
+        std::string str() const { return std::string(data, size); }
+
+        bool operator==(const JsonStringView& other) const {
+            return size == other.size && std::equal(data, data + size, other.data);
+        }
+
+        bool operator==(const std::string& other) const {
+            return size == other.size() && std::equal(data, data + size, other.data());
+        }
+    };
+
     struct JsonContainerKey : public std::string {
         JsonContainerKey(const std::string& value) : std::string(value) {}
         JsonContainerKey(const char* value) : std::string(value) {}
@@ -66,9 +135,41 @@ namespace leatherman { namespace json_container {
     };
 
     /**
-     * Typedef for RapidJSON allocator.
+     * A pre-compiled lookup path for nested JsonContainer entries.
+     * Building a path splits and stores its keys once, so repeated
+     * lookups avoid re-creating a vector of keys (and the associated
+     * string allocations) on every call.
      */
-    using json_allocator = rapidjson::CrtAllocator;
+    class JsonPath {
+    public:
+        /// Constructs a path from the given sequence of keys.
+        /// Explicit so that brace-initialized key lists keep resolving
+        /// to the vector<JsonContainerKey> accessor overloads.
+        explicit JsonPath(std::vector<std::string> keys);
+
+        /// Constructs a path by compiling a JSON Pointer expression,
+        /// e.g. "/foo/bar"; "~0" and "~1" escapes are resolved to "~"
+        /// and "/" respectively. The empty string denotes the root.
+        /// Throw a data_key_error in case the expression is malformed.
+        explicit JsonPath(const std::string& pointer);
+
+        /// The compiled sequence of keys.
+        const std::vector<std::string>& components() const { return components_; }
+
+    private:
+        std::vector<std::string> components_;
+    };
+
+    /**
+     * Typedef for the RapidJSON base (malloc) allocator.
+     */
+    using json_crt_allocator = rapidjson::CrtAllocator;
+    /**
+     * Typedef for RapidJSON allocator. Values are allocated out of a
+     * pooled arena so that building a document costs a few block
+     * grabs rather than one malloc per insertion.
+     */
+    using json_allocator = rapidjson::MemoryPoolAllocator<json_crt_allocator>;
     /**
      * Typedef for RapidJSON value.
      */
@@ -76,7 +177,71 @@ namespace leatherman { namespace json_container {
     /**
      * Typedef for RapidJSON document.
      */
-    using json_document = rapidjson::GenericDocument<rapidjson::UTF8<char>, json_allocator, json_allocator>;
+    using json_document = rapidjson::GenericDocument<rapidjson::UTF8<char>, json_allocator, json_crt_allocator>;
+    /**
+     * Typedef for a RapidJSON object member.
+     */
+    using json_member = rapidjson::GenericMember<rapidjson::UTF8<char>, json_allocator>;
+
+    /**
+     * A reusable memory arena that can back one or more JsonContainer
+     * documents. Reusing an arena across documents amortizes allocator
+     * block allocations over many parses. The arena must outlive every
+     * document built on top of it, and reset() must only be called once
+     * those documents are gone.
+     */
+    class JsonArena {
+    public:
+        /// Constructs an arena; chunk_size is the growth granularity
+        /// of the underlying pool, in bytes.
+        explicit JsonArena(size_t chunk_size = 64 * 1024);
+
+        ~JsonArena();
+
+        /// Releases all memory held by the arena so it can be reused.
+        /// Must not be called while documents built on the arena are
+        /// still alive.
+        void reset();
+
+        /// Returns the number of bytes handed out to documents.
+        size_t size() const;
+
+        /// Returns the number of bytes reserved from the system.
+        size_t capacity() const;
+
+    private:
+        friend class JsonContainer;
+
+        std::unique_ptr<json_allocator> allocator_;
+    };
+
+    class JsonView;
+    struct JsonMember;
+    class JsonMemberIterator;
+    class JsonMemberRange;
+    class FrozenJsonContainer;
+
+    /**
+     * Memory accounting for a JsonContainer; see
+     * JsonContainer::memoryUsage().
+     */
+    struct JsonMemoryStats {
+        /// Bytes handed out by the document's allocator.
+        size_t allocator_size;
+
+        /// Bytes the document's allocator reserved from the system.
+        size_t allocator_capacity;
+
+        /// Bytes held by the in situ parse buffer, if any.
+        size_t buffer_bytes;
+
+        /// Number of values in the document (the root, object entry
+        /// values, and array elements).
+        size_t node_count;
+
+        /// Payload bytes of string values and object keys.
+        size_t string_bytes;
+    };
 
     // Usage:
     //
@@ -125,30 +290,127 @@ namespace leatherman { namespace json_container {
     public:
         JsonContainer();
         explicit JsonContainer(const std::string& json_txt);
+
+        /// Parse the given JSON text with the given parse options;
+        /// see ParseOptions.
+        /// Throw a data_parse_error in case of invalid JSON.
+        JsonContainer(const std::string& json_txt, ParseOptions options);
+
+        /// Parse the given JSON text in situ: the container takes
+        /// ownership of the buffer and string values alias it, so no
+        /// per-string copies are made. The buffer is modified during
+        /// parsing. This is significantly cheaper than the copying
+        /// constructor for large, string-heavy documents.
+        /// Throw a data_parse_error in case of invalid JSON.
+        JsonContainer(std::string&& json_txt, in_situ_t);
+
+        /// Construct an empty JSON object allocating out of the given
+        /// arena, which must outlive this container.
+        explicit JsonContainer(JsonArena& arena);
+
+        /// Parse the given JSON text allocating out of the given
+        /// arena, which must outlive this container.
+        /// Throw a data_parse_error in case of invalid JSON.
+        JsonContainer(const std::string& json_txt, JsonArena& arena);
         explicit JsonContainer(const json_value& value);
+        /// Copies share the underlying document; a deep copy is
+        /// deferred until one of the sharing containers is mutated
+        /// (copy-on-write), so read-only fan-out of a parsed document
+        /// costs a reference count increment rather than a deep copy.
         JsonContainer(const JsonContainer& data);
-        JsonContainer(const JsonContainer&& data);
+
+        /// Steals the other container's document in O(1), without
+        /// copying any values; the moved-from container is left as an
+        /// empty JSON object.
+        JsonContainer(JsonContainer&& data);
         JsonContainer& operator=(JsonContainer other);
 
         ~JsonContainer();
 
         const json_document& getRaw() const;
 
+        /// Take ownership of the given rapidjson document in O(1),
+        /// replacing the current contents without copying any values;
+        /// the moved-from document is left empty. For interop with
+        /// components that build documents with rapidjson directly.
+        void adopt(json_document&& document);
+
+        /// Move the underlying document out of this (rvalue)
+        /// container in O(1), leaving it as an empty JSON object.
+        /// Falls back to a deep copy in case the document aliases
+        /// container-owned storage (an in situ parse buffer or
+        /// interned strings), so the result always owns its values.
+        json_document release() &&;
+
         std::string toString() const;
 
+        /// Serialize the document to a compact, tag-based binary
+        /// encoding that preserves the DataType model and skips the
+        /// number formatting and string escaping of the text form.
+        /// The encoding is internal to this library; use fromBinary
+        /// to read it back.
+        std::vector<char> toBinary() const;
+
+        /// Reconstruct a container from a toBinary() encoding.
+        /// Throw a data_parse_error in case the data is malformed.
+        static JsonContainer fromBinary(const char* data, size_t size);
+
+        /// Compute an RFC 6902 style patch (an array of add / remove /
+        /// replace operations with JSON Pointer paths) that transforms
+        /// the first document into the second; applying the result to
+        /// "from" with applyPatch yields "to". The patch size scales
+        /// with the changed portion rather than the document size.
+        static JsonContainer diff(const JsonContainer& from,
+                                  const JsonContainer& to);
+
+        /// Apply a patch produced by diff (or any RFC 6902 patch using
+        /// the add / remove / replace operations) to this document.
+        /// Throw a data_type_error in case the patch is not an array
+        /// of operation objects.
+        /// Throw a data_key_error or data_index_error in case a path
+        /// cannot be resolved.
+        void applyPatch(const JsonContainer& patch);
+
+        /// Reconstruct a container from a toBinary() encoding.
+        /// Throw a data_parse_error in case the data is malformed.
+        static JsonContainer fromBinary(const std::vector<char>& data) {
+            return fromBinary(data.data(), data.size());
+        }
+
+        /// Serialize the document straight to the given stream,
+        /// without materializing an intermediate string.
+        void write(std::ostream& os) const;
+
+        /// Serialize the document into the given buffer and return
+        /// the number of bytes written. No null terminator is added.
+        /// Throw a data_error in case the buffer is too small.
+        size_t write(char* buffer, size_t capacity) const;
+
         /// Throw a data_key_error in case the specified key is unknown.
         std::string toString(const JsonContainerKey& key) const;
 
         /// Throw a data_key_error in case the specified key is unknown.
         std::string toString(const std::vector<JsonContainerKey>& keys) const;
 
-        // TODO: Refactor this to use a default parameter of DEFAULT_LEFT_PADDING
-        // for left_padding to remove the empty-argument variant.
+        /// Equivalent to toPrettyJson; kept for backwards
+        /// compatibility. Both share a single streaming pretty-writer.
         std::string toPrettyString(size_t left_padding) const;
         std::string toPrettyString() const;
 
         std::string toPrettyJson(size_t left_padding = DEFAULT_LEFT_PADDING) const;
 
+        /// Pretty-print the document straight to the given stream,
+        /// without materializing an intermediate string.
+        void writePretty(std::ostream& os,
+                         size_t left_padding = DEFAULT_LEFT_PADDING) const;
+
+        /// Return memory accounting for the document: allocator bytes
+        /// held and reserved, the in situ buffer size, and node and
+        /// string payload counts from a single DOM walk. Intended for
+        /// sizing caches by real resident cost without serializing the
+        /// document.
+        JsonMemoryStats memoryUsage() const;
+
         /// Return true if the root is an empty JSON array or an empty
         /// JSON object, false otherwise.
         bool empty() const;
@@ -167,16 +429,77 @@ namespace leatherman { namespace json_container {
         /// Throw a data_key_error in case of unknown keys.
         size_t size(const std::vector<JsonContainerKey>& keys) const;
 
+        /// Return the number of entries of the element at the given
+        /// compiled path; return 0 in case it's scalar.
+        /// Throw a data_key_error in case of unknown keys.
+        size_t size(const JsonPath& path) const;
+
         /// In case the root entry is an object, returns its keys,
         /// otherwise an empty vector.
         std::vector<std::string> keys() const;
 
+        /// Returns a range over the root object's members that walks
+        /// the underlying storage directly, without materializing the
+        /// keys; empty in case the root is not an object. The yielded
+        /// keys and value views alias document memory, so the range
+        /// is invalidated by any mutation of the container.
+        JsonMemberRange members() const;
+
+        /// Returns a read-only view of the root entry. A view resolves
+        /// its entry once, so type(), size(), includes(), and get()
+        /// calls on the same entry no longer re-walk the key path. The
+        /// view aliases document memory: it is invalidated by any
+        /// mutation of the container and must not outlive it.
+        JsonView view() const;
+
+        /// Returns a view of the specified entry; see view().
+        /// Throw a data_key_error in case the specified key is unknown.
+        JsonView view(const JsonContainerKey& key) const;
+
+        /// Returns a view of the specified nested entry; see view().
+        /// Throw a data_key_error in case of unknown keys.
+        JsonView view(const std::vector<JsonContainerKey>& keys) const;
+
+        /// Returns a view of the entry at the given compiled path; see
+        /// view().
+        /// Throw a data_key_error in case of unknown keys.
+        JsonView view(const JsonPath& path) const;
+
         /// Whether the specified entry exists.
         bool includes(const JsonContainerKey& key) const;
 
         /// Whether the specified entry exists.
         bool includes(const std::vector<JsonContainerKey>& keys) const;
 
+        /// Whether the entry at the given compiled path exists.
+        bool includes(const JsonPath& path) const;
+
+        /// Enable string interning for this container. Keys created
+        /// through set()/append() and string values no longer than
+        /// INTERN_VALUE_MAX_LENGTH are stored once in a shared intern
+        /// table and referenced from the document, so documents that
+        /// repeat the same keys and enum-like values millions of
+        /// times stop allocating a copy per occurrence. The table is
+        /// shared with copies of the container and only grows; off by
+        /// default.
+        void enableStringInterning();
+
+        /// Return an immutable copy of this container, sharing the
+        /// document copy-on-write. Frozen containers expose only const
+        /// access and, with key indexing enabled, have their indexes
+        /// built while freezing, so reads on them are side-effect free
+        /// and safe for unsynchronized concurrent use across threads;
+        /// see FrozenJsonContainer.
+        FrozenJsonContainer freeze() const;
+
+        /// Enable hash indexing of object keys. Indices are built
+        /// lazily, the first time a given object is probed, and are
+        /// dropped on any mutation of the container; repeated lookups
+        /// on large objects then cost O(1) instead of a linear member
+        /// scan. Off by default since building the index only pays
+        /// off when the same objects are probed repeatedly.
+        void enableKeyIndex();
+
         DataType type() const;
 
         /// Throw a data_key_error in case the specified key is unknown.
@@ -185,6 +508,10 @@ namespace leatherman { namespace json_container {
         /// Throw a data_key_error in case of unknown keys.
         DataType type(const std::vector<JsonContainerKey>& keys) const;
 
+        /// Throw a data_key_error in case the compiled path refers to
+        /// an unknown entry.
+        DataType type(const JsonPath& path) const;
+
         /// Throw a data_type_error in case the root entry is not an array.
         /// Throw a data_index_error in case the index is out of bounds.
         DataType type(const size_t idx) const;
@@ -225,6 +552,15 @@ namespace leatherman { namespace json_container {
             return getValue<T>(*getValueInJson(keys));
         }
 
+        /// Return the value of the entry at the given compiled path.
+        /// Throw a data_key_error in case the entry does not exist.
+        /// Throw a data_type_error in case the type T doesn't match
+        /// the specified one.
+        template <typename T>
+        T get(const JsonPath& path) const {
+            return getValue<T>(*getValueInJson(path));
+        }
+
         /// Return the indexed value of root array.
         /// Throw a data_index_error in case the index is out of bound.
         /// Throw a data_type_error in case the type T doesn't match
@@ -306,6 +642,8 @@ namespace leatherman { namespace json_container {
         /// object, so that is not possible to set the entry.
         template <typename T>
         void set(const JsonContainerKey& key, T value) {
+            detach();
+            invalidateKeyIndex();
             auto jval = getValueInJson();
             auto key_data = key.data();
 
@@ -318,6 +656,7 @@ namespace leatherman { namespace json_container {
             }
 
             setValue<T>(*getValueInJson(*jval, key_data), value);
+            invalidateKeyIndex();
         }
 
         /// Throw a data_key_error if a known nested key is not associated
@@ -325,6 +664,8 @@ namespace leatherman { namespace json_container {
         /// iterate the remaining keys.
         template <typename T>
         void set(std::vector<JsonContainerKey> keys, T value) {
+            detach();
+            invalidateKeyIndex();
             auto jval = getValueInJson();
 
             for (const auto& key : keys) {
@@ -342,10 +683,103 @@ namespace leatherman { namespace json_container {
             }
 
             setValue<T>(*jval, value);
+            invalidateKeyIndex();
+        }
+
+        /// Pre-size the array entry at the given key so that elements
+        /// can be appended without intermediate reallocation; create
+        /// an empty array in case the key doesn't exist.
+        /// Throw a data_key_error in case the root is not an object.
+        /// Throw a data_type_error in case the existing entry is not
+        /// an array.
+        void reserve(const JsonContainerKey& key, size_t n);
+
+        /// Append a single value to the array entry at the given key,
+        /// creating an empty array in case the key doesn't exist.
+        /// Throw a data_key_error in case the root is not an object.
+        /// Throw a data_type_error in case the existing entry is not
+        /// an array.
+        template <typename T>
+        void append(const JsonContainerKey& key, T value) {
+            detach();
+            invalidateKeyIndex();
+            appendValue<T>(*ensureArrayInJson(key.data(), false), value);
+        }
+
+        /// Replace the entry at the given key with an array holding
+        /// the values in [begin, end), pre-sizing the array once up
+        /// front instead of re-growing it element by element.
+        /// Throw a data_key_error in case the root is not an object.
+        template <typename It>
+        void setAll(const JsonContainerKey& key, It begin, It end) {
+            detach();
+            invalidateKeyIndex();
+            auto jval = ensureArrayInJson(key.data(), true);
+            reserveArray(*jval, std::distance(begin, end));
+
+            for (; begin != end; ++begin) {
+                appendValue<typename std::iterator_traits<It>::value_type>(
+                    *jval, *begin);
+            }
         }
 
     private:
-        std::unique_ptr<json_document> document_root_;
+        friend class JsonView;
+        friend class FrozenJsonContainer;
+
+        // Shared between copies until one of them mutates; see detach().
+        std::shared_ptr<json_document> document_root_;
+
+        // Owns the original JSON text when parsing was done in situ;
+        // string values in document_root_ alias this buffer, so it
+        // must live as long as the document does.
+        std::shared_ptr<std::string> insitu_buffer_;
+
+        // Whether the document allocates out of storage it does not
+        // own itself (the bundled inline arena, or a JsonArena);
+        // release() must then deep-copy the values out rather than
+        // move the document, since a moved document would dangle once
+        // that storage goes away.
+        bool external_allocator_ { false };
+
+        // Deep-copies the document in case it is shared with other
+        // containers, so the upcoming mutation is not observed by
+        // them. Called at the top of every mutating operation.
+        void detach();
+
+        // Interned strings referenced by the document; defined in the
+        // translation unit. Shared with copies since their documents
+        // alias the same storage, and never shrunk while set.
+        struct InternTable;
+        std::shared_ptr<InternTable> intern_table_;
+
+        // Returns the canonical copy of the given string from the
+        // intern table, inserting it on first sight.
+        const char* intern(const char* str, size_t length);
+
+        // Lazily built per-object key index; defined in the
+        // translation unit. Null until the first indexed lookup.
+        struct KeyIndex;
+        mutable std::unique_ptr<KeyIndex> key_index_;
+
+        bool key_index_enabled_ { false };
+
+        // Drops the key index; called on any mutation since cached
+        // value pointers may be left dangling by it.
+        void invalidateKeyIndex();
+
+        // Indexed object member lookup; builds the index for the
+        // given object on first use. Returns nullptr if the key is
+        // not present.
+        json_value* lookupInKeyIndex(const json_value& jval, const char* key) const;
+
+        // Builds the index entries for the given object; no-op if the
+        // object is already indexed.
+        void indexObject(const json_value& jval) const;
+
+        // Eagerly indexes every object node in the given subtree, so
+        // subsequent lookups never modify the index; used by freeze().
+        void buildKeyIndex(const json_value& jval) const;
 
         size_t getSize(const json_value& jval) const;
 
@@ -398,8 +832,24 @@ namespace leatherman { namespace json_container {
             return getValueInJson(keys.cbegin(), keys.cend(), is_array, idx);
         }
 
+        // Compiled path accessor
+        // Throws a data_type_error if an intermediate entry is not an
+        // object; throws a data_key_error if a key is unknown.
+        json_value* getValueInJson(const JsonPath& path) const;
+
         void createKeyInJson(const char* key, json_value& jval);
 
+        // Returns the array entry at the given key of the root object,
+        // creating an empty array if the key is missing. With clear
+        // set, any existing entry is replaced by an empty array;
+        // otherwise a non-array entry raises a data_type_error.
+        json_value* ensureArrayInJson(const char* key, bool clear);
+
+        void reserveArray(json_value& jval, size_t n);
+
+        template<typename T>
+        void appendValue(json_value& jval, T new_value);
+
         template<typename T>
         T getValue(const json_value& value) const;
 
@@ -407,6 +857,177 @@ namespace leatherman { namespace json_container {
         void setValue(json_value& jval, T new_value);
     };
 
+    /**
+     * A lightweight, read-only view of a subtree of a JsonContainer.
+     * Descending through view() never copies the underlying values,
+     * unlike get<JsonContainer>, which deep-copies the subtree into a
+     * new document. A view references its container's memory: it is
+     * invalidated by any mutation of the container and must not
+     * outlive it. Use get<JsonContainer>() on a view to materialize
+     * an owning copy of the subtree.
+     */
+    class JsonView {
+    public:
+        /// Constructs a view of the container's root.
+        explicit JsonView(const JsonContainer& data)
+                : owner_ { &data },
+                  value_ { data.getValueInJson() } {}
+
+        DataType type() const { return owner_->getValueType(*value_); }
+
+        size_t size() const { return owner_->getSize(*value_); }
+
+        /// Whether the viewed object has the specified key; false in
+        /// case the viewed entry is not an object.
+        bool includes(const std::string& key) const {
+            return owner_->hasKey(*value_, key.data());
+        }
+
+        /// Return a view of the specified entry of the viewed object.
+        /// Throw a data_type_error in case the viewed entry is not an
+        /// object.
+        /// Throw a data_key_error in case the key is unknown.
+        JsonView view(const std::string& key) const {
+            return JsonView { *owner_, *owner_->getValueInJson(*value_, key.data()) };
+        }
+
+        /// Return a view of the indexed element of the viewed array.
+        /// Throw a data_type_error in case the viewed entry is not an
+        /// array.
+        /// Throw a data_index_error in case the index is out of bounds.
+        JsonView view(const size_t idx) const {
+            return JsonView { *owner_, *owner_->getValueInJson(*value_, idx) };
+        }
+
+        /// Return the viewed value.
+        /// Throw a data_type_error in case the type T doesn't match
+        /// the viewed one.
+        template <typename T>
+        T get() const {
+            return owner_->getValue<T>(*value_);
+        }
+
+        /// Return the value of the specified entry of the viewed
+        /// object.
+        /// Throw a data_key_error in case the entry does not exist.
+        /// Throw a data_type_error in case the type T doesn't match
+        /// the specified one.
+        template <typename T>
+        T get(const std::string& key) const {
+            return owner_->getValue<T>(*owner_->getValueInJson(*value_, key.data()));
+        }
+
+        /// Returns a range over the viewed object's members, as
+        /// JsonContainer::members().
+        JsonMemberRange members() const;
+
+    private:
+        friend class JsonContainer;
+        friend class JsonMemberIterator;
+
+        JsonView(const JsonContainer& owner, const json_value& value)
+                : owner_ { &owner },
+                  value_ { &value } {}
+
+        const JsonContainer* owner_;
+        const json_value* value_;
+    };
+
+    /**
+     * A key/value pair yielded when iterating an object's members;
+     * both the key and the value view alias document memory.
+     */
+    struct JsonMember {
+        JsonStringView key;
+        JsonView value;
+    };
+
+    /**
+     * Forward iterator over an object's members; see
+     * JsonContainer::members().
+     */
+    class JsonMemberIterator {
+    public:
+        JsonMember operator*() const;
+
+        JsonMemberIterator& operator++();
+
+        bool operator==(const JsonMemberIterator& other) const {
+            return member_ == other.member_;
+        }
+
+        bool operator!=(const JsonMemberIterator& other) const {
+            return member_ != other.member_;
+        }
+
+    private:
+        friend class JsonMemberRange;
+
+        JsonMemberIterator(const JsonContainer& owner, const json_member* member)
+                : owner_ { &owner },
+                  member_ { member } {}
+
+        const JsonContainer* owner_;
+        const json_member* member_;
+    };
+
+    /**
+     * The range of an object's members; see JsonContainer::members().
+     */
+    class JsonMemberRange {
+    public:
+        JsonMemberIterator begin() const;
+        JsonMemberIterator end() const;
+
+    private:
+        friend class JsonContainer;
+        friend class JsonView;
+
+        JsonMemberRange(const JsonContainer& owner, const json_value& value)
+                : owner_ { &owner },
+                  value_ { &value } {}
+
+        const JsonContainer* owner_;
+        const json_value* value_;
+    };
+
+    /**
+     * An immutable JSON document produced by JsonContainer::freeze().
+     * Only const access to the wrapped container is exposed, so
+     * mutation is ruled out at the type level, and reads carry no
+     * hidden side effects: when key indexing is enabled the per-object
+     * indexes are built while freezing rather than on first probe. A
+     * frozen container is therefore safe for unsynchronized concurrent
+     * reads from any number of threads, e.g. a parsed configuration
+     * document shared across a service without reader locks.
+     *
+     * The document is shared copy-on-write with the container it was
+     * frozen from; a mutation over there detaches that container and
+     * leaves the frozen document untouched.
+     */
+    class FrozenJsonContainer {
+    public:
+        /// Copies share the underlying document; the copy's key
+        /// indexes are rebuilt so it carries the same concurrency
+        /// guarantees as the original.
+        FrozenJsonContainer(const FrozenJsonContainer& other);
+        FrozenJsonContainer(FrozenJsonContainer&& other);
+        FrozenJsonContainer& operator=(FrozenJsonContainer other);
+
+        /// Read-only access to the wrapped document.
+        const JsonContainer& operator*() const { return data_; }
+
+        /// Read-only access to the wrapped document.
+        const JsonContainer* operator->() const { return &data_; }
+
+    private:
+        friend class JsonContainer;
+
+        explicit FrozenJsonContainer(JsonContainer data);
+
+        JsonContainer data_;
+    };
+
     template<>
     void JsonContainer::setValue<>(json_value& jval, const std::string& new_value);
 
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <leatherman/json_container/json_container.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace leatherman { namespace json_container {
+
+    /// Error thrown when compiling a malformed schema document.
+    class schema_error : public data_error {
+    public:
+        explicit schema_error(std::string const& msg) : data_error(msg) {}
+    };
+
+    /**
+     * A single validation failure reported by JsonSchema::validate.
+     */
+    struct SchemaValidationError {
+        /// JSON Pointer to the offending entry; empty for the root.
+        std::string path;
+
+        /// Human readable description of the failure.
+        std::string message;
+    };
+
+    /**
+     * A JSON Schema document compiled once into an internal form and
+     * applied to containers in a single DOM pass with non-throwing
+     * error collection. Replaces per-field includes()/type() probing,
+     * which re-traverses the document for every field and throws a
+     * translated exception on every miss.
+     *
+     * Supported keywords: "type" (object, array, string, integer,
+     * number, boolean, null), "properties", "required",
+     * "additionalProperties" (boolean form), "items" (single schema
+     * form), "enum" (string values), "minimum" / "maximum",
+     * "minItems" / "maxItems", and "minLength" / "maxLength".
+     * Unrecognized keywords are ignored, per JSON Schema convention.
+     *
+     * A compiled schema is immutable and safe for unsynchronized
+     * concurrent validation from multiple threads.
+     */
+    class JsonSchema {
+    public:
+        /// Compiles the given JSON Schema document.
+        /// Throw a schema_error in case the document misuses a
+        /// supported keyword.
+        explicit JsonSchema(const JsonContainer& schema);
+
+        JsonSchema(JsonSchema&& other);
+        JsonSchema& operator=(JsonSchema&& other);
+
+        ~JsonSchema();
+
+        /// Validates the given container in a single pass, appending a
+        /// SchemaValidationError per failure; never throws on invalid
+        /// data. Return true in case the container conforms.
+        bool validate(const JsonContainer& data,
+                      std::vector<SchemaValidationError>& errors) const;
+
+        /// Validates the given container, discarding error details.
+        /// Return true in case the container conforms.
+        bool validate(const JsonContainer& data) const;
+
+    private:
+        // Compiled schema node; defined in the translation unit.
+        struct Node;
+
+        // Compiles one schema level, recursing into subschemas.
+        // Throws a schema_error in case a supported keyword is misused.
+        static std::unique_ptr<Node> compile(const json_value& sval);
+
+        // Checks one value against one compiled node, recursing in
+        // lockstep and appending an error per failure.
+        static void check(const Node& node, const json_value& val,
+                          const std::string& path,
+                          std::vector<SchemaValidationError>& errors);
+
+        std::unique_ptr<Node> root_;
+    };
+
+}}  // namespace leatherman::json_container
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <leatherman/json_container/json_container.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace leatherman { namespace json_container {
+
+    /**
+     * Interface for receiving SAX-style JSON parse events from
+     * JsonStreamReader. Each callback returns true to continue
+     * parsing or false to stop it; a stopped parse is not an error.
+     * Default implementations accept every event, so subclasses only
+     * need to override the events they care about.
+     *
+     * String and key data passed to callbacks aliases the reader's
+     * internal buffer and is only valid for the duration of the call.
+     */
+    class JsonEventHandler {
+    public:
+        virtual ~JsonEventHandler() {}
+
+        /// Invoked for a null value.
+        virtual bool onNull() { return true; }
+
+        /// Invoked for a boolean value.
+        virtual bool onBool(bool value) { return true; }
+
+        /// Invoked for an integer value.
+        virtual bool onInt(int64_t value) { return true; }
+
+        /// Invoked for a floating point value.
+        virtual bool onDouble(double value) { return true; }
+
+        /// Invoked for a string value.
+        virtual bool onString(const char* value, size_t length) { return true; }
+
+        /// Invoked for an object member key.
+        virtual bool onKey(const char* key, size_t length) { return true; }
+
+        /// Invoked when an object starts.
+        virtual bool onStartObject() { return true; }
+
+        /// Invoked when an object ends.
+        virtual bool onEndObject(size_t member_count) { return true; }
+
+        /// Invoked when an array starts.
+        virtual bool onStartArray() { return true; }
+
+        /// Invoked when an array ends.
+        virtual bool onEndArray(size_t element_count) { return true; }
+    };
+
+    /**
+     * Streaming JSON reader that feeds typed parse events to a
+     * JsonEventHandler without materializing a DOM, so arbitrarily
+     * large payloads can be scanned with O(1) memory.
+     */
+    class JsonStreamReader {
+    public:
+        /// Parse the given JSON text, invoking the handler's callbacks.
+        /// Return true if the whole document was parsed, false if the
+        /// handler stopped the parse early.
+        /// Throw a data_parse_error in case of invalid JSON.
+        bool parse(const std::string& json_txt, JsonEventHandler& handler);
+
+        /// Parse JSON from the given stream in fixed-size chunks,
+        /// invoking the handler's callbacks. Return true if the whole
+        /// document was parsed, false if the handler stopped the parse
+        /// early.
+        /// Throw a data_parse_error in case of invalid JSON.
+        bool parse(std::istream& input, JsonEventHandler& handler);
+    };
+
+}}  // namespace leatherman::json_container
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <leatherman/json_container/json_container.hpp>
+
+#include <string>
+#include <vector>
+
+namespace leatherman { namespace json_container {
+
+    /**
+     * Parses a buffer of newline-delimited JSON (NDJSON) records and
+     * returns the parsed documents in record order. Blank lines are
+     * skipped. Records are split on newline boundaries up front and
+     * parsed concurrently on worker threads, so large batches use all
+     * available cores instead of the single-threaded JsonContainer
+     * constructor.
+     *
+     * num_threads caps the number of worker threads; 0 (the default)
+     * uses the hardware concurrency.
+     *
+     * Throws a data_parse_error in case any record is invalid JSON.
+     */
+    std::vector<JsonContainer> parseNdjson(const std::string& text,
+                                           size_t num_threads = 0);
+
+}}  // namespace leatherman::json_container
@@ -1,5 +1,6 @@
 #include <leatherman/json_container/json_container.hpp>
 #include <leatherman/locale/locale.hpp>
+#include <leatherman/util/profiler.hpp>
 
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
@@ -8,33 +9,444 @@
 #include <rapidjson/allocators.h>
 #include <rapidjson/rapidjson.h>
 
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
 
 namespace leatherman { namespace json_container {
 
-    const size_t LEFT_PADDING_INCREMENT { 2 };
+    // The canonical storage for interned strings; unordered_set nodes
+    // are stable, so the documents can alias c_str() pointers.
+    struct JsonContainer::InternTable {
+        std::unordered_set<std::string> strings;
+    };
+
+    // Maps each indexed object node to a hash table of its members.
+    struct JsonContainer::KeyIndex {
+        std::unordered_map<const json_value*,
+                           std::unordered_map<std::string, json_value*>> objects;
+    };
 
     //
     // free functions
     //
 
+    namespace {
+
+        // rapidjson output stream writing straight to a std::ostream.
+        // The vendored rapidjson predates OStreamWrapper.
+        struct ostream_stream {
+            typedef char Ch;
+
+            explicit ostream_stream(std::ostream& os) : os_(os) {}
+
+            void Put(Ch c) { os_.put(c); }
+            void Flush() { os_.flush(); }
+
+            std::ostream& os_;
+        };
+
+        // rapidjson output stream writing into a caller-provided,
+        // fixed-capacity buffer.
+        struct fixed_buffer_stream {
+            typedef char Ch;
+
+            fixed_buffer_stream(char* buffer, size_t capacity)
+                    : buffer_(buffer), capacity_(capacity), size_(0) {}
+
+            void Put(Ch c) {
+                if (size_ >= capacity_) {
+                    throw data_error { _("buffer too small to serialize document") };
+                }
+                buffer_[size_++] = c;
+            }
+
+            void Flush() {}
+
+            char* buffer_;
+            size_t capacity_;
+            size_t size_;
+        };
+
+        // Streaming pretty-printer shared by every pretty output
+        // method; emits standard indented JSON in a single pass.
+        template <typename Stream>
+        void write_pretty(const json_value& jval, Stream& stream, size_t indent) {
+            rapidjson::PrettyWriter<Stream> writer { stream };
+            writer.SetIndent(' ', static_cast<unsigned>(indent));
+            jval.Accept(writer);
+        }
+
+    }  // namespace
+
+    namespace binary {
+
+        // Tags of the binary encoding produced by toBinary(). Scalars
+        // are stored in little-endian byte order with fixed widths, so
+        // round-trips skip number formatting and string escaping.
+        enum tag : char {
+            null_tag = 0,
+            false_tag = 1,
+            true_tag = 2,
+            int_tag = 3,     // int64, 8 bytes LE
+            uint_tag = 4,    // uint64, 8 bytes LE
+            double_tag = 5,  // IEEE double, 8 bytes LE
+            string_tag = 6,  // uint32 LE length + raw bytes
+            array_tag = 7,   // uint32 LE count + elements
+            object_tag = 8   // uint32 LE count + (string, value) pairs
+        };
+
+        void putUint32(std::vector<char>& out, uint32_t value) {
+            for (int i = 0; i < 4; i++) {
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+            }
+        }
+
+        void putUint64(std::vector<char>& out, uint64_t value) {
+            for (int i = 0; i < 8; i++) {
+                out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+            }
+        }
+
+        void encode(const json_value& jval, std::vector<char>& out) {
+            switch (jval.GetType()) {
+                case rapidjson::Type::kNullType:
+                    out.push_back(null_tag);
+                    break;
+                case rapidjson::Type::kFalseType:
+                    out.push_back(false_tag);
+                    break;
+                case rapidjson::Type::kTrueType:
+                    out.push_back(true_tag);
+                    break;
+                case rapidjson::Type::kStringType:
+                    out.push_back(string_tag);
+                    putUint32(out, jval.GetStringLength());
+                    out.insert(out.end(), jval.GetString(),
+                               jval.GetString() + jval.GetStringLength());
+                    break;
+                case rapidjson::Type::kNumberType:
+                    if (jval.IsDouble()) {
+                        double d = jval.GetDouble();
+                        uint64_t bits;
+                        memcpy(&bits, &d, sizeof(bits));
+                        out.push_back(double_tag);
+                        putUint64(out, bits);
+                    } else if (jval.IsInt64()) {
+                        out.push_back(int_tag);
+                        putUint64(out, static_cast<uint64_t>(jval.GetInt64()));
+                    } else {
+                        out.push_back(uint_tag);
+                        putUint64(out, jval.GetUint64());
+                    }
+                    break;
+                case rapidjson::Type::kArrayType:
+                    out.push_back(array_tag);
+                    putUint32(out, jval.Size());
+                    for (json_value::ConstValueIterator itr = jval.Begin();
+                         itr != jval.End(); ++itr) {
+                        encode(*itr, out);
+                    }
+                    break;
+                case rapidjson::Type::kObjectType:
+                    out.push_back(object_tag);
+                    putUint32(out, jval.MemberCount());
+                    for (json_value::ConstMemberIterator itr = jval.MemberBegin();
+                         itr != jval.MemberEnd(); ++itr) {
+                        putUint32(out, itr->name.GetStringLength());
+                        out.insert(out.end(), itr->name.GetString(),
+                                   itr->name.GetString() + itr->name.GetStringLength());
+                        encode(itr->value, out);
+                    }
+                    break;
+            }
+        }
+
+        struct cursor {
+            const char* data;
+            size_t size;
+            size_t pos;
+
+            void require(size_t count) {
+                if (size - pos < count) {
+                    throw data_parse_error { _("truncated binary document") };
+                }
+            }
+
+            char takeTag() {
+                require(1);
+                return data[pos++];
+            }
+
+            uint32_t takeUint32() {
+                require(4);
+                uint32_t value { 0 };
+                for (int i = 0; i < 4; i++) {
+                    value |= static_cast<uint32_t>(
+                        static_cast<unsigned char>(data[pos++])) << (8 * i);
+                }
+                return value;
+            }
+
+            uint64_t takeUint64() {
+                require(8);
+                uint64_t value { 0 };
+                for (int i = 0; i < 8; i++) {
+                    value |= static_cast<uint64_t>(
+                        static_cast<unsigned char>(data[pos++])) << (8 * i);
+                }
+                return value;
+            }
+
+            const char* takeBytes(size_t count) {
+                require(count);
+                auto begin = data + pos;
+                pos += count;
+                return begin;
+            }
+        };
+
+        void decode(cursor& in, json_value& jval, json_allocator& allocator) {
+            switch (in.takeTag()) {
+                case null_tag:
+                    jval.SetNull();
+                    break;
+                case false_tag:
+                    jval.SetBool(false);
+                    break;
+                case true_tag:
+                    jval.SetBool(true);
+                    break;
+                case int_tag:
+                    jval.SetInt64(static_cast<int64_t>(in.takeUint64()));
+                    break;
+                case uint_tag:
+                    jval.SetUint64(in.takeUint64());
+                    break;
+                case double_tag: {
+                    auto bits = in.takeUint64();
+                    double d;
+                    memcpy(&d, &bits, sizeof(d));
+                    jval.SetDouble(d);
+                    break;
+                }
+                case string_tag: {
+                    auto length = in.takeUint32();
+                    jval.SetString(in.takeBytes(length), length, allocator);
+                    break;
+                }
+                case array_tag: {
+                    auto count = in.takeUint32();
+                    jval.SetArray();
+                    jval.Reserve(count, allocator);
+                    for (uint32_t i = 0; i < count; i++) {
+                        json_value element;
+                        decode(in, element, allocator);
+                        jval.PushBack(element, allocator);
+                    }
+                    break;
+                }
+                case object_tag: {
+                    auto count = in.takeUint32();
+                    jval.SetObject();
+                    for (uint32_t i = 0; i < count; i++) {
+                        auto length = in.takeUint32();
+                        json_value name { in.takeBytes(length), length, allocator };
+                        json_value member;
+                        decode(in, member, allocator);
+                        jval.AddMember(name, member, allocator);
+                    }
+                    break;
+                }
+                default:
+                    throw data_parse_error { _("invalid binary document") };
+            }
+        }
+
+    }  // namespace binary
+
     std::string valueToString(const json_value& jval) {
+        LTH_PROFILE_SCOPE("json_container.serialize");
         rapidjson::StringBuffer buffer;
         rapidjson::Writer<rapidjson::StringBuffer> writer { buffer };
         jval.Accept(writer);
         return buffer.GetString();
     }
 
+    //
+    // JsonPath
+    //
+
+    JsonPath::JsonPath(std::vector<std::string> keys)
+            : components_ { std::move(keys) } {
+    }
+
+    JsonPath::JsonPath(const std::string& pointer) {
+        if (pointer.empty()) {
+            return;
+        }
+
+        if (pointer[0] != '/') {
+            throw data_key_error { _("invalid JSON Pointer expression: {1}", pointer) };
+        }
+
+        size_t pos { 1 };
+
+        while (pos <= pointer.size()) {
+            auto next = pointer.find('/', pos);
+            if (next == std::string::npos) {
+                next = pointer.size();
+            }
+
+            std::string component {};
+            component.reserve(next - pos);
+
+            // Resolve the "~1" -> "/" and "~0" -> "~" escapes.
+            for (auto i = pos; i < next; i++) {
+                if (pointer[i] == '~') {
+                    if (i + 1 >= next || (pointer[i + 1] != '0' && pointer[i + 1] != '1')) {
+                        throw data_key_error { _("invalid JSON Pointer expression: {1}", pointer) };
+                    }
+                    component += (pointer[++i] == '0') ? '~' : '/';
+                } else {
+                    component += pointer[i];
+                }
+            }
+
+            components_.push_back(std::move(component));
+            pos = next + 1;
+        }
+    }
+
+    //
+    // JsonArena
+    //
+
+    JsonArena::JsonArena(size_t chunk_size)
+            : allocator_ { new json_allocator(chunk_size) } {
+    }
+
+    // unique_ptr requires a complete type at time of destruction, as
+    // with JsonContainer below.
+    JsonArena::~JsonArena() {}
+
+    void JsonArena::reset() {
+        allocator_->Clear();
+    }
+
+    size_t JsonArena::size() const {
+        return allocator_->Size();
+    }
+
+    size_t JsonArena::capacity() const {
+        return allocator_->Capacity();
+    }
+
+    //
+    // document storage
+    //
+
+    namespace {
+
+        /// Size of the inline arena bundled with each document; sized
+        /// to hold a scalar root or an envelope of a handful of
+        /// members, which covers the overwhelming majority of the
+        /// containers created on message paths.
+        constexpr size_t INLINE_ARENA_SIZE = 512;
+
+        // The document, its pool allocator, and a small arena that
+        // serves as the allocator's first chunk, folded into a single
+        // heap block. Small documents are then one allocation in
+        // total (the make_shared below, which also embeds the
+        // shared_ptr control block) instead of a document, a control
+        // block, and a first allocator chunk; only documents that
+        // outgrow the arena fall back to mallocing further chunks.
+        // The document is declared after the allocator so it is
+        // destroyed first.
+        struct document_block {
+            char arena[INLINE_ARENA_SIZE];
+            json_allocator allocator;
+            json_document document;
+
+            document_block()
+                    : allocator { arena, sizeof(arena) },
+                      document { &allocator } {}
+        };
+
+        // Creates a document inside a document_block, returned as an
+        // aliasing shared_ptr that keeps the whole block alive. Fully
+        // inline (zero-allocation) storage is ruled out by the
+        // copy-on-write sharing of document_root_ between copies.
+        std::shared_ptr<json_document> make_document() {
+            auto block = std::make_shared<document_block>();
+            return std::shared_ptr<json_document> { block, &block->document };
+        }
+
+    }  // namespace
+
     //
     // public interface
     //
 
-    JsonContainer::JsonContainer() : document_root_ { new json_document() } {
+    JsonContainer::JsonContainer() : document_root_ { make_document() },
+                                     external_allocator_ { true } {
         document_root_->SetObject();
     }
 
     JsonContainer::JsonContainer(const std::string& json_text) : JsonContainer() {
+        LTH_PROFILE_SCOPE("json_container.parse");
+        document_root_->Parse(json_text.data());
+
+        if (document_root_->HasParseError()) {
+            throw data_parse_error { _("invalid json") };
+        }
+    }
+
+    JsonContainer::JsonContainer(const std::string& json_text, ParseOptions options)
+            : JsonContainer() {
+        LTH_PROFILE_SCOPE("json_container.parse");
+
+        // rapidjson parse flags are template parameters, so each
+        // option combination needs its own instantiation.
+        if ((options & ParseOptions::full_precision)
+                && (options & ParseOptions::iterative)) {
+            document_root_->Parse<rapidjson::kParseFullPrecisionFlag
+                                  | rapidjson::kParseIterativeFlag>(json_text.data());
+        } else if (options & ParseOptions::full_precision) {
+            document_root_->Parse<rapidjson::kParseFullPrecisionFlag>(json_text.data());
+        } else if (options & ParseOptions::iterative) {
+            document_root_->Parse<rapidjson::kParseIterativeFlag>(json_text.data());
+        } else {
+            document_root_->Parse(json_text.data());
+        }
+
+        if (document_root_->HasParseError()) {
+            throw data_parse_error { _("invalid json") };
+        }
+    }
+
+    JsonContainer::JsonContainer(std::string&& json_text, in_situ_t) : JsonContainer() {
+        LTH_PROFILE_SCOPE("json_container.parse");
+        insitu_buffer_.reset(new std::string { std::move(json_text) });
+        document_root_->ParseInsitu(&(*insitu_buffer_)[0]);
+
+        if (document_root_->HasParseError()) {
+            throw data_parse_error { _("invalid json") };
+        }
+    }
+
+    JsonContainer::JsonContainer(JsonArena& arena)
+            : document_root_ { new json_document(arena.allocator_.get()) },
+              external_allocator_ { true } {
+        document_root_->SetObject();
+    }
+
+    JsonContainer::JsonContainer(const std::string& json_text, JsonArena& arena)
+            : JsonContainer(arena) {
+        LTH_PROFILE_SCOPE("json_container.parse");
         document_root_->Parse(json_text.data());
 
         if (document_root_->HasParseError()) {
@@ -48,16 +460,85 @@ namespace leatherman { namespace json_container {
         document_root_->CopyFrom(value, document_root_->GetAllocator());
     }
 
-    JsonContainer::JsonContainer(const JsonContainer& data) : JsonContainer(){
-        document_root_->CopyFrom(*data.document_root_, document_root_->GetAllocator());
+    JsonContainer::JsonContainer(const JsonContainer& data)
+            : document_root_ { data.document_root_ },
+              insitu_buffer_ { data.insitu_buffer_ },
+              external_allocator_ { data.external_allocator_ },
+              intern_table_ { data.intern_table_ },
+              key_index_enabled_ { data.key_index_enabled_ } {
+        // Copy-on-write: the document is shared until either side
+        // mutates and detaches. The key index is not shared since it
+        // holds non-owning pointers with independent lifetimes.
     }
 
-    JsonContainer::JsonContainer(const JsonContainer&& data) : JsonContainer() {
-        document_root_->CopyFrom(*data.document_root_, document_root_->GetAllocator());
+    void JsonContainer::detach() {
+        if (document_root_.use_count() > 1) {
+            auto own_copy = make_document();
+            own_copy->CopyFrom(*document_root_, own_copy->GetAllocator());
+            document_root_ = std::move(own_copy);
+            external_allocator_ = true;
+            // CopyFrom shares const (non-copied) strings, which in situ
+            // parsing produces, so the buffer reference must be kept.
+            invalidateKeyIndex();
+        }
+    }
+
+    JsonContainer::JsonContainer(JsonContainer&& data) : JsonContainer() {
+        std::swap(document_root_, data.document_root_);
+        std::swap(insitu_buffer_, data.insitu_buffer_);
+        std::swap(external_allocator_, data.external_allocator_);
+        std::swap(intern_table_, data.intern_table_);
+        std::swap(key_index_, data.key_index_);
+        std::swap(key_index_enabled_, data.key_index_enabled_);
     }
 
     JsonContainer& JsonContainer::operator=(JsonContainer other) {
         std::swap(document_root_, other.document_root_);
+        std::swap(insitu_buffer_, other.insitu_buffer_);
+        std::swap(external_allocator_, other.external_allocator_);
+        std::swap(intern_table_, other.intern_table_);
+        std::swap(key_index_, other.key_index_);
+        std::swap(key_index_enabled_, other.key_index_enabled_);
+        return *this;
+    }
+
+    void JsonContainer::enableStringInterning() {
+        if (!intern_table_) {
+            intern_table_.reset(new InternTable());
+        }
+    }
+
+    const char* JsonContainer::intern(const char* str, size_t length) {
+        return intern_table_->strings.emplace(str, length).first->c_str();
+    }
+
+    void JsonContainer::enableKeyIndex() {
+        key_index_enabled_ = true;
+    }
+
+    FrozenJsonContainer JsonContainer::freeze() const {
+        return FrozenJsonContainer { *this };
+    }
+
+    FrozenJsonContainer::FrozenJsonContainer(JsonContainer data)
+            : data_ { std::move(data) } {
+        if (data_.key_index_enabled_) {
+            data_.buildKeyIndex(*data_.document_root_);
+        }
+    }
+
+    FrozenJsonContainer::FrozenJsonContainer(const FrozenJsonContainer& other)
+            : FrozenJsonContainer { other.data_ } {
+        // The copy constructor of JsonContainer does not carry the key
+        // indexes over, so the delegated constructor rebuilds them.
+    }
+
+    FrozenJsonContainer::FrozenJsonContainer(FrozenJsonContainer&& other)
+            : data_ { std::move(other.data_) } {
+    }
+
+    FrozenJsonContainer& FrozenJsonContainer::operator=(FrozenJsonContainer other) {
+        std::swap(data_, other.data_);
         return *this;
     }
 
@@ -75,8 +556,101 @@ namespace leatherman { namespace json_container {
         return valueToString(*document_root_);
     }
 
+    namespace {
+
+        // Deep copy that always copies string payloads, unlike
+        // CopyFrom, which shares const (non-copied) strings; used when
+        // a document must not alias container-owned storage.
+        void copyOwned(const json_value& src, json_value& dst, json_allocator& allocator) {
+            if (src.IsObject()) {
+                dst.SetObject();
+                for (auto itr = src.MemberBegin(); itr != src.MemberEnd(); ++itr) {
+                    json_value name;
+                    name.SetString(itr->name.GetString(), itr->name.GetStringLength(),
+                                   allocator);
+                    json_value value;
+                    copyOwned(itr->value, value, allocator);
+                    dst.AddMember(name, value, allocator);
+                }
+            } else if (src.IsArray()) {
+                dst.SetArray();
+                dst.Reserve(src.Size(), allocator);
+                for (auto itr = src.Begin(); itr != src.End(); ++itr) {
+                    json_value value;
+                    copyOwned(*itr, value, allocator);
+                    dst.PushBack(value, allocator);
+                }
+            } else if (src.IsString()) {
+                dst.SetString(src.GetString(), src.GetStringLength(), allocator);
+            } else {
+                dst.CopyFrom(src, allocator);
+            }
+        }
+
+    }  // namespace
+
+    void JsonContainer::adopt(json_document&& document) {
+        document_root_.reset(new json_document(std::move(document)));
+        insitu_buffer_.reset();
+        // The moved-in document carries (and owns) its own allocator.
+        external_allocator_ = false;
+        invalidateKeyIndex();
+    }
+
+    json_document JsonContainer::release() && {
+        json_document released;
+
+        if (insitu_buffer_ || intern_table_ || external_allocator_
+                || document_root_.use_count() > 1) {
+            // The document may alias storage this container (or a
+            // copy-on-write sibling) owns; hand out owned values.
+            copyOwned(*document_root_, released, released.GetAllocator());
+        } else {
+            released = json_document { std::move(*document_root_) };
+        }
+
+        document_root_ = make_document();
+        document_root_->SetObject();
+        insitu_buffer_.reset();
+        external_allocator_ = true;
+        invalidateKeyIndex();
+        return released;
+    }
+
+    std::vector<char> JsonContainer::toBinary() const {
+        std::vector<char> out;
+        binary::encode(*document_root_, out);
+        return out;
+    }
+
+    JsonContainer JsonContainer::fromBinary(const char* data, size_t size) {
+        JsonContainer container {};
+        binary::cursor in { data, size, 0 };
+        binary::decode(in, *container.document_root_,
+                       container.document_root_->GetAllocator());
+
+        if (in.pos != size) {
+            throw data_parse_error { _("trailing data in binary document") };
+        }
+
+        return container;
+    }
+
+    void JsonContainer::write(std::ostream& os) const {
+        ostream_stream stream { os };
+        rapidjson::Writer<ostream_stream> writer { stream };
+        document_root_->Accept(writer);
+    }
+
+    size_t JsonContainer::write(char* buffer, size_t capacity) const {
+        fixed_buffer_stream stream { buffer, capacity };
+        rapidjson::Writer<fixed_buffer_stream> writer { stream };
+        document_root_->Accept(writer);
+        return stream.size_;
+    }
+
     std::string JsonContainer::toString(const JsonContainerKey& key) const {
-        auto jval = getValueInJson({ key });
+        auto jval = getValueInJson(std::vector<JsonContainerKey> { key });
         return valueToString(*jval);
     }
 
@@ -86,77 +660,59 @@ namespace leatherman { namespace json_container {
     }
 
     std::string JsonContainer::toPrettyString(size_t left_padding) const {
-        if (empty()) {
-            switch (type()) {
-                case DataType::Object:
-                    return "{}";
-                case DataType::Array:
-                    return "[]";
-                default:
-                    return "\"\"";
-            }
-        }
-
-        std::string formatted_data {};
-
-        if (type() == DataType::Object) {
-            for (const auto& key : keys()) {
-                formatted_data += std::string(left_padding, ' ');
-                formatted_data += key + " : ";
-                switch (type(key)) {
-                    case DataType::Object:
-                        // Inner object: add new line, increment padding
-                        formatted_data += "\n";
-                        formatted_data += get<JsonContainer>(key).toPrettyString(
-                                            left_padding + LEFT_PADDING_INCREMENT);
-                        break;
-                    case DataType::Array:
-                        // Array: add raw string, regardless of its items
-                        formatted_data += toString(key);
-                        break;
-                    case DataType::String:
-                        formatted_data += get<std::string>(key);
-                        break;
-                    case DataType::Int:
-                        formatted_data += std::to_string(get<int64_t>(key));
-                        break;
-                    case DataType::Bool:
-                        if (get<bool>(key)) {
-                            formatted_data += "true";
-                        } else {
-                            formatted_data += "false";
-                        }
-                        break;
-                    case DataType::Double:
-                        formatted_data += std::to_string(get<double>(key));
-                        break;
-                    default:
-                        formatted_data += "NULL";
-                }
-                formatted_data += "\n";
-            }
-        } else {
-            formatted_data += toString();
-        }
-
-        return formatted_data;
+        return toPrettyJson(left_padding);
     }
 
     std::string JsonContainer::toPrettyString() const {
-        return toPrettyString(DEFAULT_LEFT_PADDING);
+        return toPrettyJson();
     }
 
     std::string JsonContainer::toPrettyJson(size_t left_padding) const {
         rapidjson::StringBuffer buffer;
-        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer { buffer };
-        writer.SetIndent(' ', left_padding);
-        auto& jval = *getValueInJson();
-        jval.Accept(writer);
+        write_pretty(*getValueInJson(), buffer, left_padding);
         return buffer.GetString();
     }
 
+    void JsonContainer::writePretty(std::ostream& os, size_t left_padding) const {
+        ostream_stream stream { os };
+        write_pretty(*document_root_, stream, left_padding);
+    }
+
     // capacity
 
+    namespace {
+
+        // Accumulates node and string payload counts over a subtree.
+        void accountValue(const json_value& jval, JsonMemoryStats& stats) {
+            stats.node_count++;
+
+            if (jval.IsObject()) {
+                for (auto itr = jval.MemberBegin(); itr != jval.MemberEnd(); ++itr) {
+                    stats.string_bytes += itr->name.GetStringLength();
+                    accountValue(itr->value, stats);
+                }
+            } else if (jval.IsArray()) {
+                for (auto itr = jval.Begin(); itr != jval.End(); ++itr) {
+                    accountValue(*itr, stats);
+                }
+            } else if (jval.IsString()) {
+                stats.string_bytes += jval.GetStringLength();
+            }
+        }
+
+    }  // namespace
+
+    JsonMemoryStats JsonContainer::memoryUsage() const {
+        JsonMemoryStats stats {};
+        stats.allocator_size = document_root_->GetAllocator().Size();
+        stats.allocator_capacity = document_root_->GetAllocator().Capacity();
+        if (insitu_buffer_) {
+            stats.buffer_bytes = insitu_buffer_->capacity();
+        }
+        accountValue(*document_root_, stats);
+        return stats;
+    }
+
     bool JsonContainer::empty() const {
         auto jval = getValueInJson();
         auto data_type = getValueType(*jval);
@@ -176,7 +732,7 @@ namespace leatherman { namespace json_container {
     }
 
     size_t JsonContainer::size(const JsonContainerKey& key) const {
-        auto jval = getValueInJson({ key });
+        auto jval = getValueInJson(std::vector<JsonContainerKey> { key });
         return getSize(*jval);
     }
 
@@ -185,6 +741,11 @@ namespace leatherman { namespace json_container {
         return getSize(*jval);
     }
 
+    size_t JsonContainer::size(const JsonPath& path) const {
+        auto jval = getValueInJson(path);
+        return getSize(*jval);
+    }
+
     // keys
 
     std::vector<std::string> JsonContainer::keys() const {
@@ -202,6 +763,56 @@ namespace leatherman { namespace json_container {
         return k;
     }
 
+    JsonMemberRange JsonContainer::members() const {
+        return JsonMemberRange { *this, *getValueInJson() };
+    }
+
+    JsonView JsonContainer::view() const {
+        return JsonView { *this };
+    }
+
+    JsonView JsonContainer::view(const JsonContainerKey& key) const {
+        return JsonView { *this,
+                          *getValueInJson(std::vector<JsonContainerKey> { key }) };
+    }
+
+    JsonView JsonContainer::view(const std::vector<JsonContainerKey>& keys) const {
+        return JsonView { *this, *getValueInJson(keys) };
+    }
+
+    JsonView JsonContainer::view(const JsonPath& path) const {
+        return JsonView { *this, *getValueInJson(path) };
+    }
+
+    JsonMemberRange JsonView::members() const {
+        return JsonMemberRange { *owner_, *value_ };
+    }
+
+    JsonMember JsonMemberIterator::operator*() const {
+        return JsonMember {
+            JsonStringView { member_->name.GetString(), member_->name.GetStringLength() },
+            JsonView { *owner_, member_->value } };
+    }
+
+    JsonMemberIterator& JsonMemberIterator::operator++() {
+        ++member_;
+        return *this;
+    }
+
+    JsonMemberIterator JsonMemberRange::begin() const {
+        if (!value_->IsObject()) {
+            return end();
+        }
+        return JsonMemberIterator { *owner_, &*value_->MemberBegin() };
+    }
+
+    JsonMemberIterator JsonMemberRange::end() const {
+        if (!value_->IsObject()) {
+            return JsonMemberIterator { *owner_, nullptr };
+        }
+        return JsonMemberIterator { *owner_, &*value_->MemberEnd() };
+    }
+
     // includes
 
     bool JsonContainer::includes(const JsonContainerKey& key) const {
@@ -227,6 +838,19 @@ namespace leatherman { namespace json_container {
         return true;
     }
 
+    bool JsonContainer::includes(const JsonPath& path) const {
+        auto jval = dynamic_cast<json_value*>(document_root_.get());
+
+        for (const auto& key : path.components()) {
+            if (!hasKey(*jval, key.data())) {
+                return false;
+            }
+            jval = getValueInJson(*jval, key.data());
+        }
+
+        return true;
+    }
+
     // type
 
     DataType JsonContainer::type() const {
@@ -235,7 +859,7 @@ namespace leatherman { namespace json_container {
     }
 
     DataType JsonContainer::type(const JsonContainerKey& key) const {
-        auto jval = getValueInJson({ key });
+        auto jval = getValueInJson(std::vector<JsonContainerKey> { key });
         return getValueType(*jval);
     }
 
@@ -244,6 +868,11 @@ namespace leatherman { namespace json_container {
         return getValueType(*jval);
     }
 
+    DataType JsonContainer::type(const JsonPath& path) const {
+        auto jval = getValueInJson(path);
+        return getValueType(*jval);
+    }
+
     DataType JsonContainer::type(const size_t idx) const {
         auto jval = getValueInJson(std::vector<JsonContainerKey> {}, true, idx);
         return getValueType(*jval);
@@ -304,7 +933,15 @@ namespace leatherman { namespace json_container {
     // Internal key / index manipulation methods
 
     bool JsonContainer::hasKey(const json_value& jval, const char* key) const {
-        return (jval.IsObject() && jval.HasMember(key));
+        if (!jval.IsObject()) {
+            return false;
+        }
+
+        if (key_index_enabled_) {
+            return lookupInKeyIndex(jval, key) != nullptr;
+        }
+
+        return jval.HasMember(key);
     }
 
     bool JsonContainer::isObject(const json_value& jval) const {
@@ -317,6 +954,14 @@ namespace leatherman { namespace json_container {
             throw data_type_error { _("not an object") };
         }
 
+        if (key_index_enabled_) {
+            auto entry = lookupInKeyIndex(jval, key);
+            if (entry == nullptr) {
+                throw data_key_error { _("unknown object entry with key: {1}", key) };
+            }
+            return entry;
+        }
+
         if (!jval.HasMember(key)) {
             throw data_key_error { _("unknown object entry with key: {1}", key) };
         }
@@ -324,6 +969,58 @@ namespace leatherman { namespace json_container {
         return const_cast<json_value*>(&jval[key]);
     }
 
+    void JsonContainer::invalidateKeyIndex() {
+        key_index_.reset();
+    }
+
+    void JsonContainer::indexObject(const json_value& jval) const {
+        if (!key_index_) {
+            key_index_.reset(new KeyIndex());
+        }
+
+        auto inserted = key_index_->objects.emplace(
+            &jval, std::unordered_map<std::string, json_value*> {});
+        auto& members = inserted.first->second;
+
+        if (inserted.second) {
+            members.reserve(jval.MemberCount());
+            for (json_value::ConstMemberIterator itr = jval.MemberBegin();
+                 itr != jval.MemberEnd(); ++itr) {
+                members.emplace(
+                    std::string(itr->name.GetString(), itr->name.GetStringLength()),
+                    const_cast<json_value*>(&itr->value));
+            }
+        }
+    }
+
+    void JsonContainer::buildKeyIndex(const json_value& jval) const {
+        if (jval.IsObject()) {
+            indexObject(jval);
+            for (json_value::ConstMemberIterator itr = jval.MemberBegin();
+                 itr != jval.MemberEnd(); ++itr) {
+                buildKeyIndex(itr->value);
+            }
+        } else if (jval.IsArray()) {
+            for (auto itr = jval.Begin(); itr != jval.End(); ++itr) {
+                buildKeyIndex(*itr);
+            }
+        }
+    }
+
+    json_value* JsonContainer::lookupInKeyIndex(const json_value& jval,
+                                                const char* key) const {
+        // Probe before building so that lookups on already indexed
+        // objects never modify the index; freeze() relies on this to
+        // make reads on frozen containers side-effect free.
+        if (!key_index_ || key_index_->objects.find(&jval) == key_index_->objects.end()) {
+            indexObject(jval);
+        }
+
+        auto& members = key_index_->objects.find(&jval)->second;
+        auto found = members.find(key);
+        return found == members.end() ? nullptr : found->second;
+    }
+
     json_value* JsonContainer::getValueInJson(const json_value& jval,
                                                     const size_t& idx) const {
         if (getValueType(jval) != DataType::Array) {
@@ -354,13 +1051,83 @@ namespace leatherman { namespace json_container {
         return jval;
     }
 
+    json_value* JsonContainer::getValueInJson(const JsonPath& path) const {
+        auto jval = dynamic_cast<json_value*>(document_root_.get());
+
+        for (const auto& key : path.components()) {
+            jval = getValueInJson(*jval, key.data());
+        }
+
+        return jval;
+    }
+
     void JsonContainer::createKeyInJson(const char* key,
                                         json_value& jval) {
-        jval.AddMember(json_value(key, document_root_->GetAllocator()).Move(),
+        // Adding a member may reallocate the object's member storage,
+        // so any index built during this set() is no longer valid.
+        invalidateKeyIndex();
+        json_value name;
+        if (intern_table_) {
+            name.SetString(rapidjson::StringRef(intern(key, strlen(key))));
+        } else {
+            name.SetString(key, strlen(key), document_root_->GetAllocator());
+        }
+        jval.AddMember(name,
                        json_value(rapidjson::kObjectType).Move(),
                        document_root_->GetAllocator());
     }
 
+    json_value* JsonContainer::ensureArrayInJson(const char* key, bool clear) {
+        auto jval = getValueInJson();
+
+        if (!isObject(*jval)) {
+            throw data_key_error { _("root is not a valid JSON object") };
+        }
+
+        bool created { false };
+
+        if (!hasKey(*jval, key)) {
+            createKeyInJson(key, *jval);
+            created = true;
+        }
+
+        auto entry = getValueInJson(*jval, key);
+
+        if (created || clear) {
+            entry->SetArray();
+        } else if (getValueType(*entry) != DataType::Array) {
+            throw data_type_error { _("not an array") };
+        }
+
+        return entry;
+    }
+
+    void JsonContainer::reserveArray(json_value& jval, size_t n) {
+        jval.Reserve(n, document_root_->GetAllocator());
+    }
+
+    void JsonContainer::reserve(const JsonContainerKey& key, size_t n) {
+        detach();
+        invalidateKeyIndex();
+        reserveArray(*ensureArrayInJson(key.data(), false), n);
+    }
+
+    // appendValue; instantiated below for the supported value types
+
+    template <typename T>
+    void JsonContainer::appendValue(json_value& jval, T new_value) {
+        json_value element;
+        setValue<T>(element, new_value);
+        jval.PushBack(element, document_root_->GetAllocator());
+    }
+
+    template void JsonContainer::appendValue<bool>(json_value&, bool);
+    template void JsonContainer::appendValue<int>(json_value&, int);
+    template void JsonContainer::appendValue<double>(json_value&, double);
+    template void JsonContainer::appendValue<std::string>(json_value&, std::string);
+    template void JsonContainer::appendValue<const char*>(json_value&, const char*);
+    template void JsonContainer::appendValue<JsonContainer>(json_value&, JsonContainer);
+
     // getValue specialisations
 
     template<>
@@ -415,6 +1182,19 @@ namespace leatherman { namespace json_container {
         return std::string(value.GetString(), value.GetStringLength());
     }
 
+    template<>
+    JsonStringView JsonContainer::getValue<>(const json_value& value) const {
+        if (value.IsNull()) {
+            return JsonStringView { "", 0 };
+        }
+
+        if (!value.IsString()) {
+            throw data_type_error { _("not a string") };
+        }
+
+        return JsonStringView { value.GetString(), value.GetStringLength() };
+    }
+
     template<>
     double JsonContainer::getValue<>(const json_value& value) const {
         if (value.IsNull()) {
@@ -568,10 +1348,10 @@ namespace leatherman { namespace json_container {
                 throw data_type_error { _("not an object") };
             }
 
-            JsonContainer* tmp_this = const_cast<JsonContainer*>(this);
-            const json_value tmpvalue(*itr, tmp_this->document_root_->GetAllocator());
-            JsonContainer tmp_data { tmpvalue };
-            tmp.push_back(tmp_data);
+            // Copy straight into the new container's own document;
+            // going through this document's allocator would leak pool
+            // memory and mutate a possibly shared document on a read.
+            tmp.push_back(JsonContainer { *itr });
         }
 
         return tmp;
@@ -591,12 +1371,22 @@ namespace leatherman { namespace json_container {
 
     template<>
     void JsonContainer::setValue<>(json_value& jval, const std::string new_value) {
-        jval.SetString(new_value.data(), new_value.size(), document_root_->GetAllocator());
+        if (intern_table_ && new_value.size() <= INTERN_VALUE_MAX_LENGTH) {
+            jval.SetString(rapidjson::StringRef(
+                intern(new_value.data(), new_value.size()), new_value.size()));
+        } else {
+            jval.SetString(new_value.data(), new_value.size(), document_root_->GetAllocator());
+        }
     }
 
     template<>
     void JsonContainer::setValue<>(json_value& jval, const char * new_value) {
-        jval.SetString(new_value, std::string(new_value).size(), document_root_->GetAllocator());
+        auto length = strlen(new_value);
+        if (intern_table_ && length <= INTERN_VALUE_MAX_LENGTH) {
+            jval.SetString(rapidjson::StringRef(intern(new_value, length), length));
+        } else {
+            jval.SetString(new_value, length, document_root_->GetAllocator());
+        }
     }
 
     template<>
@@ -611,7 +1401,12 @@ namespace leatherman { namespace json_container {
         for (const auto& value : new_value) {
             // rapidjson doesn't like std::string...
             json_value s;
-            s.SetString(value.data(), value.size(), document_root_->GetAllocator());
+            if (intern_table_ && value.size() <= INTERN_VALUE_MAX_LENGTH) {
+                s.SetString(rapidjson::StringRef(
+                    intern(value.data(), value.size()), value.size()));
+            } else {
+                s.SetString(value.data(), value.size(), document_root_->GetAllocator());
+            }
             jval.PushBack(s, document_root_->GetAllocator());
         }
     }
@@ -0,0 +1,250 @@
+#include <leatherman/json_container/json_container.hpp>
+#include <leatherman/locale/locale.hpp>
+
+#include <rapidjson/document.h>
+#include <rapidjson/allocators.h>
+#include <rapidjson/rapidjson.h>
+
+// Mark string for translation (alias for leatherman::locale::format)
+using leatherman::locale::_;
+
+namespace leatherman { namespace json_container {
+
+    namespace {
+
+        // Escapes a key for use as a JSON Pointer token ("~" -> "~0",
+        // "/" -> "~1").
+        std::string escapeToken(const char* key, size_t length) {
+            std::string token {};
+            token.reserve(length);
+
+            for (size_t i = 0; i < length; i++) {
+                switch (key[i]) {
+                    case '~':
+                        token += "~0";
+                        break;
+                    case '/':
+                        token += "~1";
+                        break;
+                    default:
+                        token += key[i];
+                }
+            }
+
+            return token;
+        }
+
+        void addOp(json_value& ops, json_allocator& alloc, const char* op,
+                   const std::string& path, const json_value* value) {
+            json_value entry { rapidjson::kObjectType };
+            entry.AddMember(json_value("op", alloc).Move(),
+                            json_value(op, alloc).Move(), alloc);
+            entry.AddMember(json_value("path", alloc).Move(),
+                            json_value(path.data(), path.size(), alloc).Move(), alloc);
+            if (value != nullptr) {
+                json_value copy;
+                copy.CopyFrom(*value, alloc);
+                entry.AddMember(json_value("value", alloc).Move(), copy, alloc);
+            }
+            ops.PushBack(entry, alloc);
+        }
+
+        void diffValues(const json_value& from, const json_value& to,
+                        const std::string& path, json_value& ops,
+                        json_allocator& alloc) {
+            if (from == to) {
+                return;
+            }
+
+            if (from.IsObject() && to.IsObject()) {
+                for (json_value::ConstMemberIterator itr = from.MemberBegin();
+                     itr != from.MemberEnd(); ++itr) {
+                    auto token = path + "/" + escapeToken(itr->name.GetString(),
+                                                          itr->name.GetStringLength());
+                    auto found = to.FindMember(itr->name);
+                    if (found == to.MemberEnd()) {
+                        addOp(ops, alloc, "remove", token, nullptr);
+                    } else {
+                        diffValues(itr->value, found->value, token, ops, alloc);
+                    }
+                }
+
+                for (json_value::ConstMemberIterator itr = to.MemberBegin();
+                     itr != to.MemberEnd(); ++itr) {
+                    if (from.FindMember(itr->name) == from.MemberEnd()) {
+                        auto token = path + "/" + escapeToken(itr->name.GetString(),
+                                                              itr->name.GetStringLength());
+                        addOp(ops, alloc, "add", token, &itr->value);
+                    }
+                }
+                return;
+            }
+
+            if (from.IsArray() && to.IsArray()) {
+                auto common = std::min(from.Size(), to.Size());
+
+                for (rapidjson::SizeType i = 0; i < common; i++) {
+                    diffValues(from[i], to[i], path + "/" + std::to_string(i),
+                               ops, alloc);
+                }
+
+                for (auto i = common; i < to.Size(); i++) {
+                    addOp(ops, alloc, "add", path + "/" + std::to_string(i), &to[i]);
+                }
+
+                // Remove trailing elements back to front so that the
+                // indices of earlier removals stay valid.
+                for (auto i = from.Size(); i > common; i--) {
+                    addOp(ops, alloc, "remove", path + "/" + std::to_string(i - 1),
+                          nullptr);
+                }
+                return;
+            }
+
+            addOp(ops, alloc, "replace", path, &to);
+        }
+
+        // Parses an array index token; "-" denotes one past the end.
+        size_t parseIndex(const std::string& token, size_t size) {
+            if (token == "-") {
+                return size;
+            }
+
+            if (token.empty()
+                    || token.find_first_not_of("0123456789") != std::string::npos) {
+                throw data_index_error { _("invalid array index: {1}", token) };
+            }
+
+            return std::stoul(token);
+        }
+
+        // Inserts a copy of value at the given position of an array,
+        // shifting later elements; rapidjson has no insert primitive.
+        void insertAt(json_value& array, size_t idx, const json_value& value,
+                      json_allocator& alloc) {
+            if (idx > array.Size()) {
+                throw data_index_error { _("array index out of bounds") };
+            }
+
+            json_value placeholder;
+            array.PushBack(placeholder, alloc);
+
+            for (auto i = array.Size() - 1; i > idx; i--) {
+                array[i] = array[i - 1];
+            }
+
+            array[idx].CopyFrom(value, alloc);
+        }
+
+    }  // namespace
+
+    JsonContainer JsonContainer::diff(const JsonContainer& from,
+                                      const JsonContainer& to) {
+        JsonContainer patch { "[]" };
+        diffValues(*from.document_root_, *to.document_root_, "",
+                   *patch.document_root_, patch.document_root_->GetAllocator());
+        return patch;
+    }
+
+    void JsonContainer::applyPatch(const JsonContainer& patch) {
+        if (!patch.document_root_->IsArray()) {
+            throw data_type_error { _("patch is not an array") };
+        }
+
+        detach();
+        invalidateKeyIndex();
+        auto& alloc = document_root_->GetAllocator();
+
+        for (json_value::ConstValueIterator op_itr = patch.document_root_->Begin();
+             op_itr != patch.document_root_->End(); ++op_itr) {
+            if (!op_itr->IsObject() || !op_itr->HasMember("op")
+                    || !op_itr->HasMember("path")
+                    || !(*op_itr)["op"].IsString()
+                    || !(*op_itr)["path"].IsString()) {
+                throw data_type_error { _("malformed patch operation") };
+            }
+
+            std::string op { (*op_itr)["op"].GetString() };
+            JsonPath path { std::string { (*op_itr)["path"].GetString() } };
+            const auto& tokens = path.components();
+
+            if (tokens.empty()) {
+                // Whole-document operations.
+                if (op == "remove") {
+                    document_root_->SetObject();
+                } else if (op == "add" || op == "replace") {
+                    document_root_->CopyFrom((*op_itr)["value"], alloc);
+                } else {
+                    throw data_type_error { _("unsupported patch operation: {1}", op) };
+                }
+                continue;
+            }
+
+            // Resolve the parent of the target entry.
+            json_value* parent = dynamic_cast<json_value*>(document_root_.get());
+            for (size_t i = 0; i + 1 < tokens.size(); i++) {
+                if (parent->IsArray()) {
+                    auto idx = parseIndex(tokens[i], parent->Size());
+                    parent = getValueInJson(*parent, idx);
+                } else {
+                    parent = getValueInJson(*parent, tokens[i].data());
+                }
+            }
+
+            const auto& token = tokens.back();
+            bool has_value = op_itr->HasMember("value");
+
+            if ((op == "add" || op == "replace") && !has_value) {
+                throw data_type_error { _("malformed patch operation") };
+            }
+
+            if (parent->IsArray()) {
+                if (op == "add") {
+                    insertAt(*parent, parseIndex(token, parent->Size()),
+                             (*op_itr)["value"], alloc);
+                } else if (op == "remove" || op == "replace") {
+                    auto idx = parseIndex(token, parent->Size());
+                    if (idx >= parent->Size()) {
+                        throw data_index_error { _("array index out of bounds") };
+                    }
+                    if (op == "remove") {
+                        parent->Erase(parent->Begin() + idx);
+                    } else {
+                        (*parent)[idx].CopyFrom((*op_itr)["value"], alloc);
+                    }
+                } else {
+                    throw data_type_error { _("unsupported patch operation: {1}", op) };
+                }
+            } else if (parent->IsObject()) {
+                auto found = parent->FindMember(token.data());
+
+                if (op == "add") {
+                    if (found != parent->MemberEnd()) {
+                        found->value.CopyFrom((*op_itr)["value"], alloc);
+                    } else {
+                        json_value copy;
+                        copy.CopyFrom((*op_itr)["value"], alloc);
+                        parent->AddMember(
+                            json_value(token.data(), token.size(), alloc).Move(),
+                            copy, alloc);
+                    }
+                } else if (op == "remove" || op == "replace") {
+                    if (found == parent->MemberEnd()) {
+                        throw data_key_error {
+                            _("unknown object entry with key: {1}", token) };
+                    }
+                    if (op == "remove") {
+                        parent->EraseMember(found);
+                    } else {
+                        found->value.CopyFrom((*op_itr)["value"], alloc);
+                    }
+                } else {
+                    throw data_type_error { _("unsupported patch operation: {1}", op) };
+                }
+            } else {
+                throw data_type_error { _("cannot patch a scalar parent entry") };
+            }
+        }
+    }
+
+}}  // namespace leatherman::json_container
@@ -0,0 +1,311 @@
+#include <leatherman/json_container/json_schema.hpp>
+#include <leatherman/locale/locale.hpp>
+
+#include <rapidjson/document.h>
+#include <rapidjson/allocators.h>
+#include <rapidjson/rapidjson.h>
+
+// Mark string for translation (alias for leatherman::locale::format)
+using leatherman::locale::_;
+
+namespace leatherman { namespace json_container {
+
+    namespace {
+
+        // Escapes a key for use as a JSON Pointer token ("~" -> "~0",
+        // "/" -> "~1"), as in json_patch.cc.
+        std::string escapeToken(const char* key, size_t length) {
+            std::string token {};
+            token.reserve(length);
+
+            for (size_t i = 0; i < length; i++) {
+                if (key[i] == '~') {
+                    token += "~0";
+                } else if (key[i] == '/') {
+                    token += "~1";
+                } else {
+                    token += key[i];
+                }
+            }
+
+            return token;
+        }
+
+    }  // namespace
+
+    // Compiled form of one schema level. The keyword values are
+    // resolved into plain members at compile time, so validation reads
+    // them without any further DOM lookups.
+    struct JsonSchema::Node {
+        enum class Type { any, object, array, string, integer, number, boolean, null_value };
+
+        struct Property {
+            std::string name;
+            std::unique_ptr<Node> schema;
+        };
+
+        Type type { Type::any };
+        std::vector<Property> properties;
+        std::vector<std::string> required;
+        bool additional_properties { true };
+        std::unique_ptr<Node> items;
+        std::vector<std::string> enum_values;
+        bool has_minimum { false };
+        double minimum { 0 };
+        bool has_maximum { false };
+        double maximum { 0 };
+        bool has_min_items { false };
+        size_t min_items { 0 };
+        bool has_max_items { false };
+        size_t max_items { 0 };
+        bool has_min_length { false };
+        size_t min_length { 0 };
+        bool has_max_length { false };
+        size_t max_length { 0 };
+
+        static Type typeFromName(const json_value& tval) {
+            if (!tval.IsString()) {
+                throw schema_error { _("schema \"type\" must be a string") };
+            }
+
+            const std::string name { tval.GetString(), tval.GetStringLength() };
+            if (name == "object")  return Type::object;
+            if (name == "array")   return Type::array;
+            if (name == "string")  return Type::string;
+            if (name == "integer") return Type::integer;
+            if (name == "number")  return Type::number;
+            if (name == "boolean") return Type::boolean;
+            if (name == "null")    return Type::null_value;
+            throw schema_error { _("unknown schema type: {1}", name) };
+        }
+
+        static const char* typeName(Type type) {
+            switch (type) {
+                case Type::object:     return "object";
+                case Type::array:      return "array";
+                case Type::string:     return "string";
+                case Type::integer:    return "integer";
+                case Type::number:     return "number";
+                case Type::boolean:    return "boolean";
+                case Type::null_value: return "null";
+                default:               return "any";
+            }
+        }
+
+        static bool matchesType(const json_value& val, Type type) {
+            switch (type) {
+                case Type::object:     return val.IsObject();
+                case Type::array:      return val.IsArray();
+                case Type::string:     return val.IsString();
+                case Type::integer:    return val.IsInt64() || val.IsUint64();
+                case Type::number:     return val.IsNumber();
+                case Type::boolean:    return val.IsBool();
+                case Type::null_value: return val.IsNull();
+                default:               return true;
+            }
+        }
+    };
+
+    std::unique_ptr<JsonSchema::Node> JsonSchema::compile(const json_value& sval) {
+        if (!sval.IsObject()) {
+            throw schema_error { _("schema must be a JSON object") };
+        }
+
+        std::unique_ptr<Node> node { new Node() };
+
+        auto tval = sval.FindMember("type");
+        if (tval != sval.MemberEnd()) {
+            node->type = Node::typeFromName(tval->value);
+        }
+
+        auto props = sval.FindMember("properties");
+        if (props != sval.MemberEnd()) {
+            if (!props->value.IsObject()) {
+                throw schema_error { _("schema \"properties\" must be an object") };
+            }
+            for (auto itr = props->value.MemberBegin();
+                 itr != props->value.MemberEnd(); ++itr) {
+                Node::Property property;
+                property.name.assign(itr->name.GetString(),
+                                     itr->name.GetStringLength());
+                property.schema = compile(itr->value);
+                node->properties.push_back(std::move(property));
+            }
+        }
+
+        auto req = sval.FindMember("required");
+        if (req != sval.MemberEnd()) {
+            if (!req->value.IsArray()) {
+                throw schema_error { _("schema \"required\" must be an array") };
+            }
+            for (auto itr = req->value.Begin(); itr != req->value.End(); ++itr) {
+                if (!itr->IsString()) {
+                    throw schema_error { _("schema \"required\" entries must be strings") };
+                }
+                node->required.emplace_back(itr->GetString(), itr->GetStringLength());
+            }
+        }
+
+        auto additional = sval.FindMember("additionalProperties");
+        if (additional != sval.MemberEnd()) {
+            if (!additional->value.IsBool()) {
+                throw schema_error { _("schema \"additionalProperties\" must be a boolean") };
+            }
+            node->additional_properties = additional->value.GetBool();
+        }
+
+        auto items = sval.FindMember("items");
+        if (items != sval.MemberEnd()) {
+            node->items = compile(items->value);
+        }
+
+        auto enum_values = sval.FindMember("enum");
+        if (enum_values != sval.MemberEnd()) {
+            if (!enum_values->value.IsArray()) {
+                throw schema_error { _("schema \"enum\" must be an array") };
+            }
+            for (auto itr = enum_values->value.Begin();
+                 itr != enum_values->value.End(); ++itr) {
+                if (!itr->IsString()) {
+                    throw schema_error { _("schema \"enum\" entries must be strings") };
+                }
+                node->enum_values.emplace_back(itr->GetString(), itr->GetStringLength());
+            }
+        }
+
+        auto getNumber = [&sval](const char* keyword, bool& present, double& value) {
+            auto entry = sval.FindMember(keyword);
+            if (entry != sval.MemberEnd()) {
+                if (!entry->value.IsNumber()) {
+                    throw schema_error { _("schema \"{1}\" must be a number", keyword) };
+                }
+                present = true;
+                value = entry->value.GetDouble();
+            }
+        };
+        getNumber("minimum", node->has_minimum, node->minimum);
+        getNumber("maximum", node->has_maximum, node->maximum);
+
+        auto getCount = [&sval](const char* keyword, bool& present, size_t& value) {
+            auto entry = sval.FindMember(keyword);
+            if (entry != sval.MemberEnd()) {
+                if (!entry->value.IsUint64()) {
+                    throw schema_error { _("schema \"{1}\" must be a non-negative integer", keyword) };
+                }
+                present = true;
+                value = static_cast<size_t>(entry->value.GetUint64());
+            }
+        };
+        getCount("minItems", node->has_min_items, node->min_items);
+        getCount("maxItems", node->has_max_items, node->max_items);
+        getCount("minLength", node->has_min_length, node->min_length);
+        getCount("maxLength", node->has_max_length, node->max_length);
+
+        return node;
+    }
+
+    void JsonSchema::check(const Node& node, const json_value& val,
+                           const std::string& path,
+                           std::vector<SchemaValidationError>& errors) {
+        if (!Node::matchesType(val, node.type)) {
+            errors.push_back({ path, _("expected {1}", Node::typeName(node.type)) });
+            // Without the right type the remaining keywords can't be
+            // evaluated meaningfully.
+            return;
+        }
+
+        if (val.IsObject()) {
+            for (auto const& property : node.properties) {
+                auto member = val.FindMember(property.name.data());
+                if (member != val.MemberEnd()) {
+                    check(*property.schema, member->value,
+                          path + '/' + escapeToken(property.name.data(),
+                                                   property.name.size()),
+                          errors);
+                }
+            }
+            for (auto const& name : node.required) {
+                if (val.FindMember(name.data()) == val.MemberEnd()) {
+                    errors.push_back({ path, _("missing required entry: {1}", name) });
+                }
+            }
+            if (!node.additional_properties) {
+                for (auto itr = val.MemberBegin(); itr != val.MemberEnd(); ++itr) {
+                    bool known = false;
+                    for (auto const& property : node.properties) {
+                        if (property.name.size() == itr->name.GetStringLength()
+                                && property.name.compare(0, property.name.size(),
+                                                         itr->name.GetString(),
+                                                         itr->name.GetStringLength()) == 0) {
+                            known = true;
+                            break;
+                        }
+                    }
+                    if (!known) {
+                        errors.push_back({ path, _("unexpected entry: {1}",
+                                                   std::string(itr->name.GetString(),
+                                                               itr->name.GetStringLength())) });
+                    }
+                }
+            }
+        } else if (val.IsArray()) {
+            if (node.has_min_items && val.Size() < node.min_items) {
+                errors.push_back({ path, _("expected at least {1} entries", node.min_items) });
+            }
+            if (node.has_max_items && val.Size() > node.max_items) {
+                errors.push_back({ path, _("expected at most {1} entries", node.max_items) });
+            }
+            if (node.items) {
+                size_t index = 0;
+                for (auto itr = val.Begin(); itr != val.End(); ++itr, ++index) {
+                    check(*node.items, *itr, path + '/' + std::to_string(index), errors);
+                }
+            }
+        } else if (val.IsString()) {
+            if (node.has_min_length && val.GetStringLength() < node.min_length) {
+                errors.push_back({ path, _("expected at least {1} characters", node.min_length) });
+            }
+            if (node.has_max_length && val.GetStringLength() > node.max_length) {
+                errors.push_back({ path, _("expected at most {1} characters", node.max_length) });
+            }
+            if (!node.enum_values.empty()) {
+                const std::string value { val.GetString(), val.GetStringLength() };
+                if (std::find(node.enum_values.begin(), node.enum_values.end(), value)
+                        == node.enum_values.end()) {
+                    errors.push_back({ path, _("value not allowed: {1}", value) });
+                }
+            }
+        } else if (val.IsNumber()) {
+            if (node.has_minimum && val.GetDouble() < node.minimum) {
+                errors.push_back({ path, _("value below minimum of {1}", node.minimum) });
+            }
+            if (node.has_maximum && val.GetDouble() > node.maximum) {
+                errors.push_back({ path, _("value above maximum of {1}", node.maximum) });
+            }
+        }
+    }
+
+    JsonSchema::JsonSchema(const JsonContainer& schema)
+            : root_ { compile(schema.getRaw()) } {
+    }
+
+    JsonSchema::JsonSchema(JsonSchema&& other) = default;
+    JsonSchema& JsonSchema::operator=(JsonSchema&& other) = default;
+
+    // unique_ptr requires a complete type at time of destruction, as
+    // in json_container.cc.
+    JsonSchema::~JsonSchema() {}
+
+    bool JsonSchema::validate(const JsonContainer& data,
+                              std::vector<SchemaValidationError>& errors) const {
+        auto initial = errors.size();
+        check(*root_, data.getRaw(), "", errors);
+        return errors.size() == initial;
+    }
+
+    bool JsonSchema::validate(const JsonContainer& data) const {
+        std::vector<SchemaValidationError> errors;
+        return validate(data, errors);
+    }
+
+}}  // namespace leatherman::json_container
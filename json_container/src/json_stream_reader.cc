@@ -0,0 +1,123 @@
+#include <leatherman/json_container/json_stream_reader.hpp>
+#include <leatherman/locale/locale.hpp>
+
+#include <rapidjson/reader.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/rapidjson.h>
+
+#include <istream>
+
+// Mark string for translation (alias for leatherman::locale::format)
+using leatherman::locale::_;
+
+namespace leatherman { namespace json_container {
+
+    namespace {
+
+        // Adapts JsonEventHandler to the rapidjson SAX handler concept.
+        struct event_forwarder {
+            explicit event_forwarder(JsonEventHandler& handler) : handler_(handler) {}
+
+            bool Null() { return handler_.onNull(); }
+            bool Bool(bool b) { return handler_.onBool(b); }
+            bool Int(int i) { return handler_.onInt(i); }
+            bool Uint(unsigned u) { return handler_.onInt(u); }
+            bool Int64(int64_t i) { return handler_.onInt(i); }
+            bool Uint64(uint64_t u) { return handler_.onInt(static_cast<int64_t>(u)); }
+            bool Double(double d) { return handler_.onDouble(d); }
+            bool String(const char* str, rapidjson::SizeType length, bool) {
+                return handler_.onString(str, length);
+            }
+            bool Key(const char* str, rapidjson::SizeType length, bool) {
+                return handler_.onKey(str, length);
+            }
+            bool StartObject() { return handler_.onStartObject(); }
+            bool EndObject(rapidjson::SizeType member_count) {
+                return handler_.onEndObject(member_count);
+            }
+            bool StartArray() { return handler_.onStartArray(); }
+            bool EndArray(rapidjson::SizeType element_count) {
+                return handler_.onEndArray(element_count);
+            }
+
+            JsonEventHandler& handler_;
+        };
+
+        // Minimal rapidjson input stream over a std::istream, buffered
+        // in fixed-size chunks so the payload is never held in memory
+        // as a whole.
+        class istream_wrapper {
+        public:
+            typedef char Ch;
+
+            explicit istream_wrapper(std::istream& is)
+                    : is_(is), pos_(0), len_(0), count_(0) {
+                fill();
+            }
+
+            Ch Peek() const { return pos_ < len_ ? buffer_[pos_] : '\0'; }
+
+            Ch Take() {
+                if (pos_ >= len_) {
+                    return '\0';
+                }
+                Ch c = buffer_[pos_++];
+                ++count_;
+                if (pos_ >= len_) {
+                    fill();
+                }
+                return c;
+            }
+
+            size_t Tell() const { return count_; }
+
+            // Write API; not used for reading.
+            Ch* PutBegin() { RAPIDJSON_ASSERT(false); return 0; }
+            void Put(Ch) { RAPIDJSON_ASSERT(false); }
+            void Flush() { RAPIDJSON_ASSERT(false); }
+            size_t PutEnd(Ch*) { RAPIDJSON_ASSERT(false); return 0; }
+
+        private:
+            void fill() {
+                is_.read(buffer_, sizeof(buffer_));
+                pos_ = 0;
+                len_ = static_cast<size_t>(is_.gcount());
+            }
+
+            std::istream& is_;
+            char buffer_[65536];
+            size_t pos_;
+            size_t len_;
+            size_t count_;
+        };
+
+        template <typename Stream>
+        bool do_parse(Stream& stream, JsonEventHandler& handler) {
+            rapidjson::Reader reader;
+            event_forwarder forwarder { handler };
+
+            if (reader.Parse<rapidjson::kParseStopWhenDoneFlag>(stream, forwarder)) {
+                return true;
+            }
+
+            if (reader.GetParseErrorCode() == rapidjson::kParseErrorTermination) {
+                // The handler stopped the parse.
+                return false;
+            }
+
+            throw data_parse_error { _("invalid json") };
+        }
+
+    }  // namespace
+
+    bool JsonStreamReader::parse(const std::string& json_txt, JsonEventHandler& handler) {
+        rapidjson::StringStream stream { json_txt.data() };
+        return do_parse(stream, handler);
+    }
+
+    bool JsonStreamReader::parse(std::istream& input, JsonEventHandler& handler) {
+        istream_wrapper stream { input };
+        return do_parse(stream, handler);
+    }
+
+}}  // namespace leatherman::json_container
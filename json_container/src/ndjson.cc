@@ -0,0 +1,97 @@
+#include <leatherman/json_container/ndjson.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace leatherman { namespace json_container {
+
+    namespace {
+
+        // A [begin, end) byte range of one record in the input buffer.
+        using record_range = std::pair<size_t, size_t>;
+
+        std::vector<record_range> splitRecords(const std::string& text) {
+            std::vector<record_range> records;
+            size_t pos { 0 };
+
+            while (pos < text.size()) {
+                auto eol = text.find('\n', pos);
+                if (eol == std::string::npos) {
+                    eol = text.size();
+                }
+
+                auto begin = pos;
+                auto end = eol;
+
+                // Tolerate CRLF line endings and skip blank lines.
+                if (end > begin && text[end - 1] == '\r') {
+                    --end;
+                }
+                if (text.find_first_not_of(" \t", begin) < end) {
+                    records.emplace_back(begin, end);
+                }
+
+                pos = eol + 1;
+            }
+
+            return records;
+        }
+
+    }  // namespace
+
+    std::vector<JsonContainer> parseNdjson(const std::string& text,
+                                           size_t num_threads) {
+        auto records = splitRecords(text);
+        std::vector<JsonContainer> documents { records.size() };
+
+        if (records.empty()) {
+            return documents;
+        }
+
+        if (num_threads == 0) {
+            num_threads = std::thread::hardware_concurrency();
+        }
+        num_threads = std::max<size_t>(1, std::min(num_threads, records.size()));
+
+        std::mutex error_mutex;
+        std::exception_ptr first_error;
+
+        auto worker = [&](size_t worker_idx) {
+            try {
+                for (auto idx = worker_idx; idx < records.size(); idx += num_threads) {
+                    const auto& range = records[idx];
+                    documents[idx] = JsonContainer {
+                        text.substr(range.first, range.second - range.first) };
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock { error_mutex };
+                if (!first_error) {
+                    first_error = std::current_exception();
+                }
+            }
+        };
+
+        if (num_threads == 1) {
+            worker(0);
+        } else {
+            std::vector<std::thread> threads;
+            threads.reserve(num_threads);
+            for (size_t i = 0; i < num_threads; i++) {
+                threads.emplace_back(worker, i);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        if (first_error) {
+            std::rethrow_exception(first_error);
+        }
+
+        return documents;
+    }
+
+}}  // namespace leatherman::json_container
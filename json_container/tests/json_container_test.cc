@@ -1,6 +1,8 @@
 #include <catch.hpp>
 #include <leatherman/json_container/json_container.hpp>
+#include <rapidjson/document.h>
 #include <iostream>
+#include <sstream>
 
 static const std::string JSON = "{\"foo\" : {\"bar\" : 2},"
                                 " \"goo\" : 1,"
@@ -105,6 +107,372 @@ TEST_CASE("JsonContainer::JsonContainer - passing JSON string", "[data]") {
     }
 }
 
+TEST_CASE("JsonContainer::JsonContainer - in situ parsing", "[data]") {
+    SECTION("it should parse a JSON object taking ownership of the buffer") {
+        std::string json_value { JSON };
+        JsonContainer data { std::move(json_value), in_situ };
+
+        REQUIRE(data.get<std::string>("string") == "a string");
+        REQUIRE(data.get<int>("goo") == 1);
+        REQUIRE(data.get<std::string>({ "nested", "foo" }) == "bar");
+    }
+
+    SECTION("it should parse scalars and arrays") {
+        JsonContainer data { std::string { "[1, 2, 3]" }, in_situ };
+        REQUIRE(data.get<int>(1) == 2);
+    }
+
+    SECTION("the parsed document should survive assignment") {
+        JsonContainer data { std::string { "{\"foo\" : \"bar\"}" }, in_situ };
+        JsonContainer other {};
+        other = data;
+        REQUIRE(other.get<std::string>("foo") == "bar");
+    }
+
+    SECTION("it should throw a data_parse_error in case of invalid JSON") {
+        std::string json_value { "{\"foo\" : \"bar\", 42}" };
+        REQUIRE_THROWS_AS(JsonContainer(std::move(json_value), in_situ),
+                          data_parse_error);
+    }
+}
+
+TEST_CASE("JsonContainer::JsonContainer - move semantics", "[data]") {
+    SECTION("it should steal the document instead of copying it") {
+        JsonContainer data { JSON };
+        auto before = data.get<JsonStringView>("string").data;
+
+        JsonContainer moved { std::move(data) };
+
+        REQUIRE(moved.get<JsonStringView>("string").data == before);
+    }
+
+    SECTION("the moved-from container should be left as an empty object") {
+        JsonContainer data { JSON };
+        JsonContainer moved { std::move(data) };
+
+        REQUIRE(data.type() == DataType::Object);
+        REQUIRE(data.empty());
+    }
+
+    SECTION("it should keep an in situ buffer alive") {
+        JsonContainer data { std::string { JSON }, in_situ };
+        JsonContainer moved { std::move(data) };
+
+        REQUIRE(moved.get<std::string>("string") == "a string");
+    }
+}
+
+TEST_CASE("JsonContainer::adopt / release", "[data]") {
+    SECTION("release should hand over the document and leave an empty object") {
+        JsonContainer data { JSON };
+        auto document = std::move(data).release();
+
+        REQUIRE(data.type() == DataType::Object);
+        REQUIRE(data.empty());
+        REQUIRE(document["goo"].GetInt() == 1);
+    }
+
+    SECTION("adopt should make the adopted values readable") {
+        JsonContainer data { JSON };
+        auto document = std::move(data).release();
+        JsonContainer other { "{\"replaced\" : true}" };
+
+        other.adopt(std::move(document));
+
+        REQUIRE_FALSE(other.includes("replaced"));
+        REQUIRE(other.get<std::string>("string") == "a string");
+        REQUIRE(other.get<std::string>({ "nested", "foo" }) == "bar");
+    }
+
+    SECTION("release should keep an adopted document without copying") {
+        JsonContainer data { JSON };
+        JsonContainer other {};
+        other.adopt(std::move(data).release());
+        auto before = other.get<JsonStringView>("string").data;
+
+        auto document = std::move(other).release();
+
+        REQUIRE(document["string"].GetString() == before);
+    }
+
+    SECTION("releasing a parsed container should yield an owning document") {
+        JsonContainer data { JSON };
+        auto document = std::move(data).release();
+
+        REQUIRE(std::string { document["string"].GetString() } == "a string");
+        REQUIRE(document["goo"].GetInt() == 1);
+    }
+
+    SECTION("releasing an in situ parsed container should yield an owning document") {
+        JsonContainer data { std::string { JSON }, in_situ };
+        auto document = std::move(data).release();
+
+        REQUIRE(std::string { document["string"].GetString() } == "a string");
+        REQUIRE(document["vec"][1].GetInt() == 2);
+    }
+
+    SECTION("releasing a shared document should not disturb the other owner") {
+        JsonContainer data { JSON };
+        JsonContainer copy { data };
+        auto document = std::move(data).release();
+
+        REQUIRE(copy.get<int>("goo") == 1);
+        REQUIRE(document["goo"].GetInt() == 1);
+    }
+}
+
+TEST_CASE("JsonContainer - copy-on-write sharing", "[data]") {
+    SECTION("copies should share the document until mutated") {
+        JsonContainer data { JSON };
+        JsonContainer copy { data };
+
+        REQUIRE(copy.get<JsonStringView>("string").data
+                == data.get<JsonStringView>("string").data);
+    }
+
+    SECTION("mutating a copy should not affect the original") {
+        JsonContainer data { JSON };
+        JsonContainer copy { data };
+
+        copy.set<int>("goo", 42);
+
+        REQUIRE(copy.get<int>("goo") == 42);
+        REQUIRE(data.get<int>("goo") == 1);
+        REQUIRE(copy.get<JsonStringView>("string").data
+                != data.get<JsonStringView>("string").data);
+    }
+
+    SECTION("mutating the original should not affect copies") {
+        JsonContainer data { JSON };
+        JsonContainer copy { data };
+
+        data.set<int>("goo", 42);
+
+        REQUIRE(copy.get<int>("goo") == 1);
+        REQUIRE(data.get<int>("goo") == 42);
+    }
+
+    SECTION("assignment should share as well") {
+        JsonContainer data { JSON };
+        JsonContainer other {};
+        other = data;
+
+        REQUIRE(other.get<JsonStringView>("string").data
+                == data.get<JsonStringView>("string").data);
+
+        other.set<int>("goo", 3);
+        REQUIRE(data.get<int>("goo") == 1);
+    }
+}
+
+TEST_CASE("JsonContainer::JsonContainer - arena backed documents", "[data]") {
+    JsonArena arena {};
+
+    SECTION("it should parse documents out of the arena") {
+        JsonContainer data { JSON, arena };
+
+        REQUIRE(data.get<std::string>("string") == "a string");
+        REQUIRE(arena.size() > 0u);
+    }
+
+    SECTION("it should support mutation out of the arena") {
+        JsonContainer data { arena };
+        data.set<int>("foo", 42);
+
+        REQUIRE(data.get<int>("foo") == 42);
+    }
+
+    SECTION("it should be reusable across documents after a reset") {
+        {
+            JsonContainer data { JSON, arena };
+        }
+        auto reserved = arena.capacity();
+        arena.reset();
+
+        REQUIRE(arena.size() == 0u);
+
+        JsonContainer data { JSON, arena };
+        REQUIRE(data.get<int>("goo") == 1);
+        REQUIRE(arena.capacity() <= reserved);
+    }
+}
+
+TEST_CASE("JsonContainer::enableKeyIndex", "[data]") {
+    JsonContainer data { JSON };
+    data.enableKeyIndex();
+
+    SECTION("indexed lookups should behave like linear ones") {
+        REQUIRE(data.includes("goo"));
+        REQUIRE_FALSE(data.includes("spam"));
+        REQUIRE(data.get<int>("goo") == 1);
+        REQUIRE(data.get<std::string>({ "nested", "foo" }) == "bar");
+        REQUIRE_THROWS_AS(data.get<int>("spam"), data_key_error);
+    }
+
+    SECTION("the index should be rebuilt after a mutation") {
+        REQUIRE(data.get<int>("goo") == 1);
+
+        data.set<int>("new_key", 42);
+
+        REQUIRE(data.includes("new_key"));
+        REQUIRE(data.get<int>("new_key") == 42);
+        REQUIRE(data.get<int>("goo") == 1);
+    }
+}
+
+TEST_CASE("JsonContainer::memoryUsage", "[data]") {
+    SECTION("node and string accounting reflect the document") {
+        JsonContainer data { "{\"foo\" : \"bar\", \"vec\" : [1, 2]}" };
+        auto stats = data.memoryUsage();
+
+        // Root, two entry values, and two array elements.
+        REQUIRE(stats.node_count == 5u);
+        // "foo" + "vec" keys and the "bar" value.
+        REQUIRE(stats.string_bytes == 9u);
+        REQUIRE(stats.buffer_bytes == 0u);
+    }
+
+    SECTION("allocator accounting reflects parsing work") {
+        JsonContainer data { JSON };
+        auto stats = data.memoryUsage();
+
+        REQUIRE(stats.allocator_size > 0u);
+        REQUIRE(stats.allocator_capacity >= stats.allocator_size);
+    }
+
+    SECTION("in situ buffers are accounted for") {
+        std::string text { "{\"foo\" : \"bar\"}" };
+        auto text_size = text.size();
+        JsonContainer data { std::move(text), in_situ };
+
+        REQUIRE(data.memoryUsage().buffer_bytes >= text_size);
+    }
+}
+
+TEST_CASE("JsonContainer - inline document storage", "[data]") {
+    SECTION("small documents stay within the bundled arena") {
+        JsonContainer data { "{\"id\" : 42, \"type\" : \"ping\"}" };
+
+        // No allocator chunk beyond the inline arena was needed.
+        REQUIRE(data.memoryUsage().allocator_capacity <= 512u);
+    }
+
+    SECTION("documents grow past the arena transparently") {
+        JsonContainer data {};
+        for (int i = 0; i < 200; i++) {
+            data.set<int>("key_" + std::to_string(i), i);
+        }
+
+        REQUIRE(data.memoryUsage().allocator_capacity > 512u);
+        REQUIRE(data.get<int>("key_199") == 199);
+    }
+}
+
+TEST_CASE("JsonContainer - parse options", "[data]") {
+    SECTION("full precision parsing should round-trip doubles") {
+        JsonContainer data { "[0.1, 2.5]", ParseOptions::full_precision };
+        REQUIRE(data.get<double>(0) == 0.1);
+        REQUIRE(data.get<double>(1) == 2.5);
+    }
+
+    SECTION("iterative parsing should handle deeply nested input") {
+        const size_t depth = 2000;
+        std::string deep (depth, '[');
+        deep.append(depth, ']');
+
+        JsonContainer data { deep, ParseOptions::iterative };
+        REQUIRE(data.type() == DataType::Array);
+    }
+
+    SECTION("options should combine") {
+        JsonContainer data { "{\"goo\":1.25}",
+                             ParseOptions::full_precision | ParseOptions::iterative };
+        REQUIRE(data.get<double>("goo") == 1.25);
+    }
+
+    SECTION("invalid JSON should still raise a data_parse_error") {
+        REQUIRE_THROWS_AS((JsonContainer { "{", ParseOptions::iterative }),
+                          data_parse_error);
+    }
+}
+
+TEST_CASE("JsonContainer::freeze", "[data]") {
+    JsonContainer data { JSON };
+
+    SECTION("frozen containers should expose read access") {
+        auto frozen = data.freeze();
+
+        REQUIRE(frozen->get<int>("goo") == 1);
+        REQUIRE(frozen->get<std::string>({ "nested", "foo" }) == "bar");
+        REQUIRE(frozen->includes("vec"));
+        REQUIRE(frozen->type("bool") == DataType::Bool);
+    }
+
+    SECTION("freezing with key indexing enabled should pre-build the indexes") {
+        data.enableKeyIndex();
+        auto frozen = data.freeze();
+
+        REQUIRE(frozen->get<int>("goo") == 1);
+        REQUIRE_FALSE(frozen->includes("spam"));
+    }
+
+    SECTION("mutating the source container should not affect the frozen copy") {
+        auto frozen = data.freeze();
+        data.set<int>("goo", 42);
+
+        REQUIRE(data.get<int>("goo") == 42);
+        REQUIRE(frozen->get<int>("goo") == 1);
+    }
+
+    SECTION("copies of a frozen container should read the same document") {
+        data.enableKeyIndex();
+        auto frozen = data.freeze();
+        auto copy = frozen;
+
+        REQUIRE(copy->get<int>("goo") == 1);
+        REQUIRE(copy->toString() == frozen->toString());
+    }
+}
+
+TEST_CASE("JsonContainer::enableStringInterning", "[data]") {
+    JsonContainer data {};
+    data.enableStringInterning();
+
+    SECTION("repeated short values should share storage") {
+        data.set<std::string>("first", "repeated value");
+        data.set<std::string>("second", "repeated value");
+
+        REQUIRE(data.get<JsonStringView>("first").data
+                == data.get<JsonStringView>("second").data);
+    }
+
+    SECTION("long values should not be interned") {
+        std::string long_value (2 * INTERN_VALUE_MAX_LENGTH, 'x');
+        data.set<std::string>("first", long_value);
+        data.set<std::string>("second", long_value);
+
+        REQUIRE(data.get<JsonStringView>("first").data
+                != data.get<JsonStringView>("second").data);
+        REQUIRE(data.get<std::string>("first") == long_value);
+    }
+
+    SECTION("interned documents should serialize as usual") {
+        data.set<std::string>("foo", "bar");
+        data.set<std::string>("baz", "bar");
+
+        REQUIRE(data.toString() == "{\"foo\":\"bar\",\"baz\":\"bar\"}");
+    }
+
+    SECTION("copies should keep interned strings alive") {
+        data.set<std::string>("foo", "bar");
+        JsonContainer copy { data };
+        copy.set<std::string>("baz", "qux");
+
+        REQUIRE(copy.get<std::string>("foo") == "bar");
+        REQUIRE(data.toString() == "{\"foo\":\"bar\"}");
+    }
+}
+
 TEST_CASE("JsonContainer::get for object entries", "[data]") {
     JsonContainer data { JSON };
 
@@ -389,6 +757,80 @@ TEST_CASE("JsonContainer::get for object entries", "[data]") {
     }
 }
 
+TEST_CASE("JsonContainer - compiled JsonPath lookups", "[data]") {
+    JsonContainer data { JSON };
+
+    SECTION("it should look up nested entries through a compiled path") {
+        JsonPath path { std::vector<std::string> { "nested", "foo" } };
+
+        REQUIRE(data.get<std::string>(path) == "bar");
+        REQUIRE(data.includes(path));
+        REQUIRE(data.type(path) == DataType::String);
+    }
+
+    SECTION("it should compile JSON Pointer expressions") {
+        JsonPath path { std::string { "/foo/bar" } };
+
+        REQUIRE(data.get<int>(path) == 2);
+    }
+
+    SECTION("it should resolve JSON Pointer escapes") {
+        JsonContainer escapes { "{\"a/b\" : {\"m~n\" : 42}}" };
+        JsonPath path { std::string { "/a~1b/m~0n" } };
+
+        REQUIRE(escapes.get<int>(path) == 42);
+    }
+
+    SECTION("an empty pointer should denote the root") {
+        JsonPath path { std::string {} };
+
+        REQUIRE(data.size(path) == data.size());
+        REQUIRE(data.type(path) == DataType::Object);
+    }
+
+    SECTION("it should report missing entries") {
+        JsonPath path { std::vector<std::string> { "nested", "spam" } };
+
+        REQUIRE_FALSE(data.includes(path));
+        REQUIRE_THROWS_AS(data.get<int>(path), data_key_error);
+    }
+
+    SECTION("it should throw a data_key_error for malformed pointers") {
+        REQUIRE_THROWS_AS(JsonPath { std::string { "foo/bar" } }, data_key_error);
+        REQUIRE_THROWS_AS(JsonPath { std::string { "/foo~2" } }, data_key_error);
+    }
+}
+
+TEST_CASE("JsonContainer::get<JsonStringView>", "[data]") {
+    JsonContainer data { JSON };
+
+    SECTION("it should view strings without copying") {
+        auto view = data.get<JsonStringView>("string");
+
+        REQUIRE(view == std::string { "a string" });
+        REQUIRE(view.str() == "a string");
+    }
+
+    SECTION("it should preserve embedded null characters") {
+        auto view = data.get<JsonStringView>("string_with_null");
+
+        std::string expected { "a string\0with\0null", 18 };
+        REQUIRE(view.size == 18u);
+        REQUIRE(view == expected);
+    }
+
+    SECTION("it should return an empty view for null values") {
+        auto view = data.get<JsonStringView>("null");
+
+        REQUIRE(view.size == 0u);
+        REQUIRE(view.str().empty());
+    }
+
+    SECTION("it should throw a data_type_error for non-string values") {
+        REQUIRE_THROWS_AS(data.get<JsonStringView>("goo"), data_type_error);
+    }
+}
+
 TEST_CASE("JsonContainer::getWithDefault", "[data]") {
     JsonContainer data { JSON };
     JsonContainer data_a { "[1, 2, 3]" };
@@ -443,6 +885,61 @@ TEST_CASE("JsonContainer::getWithDefault", "[data]") {
     }
 }
 
+TEST_CASE("JsonContainer binary round-trips", "[data]") {
+    SECTION("it should round-trip every supported data type") {
+        JsonContainer data { JSON };
+        auto decoded = JsonContainer::fromBinary(data.toBinary());
+
+        REQUIRE(decoded.toString() == data.toString());
+        REQUIRE(decoded.get<std::string>("string_with_null")
+                == std::string("a string\0with\0null", 18));
+    }
+
+    SECTION("it should round-trip scalar roots") {
+        JsonContainer data { "42" };
+        REQUIRE(JsonContainer::fromBinary(data.toBinary()).get<int>() == 42);
+    }
+
+    SECTION("it should throw a data_parse_error on truncated data") {
+        JsonContainer data { JSON };
+        auto encoded = data.toBinary();
+        encoded.resize(encoded.size() / 2);
+
+        REQUIRE_THROWS_AS(JsonContainer::fromBinary(encoded), data_parse_error);
+    }
+
+    SECTION("it should throw a data_parse_error on trailing garbage") {
+        JsonContainer data { "{}" };
+        auto encoded = data.toBinary();
+        encoded.push_back('x');
+
+        REQUIRE_THROWS_AS(JsonContainer::fromBinary(encoded), data_parse_error);
+    }
+}
+
+TEST_CASE("JsonContainer::write", "[data]") {
+    JsonContainer data { "{\"foo\" : \"bar\"}" };
+
+    SECTION("it should serialize straight to a stream") {
+        std::ostringstream os {};
+        data.write(os);
+
+        REQUIRE(os.str() == data.toString());
+    }
+
+    SECTION("it should serialize into a caller-provided buffer") {
+        char buffer[64];
+        auto written = data.write(buffer, sizeof(buffer));
+
+        REQUIRE(std::string(buffer, written) == data.toString());
+    }
+
+    SECTION("it should throw a data_error in case the buffer is too small") {
+        char buffer[4];
+        REQUIRE_THROWS_AS(data.write(buffer, sizeof(buffer)), data_error);
+    }
+}
+
 TEST_CASE("JsonContainer::toString", "[data]") {
     SECTION("root entry") {
         SECTION("object") {
@@ -509,6 +1006,19 @@ TEST_CASE("JsonContainer::toPrettyString", "[data]") {
             REQUIRE_NOTHROW(data_ooa.toPrettyString());
         }
     }
+
+    SECTION("matches toPrettyJson") {
+        JsonContainer data { JSON };
+        REQUIRE(data.toPrettyString() == data.toPrettyJson());
+        REQUIRE(data.toPrettyString(2) == data.toPrettyJson(2));
+    }
+
+    SECTION("writePretty streams the same output") {
+        JsonContainer data { JSON };
+        std::ostringstream os;
+        data.writePretty(os);
+        REQUIRE(os.str() == data.toPrettyJson());
+    }
 }
 
 TEST_CASE("JsonContainer::toPrettyJson", "[data]") {
@@ -897,6 +1407,155 @@ TEST_CASE("JsonContainer::set", "[data]") {
     }
 }
 
+TEST_CASE("JsonView", "[data]") {
+    JsonContainer data { JSON };
+
+    SECTION("it should traverse nested entries without copying") {
+        JsonView root { data };
+        auto nested = root.view("nested");
+
+        REQUIRE(nested.type() == DataType::Object);
+        REQUIRE(nested.get<std::string>("foo") == "bar");
+        REQUIRE(nested.get<JsonStringView>("foo").data
+                == data.get<JsonStringView>({ "nested", "foo" }).data);
+    }
+
+    SECTION("it should index into arrays") {
+        JsonView root { data };
+
+        REQUIRE(root.view("vec").view(1).get<int>() == 2);
+        REQUIRE_THROWS_AS(root.view("vec").view(5), data_index_error);
+    }
+
+    SECTION("it should report keys and sizes") {
+        JsonView root { data };
+
+        REQUIRE(root.size() == data.size());
+        REQUIRE(root.includes("goo"));
+        REQUIRE_FALSE(root.includes("spam"));
+    }
+
+    SECTION("it should materialize an owning copy on demand") {
+        JsonView root { data };
+        auto copy = root.view("nested").get<JsonContainer>();
+
+        REQUIRE(copy.get<std::string>("foo") == "bar");
+    }
+
+    SECTION("it should throw a data_type_error when descending a scalar") {
+        JsonView root { data };
+
+        REQUIRE_THROWS_AS(root.view("goo").view("foo"), data_type_error);
+    }
+}
+
+TEST_CASE("JsonContainer::view", "[data]") {
+    JsonContainer data { JSON };
+
+    SECTION("it should view the root entry") {
+        REQUIRE(data.view().type() == DataType::Object);
+        REQUIRE(data.view().size() == data.size());
+    }
+
+    SECTION("a resolved entry should answer type, size, and get") {
+        auto nested = data.view("nested");
+
+        REQUIRE(nested.type() == DataType::Object);
+        REQUIRE(nested.size() == 1u);
+        REQUIRE(nested.includes("foo"));
+        REQUIRE(nested.get<std::string>("foo") == "bar");
+    }
+
+    SECTION("it should resolve nested keys and compiled paths") {
+        REQUIRE(data.view({ "nested", "foo" }).get<std::string>() == "bar");
+
+        JsonPath path { std::vector<std::string> { "nested", "foo" } };
+        REQUIRE(data.view(path).get<std::string>() == "bar");
+    }
+
+    SECTION("it should throw a data_key_error for unknown entries") {
+        REQUIRE_THROWS_AS(data.view("spam"), data_key_error);
+        REQUIRE_THROWS_AS(data.view({ "nested", "spam" }), data_key_error);
+    }
+}
+
+TEST_CASE("JsonContainer::reserve / append / setAll", "[data]") {
+    JsonContainer data {};
+
+    SECTION("append should create and grow an array entry") {
+        data.append<int>("values", 1);
+        data.append<int>("values", 2);
+
+        REQUIRE(data.get<std::vector<int>>("values") == std::vector<int>({ 1, 2 }));
+    }
+
+    SECTION("reserve should pre-size without adding elements") {
+        data.reserve("values", 1000);
+
+        REQUIRE(data.type("values") == DataType::Array);
+        REQUIRE(data.size("values") == 0u);
+
+        data.append<std::string>("values", "foo");
+        REQUIRE(data.size("values") == 1u);
+    }
+
+    SECTION("setAll should replace the entry from an iterator range") {
+        std::vector<std::string> values { "spam", "eggs" };
+        data.set<int>("values", 42);
+        data.setAll("values", values.begin(), values.end());
+
+        REQUIRE(data.get<std::vector<std::string>>("values") == values);
+    }
+
+    SECTION("append should refuse non-array entries") {
+        data.set<int>("scalar", 1);
+
+        REQUIRE_THROWS_AS(data.append<int>("scalar", 2), data_type_error);
+        REQUIRE_THROWS_AS(data.reserve("scalar", 10), data_type_error);
+    }
+}
+
+TEST_CASE("JsonContainer::members", "[data]") {
+    JsonContainer data { JSON };
+
+    SECTION("it should walk members in a single pass without copies") {
+        std::vector<std::string> found {};
+
+        for (const auto& member : data.members()) {
+            found.push_back(member.key.str());
+        }
+
+        REQUIRE(found == data.keys());
+    }
+
+    SECTION("it should expose member values as views") {
+        for (const auto& member : data.members()) {
+            if (member.key == std::string { "goo" }) {
+                REQUIRE(member.value.get<int>() == 1);
+            } else if (member.key == std::string { "nested" }) {
+                REQUIRE(member.value.get<std::string>("foo") == "bar");
+            }
+        }
+    }
+
+    SECTION("it should iterate nested objects through JsonView") {
+        size_t count { 0 };
+
+        for (const auto& member : JsonView { data }.view("nested").members()) {
+            REQUIRE(member.key == std::string { "foo" });
+            count++;
+        }
+
+        REQUIRE(count == 1u);
+    }
+
+    SECTION("it should yield an empty range for non-objects") {
+        JsonContainer array { "[1, 2, 3]" };
+
+        REQUIRE(array.members().begin() == array.members().end());
+    }
+}
+
 TEST_CASE("JsonContainer::keys", "[data]") {
     SECTION("It returns a vector of keys") {
         JsonContainer data { "{ \"a\" : 1, "
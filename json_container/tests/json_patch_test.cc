@@ -0,0 +1,87 @@
+#include <catch.hpp>
+#include <leatherman/json_container/json_container.hpp>
+
+using namespace leatherman::json_container;
+
+TEST_CASE("JsonContainer::diff / applyPatch", "[data]") {
+    SECTION("identical documents should produce an empty patch") {
+        JsonContainer data { "{\"foo\" : 1}" };
+
+        REQUIRE(JsonContainer::diff(data, data).empty());
+    }
+
+    SECTION("a round-trip should reproduce the target document") {
+        JsonContainer from {
+            "{\"certname\" : \"node-1\","
+            " \"facts\" : {\"os\" : \"linux\", \"arch\" : \"x86_64\"},"
+            " \"tags\" : [\"a\", \"b\", \"c\"],"
+            " \"count\" : 3}" };
+        JsonContainer to {
+            "{\"certname\" : \"node-1\","
+            " \"facts\" : {\"os\" : \"linux\", \"kernel\" : \"5.4\"},"
+            " \"tags\" : [\"a\", \"x\"],"
+            " \"status\" : \"changed\"}" };
+
+        auto patch = JsonContainer::diff(from, to);
+        from.applyPatch(patch);
+
+        REQUIRE(from.toString() == to.toString());
+    }
+
+    SECTION("the patch size should scale with the change") {
+        JsonContainer from { "{\"a\" : 1, \"b\" : 2, \"c\" : 3, \"d\" : 4}" };
+        JsonContainer to { "{\"a\" : 1, \"b\" : 2, \"c\" : 3, \"d\" : 5}" };
+
+        auto patch = JsonContainer::diff(from, to);
+
+        REQUIRE(patch.size() == 1u);
+        REQUIRE(patch.get<JsonContainer>(0u).get<std::string>("op") == "replace");
+        REQUIRE(patch.get<JsonContainer>(0u).get<std::string>("path") == "/d");
+    }
+
+    SECTION("it should escape JSON Pointer special characters in keys") {
+        JsonContainer from { "{\"a/b\" : 1, \"m~n\" : 2}" };
+        JsonContainer to { "{\"a/b\" : 10, \"m~n\" : 20}" };
+
+        auto patch = JsonContainer::diff(from, to);
+        from.applyPatch(patch);
+
+        REQUIRE(from.toString() == to.toString());
+    }
+
+    SECTION("it should diff nested arrays of objects") {
+        JsonContainer from { "{\"items\" : [{\"id\" : 1}, {\"id\" : 2}]}" };
+        JsonContainer to { "{\"items\" : [{\"id\" : 1}, {\"id\" : 2}, {\"id\" : 3}]}" };
+
+        auto patch = JsonContainer::diff(from, to);
+        from.applyPatch(patch);
+
+        REQUIRE(from.toString() == to.toString());
+    }
+
+    SECTION("applyPatch should support explicit RFC 6902 operations") {
+        JsonContainer data { "{\"foo\" : [1, 2]}" };
+        JsonContainer patch {
+            "[{\"op\" : \"add\", \"path\" : \"/foo/-\", \"value\" : 3},"
+            " {\"op\" : \"replace\", \"path\" : \"/foo/0\", \"value\" : 0},"
+            " {\"op\" : \"add\", \"path\" : \"/bar\", \"value\" : \"baz\"},"
+            " {\"op\" : \"remove\", \"path\" : \"/foo/1\"}]" };
+
+        data.applyPatch(patch);
+
+        REQUIRE(data.get<std::vector<int>>("foo") == std::vector<int>({ 0, 3 }));
+        REQUIRE(data.get<std::string>("bar") == "baz");
+    }
+
+    SECTION("applyPatch should reject malformed patches") {
+        JsonContainer data { "{\"foo\" : 1}" };
+
+        REQUIRE_THROWS_AS(data.applyPatch(JsonContainer { "{}" }), data_type_error);
+        REQUIRE_THROWS_AS(
+            data.applyPatch(JsonContainer { "[{\"op\" : \"add\", \"path\" : \"/x\"}]" }),
+            data_type_error);
+        REQUIRE_THROWS_AS(
+            data.applyPatch(JsonContainer { "[{\"op\" : \"remove\", \"path\" : \"/nope\"}]" }),
+            data_key_error);
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch.hpp>
+#include <leatherman/json_container/json_schema.hpp>
+
+using namespace leatherman::json_container;
+
+static const std::string MESSAGE_SCHEMA {
+    "{\"type\" : \"object\","
+    " \"required\" : [\"id\", \"sender\"],"
+    " \"properties\" : {"
+    "     \"id\" : {\"type\" : \"integer\", \"minimum\" : 0},"
+    "     \"sender\" : {\"type\" : \"string\", \"minLength\" : 1},"
+    "     \"status\" : {\"type\" : \"string\","
+    "                   \"enum\" : [\"ready\", \"running\", \"done\"]},"
+    "     \"chunks\" : {\"type\" : \"array\", \"maxItems\" : 3,"
+    "                   \"items\" : {\"type\" : \"object\","
+    "                                \"required\" : [\"data\"]}}}}" };
+
+TEST_CASE("JsonSchema::validate", "[data]") {
+    JsonSchema schema { JsonContainer { MESSAGE_SCHEMA } };
+
+    SECTION("a conforming document should validate") {
+        JsonContainer data {
+            "{\"id\" : 42, \"sender\" : \"node-1\", \"status\" : \"done\","
+            " \"chunks\" : [{\"data\" : \"x\"}]}" };
+
+        REQUIRE(schema.validate(data));
+    }
+
+    SECTION("missing required entries should be reported") {
+        JsonContainer data { "{\"id\" : 42}" };
+        std::vector<SchemaValidationError> errors;
+
+        REQUIRE_FALSE(schema.validate(data, errors));
+        REQUIRE(errors.size() == 1u);
+        REQUIRE(errors[0].path == "");
+        REQUIRE(errors[0].message.find("sender") != std::string::npos);
+    }
+
+    SECTION("every failure should be collected in a single pass") {
+        JsonContainer data {
+            "{\"id\" : -1, \"sender\" : \"\", \"status\" : \"bogus\","
+            " \"chunks\" : [{}, {}, {}, {}]}" };
+        std::vector<SchemaValidationError> errors;
+
+        REQUIRE_FALSE(schema.validate(data, errors));
+        // id below minimum, empty sender, status not in the enum,
+        // too many chunks, and one missing "data" per chunk.
+        REQUIRE(errors.size() == 8u);
+    }
+
+    SECTION("error paths should point at the offending entry") {
+        JsonContainer data {
+            "{\"id\" : 42, \"sender\" : \"node-1\","
+            " \"chunks\" : [{\"data\" : \"x\"}, {}]}" };
+        std::vector<SchemaValidationError> errors;
+
+        REQUIRE_FALSE(schema.validate(data, errors));
+        REQUIRE(errors.size() == 1u);
+        REQUIRE(errors[0].path == "/chunks/1");
+    }
+
+    SECTION("type mismatches should be reported without recursing") {
+        JsonContainer data {
+            "{\"id\" : \"not a number\", \"sender\" : \"node-1\"}" };
+        std::vector<SchemaValidationError> errors;
+
+        REQUIRE_FALSE(schema.validate(data, errors));
+        REQUIRE(errors.size() == 1u);
+        REQUIRE(errors[0].path == "/id");
+    }
+
+    SECTION("additionalProperties false should reject unknown entries") {
+        JsonSchema strict { JsonContainer {
+            "{\"type\" : \"object\","
+            " \"properties\" : {\"foo\" : {\"type\" : \"integer\"}},"
+            " \"additionalProperties\" : false}" } };
+
+        REQUIRE(strict.validate(JsonContainer { "{\"foo\" : 1}" }));
+        REQUIRE_FALSE(strict.validate(JsonContainer { "{\"foo\" : 1, \"bar\" : 2}" }));
+    }
+
+    SECTION("a malformed schema should raise a schema_error") {
+        REQUIRE_THROWS_AS((JsonSchema { JsonContainer { "{\"type\" : 42}" } }),
+                          schema_error);
+        REQUIRE_THROWS_AS((JsonSchema { JsonContainer { "{\"required\" : \"id\"}" } }),
+                          schema_error);
+    }
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+#include <leatherman/json_container/json_stream_reader.hpp>
+
+#include <sstream>
+
+using namespace leatherman::json_container;
+
+namespace {
+
+    // Collects string values found under the given key.
+    class key_collector : public JsonEventHandler {
+    public:
+        explicit key_collector(std::string key) : key_ { std::move(key) } {}
+
+        bool onKey(const char* key, size_t length) override {
+            matched_ = (key_ == std::string(key, length));
+            return true;
+        }
+
+        bool onString(const char* value, size_t length) override {
+            if (matched_) {
+                values.emplace_back(value, length);
+                matched_ = false;
+            }
+            return true;
+        }
+
+        std::vector<std::string> values;
+
+    private:
+        std::string key_;
+        bool matched_ = false;
+    };
+
+    // Stops parsing at the first string value.
+    class first_string : public JsonEventHandler {
+    public:
+        bool onString(const char* value, size_t length) override {
+            first.assign(value, length);
+            return false;
+        }
+
+        std::string first;
+    };
+
+}  // namespace
+
+TEST_CASE("JsonStreamReader::parse", "[data]") {
+    JsonStreamReader reader {};
+
+    SECTION("it should deliver typed events without building a DOM") {
+        key_collector handler { "name" };
+        auto done = reader.parse(
+            "[{\"name\" : \"spam\", \"id\" : 1},"
+            " {\"name\" : \"eggs\", \"id\" : 2}]", handler);
+
+        REQUIRE(done);
+        REQUIRE(handler.values == std::vector<std::string>({ "spam", "eggs" }));
+    }
+
+    SECTION("it should stop early when the handler returns false") {
+        first_string handler {};
+        auto done = reader.parse("[\"foo\", \"bar\"]", handler);
+
+        REQUIRE_FALSE(done);
+        REQUIRE(handler.first == "foo");
+    }
+
+    SECTION("it should read from a stream") {
+        std::istringstream input { "{\"foo\" : \"bar\"}" };
+        key_collector handler { "foo" };
+
+        REQUIRE(reader.parse(input, handler));
+        REQUIRE(handler.values == std::vector<std::string>({ "bar" }));
+    }
+
+    SECTION("it should throw a data_parse_error in case of invalid JSON") {
+        JsonEventHandler handler {};
+        REQUIRE_THROWS_AS(reader.parse("{\"foo\" : }", handler),
+                          data_parse_error);
+    }
+}
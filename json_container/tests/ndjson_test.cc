@@ -0,0 +1,47 @@
+#include <catch.hpp>
+#include <leatherman/json_container/ndjson.hpp>
+
+using namespace leatherman::json_container;
+
+TEST_CASE("parseNdjson", "[data]") {
+    SECTION("it should parse records in order") {
+        auto documents = parseNdjson(
+            "{\"id\" : 0}\n{\"id\" : 1}\n{\"id\" : 2}\n");
+
+        REQUIRE(documents.size() == 3u);
+        for (size_t i = 0; i < documents.size(); i++) {
+            REQUIRE(documents[i].get<int>("id") == static_cast<int>(i));
+        }
+    }
+
+    SECTION("it should skip blank lines and tolerate CRLF endings") {
+        auto documents = parseNdjson("{\"id\" : 0}\r\n\n  \n{\"id\" : 1}");
+
+        REQUIRE(documents.size() == 2u);
+        REQUIRE(documents[1].get<int>("id") == 1);
+    }
+
+    SECTION("it should return no documents for an empty buffer") {
+        REQUIRE(parseNdjson("").empty());
+        REQUIRE(parseNdjson("\n\n").empty());
+    }
+
+    SECTION("it should preserve order when parsing on multiple threads") {
+        std::string text {};
+        for (int i = 0; i < 500; i++) {
+            text += "{\"id\" : " + std::to_string(i) + "}\n";
+        }
+
+        auto documents = parseNdjson(text, 4);
+
+        REQUIRE(documents.size() == 500u);
+        for (size_t i = 0; i < documents.size(); i++) {
+            REQUIRE(documents[i].get<int>("id") == static_cast<int>(i));
+        }
+    }
+
+    SECTION("it should throw a data_parse_error for invalid records") {
+        REQUIRE_THROWS_AS(parseNdjson("{\"id\" : 0}\nnot json\n"),
+                          data_parse_error);
+    }
+}
@@ -15,6 +15,18 @@ namespace leatherman { namespace locale {
         throw runtime_error("leatherman::locale::clear_domain is not supported on this platform");
     }
 
+    size_t preload_catalogs(string const& domain, vector<string> const& paths)
+    {
+        // No catalogs to warm when locales are unsupported.
+        return 0;
+    }
+
+    void register_embedded_catalog(string const& language, char const* data, size_t size, string const& domain)
+    {
+        // Translation is pass-through when locales are unsupported, so
+        // embedded catalogs are ignored.
+    }
+
     string translate(string const& msg, string const& domain)
     {
         return msg;
@@ -14,7 +14,6 @@
 #pragma once
 #include <locale>
 #include <vector>
-#include <functional>
 
 #include <boost/format.hpp>
 #include <boost/regex.hpp>
@@ -54,6 +53,34 @@ namespace leatherman { namespace locale {
      */
     void clear_domain(std::string const& domain = PROJECT_NAME);
 
+    /**
+     * Warms the message catalogs for a domain before first use.
+     * Memory-maps each catalog found under the configured search paths and
+     * advises the kernel to page it in, then generates the domain's locale
+     * while the pages are resident. Safe to call from startup code; failures
+     * to map individual catalogs are ignored.
+     * @param domain The catalog domain to preload.
+     * @param paths Search paths for localization files.
+     * @return The number of catalog files that were mapped.
+     */
+    size_t preload_catalogs(std::string const& domain = PROJECT_NAME,
+                            std::vector<std::string> const& paths = {PROJECT_DIR});
+
+    /**
+     * Registers a compiled message catalog linked into the binary.
+     * When a catalog is registered for a domain, get_locale serves that
+     * domain's translations from the registered bytes instead of searching
+     * the filesystem. The data is not copied, so it must stay valid for the
+     * life of the program; linked byte arrays (see the gettext_embed CMake
+     * helper) satisfy this naturally.
+     * @param language The language the catalog translates to, like "fr".
+     * @param data The compiled (.mo format) catalog bytes.
+     * @param size The number of bytes in the catalog.
+     * @param domain The catalog domain to register under.
+     */
+    void register_embedded_catalog(std::string const& language, char const* data, size_t size,
+                                   std::string const& domain = PROJECT_NAME);
+
     /**
      * Translate text using the locale initialized by this library.
      * If localization encounters an error, the original message will be returned.
@@ -100,6 +127,17 @@ namespace leatherman { namespace locale {
      */
     std::string translate_np(std::string const& context, std::string const& single, std::string const& plural, int n, std::string const& domain = PROJECT_NAME);
 
+    /**
+     * Returns a copy of a cached boost::format for the given format string.
+     * Parses the string - including the regex rewrite of {N} tokens to %N% -
+     * once per distinct string and serves later requests as a copy of the
+     * cached parse, which is much cheaper than re-parsing. The cache is
+     * safe for concurrent use.
+     * @param fmt The format string, using {N} or %N% style substitutions.
+     * @return Returns a boost::format ready to have arguments fed to it.
+     */
+    boost::format compiled_format(std::string const& fmt);
+
     namespace {
         /*
          * Anonymous namespace, limiting access to current namespace
@@ -107,29 +145,37 @@ namespace leatherman { namespace locale {
 
         /**
          * Translates and formats text using boost::regex and boost::format.
-         * @param trans The translation function.
+         * The translator is taken as a template parameter rather than a
+         * std::function so the call inlines instead of going through type
+         * erasure; this runs for every formatted log line.
+         * @param trans The translation callable.
          * @param domain Domain name.
          * @param args Format arguments.
          * @return The string generated by translating the format string, then applying the arguments.
          */
-        template <typename... TArgs>
-        std::string format_disabled_locales(std::function<std::string(const std::string&)>&& trans, std::string domain, TArgs... args) {
+        template <typename Translator, typename... TArgs>
+        std::string format_disabled_locales(Translator&& trans, std::string const& domain, TArgs&&... args) {
+            auto text = trans(domain);
+            // Argument-free strings without substitution or escape characters
+            // need no parsing at all; this is the common case for log
+            // messages and exception text.
+            if (sizeof...(TArgs) == 0 && text.find_first_of("%{") == std::string::npos) {
+                return text;
+            }
             // When locales are disabled, use boost::format, which expects %N% style formatting
-            static const boost::regex match{"\\{(\\d+)\\}"};
-            static const std::string repl{"%\\1%"};
-            boost::format form{boost::regex_replace(trans(domain), match, repl)};
+            auto form = compiled_format(text);
             (void) std::initializer_list<int>{ ((void)(form % args), 0)... };
             return form.str();
         }
 
         /**
          * Translates and formats text using the locale initialized by this library.
-         * @param trans The translation function.
+         * @param trans The translation callable.
          * @param args Format arguments.
          * @return The string generated by translating the format string, then applying the arguments.
          */
-        template <typename... TArgs>
-        std::string format_common(std::function<std::string(const std::string&)>&& trans, TArgs... args)
+        template <typename Translator, typename... TArgs>
+        std::string format_common(Translator&& trans, TArgs&&... args)
         {
             // Create and apply formatter here, as we want to guarantee the lifetime of the arguments.
             // boost::locale::format doesn't make copies, and a common gotcha is using temporary arguments
@@ -137,15 +183,19 @@ namespace leatherman { namespace locale {
             // Technique for the one-liner explained at http://florianjw.de/en/variadic_templates.html.
             static const std::string domain{PROJECT_NAME};
 #ifdef LEATHERMAN_I18N
-            boost::locale::format form{trans(domain)};
+            auto text = trans(domain);
+            if (sizeof...(TArgs) == 0 && text.find_first_of("%{") == std::string::npos) {
+                return text;
+            }
+            boost::locale::format form{text};
             (void) std::initializer_list<int>{ ((void)(form % args), 0)... };
             try {
                 return form.str(get_locale("", domain));
             } catch (const std::exception &e) {
-                return format_disabled_locales(std::move(trans), domain, std::forward<TArgs>(args)...);
+                return format_disabled_locales(std::forward<Translator>(trans), domain, std::forward<TArgs>(args)...);
             }
 #else
-            return format_disabled_locales(std::move(trans), domain, std::forward<TArgs>(args)...);
+            return format_disabled_locales(std::forward<Translator>(trans), domain, std::forward<TArgs>(args)...);
 #endif
         }
     }
@@ -160,7 +210,7 @@ namespace leatherman { namespace locale {
      * @return The string generated by translating the format string, then applying the arguments.
      */
     template <typename... TArgs>
-    std::string format(std::string const& fmt, TArgs... args)
+    std::string format(std::string const& fmt, TArgs&&... args)
     {
         auto trans = [&fmt](const std::string& domain) {return translate(fmt, domain);};
         return format_common(std::move(trans), std::forward<TArgs>(args)...);
@@ -190,7 +240,7 @@ namespace leatherman { namespace locale {
      * @return The string generated by translating the format string, then applying the arguments.
      */
     template <typename... TArgs>
-    std::string format_p(std::string const& context, std::string const& fmt, TArgs... args)
+    std::string format_p(std::string const& context, std::string const& fmt, TArgs&&... args)
     {
         auto trans = [&context, &fmt](const std::string& domain) {return translate_p(context, fmt, domain);};
         return format_common(std::move(trans), std::forward<TArgs>(args)...);
@@ -222,7 +272,7 @@ namespace leatherman { namespace locale {
      * @return The string generated by translating the format string, then applying the arguments.
      */
     template <typename... TArgs>
-    std::string format_n(std::string const& single, std::string const& plural, int n, TArgs... args)
+    std::string format_n(std::string const& single, std::string const& plural, int n, TArgs&&... args)
     {
         auto trans = [&single, &plural, n](const std::string& domain) {return translate_n(single, plural, n, domain);};
         return format_common(std::move(trans), std::forward<TArgs>(args)...);
@@ -256,7 +306,7 @@ namespace leatherman { namespace locale {
      * @return The string generated by translating the format string, then applying the arguments.
      */
     template <typename... TArgs>
-    std::string format_np(std::string const& context, std::string const& single, std::string const& plural, int n, TArgs... args)
+    std::string format_np(std::string const& context, std::string const& single, std::string const& plural, int n, TArgs&&... args)
     {
         auto trans = [&context, &single, &plural, n](const std::string& domain) {return translate_np(context, single, plural, n, domain);};
         return format_common(std::move(trans), std::forward<TArgs>(args)...);
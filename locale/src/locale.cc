@@ -1,6 +1,9 @@
 #include <leatherman/locale/locale.hpp>
 #include <leatherman/util/environment.hpp>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 // boost includes are not always warning-clean. Disable warnings that
 // cause problems before including the headers, then re-enable the warnings.
@@ -8,18 +11,149 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #pragma GCC diagnostic ignored "-Wstrict-aliasing"
 #include <boost/locale.hpp>
+#include <boost/locale/gnu_gettext.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #pragma GCC diagnostic pop
 
+namespace fs = boost::filesystem;
+namespace ipc = boost::interprocess;
+
 namespace leatherman { namespace locale {
 
     using namespace std;
-    static map<string, std::locale> g_locales;
+
+    // Generated locales, keyed by domain. Generation runs catalog
+    // discovery and file I/O, so only the first request for a domain
+    // pays it; readers take an atomic snapshot of the map and writers
+    // publish an updated copy, making repeated lookups from logging
+    // and formatting paths lock-free.
+    static shared_ptr<map<string, std::locale>> g_locales { make_shared<map<string, std::locale>>() };
+    static mutex g_locales_mutex;
+
+    // Memoized catalog lookups. The _() alias wraps nearly every
+    // user-visible string - including exception messages on hot error
+    // paths - so repeated translations of the same literal should cost
+    // one hash probe, not a catalog lookup. Readers take an atomic
+    // snapshot of the table; a new literal copies the table, adds the
+    // entry, and publishes the copy. Message literals are finite, so
+    // the table converges and reads become contention-free.
+    static shared_ptr<unordered_map<string, string>> g_translations { make_shared<unordered_map<string, string>>() };
+    static mutex g_translations_mutex;
+
+    static string translation_key(string const& domain, string const& context, string const& msg)
+    {
+        string key;
+        key.reserve(domain.size() + context.size() + msg.size() + 2);
+        key += domain;
+        key += '\x1f';
+        key += context;
+        key += '\x1f';
+        key += msg;
+        return key;
+    }
+
+    static bool find_translation(string const& key, string& result)
+    {
+        auto snapshot = atomic_load(&g_translations);
+        auto it = snapshot->find(key);
+        if (it == snapshot->end()) {
+            return false;
+        }
+        result = it->second;
+        return true;
+    }
+
+    static void cache_translation(string key, string const& translated)
+    {
+        lock_guard<mutex> lock(g_translations_mutex);
+        auto updated = make_shared<unordered_map<string, string>>(*atomic_load(&g_translations));
+        updated->emplace(move(key), translated);
+        atomic_store(&g_translations, move(updated));
+    }
+
+    static void purge_translations(string const& domain)
+    {
+        auto prefix = domain + '\x1f';
+        lock_guard<mutex> lock(g_translations_mutex);
+        auto updated = make_shared<unordered_map<string, string>>();
+        for (auto const& entry : *atomic_load(&g_translations)) {
+            if (entry.first.compare(0, prefix.size(), prefix) != 0) {
+                updated->insert(entry);
+            }
+        }
+        atomic_store(&g_translations, move(updated));
+    }
+
+    // Catalogs compiled into the binary, registered before first use.
+    // Keyed by domain, then by language; values reference linked byte
+    // arrays, so no copies are made. Registration and lookup both happen
+    // on the cold locale-generation path, so a plain mutex suffices.
+    static map<string, map<string, pair<char const*, size_t>>> g_embedded;
+    static mutex g_embedded_mutex;
+
+    void register_embedded_catalog(string const& language, char const* data, size_t size, string const& domain)
+    {
+        lock_guard<mutex> lock(g_embedded_mutex);
+        g_embedded[domain][language] = make_pair(data, size);
+    }
+
+    // Builds a locale whose message catalogs come from the registered
+    // embedded bytes rather than the filesystem. Returns false if no
+    // catalog is registered for the base locale's language, in which
+    // case the caller falls back to file-based generation.
+    static bool embedded_locale(std::locale const& base, string const& domain, std::locale& result)
+    {
+        namespace gnu = boost::locale::gnu_gettext;
+
+        auto const& properties = std::use_facet<boost::locale::info>(base);
+        map<string, pair<char const*, size_t>> catalogs;
+        {
+            lock_guard<mutex> lock(g_embedded_mutex);
+            auto it = g_embedded.find(domain);
+            if (it == g_embedded.end() || it->second.find(properties.language()) == it->second.end()) {
+                return false;
+            }
+            catalogs = it->second;
+        }
+
+        gnu::messages_info info;
+        info.language = properties.language();
+        info.country = properties.country();
+        info.variant = properties.variant();
+        info.encoding = properties.encoding();
+        info.paths.push_back("");
+        info.domains.push_back(gnu::messages_info::domain(domain));
+
+        // boost::locale asks the callback for candidate paths of the form
+        // <path>/<language>/LC_MESSAGES/<domain>.mo; serve the registered
+        // bytes when the language component matches a catalog.
+        info.callback = [catalogs](string const& file_name, string const&) -> vector<char> {
+            auto category = file_name.find("/LC_MESSAGES/");
+            auto start = file_name.rfind('/', category == string::npos ? string::npos : category - 1);
+            if (category == string::npos || start == string::npos) {
+                return {};
+            }
+            auto it = catalogs.find(file_name.substr(start + 1, category - start - 1));
+            if (it == catalogs.end()) {
+                return {};
+            }
+            return vector<char>(it->second.first, it->second.first + it->second.second);
+        };
+
+        result = std::locale(base, gnu::create_messages_facet<char>(info));
+        return true;
+    }
 
     const std::locale get_locale(string const& id, string const& domain, vector<string> const& paths)
     {
-        auto it = g_locales.find(domain);
-        if (it != g_locales.end()) {
-            return it->second;
+        {
+            auto snapshot = atomic_load(&g_locales);
+            auto it = snapshot->find(domain);
+            if (it != snapshot->end()) {
+                return it->second;
+            }
         }
 
         // The system default locale is set with id == "", except on Windows boost::locale's
@@ -27,70 +161,235 @@ namespace leatherman { namespace locale {
         // the default on all platforms.
         boost::locale::generator gen;
 
+        std::locale generated;
+        bool have_locale = false;
         if (!domain.empty()) {
-            // Setup so we can find installed locales. Expects a default path unless
-            // an environment variable is specified.
+            // Catalogs compiled into the binary take priority: generate the
+            // bare locale and attach the registered messages, leaving the
+            // filesystem untouched.
+            try {
+                have_locale = embedded_locale(gen(id), domain, generated);
+            } catch (boost::locale::conv::conversion_error&) {
+            }
+        }
+
+        if (!have_locale) {
+            if (!domain.empty()) {
+                // Setup so we can find installed locales. Expects a default path unless
+                // an environment variable is specified.
 #ifdef LEATHERMAN_LOCALE_VAR
-            string locale_path;
-            if (util::environment::get(LEATHERMAN_LOCALE_VAR, locale_path)) {
-                gen.add_messages_path(locale_path+'/'+LEATHERMAN_LOCALE_INSTALL);
+                string locale_path;
+                if (util::environment::get(LEATHERMAN_LOCALE_VAR, locale_path)) {
+                    gen.add_messages_path(locale_path+'/'+LEATHERMAN_LOCALE_INSTALL);
+                }
+#else
+                gen.add_messages_path(LEATHERMAN_LOCALE_INSTALL);
+#endif
+                for (auto& path : paths) {
+                    gen.add_messages_path(path);
+                }
+                gen.add_messages_domain(domain);
             }
+
+            try {
+                generated = gen(id);
+            } catch (boost::locale::conv::conversion_error&) {
+                generated = std::locale();
+            }
+        }
+
+        // Publish the generated locale; if another thread won the race
+        // for this domain, keep its locale so all callers agree.
+        lock_guard<mutex> lock(g_locales_mutex);
+        auto current = atomic_load(&g_locales);
+        auto it = current->find(domain);
+        if (it != current->end()) {
+            return it->second;
+        }
+        auto updated = make_shared<map<string, std::locale>>(*current);
+        updated->insert(make_pair(domain, generated));
+        atomic_store(&g_locales, move(updated));
+        return generated;
+    }
+
+    // Parsed boost::format objects, keyed by the format string they
+    // were parsed from. Feeding arguments mutates a format, so callers
+    // get a copy of the cached parse; copying is much cheaper than the
+    // regex rewrite and parse it replaces.
+    static shared_ptr<unordered_map<string, boost::format>> g_formats { make_shared<unordered_map<string, boost::format>>() };
+    static mutex g_formats_mutex;
+
+    boost::format compiled_format(string const& fmt)
+    {
+        {
+            auto snapshot = atomic_load(&g_formats);
+            auto it = snapshot->find(fmt);
+            if (it != snapshot->end()) {
+                return it->second;
+            }
+        }
+
+        static const boost::regex match {"\\{(\\d+)\\}"};
+        static const string repl {"%\\1%"};
+        boost::format form {boost::regex_replace(fmt, match, repl)};
+
+        lock_guard<mutex> lock(g_formats_mutex);
+        auto updated = make_shared<unordered_map<string, boost::format>>(*atomic_load(&g_formats));
+        updated->emplace(fmt, form);
+        atomic_store(&g_formats, std::move(updated));
+        return form;
+    }
+
+    // The search roots the generator in get_locale is configured with,
+    // in the same order: the install path (or the environment override),
+    // then any caller-supplied paths.
+    static vector<string> catalog_roots(vector<string> const& paths)
+    {
+        vector<string> roots;
+#ifdef LEATHERMAN_LOCALE_VAR
+        string locale_path;
+        if (util::environment::get(LEATHERMAN_LOCALE_VAR, locale_path)) {
+            roots.push_back(locale_path+'/'+LEATHERMAN_LOCALE_INSTALL);
+        }
 #else
-            gen.add_messages_path(LEATHERMAN_LOCALE_INSTALL);
+        roots.push_back(LEATHERMAN_LOCALE_INSTALL);
 #endif
-            for (auto& path : paths) {
-                gen.add_messages_path(path);
+        for (auto& path : paths) {
+            if (!path.empty()) {
+                roots.push_back(path);
             }
-            gen.add_messages_domain(domain);
         }
+        return roots;
+    }
 
-        // Ensure creating and adding a new locale is thread-safe.
-        try {
-            return g_locales.insert(make_pair(domain, gen(id))).first->second;
-        } catch(boost::locale::conv::conversion_error &e) {
-            return g_locales.insert(make_pair(domain, std::locale())).first->second;
+    size_t preload_catalogs(string const& domain, vector<string> const& paths)
+    {
+        size_t mapped = 0;
+        if (!domain.empty()) {
+            auto catalog = domain + ".mo";
+            for (auto const& root : catalog_roots(paths)) {
+                boost::system::error_code ec;
+                fs::recursive_directory_iterator it {root, ec}, end;
+                for (; !ec && it != end; it.increment(ec)) {
+                    if (it->path().filename() != catalog) {
+                        continue;
+                    }
+                    try {
+                        // Mapping the catalog and advising the kernel it
+                        // will be needed starts read-ahead without copying
+                        // the file through a userspace buffer; the parse
+                        // below then hits warm pages.
+                        ipc::file_mapping mapping {it->path().string().c_str(), ipc::read_only};
+                        ipc::mapped_region region {mapping, ipc::read_only};
+                        region.advise(ipc::mapped_region::advice_willneed);
+                        ++mapped;
+                    } catch (ipc::interprocess_exception&) {
+                        // Unreadable or empty catalog; the generator will
+                        // cope when it gets there.
+                    }
+                }
+            }
         }
+
+        // Generate and publish the locale while the pages are resident.
+        get_locale("", domain, paths);
+        return mapped;
     }
 
     void clear_domain(string const& domain)
     {
-        g_locales.erase(domain);
+        {
+            lock_guard<mutex> lock(g_locales_mutex);
+            auto updated = make_shared<map<string, std::locale>>(*atomic_load(&g_locales));
+            updated->erase(domain);
+            atomic_store(&g_locales, move(updated));
+        }
+        purge_translations(domain);
     }
 
     string translate(string const& msg, string const& domain)
     {
+        auto key = translation_key(domain, "", msg);
+        string result;
+        if (find_translation(key, result)) {
+            return result;
+        }
         try {
-            return boost::locale::translate(msg).str(get_locale("", domain));
+            result = boost::locale::translate(msg).str(get_locale("", domain));
         } catch (exception const&) {
-            return msg;
+            result = msg;
         }
+        cache_translation(move(key), result);
+        return result;
     }
 
     string translate_p(string const& context, string const& msg, string const& domain)
     {
+        auto key = translation_key(domain, context, msg);
+        string result;
+        if (find_translation(key, result)) {
+            return result;
+        }
         try {
-            return boost::locale::translate(context, msg).str(get_locale("", domain));
+            result = boost::locale::translate(context, msg).str(get_locale("", domain));
         } catch (exception const&) {
-            return msg;
+            result = msg;
         }
+        cache_translation(move(key), result);
+        return result;
+    }
+
+    // The translation a catalog picks depends only on the plural class
+    // its Plural-Forms expression assigns to n. Those expressions compare
+    // n against small constants and the n%10/n%100 remainders, so every
+    // n from 100 up that shares a remainder mod 100 shares a class.
+    // Folding n accordingly keeps the memoization table bounded while
+    // loop counters keep hitting the same entries.
+    static int plural_class_proxy(int n)
+    {
+        return (n > -100 && n < 100) ? n : 100 + n % 100;
+    }
+
+    static string plural_key(string const& domain, string const& context, string const& single, string const& plural, int n)
+    {
+        auto key = translation_key(domain, context, single);
+        key += '\x1f';
+        key += plural;
+        key += '\x1f';
+        key += to_string(plural_class_proxy(n));
+        return key;
     }
 
     string translate_n(string const& single, string const& plural, int n, string const& domain)
     {
+        auto key = plural_key(domain, "", single, plural, n);
+        string result;
+        if (find_translation(key, result)) {
+            return result;
+        }
         try {
-            return boost::locale::translate(single, plural, n).str(get_locale("", domain));
+            result = boost::locale::translate(single, plural, n).str(get_locale("", domain));
         } catch (exception const&) {
-            return n == 1 ? single : plural;
+            result = n == 1 ? single : plural;
         }
+        cache_translation(move(key), result);
+        return result;
     }
 
     string translate_np(string const& context, string const& single, string const& plural, int n, string const& domain)
     {
+        auto key = plural_key(domain, context, single, plural, n);
+        string result;
+        if (find_translation(key, result)) {
+            return result;
+        }
         try {
-            return boost::locale::translate(context, single, plural, n).str(get_locale("", domain));
+            result = boost::locale::translate(context, single, plural, n).str(get_locale("", domain));
         } catch (exception const&) {
-            return n == 1 ? single : plural;
+            result = n == 1 ? single : plural;
         }
+        cache_translation(move(key), result);
+        return result;
     }
 
 }}  // namespace leatherman::locale
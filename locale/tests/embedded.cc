@@ -0,0 +1,95 @@
+#ifndef LEATHERMAN_I18N
+#define LEATHERMAN_I18N
+#endif
+
+#undef PROJECT_NAME
+#define PROJECT_NAME "leatherman_embedded"
+
+#include <catch.hpp>
+#include <leatherman/locale/locale.hpp>
+
+using namespace std;
+using namespace leatherman::locale;
+
+// Builds a minimal compiled (.mo format) catalog in memory, translating
+// a single message. Tests can use it to exercise embedded catalogs
+// without requiring gettext tooling at build time.
+static vector<char> const& test_catalog()
+{
+    static vector<char> catalog;
+    if (!catalog.empty()) {
+        return catalog;
+    }
+
+    auto append_u32 = [](vector<char>& data, uint32_t value) {
+        data.push_back(static_cast<char>(value & 0xff));
+        data.push_back(static_cast<char>((value >> 8) & 0xff));
+        data.push_back(static_cast<char>((value >> 16) & 0xff));
+        data.push_back(static_cast<char>((value >> 24) & 0xff));
+    };
+
+    string originals[] = { "", "requesting {1,number} embedded." };
+    string translations[] = { "Content-Type: text/plain; charset=UTF-8\n", "demande {1,number} integre." };
+
+    // Header: magic, revision, string count, original and translation
+    // table offsets, and an empty hash table.
+    append_u32(catalog, 0x950412de);
+    append_u32(catalog, 0);
+    append_u32(catalog, 2);
+    append_u32(catalog, 28);
+    append_u32(catalog, 44);
+    append_u32(catalog, 0);
+    append_u32(catalog, 0);
+
+    // Both tables hold (length, offset) pairs; strings follow the tables
+    // and are NUL terminated.
+    uint32_t offset = 60;
+    for (auto const& entry : originals) {
+        append_u32(catalog, entry.size());
+        append_u32(catalog, offset);
+        offset += entry.size() + 1;
+    }
+    for (auto const& entry : translations) {
+        append_u32(catalog, entry.size());
+        append_u32(catalog, offset);
+        offset += entry.size() + 1;
+    }
+    for (auto const& entry : originals) {
+        catalog.insert(catalog.end(), entry.begin(), entry.end());
+        catalog.push_back('\0');
+    }
+    for (auto const& entry : translations) {
+        catalog.insert(catalog.end(), entry.begin(), entry.end());
+        catalog.push_back('\0');
+    }
+    return catalog;
+}
+
+SCENARIO("an embedded catalog", "[locale]") {
+    auto const& catalog = test_catalog();
+    register_embedded_catalog("fr", catalog.data(), catalog.size());
+
+    GIVEN("a locale for the registered language") {
+        get_locale("fr.UTF-8");
+
+        THEN("messages should be translated from the embedded bytes") {
+            REQUIRE(translate("requesting {1,number} embedded.") == "demande {1,number} integre.");
+        }
+
+        THEN("unknown messages should pass through") {
+            REQUIRE(translate("an untranslated message.") == "an untranslated message.");
+        }
+    }
+
+    clear_domain();
+
+    GIVEN("a locale for an unregistered language") {
+        get_locale("");
+
+        THEN("messages should not be translated") {
+            REQUIRE(translate("requesting {1,number} embedded.") == "requesting {1,number} embedded.");
+        }
+    }
+
+    clear_domain();
+}
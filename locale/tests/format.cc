@@ -43,6 +43,11 @@ SCENARIO("a format string", "[locale]") {
         THEN("2 items with context should be plural") {
             REQUIRE(translate_np("foo", literal, plural, 2) == plural);
         }
+
+        THEN("large counts should be served from the plural-class cache") {
+            REQUIRE(translate_n(literal, plural, 1001) == plural);
+            REQUIRE(translate_n(literal, plural, 2101) == plural);
+        }
     }
 
     GIVEN("leatherman::locale::format") {
@@ -20,6 +20,11 @@ SCENARIO("a default locale", "[locale]") {
         THEN("messages with context should not be translated") {
             REQUIRE(translate_p("foo", "requesting {1,number}.") == "requesting {1,number}.");
         }
+
+        THEN("repeated translations are served from the memoization table") {
+            REQUIRE(translate("requesting {1,number}.") == "requesting {1,number}.");
+            REQUIRE(translate("requesting {1,number}.") == "requesting {1,number}.");
+        }
     }
 
     GIVEN("plural leatherman::locale::translate") {
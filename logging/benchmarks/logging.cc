@@ -0,0 +1,105 @@
+/**
+ * @file
+ * Measures the throughput and per-call latency of the LOG_* path.
+ * Run by hand when measuring a change to the logging hot path; each
+ * configuration is reported as operations/sec and p99 latency across
+ * several thread counts through the shared benchmark reporter.
+ */
+#include <leatherman/logging/logging.hpp>
+#include <benchmark.hpp>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::logging;
+
+namespace {
+
+    // Discards everything written to it, so the benchmarks measure the
+    // logging path rather than sink I/O.
+    struct null_buffer : streambuf
+    {
+        streamsize xsputn(char_type const*, streamsize count) override { return count; }
+        int_type overflow(int_type c) override { return c; }
+    };
+
+    const size_t iterations = 100000;
+
+    leatherman::benchmark::timing run(size_t num_threads)
+    {
+        vector<vector<uint64_t>> latencies(num_threads);
+        vector<thread> threads;
+        auto start = chrono::steady_clock::now();
+
+        for (size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([t, &latencies]() {
+                auto& samples = latencies[t];
+                samples.reserve(iterations);
+                for (size_t i = 0; i < iterations; ++i) {
+                    auto before = chrono::steady_clock::now();
+                    LOG_DEBUG("benchmark message {1}", i);
+                    auto after = chrono::steady_clock::now();
+                    samples.push_back(chrono::duration_cast<chrono::nanoseconds>(after - before).count());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        vector<uint64_t> all;
+        all.reserve(num_threads * iterations);
+        for (auto const& samples : latencies) {
+            all.insert(all.end(), samples.begin(), samples.end());
+        }
+        return leatherman::benchmark::summarize(all, elapsed);
+    }
+
+    void report(string const& name, size_t num_threads)
+    {
+        leatherman::benchmark::report(name, num_threads, run(num_threads));
+    }
+
+}  // namespace
+
+LEATHERMAN_BENCHMARK(logging)
+{
+    null_buffer buffer;
+    ostream null_stream(&buffer);
+    const vector<size_t> thread_counts = {1, 2, 4};
+
+    for (auto num_threads : thread_counts) {
+        setup_logging(null_stream);
+        set_level(log_level::warning);
+        report("disabled level", num_threads);
+    }
+
+    for (auto num_threads : thread_counts) {
+        setup_logging(null_stream);
+        set_level(log_level::debug);
+        set_colorization(false);
+        report("enabled", num_threads);
+    }
+
+    for (auto num_threads : thread_counts) {
+        setup_logging(null_stream);
+        set_level(log_level::debug);
+        set_colorization(true);
+        report("colorized", num_threads);
+    }
+
+    for (auto num_threads : thread_counts) {
+        setup_logging(null_stream);
+        set_level(log_level::debug);
+        set_colorization(false);
+        on_message([](log_level, string const&) { return false; });
+        report("on_message", num_threads);
+        on_message(nullptr);
+    }
+}
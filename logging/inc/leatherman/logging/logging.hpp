@@ -14,6 +14,9 @@
 #include <leatherman/locale/locale.hpp>
 #include <boost/log/core.hpp>
 #include <boost/log/expressions.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <functional>
 
@@ -26,6 +29,30 @@
 #define LOG_NAMESPACE LEATHERMAN_LOGGING_NAMESPACE
 #endif
 
+/**
+ * Defines the compile-time log level floor. Logging macros below this
+ * severity compile to nothing, so stripped levels cost zero at runtime.
+ * Levels are numbered as in leatherman::logging::log_level: 1 = trace,
+ * 2 = debug, 3 = info, 4 = warning, 5 = error, 6 = fatal. Defaults to
+ * trace, i.e. nothing is stripped.
+ */
+#ifndef LEATHERMAN_LOG_MIN_LEVEL
+#define LEATHERMAN_LOG_MIN_LEVEL 1
+#endif
+
+
+/**
+ * Checks a log level against the namespace level for LOG_NAMESPACE.
+ * The handle lookup runs once per call site and is cached in a
+ * function-local static; afterwards the check is a single relaxed
+ * atomic load.
+ * @param level The logging level to check.
+ */
+#define LOG_LEVEL_ENABLED(level) \
+    ([](leatherman::logging::log_level lth_lvl) { \
+        static auto& lth_ns_level = leatherman::logging::namespace_level(LOG_NAMESPACE); \
+        return leatherman::logging::is_enabled(lth_ns_level, lth_lvl); \
+    }(level))
 
 /**
  * Logs a message.
@@ -36,12 +63,12 @@
  */
 #ifdef LEATHERMAN_LOGGING_LINE_NUMBERS
 #define LOG_MESSAGE(level, line_num, format, ...) \
-    if (leatherman::logging::is_enabled(level)) { \
+    if (LOG_LEVEL_ENABLED(level)) { \
         leatherman::logging::log(LOG_NAMESPACE, level, line_num, format, ##__VA_ARGS__); \
     }
 #else
 #define LOG_MESSAGE(level, line_num, format, ...) \
-    if (leatherman::logging::is_enabled(level)) { \
+    if (LOG_LEVEL_ENABLED(level)) { \
         leatherman::logging::log(LOG_NAMESPACE, level, 0, format, ##__VA_ARGS__); \
     }
 #endif
@@ -50,31 +77,51 @@
  * @param format The format message.
  * @param ... The format message parameters.
  */
+#if LEATHERMAN_LOG_MIN_LEVEL <= 1
 #define LOG_TRACE(format, ...) LOG_MESSAGE(leatherman::logging::log_level::trace, __LINE__, format, ##__VA_ARGS__)
+#else
+#define LOG_TRACE(format, ...)
+#endif
 /**
  * Logs a debug message.
  * @param format The format message.
  * @param ... The format message parameters.
  */
+#if LEATHERMAN_LOG_MIN_LEVEL <= 2
 #define LOG_DEBUG(format, ...) LOG_MESSAGE(leatherman::logging::log_level::debug, __LINE__, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...)
+#endif
 /**
  * Logs an info message.
  * @param format The format message.
  * @param ... The format message parameters.
  */
+#if LEATHERMAN_LOG_MIN_LEVEL <= 3
 #define LOG_INFO(format, ...) LOG_MESSAGE(leatherman::logging::log_level::info, __LINE__, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...)
+#endif
 /**
  * Logs a warning message.
  * @param format The format message.
  * @param ... The format message parameters.
  */
+#if LEATHERMAN_LOG_MIN_LEVEL <= 4
 #define LOG_WARNING(format, ...) LOG_MESSAGE(leatherman::logging::log_level::warning, __LINE__, format, ##__VA_ARGS__)
+#else
+#define LOG_WARNING(format, ...)
+#endif
 /**
  * Logs an error message.
  * @param format The format message.
  * @param ... The format message parameters.
  */
+#if LEATHERMAN_LOG_MIN_LEVEL <= 5
 #define LOG_ERROR(format, ...) LOG_MESSAGE(leatherman::logging::log_level::error, __LINE__, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...)
+#endif
 /**
  * Logs a fatal message.
  * @param format The format message.
@@ -85,32 +132,52 @@
  * Determines if the trace logging level is enabled.
  * @returns Returns true if trace logging is enabled or false if it is not enabled.
  */
-#define LOG_IS_TRACE_ENABLED() leatherman::logging::is_enabled(leatherman::logging::log_level::trace)
+#if LEATHERMAN_LOG_MIN_LEVEL <= 1
+#define LOG_IS_TRACE_ENABLED() LOG_LEVEL_ENABLED(leatherman::logging::log_level::trace)
+#else
+#define LOG_IS_TRACE_ENABLED() false
+#endif
 /**
  * Determines if the debug logging level is enabled.
  * @returns Returns true if debug logging is enabled or false if it is not enabled.
  */
-#define LOG_IS_DEBUG_ENABLED() leatherman::logging::is_enabled(leatherman::logging::log_level::debug)
+#if LEATHERMAN_LOG_MIN_LEVEL <= 2
+#define LOG_IS_DEBUG_ENABLED() LOG_LEVEL_ENABLED(leatherman::logging::log_level::debug)
+#else
+#define LOG_IS_DEBUG_ENABLED() false
+#endif
 /**
  * Determines if the info logging level is enabled.
  * @returns Returns true if info logging is enabled or false if it is not enabled.
  */
-#define LOG_IS_INFO_ENABLED() leatherman::logging::is_enabled(leatherman::logging::log_level::info)
+#if LEATHERMAN_LOG_MIN_LEVEL <= 3
+#define LOG_IS_INFO_ENABLED() LOG_LEVEL_ENABLED(leatherman::logging::log_level::info)
+#else
+#define LOG_IS_INFO_ENABLED() false
+#endif
 /**
  * Determines if the warning logging level is enabled.
  * @returns Returns true if warning logging is enabled or false if it is not enabled.
  */
-#define LOG_IS_WARNING_ENABLED() leatherman::logging::is_enabled(leatherman::logging::log_level::warning)
+#if LEATHERMAN_LOG_MIN_LEVEL <= 4
+#define LOG_IS_WARNING_ENABLED() LOG_LEVEL_ENABLED(leatherman::logging::log_level::warning)
+#else
+#define LOG_IS_WARNING_ENABLED() false
+#endif
 /**
  * Determines if the error logging level is enabled.
  * @returns Returns true if error logging is enabled or false if it is not enabled.
  */
-#define LOG_IS_ERROR_ENABLED() leatherman::logging::is_enabled(leatherman::logging::log_level::error)
+#if LEATHERMAN_LOG_MIN_LEVEL <= 5
+#define LOG_IS_ERROR_ENABLED() LOG_LEVEL_ENABLED(leatherman::logging::log_level::error)
+#else
+#define LOG_IS_ERROR_ENABLED() false
+#endif
 /**
  * Determines if the fatal logging level is enabled.
  * @returns Returns true if fatal logging is enabled or false if it is not enabled.
  */
-#define LOG_IS_FATAL_ENABLED() leatherman::logging::is_enabled(leatherman::logging::log_level::fatal)
+#define LOG_IS_FATAL_ENABLED() LOG_LEVEL_ENABLED(leatherman::logging::log_level::fatal)
 
 namespace leatherman { namespace logging {
 
@@ -192,6 +259,18 @@ namespace leatherman { namespace logging {
      */
     void setup_eventlog_logging(std::string application);
 
+    /**
+     * Enables or disables batched Event Log submission.
+     * When enabled, records logged through the event log backend are
+     * enqueued and submitted by a background thread, with consecutive
+     * records of the same severity coalesced into a single ReportEvent
+     * call, so application threads pay an enqueue instead of an Event
+     * Log RPC per record. Disabling drains the queue and joins the
+     * thread. Only available on Windows.
+     * @param enabled True to batch event log writes or false to write them inline.
+     */
+    void set_eventlog_batching(bool enabled);
+
     /**
      * Configures application to log to syslog
      * The logging level is set to warning by default.
@@ -200,6 +279,114 @@ namespace leatherman { namespace logging {
      */
     void setup_syslog_logging(const char* application, const std::string& facility);
 
+    /**
+     * Enables or disables batched syslog transmission.
+     * When enabled, records logged through the syslog backend are
+     * enqueued and transmitted in batches by a background thread, so a
+     * backed-up syslog socket stalls that thread instead of the
+     * application threads doing the logging. Disabling drains the queue
+     * and joins the thread. Only available on platforms with syslog
+     * support.
+     * @param enabled True to batch syslog writes or false to write them inline.
+     */
+    void set_syslog_batching(bool enabled);
+
+    /**
+     * Represents what happens when the asynchronous logging queue is full.
+     */
+    enum class async_overflow_policy
+    {
+        /**
+         * The logging thread blocks until the writer catches up.
+         */
+        block,
+        /**
+         * The record is discarded.
+         */
+        drop
+    };
+
+    /**
+     * Sets up asynchronous logging for the given stream.
+     * Records are pushed onto a bounded queue and written to the destination
+     * by a dedicated thread, so a slow sink no longer stalls logging threads.
+     * The logging level is set to warning by default.
+     * @param dst Destination stream for logging output.
+     * @param policy What to do when the queue is full.
+     * @param locale The locale identifier to use for logging.
+     * @param domain The catalog domain to use for i18n via gettext.
+     * @param use_locale Whether to use locales in logging setup. If locales are disabled this parameter is ignored.
+     */
+    void setup_async_logging(std::ostream &dst, async_overflow_policy policy = async_overflow_policy::block,
+                             std::string locale = "", std::string domain = PROJECT_NAME, bool use_locale = true);
+
+    /**
+     * Flushes any queued records and stops the asynchronous logging thread.
+     * Called automatically when logging is set up again; only needed
+     * explicitly to guarantee the queue is drained, e.g. before process exit.
+     */
+    void shutdown_async_logging();
+
+    /**
+     * Sets up memory-mapped file logging.
+     * The log file is preallocated to segment_size bytes and memory
+     * mapped, so appending a record is a copy into the mapping rather
+     * than a write system call; a background thread periodically asks
+     * the kernel to flush dirty pages. The file rotates to <path>.1,
+     * <path>.2, ... when the segment fills or max_age elapses, keeping
+     * max_segments files in total; on rotation and shutdown the active
+     * segment is truncated to the bytes actually written. The logging
+     * level is set to warning by default.
+     * @param path The path of the log file.
+     * @param segment_size The preallocated size of each segment, in bytes.
+     * @param max_segments The number of segments kept, including the active one.
+     * @param max_age Rotate the active segment after this much time even if it is not full; zero disables time-based rotation.
+     */
+    void setup_file_logging(std::string const& path, std::size_t segment_size = 16*1024*1024, std::size_t max_segments = 4,
+                            std::chrono::seconds max_age = std::chrono::seconds::zero());
+
+    /**
+     * Flushes the memory-mapped log file, truncates it to the bytes
+     * actually written, and closes it. Called automatically when logging
+     * is set up again; only needed explicitly to guarantee the file is
+     * finalized, e.g. before process exit.
+     */
+    void shutdown_file_logging();
+
+    /**
+     * Sets up structured binary logging for the given stream.
+     * Each record is written as a compact binary frame (timestamp, level,
+     * namespace, line number and message) instead of formatted text, so no
+     * textual rendering happens on the logging path; decode_structured_log
+     * turns the frames back into the standard text format offline.
+     * Records are host-endian and meant to be decoded on the machine that
+     * produced them. The logging level is set to warning by default.
+     * @param dst Destination stream for the binary records.
+     */
+    void setup_structured_logging(std::ostream &dst);
+
+    /**
+     * Decodes records written by setup_structured_logging into the
+     * standard textual log format.
+     * @param in The stream of binary records.
+     * @param out The stream to write the decoded text to.
+     * @return Returns the number of records decoded.
+     */
+    std::size_t decode_structured_log(std::istream &in, std::ostream &out);
+
+    /**
+     * Sets up direct logging for the given stream.
+     * Records bypass the Boost.Log pipeline entirely: the record prefix
+     * is rendered into a stack buffer and written straight to the
+     * destination along with the message, trading Boost.Log's attribute
+     * sets and record machinery for a much cheaper path on
+     * throughput-critical services. The eventlog and syslog backends are
+     * unaffected, and output is never colorized. The logging level is
+     * set to warning by default.
+     * @param dst Destination stream for logging output.
+     */
+    void setup_direct_logging(std::ostream &dst);
+
     /**
      * Sets the current log level.
      * @param level The new current log level to set.
@@ -227,16 +414,126 @@ namespace leatherman { namespace logging {
     /**
      * Provides a callback for when a message is logged.
      * If the callback returns false, the message will not be logged.
+     * Replaces any callback previously set through this function;
+     * handlers registered with add_message_handler are unaffected.
      * @param callback The callback to call when a message is about to be logged.
      */
     void on_message(std::function<bool(log_level, std::string const&)> callback);
 
+    /**
+     * Registers an additional callback for when a message is logged.
+     * Any number of handlers can be registered; every handler sees every
+     * message and the message is not logged if any handler returns
+     * false. Handlers are stored in an immutable snapshot list read
+     * without locks on the logging path, so registration never contends
+     * with logging threads.
+     * @param callback The callback to call when a message is about to be logged.
+     * @return Returns an id that can be passed to remove_message_handler.
+     */
+    std::uint64_t add_message_handler(std::function<bool(log_level, std::string const&)> callback);
+
+    /**
+     * Removes a handler registered with add_message_handler.
+     * @param id The id returned by add_message_handler.
+     */
+    void remove_message_handler(std::uint64_t id);
+
+    /**
+     * The current log level, stored atomically so the hot-path check in
+     * is_enabled is an inline relaxed load rather than a call into
+     * another translation unit. Use set_level/get_level instead of
+     * touching this directly.
+     */
+    extern std::atomic<log_level> g_log_level;
+
     /**
      * Determines if the given log level is enabled for the given logger.
      * @param level The logging level to check.
      * @return Returns true if the logging level is enabled or false if it is not.
      */
-    bool is_enabled(log_level level);
+    inline bool is_enabled(log_level level)
+    {
+        auto current = g_log_level.load(std::memory_order_relaxed);
+        return current != log_level::none && static_cast<int>(level) >= static_cast<int>(current);
+    }
+
+    /**
+     * Gets the level handle for a logging namespace.
+     * The handle holds the namespace's level override as an integer, or a
+     * negative value when the namespace inherits the global level. The
+     * logging macros resolve the handle once per call site and cache it
+     * in a function-local static, so repeated checks never touch the
+     * registry. The returned reference remains valid for the life of the
+     * process.
+     * @param name_space The logging namespace.
+     * @return Returns a reference to the namespace's level handle.
+     */
+    std::atomic<int>& namespace_level(std::string const& name_space);
+
+    /**
+     * Sets the log level for a single logging namespace.
+     * Messages logged under that namespace use this level instead of the
+     * global one, so one subsystem can log at debug without enabling
+     * debug everywhere. A global level of none still disables logging
+     * entirely.
+     * @param name_space The logging namespace.
+     * @param level The log level to use for the namespace.
+     */
+    void set_namespace_level(std::string const& name_space, log_level level);
+
+    /**
+     * Clears all namespace level overrides.
+     * Every namespace reverts to the global level.
+     */
+    void clear_namespace_levels();
+
+    /**
+     * Enables rate limiting of log messages per call site.
+     * Each call site (logging namespace plus line number) gets a token
+     * bucket: up to burst messages pass back to back and tokens refill
+     * at per_second. Messages that find the bucket empty are dropped and
+     * counted, and a "suppressed N duplicate messages" summary is logged
+     * the next time the call site is allowed through, so an event storm
+     * cannot saturate the sink. Rate limiting is off by default; pass
+     * zero for either parameter to turn it off again.
+     * @param per_second The sustained number of messages allowed per second per call site.
+     * @param burst The number of messages a call site may emit back to back.
+     */
+    void set_rate_limit(double per_second, std::size_t burst);
+
+    /**
+     * Determines if the given log level is enabled for a namespace handle.
+     * @param ns_level The handle returned by namespace_level.
+     * @param level The logging level to check.
+     * @return Returns true if the logging level is enabled or false if it is not.
+     */
+    inline bool is_enabled(std::atomic<int> const& ns_level, log_level level)
+    {
+        auto ns = ns_level.load(std::memory_order_relaxed);
+        if (ns < 0) {
+            return is_enabled(level);
+        }
+        auto current = static_cast<log_level>(ns);
+        return current != log_level::none && static_cast<int>(level) >= static_cast<int>(current);
+    }
+
+    /**
+     * Gets the number of messages submitted at the given level.
+     * Counters are kept per thread and folded when queried, so counting
+     * never bounces a shared cache line between logging threads. A
+     * message is counted when it reaches the library, whether or not
+     * the current level let it through to a sink; messages the logging
+     * macros short-circuit at the call site are not counted.
+     * @param level The logging level to count.
+     * @return Returns the number of messages submitted at that level.
+     */
+    std::uint64_t message_count(log_level level);
+
+    /**
+     * Resets all per-level message counters to zero and clears the
+     * error-logged flag.
+     */
+    void reset_message_counts();
 
     /**
      * Determine if an error has been logged
@@ -306,6 +603,19 @@ namespace leatherman { namespace logging {
      */
     bool color_supported(std::ostream &dst);
 
+    /**
+     * Returns the stream log sinks should write to for the given destination.
+     * On Windows, when the destination is an actual console, this is a
+     * batching wrapper that converts buffered output once and issues a
+     * single WriteConsoleW per flush - console I/O is slow enough that
+     * per-record writes visibly stall verbose logging. Everywhere else,
+     * and for redirected or file streams, the destination itself is
+     * returned.
+     * @param dst The destination passed to setup_logging.
+     * @return Returns the stream to write log output to.
+     */
+    std::ostream& console_stream(std::ostream &dst);
+
     // private
     void log_eventlog(log_level level, std::string const& message);
     void log_syslog(log_level level, std::string const& message);
@@ -1,5 +1,13 @@
 #include <leatherman/logging/logging.hpp>
 #include <leatherman/locale/locale.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 // Mark string for translation (alias for leatherman::locale::format)
@@ -15,10 +23,18 @@ using leatherman::locale::_;
 #include <boost/log/sources/logger.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/drop_on_overflow.hpp>
 #include <boost/log/sinks/basic_sink_backend.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 
 #pragma GCC diagnostic pop
 
@@ -28,17 +44,266 @@ namespace src = boost::log::sources;
 namespace attrs = boost::log::attributes;
 namespace keywords = boost::log::keywords;
 namespace sinks = boost::log::sinks;
+namespace fs = boost::filesystem;
+namespace ipc = boost::interprocess;
 
 namespace leatherman { namespace logging {
 
-    static function<bool(log_level, string const&)> g_callback;
-    static log_level g_level = log_level::none;
+    std::atomic<log_level> g_log_level {log_level::none};
     static logging_backend g_backend = logging_backend::file;
+    static const size_t level_count = 7;
+    // Destination of the direct sink; when set, records headed for the
+    // stream backend are formatted and written here without entering the
+    // Boost.Log core.
+    static std::atomic<ostream*> g_direct_dst {nullptr};
     static bool g_colorize = false;
-    static bool g_error_logged = false;
 
     namespace lth_locale = leatherman::locale;
 
+    // Per-thread message counters. Each thread owns one block and bumps
+    // it with relaxed increments on its own cache line, so concurrent
+    // logging never contends on shared counter state; queries fold the
+    // registered blocks. Blocks are kept alive by the registry, so
+    // counts survive the threads that produced them.
+    struct level_counters
+    {
+        level_counters()
+        {
+            for (auto& count : counts) {
+                count.store(0, memory_order_relaxed);
+            }
+        }
+        atomic<uint64_t> counts[level_count];
+    };
+
+    static mutex g_counter_mutex;
+    static vector<shared_ptr<level_counters>> g_counter_blocks;
+
+    // The errors-plus-fatals total as of the last clear_error_logged_flag
+    // call; the flag is derived by comparing against the current total.
+    static atomic<uint64_t> g_error_baseline {0};
+
+    static level_counters& thread_counters()
+    {
+        static thread_local shared_ptr<level_counters> block = []() {
+            auto created = make_shared<level_counters>();
+            lock_guard<mutex> lock(g_counter_mutex);
+            g_counter_blocks.push_back(created);
+            return created;
+        }();
+        return *block;
+    }
+
+    uint64_t message_count(log_level level)
+    {
+        auto index = static_cast<size_t>(level);
+        if (index >= level_count) {
+            return 0;
+        }
+        uint64_t total = 0;
+        lock_guard<mutex> lock(g_counter_mutex);
+        for (auto const& block : g_counter_blocks) {
+            total += block->counts[index].load(memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void reset_message_counts()
+    {
+        lock_guard<mutex> lock(g_counter_mutex);
+        for (auto const& block : g_counter_blocks) {
+            for (auto& count : block->counts) {
+                count.store(0, memory_order_relaxed);
+            }
+        }
+        g_error_baseline.store(0, memory_order_relaxed);
+    }
+
+    // Registered message handlers. The list is an immutable snapshot
+    // published with an atomic shared_ptr store (read-copy-update): the
+    // log path reads it with atomic_load and no lock, while registration
+    // copies the list under a mutex and swaps in the new snapshot, so
+    // observers never contend with writers. The legacy on_message
+    // callback occupies the reserved handler id 0.
+    struct message_handler
+    {
+        uint64_t id;
+        function<bool(log_level, string const&)> callback;
+    };
+    using handler_list = vector<message_handler>;
+
+    static mutex g_handler_mutex;  // serializes registration only
+    static shared_ptr<handler_list const> g_handlers;
+    static uint64_t g_next_handler_id = 1;
+
+    // Publishes a copy of the handler list without the given id, with
+    // the replacement appended when one is supplied. The mutex must be held.
+    static void publish_handlers(uint64_t id, function<bool(log_level, string const&)> callback)
+    {
+        auto updated = make_shared<handler_list>();
+        auto current = atomic_load(&g_handlers);
+        if (current) {
+            for (auto const& handler : *current) {
+                if (handler.id != id) {
+                    updated->push_back(handler);
+                }
+            }
+        }
+        if (callback) {
+            updated->push_back({id, move(callback)});
+        }
+        atomic_store(&g_handlers, shared_ptr<handler_list const>(move(updated)));
+    }
+
+    uint64_t add_message_handler(function<bool(log_level, string const&)> callback)
+    {
+        lock_guard<mutex> lock(g_handler_mutex);
+        auto id = g_next_handler_id++;
+        publish_handlers(id, move(callback));
+        return id;
+    }
+
+    void remove_message_handler(uint64_t id)
+    {
+        lock_guard<mutex> lock(g_handler_mutex);
+        publish_handlers(id, nullptr);
+    }
+
+    // Runs every registered handler; returns false if any vetoes the
+    // message. All handlers run regardless, so observers see every
+    // message even when another handler suppresses it.
+    static bool invoke_handlers(shared_ptr<handler_list const> const& handlers, log_level level, string const& message)
+    {
+        bool allowed = true;
+        if (handlers) {
+            for (auto const& handler : *handlers) {
+                if (!handler.callback(level, message)) {
+                    allowed = false;
+                }
+            }
+        }
+        return allowed;
+    }
+
+    // Registry of per-namespace level handles. The mutex-protected map
+    // lookup only happens when a handle is first resolved (the logging
+    // macros cache it per call site) or when a record is actually
+    // emitted; the hot-path check is a relaxed load on the handle.
+    // Handles are never destroyed, so references stay valid.
+    static mutex g_namespace_mutex;
+    static map<string, unique_ptr<atomic<int>>> g_namespace_levels;
+
+    atomic<int>& namespace_level(string const& name_space)
+    {
+        lock_guard<mutex> lock(g_namespace_mutex);
+        auto& handle = g_namespace_levels[name_space];
+        if (!handle) {
+            handle.reset(new atomic<int>(-1));
+        }
+        return *handle;
+    }
+
+    void set_namespace_level(string const& name_space, log_level level)
+    {
+        namespace_level(name_space).store(static_cast<int>(level), memory_order_relaxed);
+    }
+
+    void clear_namespace_levels()
+    {
+        lock_guard<mutex> lock(g_namespace_mutex);
+        for (auto& entry : g_namespace_levels) {
+            entry.second->store(-1, memory_order_relaxed);
+        }
+    }
+
+    // Rate limiting state. Each call site (namespace plus line number)
+    // gets a token bucket; messages that find the bucket empty are
+    // dropped and counted, and the count is reported in a summary
+    // message the next time the call site is allowed through. The
+    // atomic flag keeps the disabled case free of the mutex.
+    struct rate_bucket
+    {
+        double tokens = 0;
+        chrono::steady_clock::time_point last;
+        uint64_t suppressed = 0;
+    };
+
+    static atomic<bool> g_rate_limiting {false};
+    static mutex g_rate_mutex;
+    static map<pair<string, int>, rate_bucket> g_rate_buckets;
+    static double g_rate_per_second;
+    static double g_rate_burst;
+
+    void set_rate_limit(double per_second, size_t burst)
+    {
+        lock_guard<mutex> lock(g_rate_mutex);
+        g_rate_buckets.clear();
+        g_rate_per_second = per_second;
+        g_rate_burst = static_cast<double>(burst);
+        g_rate_limiting.store(per_second > 0 && burst > 0, memory_order_relaxed);
+    }
+
+    // Returns whether the call site may log. When it may, suppressed is
+    // set to the number of messages dropped since it last logged.
+    static bool rate_limit_allows(string const& logger, int line_num, uint64_t& suppressed)
+    {
+        if (!g_rate_limiting.load(memory_order_relaxed)) {
+            return true;
+        }
+        auto now = chrono::steady_clock::now();
+        lock_guard<mutex> lock(g_rate_mutex);
+        auto& bucket = g_rate_buckets[make_pair(logger, line_num)];
+        if (bucket.last == chrono::steady_clock::time_point()) {
+            bucket.tokens = g_rate_burst;
+        } else {
+            auto elapsed = chrono::duration<double>(now - bucket.last).count();
+            bucket.tokens = min(g_rate_burst, bucket.tokens + elapsed * g_rate_per_second);
+        }
+        bucket.last = now;
+        if (bucket.tokens < 1.0) {
+            ++bucket.suppressed;
+            return false;
+        }
+        bucket.tokens -= 1.0;
+        suppressed = bucket.suppressed;
+        bucket.suppressed = 0;
+        return true;
+    }
+
+    // Formats a record timestamp for the textual sinks. The
+    // seconds-granularity date and time strings are cached and only
+    // re-rendered when the clock ticks over to the next second; per
+    // record only the subsecond digits are formatted. Guarded by a mutex
+    // since sinks can feed from multiple threads.
+    static void format_timestamp(boost::posix_time::ptime const& timestamp, string& date, string& time)
+    {
+        static mutex ts_mutex;
+        static boost::posix_time::ptime cached_second;
+        static string cached_date;
+        static string cached_time;
+
+        boost::posix_time::ptime whole_second(timestamp.date(), boost::posix_time::seconds(timestamp.time_of_day().total_seconds()));
+        {
+            lock_guard<mutex> lock(ts_mutex);
+            if (whole_second != cached_second || cached_time.empty()) {
+                cached_date = boost::gregorian::to_iso_extended_string(whole_second.date());
+                cached_time = boost::posix_time::to_simple_string(whole_second.time_of_day());
+                cached_second = whole_second;
+            }
+            date = cached_date;
+            time = cached_time;
+        }
+
+        auto frac = timestamp.time_of_day().fractional_seconds();
+        if (frac != 0) {
+            char buffer[16];
+            snprintf(buffer, sizeof(buffer), ".%0*ld",
+                     static_cast<int>(boost::posix_time::time_duration::num_fractional_digits()),
+                     static_cast<long>(frac));
+            time += buffer;
+        }
+    }
+
     class color_writer : public sinks::basic_sink_backend<sinks::synchronized_feeding>
     {
      public:
@@ -53,18 +318,20 @@ namespace leatherman { namespace logging {
     void color_writer::consume(boost::log::record_view const& rec)
     {
         auto level = boost::log::extract<log_level>("Severity", rec);
+        auto name_space = boost::log::extract<string>("Namespace", rec);
 
-        if (!is_enabled(*level)) {
+        if (!is_enabled(namespace_level(*name_space), *level)) {
             return;
         }
 
         auto line_num = boost::log::extract<int>("LineNum", rec);
-        auto name_space = boost::log::extract<string>("Namespace", rec);
         auto timestamp = boost::log::extract<boost::posix_time::ptime>("TimeStamp", rec);
         auto message = rec[expr::smessage];
 
-        _dst << boost::gregorian::to_iso_extended_string(timestamp->date());
-        _dst << " " << boost::posix_time::to_simple_string(timestamp->time_of_day());
+        string date, time;
+        format_timestamp(*timestamp, date, time);
+        _dst << date;
+        _dst << " " << time;
         _dst << " " << left << setfill(' ') << setw(5) << level << " " << *name_space;
         if (line_num) {
             _dst << ":" << *line_num;
@@ -76,15 +343,313 @@ namespace leatherman { namespace logging {
         _dst << endl;
     }
 
+    // Binary record layout written by binary_writer and read back by
+    // decode_structured_log. All integers are host-endian, so records are
+    // meant to be decoded on the machine that produced them:
+    //   uint64_t timestamp - microseconds since the Unix epoch
+    //   uint8_t  level
+    //   uint32_t line      - 0 when no line number was attached
+    //   uint16_t ns_size   - followed by that many namespace bytes
+    //   uint32_t msg_size  - followed by that many message bytes
+    class binary_writer : public sinks::basic_sink_backend<sinks::synchronized_feeding>
+    {
+     public:
+        binary_writer(ostream *dst);
+        void consume(boost::log::record_view const& rec);
+     private:
+        ostream &_dst;
+    };
+
+    binary_writer::binary_writer(ostream *dst) : _dst(*dst) {}
+
+    void binary_writer::consume(boost::log::record_view const& rec)
+    {
+        auto level = boost::log::extract<log_level>("Severity", rec);
+        auto name_space = boost::log::extract<string>("Namespace", rec);
+
+        if (!is_enabled(namespace_level(*name_space), *level)) {
+            return;
+        }
+
+        auto line_num = boost::log::extract<int>("LineNum", rec);
+        auto timestamp = boost::log::extract<boost::posix_time::ptime>("TimeStamp", rec);
+        auto message = rec[expr::smessage];
+
+        static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+        uint64_t stamp = (*timestamp - epoch).total_microseconds();
+        uint8_t lvl = static_cast<uint8_t>(*level);
+        uint32_t line = line_num ? static_cast<uint32_t>(*line_num) : 0u;
+        uint16_t ns_size = static_cast<uint16_t>(name_space->size());
+        uint32_t msg_size = static_cast<uint32_t>(message->size());
+
+        string record;
+        record.reserve(sizeof(stamp) + sizeof(lvl) + sizeof(line) + sizeof(ns_size) + ns_size + sizeof(msg_size) + msg_size);
+        auto append = [&](void const* data, size_t size) {
+            record.append(reinterpret_cast<char const*>(data), size);
+        };
+        append(&stamp, sizeof(stamp));
+        append(&lvl, sizeof(lvl));
+        append(&line, sizeof(line));
+        append(&ns_size, sizeof(ns_size));
+        record.append(*name_space, 0, ns_size);
+        append(&msg_size, sizeof(msg_size));
+        record.append(*message, 0, msg_size);
+
+        // A single write keeps the record contiguous in the stream.
+        _dst.write(record.data(), record.size());
+        _dst.flush();
+    }
+
+    // Writes formatted records into a preallocated memory-mapped file.
+    // Appending a record is a copy into the mapping; a background thread
+    // periodically asks the kernel to flush dirty pages. When a segment
+    // fills (or ages out) it is truncated to its used size and rotated to
+    // <path>.1, <path>.2, ..., dropping the oldest segment.
+    class mmap_writer : public sinks::basic_sink_backend<sinks::synchronized_feeding>
+    {
+     public:
+        mmap_writer(string path, size_t segment_size, size_t max_segments, chrono::seconds max_age);
+        ~mmap_writer();
+        void consume(boost::log::record_view const& rec);
+     private:
+        string numbered(size_t n) const;
+        void shift_segments();
+        void open_segment();
+        void close_segment();
+        void rotate();
+
+        string _path;
+        size_t _segment_size;
+        size_t _max_segments;
+        chrono::seconds _max_age;
+        ipc::file_mapping _mapping;
+        ipc::mapped_region _region;
+        size_t _used = 0;
+        chrono::steady_clock::time_point _opened;
+        mutex _mutex;
+        condition_variable _cv;
+        bool _stop = false;
+        thread _flusher;
+    };
+
+    mmap_writer::mmap_writer(string path, size_t segment_size, size_t max_segments, chrono::seconds max_age) :
+        _path(move(path)), _segment_size(max<size_t>(segment_size, 1)), _max_segments(max<size_t>(max_segments, 1)), _max_age(max_age)
+    {
+        boost::system::error_code ec;
+        if (fs::exists(_path, ec) && fs::file_size(_path, ec) > 0) {
+            // Leftovers from a previous run become the most recent
+            // rotated segment rather than being overwritten.
+            shift_segments();
+        }
+        open_segment();
+
+        _flusher = thread([this]() {
+            unique_lock<mutex> lock(_mutex);
+            while (!_stop) {
+                _cv.wait_for(lock, chrono::seconds(1));
+                if (_region.get_address() && _used > 0) {
+                    // Asynchronous flush: schedule the writeback without
+                    // blocking record appends for the duration.
+                    _region.flush(0, _used, true);
+                }
+            }
+        });
+    }
+
+    mmap_writer::~mmap_writer()
+    {
+        {
+            lock_guard<mutex> lock(_mutex);
+            _stop = true;
+        }
+        _cv.notify_one();
+        _flusher.join();
+
+        lock_guard<mutex> lock(_mutex);
+        close_segment();
+    }
+
+    string mmap_writer::numbered(size_t n) const
+    {
+        return _path + "." + to_string(n);
+    }
+
+    void mmap_writer::shift_segments()
+    {
+        boost::system::error_code ec;
+        fs::remove(numbered(_max_segments - 1), ec);
+        for (size_t i = _max_segments - 1; i > 1; --i) {
+            fs::rename(numbered(i - 1), numbered(i), ec);
+        }
+        if (_max_segments > 1) {
+            fs::rename(_path, numbered(1), ec);
+        } else {
+            fs::remove(_path, ec);
+        }
+    }
+
+    void mmap_writer::open_segment()
+    {
+        {
+            // Ensure the file exists before preallocating it.
+            fs::ofstream touch(fs::path(_path), ios::binary | ios::app);
+        }
+        fs::resize_file(_path, _segment_size);
+        _mapping = ipc::file_mapping(_path.c_str(), ipc::read_write);
+        _region = ipc::mapped_region(_mapping, ipc::read_write);
+        _used = 0;
+        _opened = chrono::steady_clock::now();
+    }
+
+    void mmap_writer::close_segment()
+    {
+        if (!_region.get_address()) {
+            return;
+        }
+        _region.flush(0, _used, false);
+        _region = ipc::mapped_region();
+        _mapping = ipc::file_mapping();
+        boost::system::error_code ec;
+        fs::resize_file(_path, _used, ec);
+    }
+
+    void mmap_writer::rotate()
+    {
+        close_segment();
+        shift_segments();
+        open_segment();
+    }
+
+    void mmap_writer::consume(boost::log::record_view const& rec)
+    {
+        auto level = boost::log::extract<log_level>("Severity", rec);
+        auto name_space = boost::log::extract<string>("Namespace", rec);
+
+        if (!is_enabled(namespace_level(*name_space), *level)) {
+            return;
+        }
+
+        auto line_num = boost::log::extract<int>("LineNum", rec);
+        auto timestamp = boost::log::extract<boost::posix_time::ptime>("TimeStamp", rec);
+        auto message = rec[expr::smessage];
+
+        string date, time;
+        format_timestamp(*timestamp, date, time);
+        ostringstream buffer;
+        buffer << date << " " << time;
+        buffer << " " << left << setfill(' ') << setw(5) << *level << " " << *name_space;
+        if (line_num) {
+            buffer << ":" << *line_num;
+        }
+        buffer << " - " << *message << "\n";
+        auto text = buffer.str();
+
+        lock_guard<mutex> lock(_mutex);
+        if (_max_age.count() > 0 && chrono::steady_clock::now() - _opened >= _max_age) {
+            rotate();
+        }
+        if (_used + text.size() > _segment_size) {
+            rotate();
+        }
+        // A record larger than a whole segment is clamped to fit.
+        auto count = min(text.size(), _segment_size);
+        memcpy(static_cast<char*>(_region.get_address()) + _used, text.data(), count);
+        _used += count;
+    }
+
+    // Removes the active memory-mapped file sink, if any; dropping the
+    // last reference finalizes the file.
+    static function<void()> g_file_stop;
+
+    static void stop_file_sink()
+    {
+        if (g_file_stop) {
+            g_file_stop();
+            g_file_stop = nullptr;
+        }
+    }
+
+    // Detaches the direct sink, if any; later records flow through the
+    // Boost.Log core again.
+    static void stop_direct_sink()
+    {
+        g_direct_dst.store(nullptr, memory_order_relaxed);
+    }
+
+    // Formats and writes a record without involving Boost.Log. The record
+    // prefix is rendered into a stack buffer; the only allocations on this
+    // path are the cached timestamp strings when the clock ticks over to a
+    // new second.
+    static void log_direct(ostream& dst, const string &logger, log_level level, int line_num, string const& message)
+    {
+        static const char* const level_names[] = {"", "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+        string date, time;
+        format_timestamp(boost::posix_time::microsec_clock::local_time(), date, time);
+
+        char prefix[512];
+        int count;
+        if (line_num > 0) {
+            count = snprintf(prefix, sizeof(prefix), "%s %s %-5s %s:%d - ",
+                             date.c_str(), time.c_str(), level_names[static_cast<size_t>(level)], logger.c_str(), line_num);
+        } else {
+            count = snprintf(prefix, sizeof(prefix), "%s %s %-5s %s - ",
+                             date.c_str(), time.c_str(), level_names[static_cast<size_t>(level)], logger.c_str());
+        }
+        if (count < 0) {
+            return;
+        }
+
+        static mutex direct_mutex;
+        lock_guard<mutex> lock(direct_mutex);
+        dst.write(prefix, min(static_cast<size_t>(count), sizeof(prefix) - 1));
+        dst.write(message.data(), message.size());
+        dst.put('\n');
+        dst.flush();
+    }
+
+    // The number of records the asynchronous queue holds before the
+    // overflow policy applies. Boost.Log's bounded queue takes its
+    // capacity as a compile-time constant.
+    constexpr size_t async_queue_size = 4096;
+
+    // Stops the active asynchronous sink, if any, draining its queue.
+    // Stored as a callback since the sink's type depends on the chosen
+    // overflow policy.
+    static function<void()> g_async_stop;
+
+    static void stop_async_sink()
+    {
+        if (g_async_stop) {
+            g_async_stop();
+            g_async_stop = nullptr;
+        }
+    }
+
+    template <typename overflow_strategy>
+    static void add_async_sink(ostream &dst)
+    {
+        using sink_t = sinks::asynchronous_sink<color_writer, sinks::bounded_fifo_queue<async_queue_size, overflow_strategy>>;
+        auto sink = boost::make_shared<sink_t>(boost::make_shared<color_writer>(&console_stream(dst)));
+        boost::log::core::get()->add_sink(sink);
+        g_async_stop = [sink]() {
+            sink->stop();
+            sink->flush();
+        };
+    }
+
     // cppcheck-suppress passedByValue
     void setup_logging(ostream &dst, string locale, string domain, bool use_locale)
     {
         // Remove existing sinks before adding a new one
         auto core = boost::log::core::get();
+        stop_async_sink();
+        stop_file_sink();
+        stop_direct_sink();
         core->remove_all_sinks();
 
         using sink_t = sinks::synchronous_sink<color_writer>;
-        boost::shared_ptr<sink_t> sink = boost::make_shared<sink_t>(boost::make_shared<color_writer>(&dst));
+        boost::shared_ptr<sink_t> sink = boost::make_shared<sink_t>(boost::make_shared<color_writer>(&console_stream(dst)));
         core->add_sink(sink);
 
 
@@ -116,16 +681,164 @@ namespace leatherman { namespace logging {
         setup_logging(dst, move(locale), move(domain), true);
     }
 
+    // cppcheck-suppress passedByValue
+    void setup_async_logging(ostream &dst, async_overflow_policy policy, string locale, string domain, bool use_locale)
+    {
+        // Remove existing sinks before adding a new one
+        auto core = boost::log::core::get();
+        stop_async_sink();
+        stop_file_sink();
+        stop_direct_sink();
+        core->remove_all_sinks();
+
+        if (policy == async_overflow_policy::drop) {
+            add_async_sink<sinks::drop_on_overflow>(dst);
+        } else {
+            add_async_sink<sinks::block_on_overflow>(dst);
+        }
+
+#ifdef LEATHERMAN_USE_LOCALES
+        // Imbue the logging sink with the requested locale; see setup_logging.
+        if (use_locale) {
+            dst.imbue(lth_locale::get_locale(locale, domain, {}));
+        }
+#endif
+
+        boost::log::add_common_attributes();
+
+        // Default to the warning level
+        set_level(log_level::warning);
+
+        // Set whether or not to use colorization depending if the destination is a tty
+        g_colorize = color_supported(dst);
+    }
+
+    void setup_direct_logging(ostream &dst)
+    {
+        // Remove existing sinks; records no longer flow through the core.
+        auto core = boost::log::core::get();
+        stop_async_sink();
+        stop_file_sink();
+        core->remove_all_sinks();
+
+        g_direct_dst.store(&dst, memory_order_relaxed);
+
+        // Default to the warning level
+        set_level(log_level::warning);
+
+        // The direct path writes whole buffers; colorizing would split
+        // them, so it stays off.
+        g_colorize = false;
+    }
+
+    void shutdown_async_logging()
+    {
+        stop_async_sink();
+    }
+
+    void setup_file_logging(string const& path, size_t segment_size, size_t max_segments, chrono::seconds max_age)
+    {
+        // Remove existing sinks before adding a new one
+        auto core = boost::log::core::get();
+        stop_async_sink();
+        stop_file_sink();
+        stop_direct_sink();
+        core->remove_all_sinks();
+
+        using sink_t = sinks::synchronous_sink<mmap_writer>;
+        auto backend = boost::make_shared<mmap_writer>(path, segment_size, max_segments, max_age);
+        boost::shared_ptr<sink_t> sink = boost::make_shared<sink_t>(backend);
+        core->add_sink(sink);
+        g_file_stop = [sink]() {
+            boost::log::core::get()->remove_sink(sink);
+        };
+
+        boost::log::add_common_attributes();
+
+        // Default to the warning level
+        set_level(log_level::warning);
+
+        // The mapped file is never colorized.
+        g_colorize = false;
+    }
+
+    void shutdown_file_logging()
+    {
+        stop_file_sink();
+    }
+
+    void setup_structured_logging(ostream &dst)
+    {
+        // Remove existing sinks before adding a new one
+        auto core = boost::log::core::get();
+        stop_async_sink();
+        stop_file_sink();
+        stop_direct_sink();
+        core->remove_all_sinks();
+
+        using sink_t = sinks::synchronous_sink<binary_writer>;
+        boost::shared_ptr<sink_t> sink = boost::make_shared<sink_t>(boost::make_shared<binary_writer>(&dst));
+        core->add_sink(sink);
+
+        boost::log::add_common_attributes();
+
+        // Default to the warning level
+        set_level(log_level::warning);
+
+        // Binary records are never colorized.
+        g_colorize = false;
+    }
+
+    size_t decode_structured_log(istream &in, ostream &out)
+    {
+        static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+        size_t count = 0;
+        while (true) {
+            uint64_t stamp;
+            uint8_t lvl;
+            uint32_t line;
+            uint16_t ns_size;
+            uint32_t msg_size;
+
+            if (!in.read(reinterpret_cast<char*>(&stamp), sizeof(stamp))) {
+                // A clean end of stream between records.
+                break;
+            }
+            in.read(reinterpret_cast<char*>(&lvl), sizeof(lvl));
+            in.read(reinterpret_cast<char*>(&line), sizeof(line));
+            in.read(reinterpret_cast<char*>(&ns_size), sizeof(ns_size));
+            string name_space(ns_size, '\0');
+            in.read(&name_space[0], ns_size);
+            in.read(reinterpret_cast<char*>(&msg_size), sizeof(msg_size));
+            string message(msg_size, '\0');
+            in.read(&message[0], msg_size);
+            if (!in) {
+                throw runtime_error(_("truncated structured log record."));
+            }
+
+            auto timestamp = epoch + boost::posix_time::microseconds(stamp);
+            out << boost::gregorian::to_iso_extended_string(timestamp.date());
+            out << " " << boost::posix_time::to_simple_string(timestamp.time_of_day());
+            out << " " << left << setfill(' ') << setw(5) << static_cast<log_level>(lvl) << " " << name_space;
+            if (line) {
+                out << ":" << line;
+            }
+            out << " - " << message << endl;
+            ++count;
+        }
+        return count;
+    }
+
     void set_level(log_level level)
     {
         auto core = boost::log::core::get();
         core->set_logging_enabled(level != log_level::none);
-        g_level = level;
+        g_log_level.store(level, std::memory_order_relaxed);
     }
 
     log_level get_level()
     {
-        return g_level;
+        return g_log_level.load(std::memory_order_relaxed);
     }
 
     void set_colorization(bool color)
@@ -138,34 +851,30 @@ namespace leatherman { namespace logging {
         return g_colorize;
     }
 
-    bool is_enabled(log_level level)
+    // The number of error and fatal messages submitted so far.
+    static uint64_t error_total()
     {
-        return g_level != log_level::none && static_cast<int>(level) >= static_cast<int>(g_level);
+        return message_count(log_level::error) + message_count(log_level::fatal);
     }
 
     bool error_has_been_logged() {
-        return g_error_logged;
+        return error_total() > g_error_baseline.load(memory_order_relaxed);
     }
 
     void clear_error_logged_flag() {
-        g_error_logged = false;
+        g_error_baseline.store(error_total(), memory_order_relaxed);
     }
 
     // cppcheck-suppress passedByValue
     void on_message(function<bool(log_level, string const&)> callback)
     {
-        g_callback = callback;
+        lock_guard<mutex> lock(g_handler_mutex);
+        publish_handlers(0, move(callback));
     }
 
-    void log_helper(const string &logger, log_level level, int line_num, string const& message)
+    // Hands a message that passed all checks to the active backend.
+    static void dispatch(const string &logger, log_level level, int line_num, string const& message)
     {
-        if (level >= log_level::error) {
-            g_error_logged = true;
-        }
-        if (!is_enabled(level) || (g_callback && !g_callback(level, message))) {
-            return;
-        }
-
         switch (g_backend) {
         case logging_backend::eventlog:
             log_eventlog(level, message);
@@ -174,11 +883,44 @@ namespace leatherman { namespace logging {
             log_syslog(level, message);
             break;
         default:
-            log_boost(logger, level, line_num, message);
+            if (auto dst = g_direct_dst.load(memory_order_relaxed)) {
+                log_direct(*dst, logger, level, line_num, message);
+            } else {
+                log_boost(logger, level, line_num, message);
+            }
             break;
         }
     }
 
+    void log_helper(const string &logger, log_level level, int line_num, string const& message)
+    {
+        auto level_index = static_cast<size_t>(level);
+        if (level_index < level_count) {
+            thread_counters().counts[level_index].fetch_add(1, memory_order_relaxed);
+        }
+        if (!is_enabled(namespace_level(logger), level)) {
+            return;
+        }
+
+        uint64_t suppressed = 0;
+        if (!rate_limit_allows(logger, line_num, suppressed)) {
+            return;
+        }
+
+        auto handlers = atomic_load(&g_handlers);
+        if (suppressed > 0) {
+            auto summary = _("suppressed {1} duplicate messages.", suppressed);
+            if (invoke_handlers(handlers, level, summary)) {
+                dispatch(logger, level, line_num, summary);
+            }
+        }
+
+        if (!invoke_handlers(handlers, level, message)) {
+            return;
+        }
+        dispatch(logger, level, line_num, message);
+    }
+
     void log_boost(const string &logger, log_level level, int line_num, string const& message)
     {
         src::logger slg;
@@ -1,5 +1,11 @@
 #include <leatherman/logging/logging.hpp>
 #include <boost/nowide/iostream.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <unistd.h>
 #include <syslog.h>
 
@@ -15,34 +21,45 @@ namespace leatherman { namespace logging {
             return;
         }
 
-        static const string cyan = "\33[0;36m";
-        static const string green = "\33[0;32m";
-        static const string yellow = "\33[0;33m";
-        static const string red = "\33[0;31m";
-        static const string reset = "\33[0m";
-
-        if (level == log_level::trace || level == log_level::debug) {
-            dst << cyan;
-        } else if (level == log_level::info) {
-            dst << green;
-        } else if (level == log_level::warning) {
-            dst << yellow;
-        } else if (level == log_level::error || level == log_level::fatal) {
-            dst << red;
-        } else {
-            dst << reset;
+        // Escape sequences indexed by log level, with none mapping to
+        // reset. Precomputed lengths let the write skip a strlen (or a
+        // string construction) per record.
+        struct escape { char const* text; size_t size; };
+        static const escape table[] = {
+            { "\33[0m",    4 },  // none: reset
+            { "\33[0;36m", 7 },  // trace: cyan
+            { "\33[0;36m", 7 },  // debug: cyan
+            { "\33[0;32m", 7 },  // info: green
+            { "\33[0;33m", 7 },  // warning: yellow
+            { "\33[0;31m", 7 },  // error: red
+            { "\33[0;31m", 7 },  // fatal: red
+        };
+
+        auto index = static_cast<size_t>(level);
+        if (index >= sizeof(table) / sizeof(table[0])) {
+            index = 0;
         }
+        dst.write(table[index].text, table[index].size);
     }
 
     bool color_supported(ostream& dst)
     {
-        return (&dst == &cout && isatty(fileno(stdout))) || (&dst == &cerr && isatty(fileno(stderr)));
+        // Whether the standard streams are ttys can't change over the
+        // process's lifetime; probe once instead of issuing isatty calls
+        // on every query.
+        static const bool stdout_tty = isatty(fileno(stdout)) != 0;
+        static const bool stderr_tty = isatty(fileno(stderr)) != 0;
+        return (&dst == &cout && stdout_tty) || (&dst == &cerr && stderr_tty);
     }
 
     void log_eventlog(log_level level, string const& message) {
         throw runtime_error("eventlog is available only on windows");
     }
 
+    void set_eventlog_batching(bool enabled) {
+        throw runtime_error("eventlog is available only on windows");
+    }
+
     syslog_facility string_to_syslog_facility(std::string facility)
     {
         syslog_facility fac;
@@ -106,12 +123,89 @@ namespace leatherman { namespace logging {
         }
     }
 
+    // Batching state for syslog transmission. Records are appended to a
+    // queue under the mutex and drained in whole batches by a background
+    // thread, so application threads never block on the syslog socket.
+    // syslog(3) owns the socket, so the drain still submits one record
+    // at a time; the win is moving the blocking calls off the logging
+    // threads.
+    struct syslog_batcher
+    {
+        mutex queue_mutex;
+        condition_variable cv;
+        vector<pair<int, string>> queue;
+        bool stop = false;
+        thread worker;
+    };
+
+    static unique_ptr<syslog_batcher> g_batcher;
+
+    void set_syslog_batching(bool enabled)
+    {
+        if (enabled == static_cast<bool>(g_batcher)) {
+            return;
+        }
+
+        if (!enabled) {
+            {
+                lock_guard<mutex> lock(g_batcher->queue_mutex);
+                g_batcher->stop = true;
+            }
+            g_batcher->cv.notify_one();
+            g_batcher->worker.join();
+            g_batcher.reset();
+            return;
+        }
+
+        g_batcher.reset(new syslog_batcher());
+        auto batcher = g_batcher.get();
+        g_batcher->worker = thread([batcher]() {
+            unique_lock<mutex> lock(batcher->queue_mutex);
+            while (true) {
+                batcher->cv.wait(lock, [&]() { return batcher->stop || !batcher->queue.empty(); });
+                if (batcher->queue.empty()) {
+                    break;
+                }
+                // Swap the whole batch out so producers are released
+                // while the records are transmitted.
+                vector<pair<int, string>> batch;
+                batch.swap(batcher->queue);
+                lock.unlock();
+                for (auto const& entry : batch) {
+                    syslog(entry.first, "%s", entry.second.c_str());
+                }
+                lock.lock();
+                if (batcher->stop && batcher->queue.empty()) {
+                    break;
+                }
+            }
+        });
+    }
+
     void log_syslog(log_level level, string const &message) {
-        if (level != log_level::none) {
-            int severity = log_level_to_severity(level);
-            syslog(severity, "%s", message.c_str());
+        if (level == log_level::none) {
+            return;
         }
+        int severity = log_level_to_severity(level);
+        if (g_batcher) {
+            {
+                lock_guard<mutex> lock(g_batcher->queue_mutex);
+                g_batcher->queue.emplace_back(severity, message);
+            }
+            g_batcher->cv.notify_one();
+            return;
+        }
+        syslog(severity, "%s", message.c_str());
     }
 
-    void clean_syslog_logging() { closelog(); }
+    void clean_syslog_logging() {
+        set_syslog_batching(false);
+        closelog();
+    }
+
+    ostream& console_stream(ostream &dst) {
+        // POSIX terminal writes are already buffered by the stream; the
+        // batching wrapper only exists for the Windows console.
+        return dst;
+    }
 }}  // namespace leatherman::logging
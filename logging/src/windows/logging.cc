@@ -1,5 +1,14 @@
 #include <leatherman/logging/logging.hpp>
+#include <boost/nowide/convert.hpp>
 #include <boost/nowide/iostream.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <windows.h>
 
 #define STATUS_SEVERITY_SUCCESS          0x0
@@ -93,31 +102,220 @@ namespace leatherman { namespace logging {
         return STATUS_SEVERITY_SUCCESS;
     }
 
+    // Submits a run of same-severity records as a single event; Event
+    // Log writes are slow RPCs, so coalescing bounds the RPC count by
+    // the number of severity changes in a burst rather than by the
+    // number of records.
+    static void report_events(int severity, vector<wstring> const& messages)
+    {
+        const int category = 0;
+        const int event_id = 1;
+        vector<LPCWSTR> strings;
+        strings.reserve(messages.size());
+        for (auto const& message : messages) {
+            strings.push_back(message.c_str());
+        }
+        if (!ReportEvent(h_event_log, severity, category, event_id, NULL,
+                         static_cast<WORD>(strings.size()), 0, strings.data(), NULL)) {
+            // this message won't show up when running as a service
+            boost::nowide::cerr << "ReportEvent failed with " << GetLastError() << "\n";
+        }
+    }
+
+    // Batching state for Event Log submission. Records are appended to
+    // a queue under the mutex and drained by a background thread, which
+    // coalesces consecutive records of the same severity into a single
+    // ReportEvent call; application threads pay only an enqueue.
+    struct eventlog_batcher
+    {
+        mutex queue_mutex;
+        condition_variable cv;
+        vector<pair<int, wstring>> queue;
+        bool stop = false;
+        thread worker;
+    };
+
+    static unique_ptr<eventlog_batcher> g_event_batcher;
+
+    void set_eventlog_batching(bool enabled)
+    {
+        if (enabled == static_cast<bool>(g_event_batcher)) {
+            return;
+        }
+
+        if (!enabled) {
+            {
+                lock_guard<mutex> lock(g_event_batcher->queue_mutex);
+                g_event_batcher->stop = true;
+            }
+            g_event_batcher->cv.notify_one();
+            g_event_batcher->worker.join();
+            g_event_batcher.reset();
+            return;
+        }
+
+        g_event_batcher.reset(new eventlog_batcher());
+        auto batcher = g_event_batcher.get();
+        g_event_batcher->worker = thread([batcher]() {
+            unique_lock<mutex> lock(batcher->queue_mutex);
+            while (true) {
+                batcher->cv.wait(lock, [&]() { return batcher->stop || !batcher->queue.empty(); });
+                if (batcher->queue.empty()) {
+                    break;
+                }
+                // Swap the whole batch out so producers are released
+                // while the records are submitted.
+                vector<pair<int, wstring>> batch;
+                batch.swap(batcher->queue);
+                lock.unlock();
+                vector<wstring> run;
+                int run_severity = batch.front().first;
+                for (auto& entry : batch) {
+                    if (entry.first != run_severity) {
+                        report_events(run_severity, run);
+                        run.clear();
+                        run_severity = entry.first;
+                    }
+                    run.push_back(std::move(entry.second));
+                }
+                report_events(run_severity, run);
+                lock.lock();
+                if (batcher->stop && batcher->queue.empty()) {
+                    break;
+                }
+            }
+        });
+    }
+
     void log_eventlog(log_level level, string const &message)
     {
         if (h_event_log) {
             int severity = log_level_to_severity(level);
             if (severity != STATUS_SEVERITY_SUCCESS) {
-                const int category = 0;
-                const int event_id = 1;
-                const wstring w_message(message.begin(), message.end());
-                LPCWSTR p_w_message = w_message.c_str();
-                if (!ReportEvent(h_event_log, severity, category, event_id, NULL, 1,
-                                 0, &p_w_message, NULL)) {
-                    // this message won't show up when running as a service
-                    boost::nowide::cerr << "ReportEvent failed with " << GetLastError()
-                                        << ", msg: " << message << "\n";
+                wstring w_message = boost::nowide::widen(message);
+                if (g_event_batcher) {
+                    {
+                        lock_guard<mutex> lock(g_event_batcher->queue_mutex);
+                        g_event_batcher->queue.emplace_back(severity, std::move(w_message));
+                    }
+                    g_event_batcher->cv.notify_one();
+                    return;
+                }
+                report_events(severity, { std::move(w_message) });
+            }
+        }
+    }
+
+    // Batches console output into a large buffer and writes it with a
+    // single WriteConsoleW per flush; console I/O is slow enough that a
+    // WriteConsoleW per record visibly stalls verbose logging. The
+    // buffer flushes when it fills, when it holds enough complete
+    // lines, or when its oldest byte has waited too long, so output
+    // still appears promptly.
+    class console_buffer : public streambuf
+    {
+     public:
+        explicit console_buffer(HANDLE console) : _console(console)
+        {
+            _buffer.reserve(buffer_size);
+        }
+
+     protected:
+        int overflow(int ch) override
+        {
+            if (ch != EOF) {
+                char c = static_cast<char>(ch);
+                xsputn(&c, 1);
+            }
+            return ch;
+        }
+
+        streamsize xsputn(char const* data, streamsize count) override
+        {
+            if (_buffer.empty()) {
+                _oldest = chrono::steady_clock::now();
+            }
+            for (streamsize i = 0; i < count; ++i) {
+                if (data[i] == '\n') {
+                    ++_newlines;
                 }
             }
+            _buffer.append(data, static_cast<size_t>(count));
+            if (_buffer.size() >= buffer_size || _newlines >= newline_limit ||
+                chrono::steady_clock::now() - _oldest > flush_after) {
+                write_out();
+            }
+            return count;
+        }
+
+        int sync() override
+        {
+            write_out();
+            return 0;
+        }
+
+     private:
+        static const size_t buffer_size = 64 * 1024;
+        static const size_t newline_limit = 64;
+        static constexpr chrono::milliseconds flush_after {100};
+
+        void write_out()
+        {
+            if (_buffer.empty()) {
+                return;
+            }
+            // One conversion and one console write for the whole batch.
+            auto wide = boost::nowide::widen(_buffer);
+            DWORD written = 0;
+            WriteConsoleW(_console, wide.data(), static_cast<DWORD>(wide.size()), &written, nullptr);
+            _buffer.clear();
+            _newlines = 0;
         }
+
+        HANDLE _console;
+        string _buffer;
+        size_t _newlines = 0;
+        chrono::steady_clock::time_point _oldest;
+    };
+
+    constexpr chrono::milliseconds console_buffer::flush_after;
+
+    ostream& console_stream(ostream &dst)
+    {
+        // Only wrap destinations that are actual consoles; redirected
+        // standard streams go through the usual buffered path.
+        HANDLE console = INVALID_HANDLE_VALUE;
+        if (&dst == &cout || &dst == &boost::nowide::cout) {
+            console = GetStdHandle(STD_OUTPUT_HANDLE);
+        } else if (&dst == &cerr || &dst == &boost::nowide::cerr) {
+            console = GetStdHandle(STD_ERROR_HANDLE);
+        }
+        DWORD mode;
+        if (console == INVALID_HANDLE_VALUE || !GetConsoleMode(console, &mode)) {
+            return dst;
+        }
+
+        if (console == GetStdHandle(STD_OUTPUT_HANDLE)) {
+            static console_buffer out_buffer { GetStdHandle(STD_OUTPUT_HANDLE) };
+            static ostream out_stream { &out_buffer };
+            return out_stream;
+        }
+        static console_buffer err_buffer { GetStdHandle(STD_ERROR_HANDLE) };
+        static ostream err_stream { &err_buffer };
+        return err_stream;
     }
 
     void log_syslog(log_level level, string const &message) {
         throw runtime_error("syslog is only available on POSIX platforms");
     }
 
+    void set_syslog_batching(bool enabled) {
+        throw runtime_error("syslog is only available on POSIX platforms");
+    }
+
     void clean_eventlog_logging()
     {
+        set_eventlog_batching(false);
         if (h_event_log) {
             DeregisterEventSource(h_event_log);
             h_event_log = NULL;
@@ -0,0 +1,46 @@
+#include "logging.hpp"
+#include <sstream>
+
+using namespace leatherman::test;
+using namespace leatherman::logging;
+
+SCENARIO("logging asynchronously to a stream") {
+    std::ostringstream stream;
+    setup_async_logging(stream);
+    set_level(log_level::debug);
+    clear_error_logged_flag();
+
+    GIVEN("a message logged through the macros") {
+        LOG_INFO("hello {1}", "async");
+        THEN("the message reaches the stream once the queue is drained") {
+            shutdown_async_logging();
+            REQUIRE(stream.str().find("hello async") != std::string::npos);
+            REQUIRE(stream.str().find("INFO") != std::string::npos);
+        }
+    }
+
+    GIVEN("a drop-on-overflow policy") {
+        setup_async_logging(stream, async_overflow_policy::drop);
+        set_level(log_level::debug);
+        LOG_INFO("drop-policy message");
+        THEN("records below the queue capacity are still written") {
+            shutdown_async_logging();
+            REQUIRE(stream.str().find("drop-policy message") != std::string::npos);
+        }
+    }
+
+    GIVEN("a disabled level") {
+        LOG_TRACE("should not appear");
+        THEN("nothing is queued for the writer thread") {
+            shutdown_async_logging();
+            REQUIRE(stream.str().find("should not appear") == std::string::npos);
+        }
+    }
+
+    shutdown_async_logging();
+    auto core = boost::log::core::get();
+    core->reset_filter();
+    core->remove_all_sinks();
+    set_level(log_level::none);
+    clear_error_logged_flag();
+}
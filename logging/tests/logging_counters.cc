@@ -0,0 +1,54 @@
+#include "logging.hpp"
+
+using namespace leatherman::test;
+using namespace leatherman::logging;
+
+SCENARIO("counting messages per level") {
+    logging_context context(log_level::debug);
+    reset_message_counts();
+
+    GIVEN("messages submitted at several levels") {
+        auto infos = message_count(log_level::info);
+        auto warnings = message_count(log_level::warning);
+        LOG_INFO("an info message");
+        LOG_INFO("another info message");
+        LOG_WARNING("a warning message");
+        THEN("each level's counter reflects its submissions") {
+            REQUIRE(message_count(log_level::info) == infos + 2);
+            REQUIRE(message_count(log_level::warning) == warnings + 1);
+        }
+    }
+
+    GIVEN("a message suppressed by the current level") {
+        auto traces = message_count(log_level::trace);
+        set_level(log_level::warning);
+        log("test", log_level::trace, 0, "a suppressed trace message");
+        THEN("the submission is still counted") {
+            REQUIRE(message_count(log_level::trace) == traces + 1);
+        }
+    }
+
+    GIVEN("an error message") {
+        REQUIRE_FALSE(error_has_been_logged());
+        auto errors = message_count(log_level::error);
+        LOG_ERROR("an error message");
+        THEN("the counter and the error flag both reflect it") {
+            REQUIRE(message_count(log_level::error) == errors + 1);
+            REQUIRE(error_has_been_logged());
+        }
+        THEN("clearing the flag does not disturb the counter") {
+            clear_error_logged_flag();
+            REQUIRE_FALSE(error_has_been_logged());
+            REQUIRE(message_count(log_level::error) == errors + 1);
+        }
+    }
+
+    GIVEN("reset counters") {
+        LOG_ERROR("an error message");
+        reset_message_counts();
+        THEN("every counter reads zero and the error flag is cleared") {
+            REQUIRE(message_count(log_level::error) == 0u);
+            REQUIRE_FALSE(error_has_been_logged());
+        }
+    }
+}
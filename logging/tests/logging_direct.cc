@@ -0,0 +1,56 @@
+#include "logging.hpp"
+#include <sstream>
+
+using namespace leatherman::test;
+using namespace leatherman::logging;
+
+SCENARIO("logging directly to a stream") {
+    std::ostringstream stream;
+    setup_direct_logging(stream);
+    set_level(log_level::debug);
+    clear_error_logged_flag();
+
+    GIVEN("a message logged through the macros") {
+        LOG_INFO("hello {1}", "direct");
+        THEN("the formatted record is written to the stream") {
+            auto text = stream.str();
+            REQUIRE(text.find("hello direct") != std::string::npos);
+            REQUIRE(text.find("INFO") != std::string::npos);
+            REQUIRE(text.find(LOG_NAMESPACE) != std::string::npos);
+        }
+    }
+
+    GIVEN("a disabled level") {
+        LOG_TRACE("should not appear");
+        THEN("nothing is written") {
+            REQUIRE(stream.str().find("should not appear") == std::string::npos);
+        }
+    }
+
+    GIVEN("an error level message") {
+        LOG_ERROR("direct error");
+        THEN("the error flag is set") {
+            REQUIRE(stream.str().find("direct error") != std::string::npos);
+            REQUIRE(error_has_been_logged());
+        }
+    }
+
+    GIVEN("logging set up again for a stream sink") {
+        std::ostringstream other;
+        setup_logging(other);
+        set_level(log_level::debug);
+        LOG_INFO("back through boost");
+        THEN("the direct destination no longer receives records") {
+            REQUIRE(stream.str().find("back through boost") == std::string::npos);
+            REQUIRE(other.str().find("back through boost") != std::string::npos);
+        }
+    }
+
+    // Detach the direct destination before the stream goes out of scope.
+    setup_logging(stream);
+    auto core = boost::log::core::get();
+    core->reset_filter();
+    core->remove_all_sinks();
+    set_level(log_level::none);
+    clear_error_logged_flag();
+}
@@ -0,0 +1,75 @@
+#include <catch.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <sstream>
+#include <string>
+
+using namespace std;
+using namespace leatherman::logging;
+namespace fs = boost::filesystem;
+
+namespace {
+    string read_file(string const& path)
+    {
+        boost::nowide::ifstream in(path.c_str(), ios::binary);
+        ostringstream buffer;
+        buffer << in.rdbuf();
+        return buffer.str();
+    }
+}
+
+TEST_CASE("memory-mapped file logging") {
+    auto base = fs::temp_directory_path() / fs::unique_path("leatherman_mmap_log_%%%%%%%%");
+    auto path = (base / "test.log").string();
+    fs::create_directories(base);
+
+    SECTION("records are written and the file is truncated on shutdown") {
+        setup_file_logging(path, 4096);
+        set_level(log_level::debug);
+        log("test", log_level::info, 42, "hello mapped file");
+        shutdown_file_logging();
+
+        REQUIRE(fs::file_size(path) < 4096u);
+        auto text = read_file(path);
+        REQUIRE(text.find("INFO") != string::npos);
+        REQUIRE(text.find("test:42") != string::npos);
+        REQUIRE(text.find("hello mapped file") != string::npos);
+    }
+
+    SECTION("a full segment rotates and the oldest is dropped") {
+        setup_file_logging(path, 256, 2);
+        set_level(log_level::debug);
+        for (int i = 0; i < 20; ++i) {
+            log("test", log_level::info, 0, "message number {1}", i);
+        }
+        shutdown_file_logging();
+
+        REQUIRE(fs::exists(path));
+        REQUIRE(fs::exists(path + ".1"));
+        REQUIRE_FALSE(fs::exists(path + ".2"));
+        REQUIRE(fs::file_size(path + ".1") <= 256u);
+    }
+
+    SECTION("an existing log file is rotated away on setup") {
+        setup_file_logging(path, 4096);
+        set_level(log_level::debug);
+        log("test", log_level::info, 0, "from the first run");
+        shutdown_file_logging();
+
+        setup_file_logging(path, 4096);
+        set_level(log_level::debug);
+        log("test", log_level::info, 0, "from the second run");
+        shutdown_file_logging();
+
+        REQUIRE(read_file(path).find("from the second run") != string::npos);
+        REQUIRE(read_file(path + ".1").find("from the first run") != string::npos);
+    }
+
+    fs::remove_all(base);
+    auto core = boost::log::core::get();
+    core->reset_filter();
+    core->remove_all_sinks();
+    set_level(log_level::none);
+    clear_error_logged_flag();
+}
@@ -0,0 +1,77 @@
+#include <catch.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <string>
+#include <vector>
+#include "logging.hpp"
+
+using namespace std;
+using namespace leatherman::logging;
+
+TEST_CASE("logging with multiple message handlers") {
+    leatherman::test::logging_context ctx(log_level::trace);
+
+    SECTION("every registered handler sees the message") {
+        vector<string> first, second;
+        auto first_id = add_message_handler([&](log_level lvl, string const& msg) {
+            first.push_back(msg);
+            return false;
+        });
+        auto second_id = add_message_handler([&](log_level lvl, string const& msg) {
+            second.push_back(msg);
+            return false;
+        });
+
+        LOG_INFO("observed message");
+        REQUIRE(first == vector<string>{"observed message"});
+        REQUIRE(second == vector<string>{"observed message"});
+
+        remove_message_handler(first_id);
+        remove_message_handler(second_id);
+    }
+
+    SECTION("a removed handler no longer sees messages") {
+        vector<string> messages;
+        auto id = add_message_handler([&](log_level lvl, string const& msg) {
+            messages.push_back(msg);
+            return false;
+        });
+        remove_message_handler(id);
+
+        on_message([](log_level, string const&) { return false; });
+        LOG_INFO("after removal");
+        REQUIRE(messages.empty());
+    }
+
+    SECTION("handlers observe messages vetoed by another handler") {
+        vector<string> messages;
+        auto id = add_message_handler([&](log_level lvl, string const& msg) {
+            messages.push_back(msg);
+            return true;
+        });
+        on_message([](log_level, string const&) { return false; });
+
+        LOG_INFO("vetoed message");
+        REQUIRE(messages == vector<string>{"vetoed message"});
+
+        remove_message_handler(id);
+    }
+
+    SECTION("on_message replaces only the legacy callback") {
+        vector<string> legacy, handler;
+        auto id = add_message_handler([&](log_level lvl, string const& msg) {
+            handler.push_back(msg);
+            return false;
+        });
+        on_message([&](log_level lvl, string const& msg) {
+            legacy.push_back(msg);
+            return false;
+        });
+        on_message([](log_level, string const&) { return false; });
+
+        LOG_INFO("replaced message");
+        REQUIRE(legacy.empty());
+        REQUIRE(handler == vector<string>{"replaced message"});
+
+        remove_message_handler(id);
+    }
+}
@@ -0,0 +1,46 @@
+// Exercises the compile-time log level floor: with the floor set to
+// info, the trace and debug macros in this translation unit compile to
+// nothing while the higher-severity macros behave as usual.
+#define LEATHERMAN_LOG_MIN_LEVEL 3
+
+#include <catch.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::logging;
+
+TEST_CASE("logging with a compile-time level floor") {
+    set_level(log_level::trace);
+
+    vector<string> messages;
+    on_message([&](log_level lvl, string const& msg) {
+        messages.push_back(msg);
+        return false;
+    });
+
+    SECTION("macros below the floor compile to nothing") {
+        LOG_TRACE("trace message");
+        LOG_DEBUG("debug message");
+        REQUIRE(messages.empty());
+    }
+
+    SECTION("enabled checks below the floor report disabled") {
+        REQUIRE_FALSE(LOG_IS_TRACE_ENABLED());
+        REQUIRE_FALSE(LOG_IS_DEBUG_ENABLED());
+        REQUIRE(LOG_IS_INFO_ENABLED());
+    }
+
+    SECTION("macros at or above the floor still log") {
+        LOG_INFO("info message");
+        LOG_ERROR("error message");
+        REQUIRE(messages.size() == 2u);
+        REQUIRE(messages[0] == "info message");
+        REQUIRE(messages[1] == "error message");
+    }
+
+    on_message(nullptr);
+    set_level(log_level::none);
+    clear_error_logged_flag();
+}
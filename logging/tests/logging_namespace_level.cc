@@ -0,0 +1,59 @@
+#include <catch.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::logging;
+
+TEST_CASE("logging with per-namespace levels") {
+    set_level(log_level::warning);
+
+    vector<string> messages;
+    on_message([&](log_level lvl, string const& msg) {
+        messages.push_back(msg);
+        return false;
+    });
+
+    SECTION("namespaces inherit the global level by default") {
+        LOG_DEBUG("debug message");
+        REQUIRE(messages.empty());
+        LOG_ERROR("error message");
+        REQUIRE(messages.size() == 1u);
+    }
+
+    SECTION("an override enables debug logging for one namespace") {
+        set_namespace_level(LOG_NAMESPACE, log_level::debug);
+        REQUIRE(LOG_IS_DEBUG_ENABLED());
+        LOG_DEBUG("debug message");
+        REQUIRE(messages.size() == 1u);
+        REQUIRE(messages[0] == "debug message");
+    }
+
+    SECTION("an override can also raise the level above the global one") {
+        set_namespace_level(LOG_NAMESPACE, log_level::error);
+        LOG_WARNING("warning message");
+        REQUIRE(messages.empty());
+        LOG_ERROR("error message");
+        REQUIRE(messages.size() == 1u);
+    }
+
+    SECTION("overrides on other namespaces have no effect") {
+        set_namespace_level("some.other.namespace", log_level::debug);
+        LOG_DEBUG("debug message");
+        REQUIRE(messages.empty());
+    }
+
+    SECTION("clearing overrides reverts to the global level") {
+        set_namespace_level(LOG_NAMESPACE, log_level::debug);
+        clear_namespace_levels();
+        REQUIRE_FALSE(LOG_IS_DEBUG_ENABLED());
+        LOG_DEBUG("debug message");
+        REQUIRE(messages.empty());
+    }
+
+    clear_namespace_levels();
+    on_message(nullptr);
+    set_level(log_level::none);
+    clear_error_logged_flag();
+}
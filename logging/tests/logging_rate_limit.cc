@@ -0,0 +1,62 @@
+#include <catch.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::logging;
+
+TEST_CASE("logging with per-call-site rate limiting") {
+    set_level(log_level::debug);
+
+    vector<string> messages;
+    on_message([&](log_level lvl, string const& msg) {
+        messages.push_back(msg);
+        return false;
+    });
+
+    SECTION("messages beyond the burst are dropped") {
+        set_rate_limit(0.001, 3);
+        for (int i = 0; i < 10; ++i) {
+            LOG_WARNING("repeated message");
+        }
+        REQUIRE(messages.size() == 3u);
+    }
+
+    SECTION("distinct call sites are limited independently") {
+        set_rate_limit(0.001, 1);
+        log("test", log_level::warning, 1, "first site");
+        log("test", log_level::warning, 2, "second site");
+        log("test", log_level::warning, 1, "first site again");
+        REQUIRE(messages.size() == 2u);
+    }
+
+    SECTION("a summary reports the suppressed count once tokens refill") {
+        set_rate_limit(50, 1);
+        for (int i = 0; i < 5; ++i) {
+            log("test", log_level::warning, 7, "repeated message");
+        }
+        REQUIRE(messages.size() == 1u);
+
+        this_thread::sleep_for(chrono::milliseconds(100));
+        log("test", log_level::warning, 7, "repeated message");
+        REQUIRE(messages.size() == 3u);
+        REQUIRE(messages[1].find("suppressed 4") != string::npos);
+        REQUIRE(messages[2] == "repeated message");
+    }
+
+    SECTION("passing zero turns rate limiting off") {
+        set_rate_limit(0, 0);
+        for (int i = 0; i < 10; ++i) {
+            LOG_WARNING("repeated message");
+        }
+        REQUIRE(messages.size() == 10u);
+    }
+
+    set_rate_limit(0, 0);
+    on_message(nullptr);
+    set_level(log_level::none);
+    clear_error_logged_flag();
+}
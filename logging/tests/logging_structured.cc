@@ -0,0 +1,47 @@
+#include <catch.hpp>
+#include <leatherman/logging/logging.hpp>
+#include <sstream>
+
+using namespace std;
+using namespace leatherman::logging;
+
+TEST_CASE("structured binary logging") {
+    ostringstream stream;
+    setup_structured_logging(stream);
+    set_level(log_level::debug);
+    clear_error_logged_flag();
+
+    SECTION("records round-trip through the decoder") {
+        log("test", log_level::info, 42, "value is {1}", 7);
+        istringstream in(stream.str());
+        ostringstream out;
+        REQUIRE(decode_structured_log(in, out) == 1u);
+        auto text = out.str();
+        REQUIRE(text.find("INFO") != string::npos);
+        REQUIRE(text.find("test:42") != string::npos);
+        REQUIRE(text.find("value is 7") != string::npos);
+    }
+
+    SECTION("multiple records decode in order") {
+        log("test", log_level::warning, 0, "first message");
+        log("test", log_level::error, 0, "second message");
+        istringstream in(stream.str());
+        ostringstream out;
+        REQUIRE(decode_structured_log(in, out) == 2u);
+        REQUIRE(out.str().find("first message") < out.str().find("second message"));
+    }
+
+    SECTION("a truncated record is reported") {
+        log("test", log_level::info, 0, "a message");
+        auto data = stream.str();
+        istringstream in(data.substr(0, data.size() - 1));
+        ostringstream out;
+        REQUIRE_THROWS_AS(decode_structured_log(in, out), runtime_error);
+    }
+
+    auto core = boost::log::core::get();
+    core->reset_filter();
+    core->remove_all_sinks();
+    set_level(log_level::none);
+    clear_error_logged_flag();
+}
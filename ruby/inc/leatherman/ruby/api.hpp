@@ -10,8 +10,11 @@
 #include <set>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <initializer_list>
 
+#include <boost/utility/string_ref.hpp>
 #include <leatherman/dynamic_library/dynamic_library.hpp>
 #ifndef _WIN32
     #include <sys/types.h>
@@ -128,6 +131,19 @@ namespace leatherman {  namespace ruby {
          */
         static api& instance();
 
+        /**
+         * Starts creating the Ruby API instance on a background thread.
+         * Library load and symbol resolution cost hundreds of
+         * milliseconds; calling this during process startup moves that
+         * cost off the first real Ruby call, which then finds the
+         * instance already constructed (or blocks until it is). The VM
+         * itself is not initialized - call initialize() at the usual
+         * stack frame. A failure to load the library is logged and
+         * deferred: instance() throws it again when actually called.
+         * Call after ruby_library_path, if used, has been set.
+         */
+        static void preload();
+
         /**
          * Called to initialize the API.
          * This should be done at the same stack frame where code is loaded into the Ruby VM.
@@ -472,6 +488,20 @@ namespace leatherman {  namespace ruby {
          */
         std::string to_string(VALUE v) const;
 
+        /**
+         * Returns a view of a Ruby string's bytes without copying.
+         * The view aliases the VM's buffer: it remains valid only while
+         * the value stays reachable by the garbage collector and no
+         * Ruby code runs that could modify the string - treat it as
+         * pinned for the duration of a C++ call frame, in the manner of
+         * rb_str_locktmp, and copy it out if it must live longer. The
+         * value must already be a String; unlike to_string, no to_s
+         * conversion or re-encoding is performed.
+         * @param v The Ruby String value to view.
+         * @return Returns a view of the string's bytes.
+         */
+        boost::string_ref to_string_view(VALUE v) const;
+
         /**
          * Converts the given string to a Ruby symbol.
          * @param s The string to convert to a symbol.
@@ -517,6 +547,38 @@ namespace leatherman {  namespace ruby {
          */
         VALUE protect(int& tag, std::function<VALUE()> callback) const;
 
+        /**
+         * Describes one method call for protect_all.
+         */
+        struct call_spec
+        {
+            /**
+             * The value receiving the call.
+             */
+            VALUE receiver;
+            /**
+             * The pre-interned method ID, from intern().
+             */
+            ID method;
+            /**
+             * The arguments to pass.
+             */
+            std::vector<VALUE> args;
+        };
+
+        /**
+         * Executes many method calls inside one protected frame.
+         * Exception-safe calls normally pay the rb_rescue2 setup per
+         * invocation; here a whole batch shares one frame, and only a
+         * call that raises costs an additional frame to resume the
+         * remainder. A failed call's result is nil and its message is
+         * captured at the matching index of errors.
+         * @param calls The calls to execute, in order.
+         * @param errors If not null, receives one entry per call: empty on success, the exception message otherwise.
+         * @return Returns each call's result, in order; nil for calls that raised.
+         */
+        std::vector<VALUE> protect_all(std::vector<call_spec> const& calls, std::vector<std::string>* errors = nullptr) const;
+
         /**
          * Enumerates an array.
          * @param array The array to enumerate.
@@ -643,6 +705,43 @@ namespace leatherman {  namespace ruby {
          */
         VALUE lookup(std::initializer_list<std::string> const& names) const;
 
+        /**
+         * Interns the given name, caching the resulting ID.
+         * rb_intern hashes inside the Ruby VM on every call; repeated
+         * interning of the same name becomes a lock-free cache probe.
+         * @param name The method or constant name to intern.
+         * @return Returns the interned ID.
+         */
+        ID intern(std::string const& name) const;
+
+        /**
+         * Calls a method using a pre-interned ID.
+         * @tparam TArgs The types of the method's arguments; each must be a VALUE.
+         * @param receiver The value receiving the call.
+         * @param method The pre-interned method ID, from intern().
+         * @param args The arguments to pass.
+         * @return Returns the method call's result.
+         */
+        template <typename... TArgs>
+        VALUE funcall(VALUE receiver, ID method, TArgs... args) const
+        {
+            return rb_funcall(receiver, method, static_cast<int>(sizeof...(TArgs)), args...);
+        }
+
+        /**
+         * Calls a method by name, interning through the ID cache.
+         * @tparam TArgs The types of the method's arguments; each must be a VALUE.
+         * @param receiver The value receiving the call.
+         * @param method The method's name.
+         * @param args The arguments to pass.
+         * @return Returns the method call's result.
+         */
+        template <typename... TArgs>
+        VALUE funcall(VALUE receiver, std::string const& method, TArgs... args) const
+        {
+            return funcall(receiver, intern(method), args...);
+        }
+
         /**
          * Determines if two values are equal.
          * @param first The first value to compare.
@@ -723,6 +822,11 @@ namespace leatherman {  namespace ruby {
 
         static std::set<VALUE> _data_objects;
 
+        // Interned IDs, keyed by name. Readers take an atomic snapshot;
+        // a miss interns the name and publishes a copied table.
+        mutable std::shared_ptr<std::unordered_map<std::string, ID>> _interned_ids;
+        mutable std::mutex _intern_mutex;
+
         // Represents object data
         // This definition comes from Ruby (unfortunately)
         struct RData
@@ -746,4 +850,108 @@ namespace leatherman {  namespace ruby {
         bool _include_stack_trace = false;
     };
 
+    /**
+     * Represents a Ruby script parsed once and re-executed many times.
+     * Compilation uses RubyVM::InstructionSequence, so repeated runs
+     * skip the parse and compile that api::eval pays on every call. On
+     * Ruby implementations without RubyVM, running falls back to
+     * evaluating the source each time.
+     */
+    class compiled_script
+    {
+     public:
+        /**
+         * Compiles the given code.
+         * @param ruby The Ruby API to compile with; must outlive the script.
+         * @param code The Ruby code to compile.
+         */
+        compiled_script(api& ruby, std::string code);
+
+        /**
+         * Releases the compiled form back to the garbage collector.
+         */
+        ~compiled_script();
+
+        /**
+         * Prevents the script from being copied.
+         */
+        compiled_script(compiled_script const&) = delete;
+
+        /**
+         * Prevents the script from being copied.
+         * @return Returns this script.
+         */
+        compiled_script& operator=(compiled_script const&) = delete;
+
+        /**
+         * Runs the script.
+         * Any exception raised is propagated as a C++ runtime_error.
+         * @return Returns the value of the script's last expression.
+         */
+        VALUE run() const;
+
+     private:
+        api& _ruby;
+        VALUE _compiled;
+        std::string _source;
+    };
+
+    /**
+     * Keeps many Ruby values alive through a single garbage collector
+     * root. Registering each C++-held VALUE individually with
+     * rb_gc_register_address bloats the VM's root list, and every root
+     * is walked on every mark phase; a pool instead registers one Ruby
+     * array and keeps the values reachable through it, so thousands of
+     * live values cost the collector one root. Values share the pool's
+     * lifetime and are released in bulk by clear() or destruction.
+     */
+    class value_pool
+    {
+     public:
+        /**
+         * Constructs a pool.
+         * @param ruby The Ruby API to pool values with; must outlive the pool.
+         */
+        explicit value_pool(api& ruby);
+
+        /**
+         * Releases all pooled values back to the garbage collector.
+         */
+        ~value_pool();
+
+        /**
+         * Prevents the pool from being copied.
+         */
+        value_pool(value_pool const&) = delete;
+
+        /**
+         * Prevents the pool from being copied.
+         * @return Returns this pool.
+         */
+        value_pool& operator=(value_pool const&) = delete;
+
+        /**
+         * Keeps the given value alive for the pool's lifetime.
+         * @param value The value to protect.
+         * @return Returns the protected value, for chaining.
+         */
+        VALUE protect(VALUE value);
+
+        /**
+         * @return Returns the number of values the pool keeps alive.
+         */
+        std::size_t size() const;
+
+        /**
+         * Releases all pooled values in one step; the pool can be
+         * reused afterwards.
+         */
+        void clear();
+
+     private:
+        api& _ruby;
+        VALUE _values;
+        std::size_t _count;
+    };
+
 }}  // namespace leatherman::ruby
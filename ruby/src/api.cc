@@ -7,6 +7,7 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <sstream>
+#include <thread>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -115,10 +116,29 @@ namespace leatherman { namespace ruby {
         LOAD_SYMBOL(ruby_sysinit),
         LOAD_SYMBOL(ruby_options),
         LOAD_SYMBOL(ruby_cleanup),
+        _interned_ids(make_shared<unordered_map<string, ID>>()),
         _library(move(library))
     {
     }
 
+    ID api::intern(string const& name) const
+    {
+        {
+            auto snapshot = atomic_load(&_interned_ids);
+            auto it = snapshot->find(name);
+            if (it != snapshot->end()) {
+                return it->second;
+            }
+        }
+
+        auto id = rb_intern(name.c_str());
+        lock_guard<mutex> lock(_intern_mutex);
+        auto updated = make_shared<unordered_map<string, ID>>(*atomic_load(&_interned_ids));
+        updated->emplace(name, id);
+        atomic_store(&_interned_ids, std::move(updated));
+        return id;
+    }
+
     api::~api()
     {
         uninitialize();
@@ -130,6 +150,22 @@ namespace leatherman { namespace ruby {
         return instance;
     }
 
+    void api::preload()
+    {
+        // instance()'s function-local static is thread safe, so the
+        // background construction and a concurrent first real call
+        // cannot race: whichever starts first constructs, the other
+        // blocks until it is done.
+        thread([]() {
+            try {
+                instance();
+            } catch (exception const& ex) {
+                // Deferred: instance() throws again when actually called.
+                LOG_DEBUG("ruby preload failed: {1}.", ex.what());
+            }
+        }).detach();
+    }
+
     lth_lib::dynamic_library api::create()
     {
         lth_lib::dynamic_library library = find_library();
@@ -265,14 +301,24 @@ namespace leatherman { namespace ruby {
 
     string api::to_string(VALUE v) const
     {
-        v = rb_funcall(v, rb_intern("to_s"), 0);
+        v = rb_funcall(v, intern("to_s"), 0);
         v = rb_str_encode(v, utf8_value("UTF-8"), 0, _nil);
-        return string(rb_string_value_ptr(&v), num2size_t(rb_funcall(v, rb_intern("bytesize"), 0)));
+        return string(rb_string_value_ptr(&v), num2size_t(rb_funcall(v, intern("bytesize"), 0)));
+    }
+
+    boost::string_ref api::to_string_view(VALUE v) const
+    {
+        if (!is_string(v)) {
+            throw invalid_conversion(_("expected a String value"));
+        }
+        auto data = rb_string_value_ptr(&v);
+        auto size = num2size_t(rb_funcall(v, intern("bytesize"), 0));
+        return boost::string_ref(data, size);
     }
 
     VALUE api::to_symbol(string const& s) const
     {
-        return rb_funcall(utf8_value(s), rb_intern("to_sym"), 0);
+        return rb_funcall(utf8_value(s), intern("to_sym"), 0);
     }
 
     VALUE api::utf8_value(char const* s, size_t len) const
@@ -309,6 +355,45 @@ namespace leatherman { namespace ruby {
             &tag);
     }
 
+    vector<VALUE> api::protect_all(vector<call_spec> const& calls, vector<string>* errors) const
+    {
+        vector<VALUE> results(calls.size(), _nil);
+        if (errors) {
+            errors->assign(calls.size(), string());
+        }
+
+        size_t index = 0;
+        while (index < calls.size()) {
+            bool raised = false;
+            string error;
+            rescue(
+                [&]() {
+                    for (; index < calls.size(); ++index) {
+                        auto const& call = calls[index];
+                        results[index] = rb_funcallv(call.receiver, call.method,
+                                                     static_cast<int>(call.args.size()), call.args.data());
+                    }
+                    return _nil;
+                },
+                [&](VALUE exc) {
+                    raised = true;
+                    error = exception_to_string(exc);
+                    return _nil;
+                });
+
+            if (!raised) {
+                break;
+            }
+            // The call at index raised; record it and resume with the rest.
+            results[index] = _nil;
+            if (errors) {
+                (*errors)[index] = move(error);
+            }
+            ++index;
+        }
+        return results;
+    }
+
     VALUE api::callback_thunk(VALUE parameter)
     {
         auto callback = reinterpret_cast<function<VALUE()>*>(parameter);
@@ -357,7 +442,7 @@ namespace leatherman { namespace ruby {
             result << "\nbacktrace:\n";
 
             // Append ex.backtrace.join('\n')
-            result << to_string(rb_funcall(rb_funcall(ex, rb_intern("backtrace"), 0), rb_intern("join"), 1, utf8_value("\n")));
+            result << to_string(rb_funcall(rb_funcall(ex, intern("backtrace"), 0), intern("join"), 1, utf8_value("\n")));
         }
 
         return result.str();
@@ -365,7 +450,7 @@ namespace leatherman { namespace ruby {
 
     bool api::is_a(VALUE value, VALUE klass) const
     {
-        return rb_funcall(value, rb_intern("is_a?"), 1, klass) != 0;
+        return rb_funcall(value, intern("is_a?"), 1, klass) != 0;
     }
 
     bool api::is_nil(VALUE value) const
@@ -432,7 +517,7 @@ namespace leatherman { namespace ruby {
     {
         // This is used for rb_ary_entry, which only accepts a 'long'. So we only expect to
         // encounter long values here.
-        auto size = rb_num2ull(rb_funcall(array, rb_intern("size"), 0));
+        auto size = rb_num2ull(rb_funcall(array, intern("size"), 0));
         if (size > numeric_limits<long>::max()) {
             throw invalid_conversion(_("maximum array size exceeded, reported size was {1}", to_string(size)));
         }
@@ -444,19 +529,19 @@ namespace leatherman { namespace ruby {
         volatile VALUE current = *rb_cObject;
 
         for (auto const& name : names) {
-            current = rb_const_get(current, rb_intern(name.c_str()));
+            current = rb_const_get(current, intern(name));
         }
         return current;
     }
 
     bool api::equals(VALUE first, VALUE second) const
     {
-        return is_true(rb_funcall(first, rb_intern("eql?"), 1, second));
+        return is_true(rb_funcall(first, intern("eql?"), 1, second));
     }
 
     bool api::case_equals(VALUE first, VALUE second) const
     {
-        return is_true(rb_funcall(first, rb_intern("==="), 1, second));
+        return is_true(rb_funcall(first, intern("==="), 1, second));
     }
 
     VALUE api::eval(const string& code)
@@ -478,6 +563,89 @@ namespace leatherman { namespace ruby {
         return result;
     }
 
+    compiled_script::compiled_script(api& ruby, string code) :
+        _ruby(ruby), _compiled(ruby.nil_value()), _source(move(code))
+    {
+        // Compile through RubyVM::InstructionSequence when the
+        // implementation provides it; any failure - a missing RubyVM or
+        // a syntax error - leaves the script in source form, and run()
+        // surfaces the error the same way api::eval would.
+        auto compiled = _ruby.rescue(
+                [&]() {
+                    auto iseq = _ruby.lookup({"RubyVM", "InstructionSequence"});
+                    return _ruby.funcall(iseq, "compile", _ruby.utf8_value(_source));
+                },
+                [&](VALUE) {
+                    return _ruby.nil_value();
+                });
+
+        if (!_ruby.is_nil(compiled)) {
+            _compiled = compiled;
+            _ruby.rb_gc_register_address(&_compiled);
+        }
+    }
+
+    compiled_script::~compiled_script()
+    {
+        if (!_ruby.is_nil(_compiled)) {
+            _ruby.rb_gc_unregister_address(&_compiled);
+        }
+    }
+
+    VALUE compiled_script::run() const
+    {
+        if (_ruby.is_nil(_compiled)) {
+            return _ruby.eval(_source);
+        }
+
+        string exception;
+        VALUE result = _ruby.rescue(
+                [&]() {
+                    return _ruby.funcall(_compiled, "eval");
+                },
+                [&](VALUE exc) {
+                    exception = _ruby.exception_to_string(exc);
+                    return _ruby.nil_value();
+                });
+
+        if (!exception.empty()) {
+            throw runtime_error(exception);
+        }
+        return result;
+    }
+
+    value_pool::value_pool(api& ruby) :
+        _ruby(ruby), _count(0)
+    {
+        // The array is the pool's only registered root; everything
+        // protected stays reachable through it.
+        _values = _ruby.rb_ary_new_capa(0);
+        _ruby.rb_gc_register_address(&_values);
+    }
+
+    value_pool::~value_pool()
+    {
+        _ruby.rb_gc_unregister_address(&_values);
+    }
+
+    VALUE value_pool::protect(VALUE value)
+    {
+        _ruby.rb_ary_push(_values, value);
+        ++_count;
+        return value;
+    }
+
+    size_t value_pool::size() const
+    {
+        return _count;
+    }
+
+    void value_pool::clear()
+    {
+        _ruby.funcall(_values, "clear");
+        _count = 0;
+    }
+
     lth_lib::dynamic_library api::find_library() {
         // First search for an already loaded Ruby.
         auto library = find_loaded_library();
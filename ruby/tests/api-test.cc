@@ -5,6 +5,54 @@
 using namespace std;
 using namespace leatherman::ruby;
 
+TEST_CASE("api::preload", "[ruby-api]") {
+    SECTION("a first call after preloading finds the instance usable") {
+        api::preload();
+        auto& ruby = api::instance();
+        ruby.initialize();
+        REQUIRE(ruby.initialized());
+    }
+}
+
+TEST_CASE("value_pool", "[ruby-api]") {
+    auto& ruby = api::instance();
+    ruby.initialize();
+    REQUIRE(ruby.initialized());
+
+    SECTION("pooled values survive a garbage collection") {
+        value_pool pool { ruby };
+        auto value = pool.protect(ruby.eval("'pooled' + ' value'"));
+        REQUIRE(pool.size() == 1u);
+
+        ruby.eval("GC.start");
+        REQUIRE(ruby.to_string(value) == "pooled value");
+    }
+
+    SECTION("many values cost the pool a single root") {
+        value_pool pool { ruby };
+        vector<VALUE> values;
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(pool.protect(ruby.eval("'value " + to_string(i) + "'")));
+        }
+        REQUIRE(pool.size() == 100u);
+
+        ruby.eval("GC.start");
+        REQUIRE(ruby.to_string(values[0]) == "value 0");
+        REQUIRE(ruby.to_string(values[99]) == "value 99");
+    }
+
+    SECTION("clearing releases everything and the pool is reusable") {
+        value_pool pool { ruby };
+        pool.protect(ruby.eval("'discarded'"));
+        pool.clear();
+        REQUIRE(pool.size() == 0u);
+
+        auto value = pool.protect(ruby.eval("'kept'"));
+        ruby.eval("GC.start");
+        REQUIRE(ruby.to_string(value) == "kept");
+    }
+}
+
 TEST_CASE("api::eval", "[ruby-api]") {
     SECTION("can load api and evaluate ruby code") {
         auto& ruby = api::instance();
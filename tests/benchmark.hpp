@@ -0,0 +1,114 @@
+/**
+ * @file
+ * Declares the registry and measurement helpers the benchmark
+ * executable runs from. Benchmark sources define entries with
+ * LEATHERMAN_BENCHMARK(name) and are linked into the single
+ * leatherman_benchmarks binary, which runs every registered benchmark
+ * or just the ones named on its command line. Passing --json emits
+ * one JSON object per reported result instead of the table, so runs
+ * can be archived and compared mechanically.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace leatherman { namespace benchmark {
+
+    /**
+     * @return Returns the registered benchmarks, keyed by name.
+     */
+    std::map<std::string, std::function<void()>>& registry();
+
+    /**
+     * The summarized timing of a benchmarked operation.
+     */
+    struct timing
+    {
+        /**
+         * The number of operations completed per second of wall time.
+         */
+        double per_sec;
+
+        /**
+         * The 99th percentile of per-operation latency, in microseconds.
+         */
+        double p99_usec;
+    };
+
+    /**
+     * Summarizes raw per-operation latencies into a timing.
+     * @param samples_ns The per-operation latencies, in nanoseconds. Reordered in place.
+     * @param elapsed_sec The wall time the operations took, in seconds.
+     * @return Returns the summarized timing.
+     */
+    timing summarize(std::vector<std::uint64_t>& samples_ns, double elapsed_sec);
+
+    /**
+     * Times a callable with a warmup pass for stable results.
+     * The warmup iterations populate caches and branch predictors and
+     * are discarded; only the measured iterations are summarized.
+     * @param warmup The number of unmeasured warmup iterations.
+     * @param iterations The number of measured iterations.
+     * @param operation The operation to time.
+     * @return Returns the summarized timing.
+     */
+    template <typename Callable>
+    timing measure(std::size_t warmup, std::size_t iterations, Callable operation)
+    {
+        for (std::size_t i = 0; i < warmup; ++i) {
+            operation();
+        }
+
+        std::vector<std::uint64_t> samples;
+        samples.reserve(iterations);
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto before = std::chrono::steady_clock::now();
+            operation();
+            auto after = std::chrono::steady_clock::now();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count());
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return summarize(samples, elapsed);
+    }
+
+    /**
+     * Reports one benchmark result, as a table line or as JSON when
+     * the executable was started with --json.
+     * @param name The name of the measured case within the benchmark.
+     * @param threads The number of threads the case ran with.
+     * @param t The summarized timing of the case.
+     */
+    void report(std::string const& name, std::size_t threads, timing const& t);
+
+    /**
+     * Registers a benchmark at static initialization time.
+     */
+    struct registration
+    {
+        /**
+         * Registers the given benchmark.
+         * @param name The benchmark's name, matched against command line arguments.
+         * @param benchmark The function that runs the benchmark.
+         */
+        registration(std::string name, std::function<void()> benchmark)
+        {
+            registry().emplace(std::move(name), std::move(benchmark));
+        }
+    };
+
+}}  // namespace leatherman::benchmark
+
+/**
+ * Defines and registers a benchmark function.
+ * @param name The benchmark's name.
+ */
+#define LEATHERMAN_BENCHMARK(name) \
+    static void benchmark_##name(); \
+    static leatherman::benchmark::registration benchmark_##name##_registration(#name, &benchmark_##name); \
+    static void benchmark_##name()
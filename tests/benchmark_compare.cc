@@ -0,0 +1,173 @@
+/**
+ * @file
+ * Compares two benchmark JSON outputs and exits nonzero when a case
+ * regresses beyond its threshold, so "no perf regressions" can be
+ * wired into release gates:
+ *
+ *     leatherman_benchmarks --json > baseline.json   (repeat for stability)
+ *     leatherman_benchmarks --json > current.json
+ *     leatherman_benchmark_compare baseline.json current.json \
+ *         [--threshold PCT] [--threshold BENCHMARK=PCT]...
+ *
+ * Each file may contain several appended runs; repeated entries for a
+ * case are aggregated to their median, and a slowdown only counts as
+ * a regression when it exceeds both the threshold and the run-to-run
+ * spread observed for that case, so noisy cases do not fail gates.
+ */
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+    struct samples
+    {
+        vector<double> per_sec;
+    };
+
+    // Extracts a field from one line of the benchmark --json output.
+    // The format is our own and regular, so no JSON library is needed.
+    bool extract(string const& line, string const& key, string& value)
+    {
+        auto marker = "\"" + key + "\":";
+        auto start = line.find(marker);
+        if (start == string::npos) {
+            return false;
+        }
+        start += marker.size();
+        bool quoted = line[start] == '"';
+        if (quoted) {
+            ++start;
+        }
+        auto end = line.find_first_of(quoted ? "\"" : ",}", start);
+        if (end == string::npos) {
+            return false;
+        }
+        value = line.substr(start, end - start);
+        return true;
+    }
+
+    bool load(string const& path, map<string, samples>& results)
+    {
+        ifstream in(path.c_str());
+        if (!in) {
+            cerr << "failed to open " << path << endl;
+            return false;
+        }
+        string line;
+        while (getline(in, line)) {
+            string benchmark, name, threads, per_sec;
+            if (!extract(line, "benchmark", benchmark) ||
+                !extract(line, "case", name) ||
+                !extract(line, "threads", threads) ||
+                !extract(line, "per_sec", per_sec)) {
+                continue;
+            }
+            auto key = benchmark + " / " + name + " @" + threads;
+            results[key].per_sec.push_back(strtod(per_sec.c_str(), nullptr));
+        }
+        return true;
+    }
+
+    double median(vector<double> values)
+    {
+        auto middle = values.begin() + values.size() / 2;
+        nth_element(values.begin(), middle, values.end());
+        return *middle;
+    }
+
+    // The relative run-to-run spread of a case, used as its noise
+    // floor; a single run has no observable spread.
+    double spread(vector<double> const& values)
+    {
+        if (values.size() < 2) {
+            return 0.0;
+        }
+        auto bounds = minmax_element(values.begin(), values.end());
+        return (*bounds.second - *bounds.first) / *bounds.second;
+    }
+
+    double threshold_for(string const& key, map<string, double> const& thresholds, double fallback)
+    {
+        for (auto const& entry : thresholds) {
+            if (key.compare(0, entry.first.size(), entry.first) == 0) {
+                return entry.second;
+            }
+        }
+        return fallback;
+    }
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    vector<string> files;
+    map<string, double> thresholds;
+    double default_threshold = 0.10;
+
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--threshold" && i + 1 < argc) {
+            string value = argv[++i];
+            auto equals = value.find('=');
+            if (equals == string::npos) {
+                default_threshold = strtod(value.c_str(), nullptr) / 100.0;
+            } else {
+                thresholds[value.substr(0, equals)] = strtod(value.c_str() + equals + 1, nullptr) / 100.0;
+            }
+        } else {
+            files.push_back(argument);
+        }
+    }
+
+    if (files.size() != 2) {
+        cerr << "usage: leatherman_benchmark_compare <baseline.json> <current.json>"
+                " [--threshold PCT] [--threshold BENCHMARK=PCT]..." << endl;
+        return 2;
+    }
+
+    map<string, samples> baseline, current;
+    if (!load(files[0], baseline) || !load(files[1], current)) {
+        return 2;
+    }
+
+    int regressions = 0;
+    for (auto const& entry : current) {
+        auto base = baseline.find(entry.first);
+        if (base == baseline.end()) {
+            cout << "NEW        " << entry.first << endl;
+            continue;
+        }
+
+        auto before = median(base->second.per_sec);
+        auto after = median(entry.second.per_sec);
+        auto change = (after - before) / before;
+        auto noise = max(spread(base->second.per_sec), spread(entry.second.per_sec));
+        auto threshold = threshold_for(entry.first, thresholds, default_threshold);
+
+        bool regressed = change < 0 && -change > threshold && -change > noise;
+        cout << (regressed ? "REGRESSED  " : (change > threshold ? "IMPROVED   " : "OK         "))
+             << entry.first
+             << fixed << setprecision(1)
+             << "  " << before << " -> " << after << " /sec"
+             << " (" << showpos << change * 100 << noshowpos << "%)" << endl;
+        if (regressed) {
+            ++regressions;
+        }
+    }
+
+    for (auto const& entry : baseline) {
+        if (current.find(entry.first) == current.end()) {
+            cout << "MISSING    " << entry.first << endl;
+        }
+    }
+
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+namespace leatherman { namespace benchmark {
+
+    // The benchmark being run and the output mode, set by main before
+    // benchmarks are invoked and read by report().
+    static string g_benchmark;
+    static bool g_json = false;
+
+    map<string, function<void()>>& registry()
+    {
+        static map<string, function<void()>> benchmarks;
+        return benchmarks;
+    }
+
+    timing summarize(vector<uint64_t>& samples_ns, double elapsed_sec)
+    {
+        timing t;
+        t.per_sec = elapsed_sec > 0 ? samples_ns.size() / elapsed_sec : 0;
+        auto p99 = samples_ns.begin() + (samples_ns.size() * 99) / 100;
+        if (p99 == samples_ns.end()) {
+            --p99;
+        }
+        nth_element(samples_ns.begin(), p99, samples_ns.end());
+        t.p99_usec = *p99 / 1000.0;
+        return t;
+    }
+
+    void report(string const& name, size_t threads, timing const& t)
+    {
+        if (g_json) {
+            cout << "{\"benchmark\":\"" << g_benchmark << "\""
+                 << ",\"case\":\"" << name << "\""
+                 << ",\"threads\":" << threads
+                 << ",\"per_sec\":" << fixed << setprecision(0) << t.per_sec
+                 << ",\"p99_usec\":" << setprecision(3) << t.p99_usec
+                 << "}" << endl;
+            return;
+        }
+        cout << left << setw(24) << name
+             << right << setw(8) << threads << " threads"
+             << setw(16) << fixed << setprecision(0) << t.per_sec << " /sec"
+             << setw(12) << setprecision(2) << t.p99_usec << " us p99" << endl;
+    }
+
+}}  // namespace leatherman::benchmark
+
+int main(int argc, char** argv)
+{
+    namespace bench = leatherman::benchmark;
+
+    vector<string> names;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--json") {
+            bench::g_json = true;
+        } else {
+            names.emplace_back(argv[i]);
+        }
+    }
+
+    auto& benchmarks = bench::registry();
+    auto run = [&](pair<string const, function<void()>> const& benchmark) {
+        if (!bench::g_json) {
+            cout << "== " << benchmark.first << " ==" << endl;
+        }
+        bench::g_benchmark = benchmark.first;
+        benchmark.second();
+    };
+
+    if (!names.empty()) {
+        for (auto const& name : names) {
+            auto it = benchmarks.find(name);
+            if (it == benchmarks.end()) {
+                cerr << "unknown benchmark: " << name << endl;
+                return 1;
+            }
+            run(*it);
+        }
+        return 0;
+    }
+
+    for (auto const& benchmark : benchmarks) {
+        run(benchmark);
+    }
+    return 0;
+}
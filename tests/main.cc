@@ -1,6 +1,21 @@
+#include <csignal>
+
+// glibc 2.34 turned SIGSTKSZ into a sysconf() call, but the vendored
+// Catch uses it as an array bound; pin it back to a constant here.
+#if defined(__linux__) && defined(SIGSTKSZ)
+#  undef SIGSTKSZ
+#  define SIGSTKSZ 32768
+#endif
+
 #define CATCH_CONFIG_RUNNER
 #include <catch.hpp>
 
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <string>
+
 // To enable log messages:
 // #define ENABLE_LOGGING
 
@@ -8,6 +23,82 @@
 #include <leatherman/logging/logging.hpp>
 #endif
 
+namespace {
+
+    // Escapes a test or section name for embedding in a JSON string.
+    std::string json_escape(std::string const& text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (auto c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if (c == '\n') {
+                escaped += "\\n";
+            } else if (c == '\t') {
+                escaped += "\\t";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    // Records wall time per test case and per section. When the
+    // LEATHERMAN_TEST_TIMING environment variable names a file, one
+    // JSON object per entry is written there at the end of the run,
+    // in the line format emitted by the benchmark harness, so timing
+    // reports can be compared against a baseline with
+    // leatherman_benchmark_compare to catch test-time regressions. A
+    // test case that runs several times (once per leaf section) is
+    // accounted at its total cost.
+    struct timing_listener : Catch::TestEventListenerBase {
+        timing_listener(Catch::ReporterConfig const& config)
+                : TestEventListenerBase(config) {}
+
+        virtual void sectionEnded(Catch::SectionStats const& stats) CATCH_OVERRIDE {
+            // The base class section stack still holds the ending
+            // section; its front entry is the test case itself.
+            std::string path;
+            for (auto const& section : m_sectionStack) {
+                if (!path.empty()) {
+                    path += " / ";
+                }
+                path += section.name;
+            }
+            durations_[path] += stats.durationInSeconds;
+            TestEventListenerBase::sectionEnded(stats);
+        }
+
+        virtual void testRunEnded(Catch::TestRunStats const& stats) CATCH_OVERRIDE {
+            TestEventListenerBase::testRunEnded(stats);
+            auto target = std::getenv("LEATHERMAN_TEST_TIMING");
+            if (!target) {
+                return;
+            }
+            std::ofstream out { target };
+            for (auto const& entry : durations_) {
+                // Durations are inverted into rates so that a slower
+                // test reads as a lower rate, which the comparison
+                // tool reports as a regression.
+                auto seconds = entry.second > 0 ? entry.second : 1e-9;
+                out << "{\"benchmark\":\"tests\""
+                    << ",\"case\":\"" << json_escape(entry.first) << "\""
+                    << ",\"threads\":1"
+                    << ",\"per_sec\":" << std::fixed << std::setprecision(3) << 1.0 / seconds
+                    << ",\"p99_usec\":" << std::setprecision(3) << entry.second * 1e6
+                    << "}\n";
+            }
+        }
+
+        std::map<std::string, double> durations_;
+    };
+
+}  // namespace
+
+CATCH_REGISTER_LISTENER(timing_listener)
+
 int main(int argc, char **argv)
 {
 #ifdef ENABLE_LOGGING
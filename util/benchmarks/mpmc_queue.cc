@@ -0,0 +1,105 @@
+/**
+ * @file
+ * Measures mpmc_queue throughput against a mutex-guarded deque.
+ * Run by hand when measuring a change to the queue; each configuration
+ * is reported as ops/sec across several producer/consumer counts.
+ */
+#include <leatherman/util/mpmc_queue.hpp>
+#include <benchmark.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::util;
+
+namespace {
+
+    const size_t items_per_producer = 200000;
+
+    // The baseline the queue is meant to replace.
+    struct locked_queue
+    {
+        void push(uint64_t value)
+        {
+            {
+                lock_guard<mutex> lock(_mutex);
+                _items.push_back(value);
+            }
+            _cv.notify_one();
+        }
+
+        void pop(uint64_t& value)
+        {
+            unique_lock<mutex> lock(_mutex);
+            _cv.wait(lock, [this]() { return !_items.empty(); });
+            value = _items.front();
+            _items.pop_front();
+        }
+
+        mutex _mutex;
+        condition_variable _cv;
+        deque<uint64_t> _items;
+    };
+
+    template <typename Queue>
+    double run(Queue& queue, size_t producers, size_t consumers)
+    {
+        auto total = producers * items_per_producer;
+        atomic<size_t> consumed {0};
+        vector<thread> threads;
+        auto start = chrono::steady_clock::now();
+
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&]() {
+                for (size_t i = 0; i < items_per_producer; ++i) {
+                    queue.push(i);
+                }
+            });
+        }
+        for (size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&]() {
+                uint64_t value;
+                while (consumed.fetch_add(1) < total) {
+                    queue.pop(value);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return total / elapsed;
+    }
+
+    template <typename Queue>
+    void report(string const& name, Queue& queue, size_t producers, size_t consumers)
+    {
+        auto ops = run(queue, producers, consumers);
+        cout << left << setw(16) << name
+             << right << setw(4) << producers << "p/" << consumers << "c"
+             << setw(16) << fixed << setprecision(0) << ops << " ops/sec" << endl;
+    }
+
+}  // namespace
+
+LEATHERMAN_BENCHMARK(mpmc_queue)
+{
+    const vector<pair<size_t, size_t>> shapes = {{1, 1}, {2, 2}, {4, 4}};
+
+    for (auto const& shape : shapes) {
+        mpmc_queue<uint64_t> queue(4096);
+        report("mpmc_queue", queue, shape.first, shape.second);
+    }
+    for (auto const& shape : shapes) {
+        locked_queue queue;
+        report("mutex+deque", queue, shape.first, shape.second);
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file
+ * Measures the utility primitives that sit under every other
+ * component's hot path: UUID generation, line splitting, URI parsing,
+ * option_set operations, environment search path lookup and timer
+ * overhead. Run by hand when measuring a change to these helpers.
+ */
+#include <leatherman/util/environment.hpp>
+#include <leatherman/util/option_set.hpp>
+#include <leatherman/util/strings.hpp>
+#include <leatherman/util/timer.hpp>
+#include <leatherman/util/uri.hpp>
+#include <benchmark.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace leatherman::util;
+
+namespace {
+
+    enum class sample_options
+    {
+        first = (1 << 0),
+        second = (1 << 1),
+        third = (1 << 2),
+    };
+
+    const size_t warmup = 1000;
+    const size_t iterations = 50000;
+
+    string lines_corpus()
+    {
+        string corpus;
+        for (int i = 0; i < 100; ++i) {
+            corpus += "line of child process output number " + to_string(i) + "\n";
+        }
+        return corpus;
+    }
+
+}  // namespace
+
+LEATHERMAN_BENCHMARK(util)
+{
+    auto uuid = leatherman::benchmark::measure(warmup, iterations / 10, []() {
+        get_UUID();
+    });
+    leatherman::benchmark::report("get_UUID", 1, uuid);
+
+    auto corpus = lines_corpus();
+    auto lines = leatherman::benchmark::measure(warmup, iterations / 10, [&]() {
+        size_t count = 0;
+        each_line(corpus, [&](string&) {
+            ++count;
+            return true;
+        });
+    });
+    leatherman::benchmark::report("each_line 100 lines", 1, lines);
+
+    auto views = leatherman::benchmark::measure(warmup, iterations / 10, [&]() {
+        size_t count = 0;
+        each_line_view(corpus, [&](boost::string_ref) {
+            ++count;
+            return true;
+        });
+    });
+    leatherman::benchmark::report("each_line_view 100 lines", 1, views);
+
+    auto parse_uri = leatherman::benchmark::measure(warmup, iterations, []() {
+        uri parsed { "https://user@example.com:8140/puppet/v3/catalog?environment=production" };
+    });
+    leatherman::benchmark::report("uri parse", 1, parse_uri);
+
+    auto options = leatherman::benchmark::measure(warmup, iterations, []() {
+        option_set<sample_options> set = { sample_options::first, sample_options::third };
+        set.set(sample_options::second);
+        bool checked = set[sample_options::first] && set[sample_options::second];
+        static_cast<void>(checked);
+    });
+    leatherman::benchmark::report("option_set ops", 1, options);
+
+    auto paths = leatherman::benchmark::measure(warmup, iterations, []() {
+        environment::search_paths();
+    });
+    leatherman::benchmark::report("search_paths", 1, paths);
+
+    auto timing = leatherman::benchmark::measure(warmup, iterations, []() {
+        Timer timer;
+        timer.elapsed_seconds();
+    });
+    leatherman::benchmark::report("timer overhead", 1, timing);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file
+ * Declares a monotonic arena allocator.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace leatherman { namespace util {
+
+    /**
+     * A monotonic bump-pointer allocator for request-scoped memory.
+     * Allocations advance a pointer through progressively larger
+     * blocks and are never freed individually; reset() releases
+     * everything at once while keeping the largest block, so a reused
+     * arena stops touching malloc entirely in the steady state. Not
+     * thread safe; use one arena per operation or thread.
+     */
+    class arena
+    {
+     public:
+        /**
+         * Constructs an arena.
+         * @param initial_size The size of the first block in bytes.
+         */
+        explicit arena(std::size_t initial_size = 4096) :
+            _next_size(initial_size == 0 ? 4096 : initial_size)
+        {
+        }
+
+        /**
+         * Arenas cannot be copied; handed-out pointers tie memory to
+         * this instance.
+         */
+        arena(arena const&) = delete;
+
+        /**
+         * Arenas cannot be assigned.
+         * @return Returns this arena.
+         */
+        arena& operator=(arena const&) = delete;
+
+        /**
+         * Allocates uninitialized memory from the arena.
+         * @param bytes The number of bytes to allocate.
+         * @param alignment The required alignment; must be a power of two.
+         * @return Returns a pointer to the allocated memory, valid until reset or destruction.
+         */
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(long double))
+        {
+            if (!_blocks.empty()) {
+                auto& current = _blocks.back();
+                auto offset = align_up(current.used, alignment);
+                if (offset + bytes <= current.size) {
+                    current.used = offset + bytes;
+                    return current.data.get() + offset;
+                }
+            }
+
+            // Grow geometrically so a long-lived arena settles into a
+            // handful of blocks.
+            auto size = _next_size;
+            while (size < bytes + alignment) {
+                size *= 2;
+            }
+            _next_size = size * 2;
+            _blocks.emplace_back(size);
+            auto& fresh = _blocks.back();
+            auto offset = align_up(0, alignment);
+            fresh.used = offset + bytes;
+            return fresh.data.get() + offset;
+        }
+
+        /**
+         * Releases every allocation at once.
+         * The largest block is kept for reuse, so resetting between
+         * operations amortizes away further allocation.
+         */
+        void reset()
+        {
+            if (_blocks.empty()) {
+                return;
+            }
+            auto largest = _blocks.begin();
+            for (auto it = _blocks.begin(); it != _blocks.end(); ++it) {
+                if (it->size > largest->size) {
+                    largest = it;
+                }
+            }
+            block kept = std::move(*largest);
+            kept.used = 0;
+            _blocks.clear();
+            _blocks.emplace_back(std::move(kept));
+        }
+
+        /**
+         * @return Returns the number of bytes currently allocated from the arena.
+         */
+        std::size_t bytes_allocated() const
+        {
+            std::size_t total = 0;
+            for (auto const& current : _blocks) {
+                total += current.used;
+            }
+            return total;
+        }
+
+     private:
+        struct block
+        {
+            explicit block(std::size_t block_size) :
+                data(new char[block_size]), size(block_size), used(0)
+            {
+            }
+
+            block(block&&) = default;
+            block& operator=(block&&) = default;
+
+            std::unique_ptr<char[]> data;
+            std::size_t size;
+            std::size_t used;
+        };
+
+        static std::size_t align_up(std::size_t offset, std::size_t alignment)
+        {
+            return (offset + alignment - 1) & ~(alignment - 1);
+        }
+
+        std::vector<block> _blocks;
+        std::size_t _next_size;
+    };
+
+    /**
+     * A std-compatible allocator drawing from an arena.
+     * deallocate is a no-op - memory is reclaimed wholesale by the
+     * arena's reset - so containers built with this allocator must not
+     * outlive the arena.
+     * @tparam T The type of the allocated elements.
+     */
+    template <typename T>
+    class arena_allocator
+    {
+     public:
+        /**
+         * The type of the allocated elements.
+         */
+        typedef T value_type;
+
+        /**
+         * Rebinds the allocator to another element type.
+         * @tparam U The other element type.
+         */
+        template <typename U>
+        struct rebind
+        {
+            /**
+             * The rebound allocator type.
+             */
+            typedef arena_allocator<U> other;
+        };
+
+        /**
+         * Constructs an allocator drawing from the given arena.
+         * @param backing The arena to allocate from; must outlive every container using the allocator.
+         */
+        explicit arena_allocator(arena& backing) : _arena(&backing)
+        {
+        }
+
+        /**
+         * Converts from an allocator of another element type.
+         * @tparam U The other element type.
+         * @param other The allocator to convert from.
+         */
+        template <typename U>
+        arena_allocator(arena_allocator<U> const& other) : _arena(other._arena)
+        {
+        }
+
+        /**
+         * Allocates storage for the given number of elements.
+         * @param count The number of elements.
+         * @return Returns the allocated storage.
+         */
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        /**
+         * Does nothing; the memory is reclaimed by the arena's reset.
+         */
+        void deallocate(T*, std::size_t)
+        {
+        }
+
+        /**
+         * @param other The allocator to compare against.
+         * @return Returns true if both allocators draw from the same arena.
+         */
+        bool operator==(arena_allocator const& other) const
+        {
+            return _arena == other._arena;
+        }
+
+        /**
+         * @param other The allocator to compare against.
+         * @return Returns true if the allocators draw from different arenas.
+         */
+        bool operator!=(arena_allocator const& other) const
+        {
+            return !(*this == other);
+        }
+
+     private:
+        template <typename U>
+        friend class arena_allocator;
+
+        arena* _arena;
+    };
+
+}}  // namespace leatherman::util
@@ -4,6 +4,8 @@
 */
 #pragma once
 
+#include <boost/utility/string_ref.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 #include <functional>
@@ -50,6 +52,16 @@ namespace leatherman { namespace util {
          */
         static bool clear(std::string const& name);
 
+        /**
+         * Gets the environment generation counter.
+         * The counter is incremented whenever the environment is changed through
+         * set() or clear(), so callers can cheaply detect whether data derived
+         * from the environment is still current. Changes made behind this API's
+         * back (e.g. by calling setenv directly) are not tracked.
+         * @return Returns the current generation counter value.
+         */
+        static size_t generation();
+
         /**
          * Gets the platform-specific path separator.
          * @return Returns the platform-specific path separator.
@@ -58,12 +70,18 @@ namespace leatherman { namespace util {
 
         /**
          * Gets the platform-specific search program paths.
+         * The split paths are cached against the environment generation,
+         * so PATH is only re-tokenized after the environment is mutated
+         * through this API; the returned reference stays valid until the
+         * environment next changes.
          * @return Returns the platform-specific program search paths.
          */
         static std::vector<std::string> const& search_paths();
 
         /**
          * Force search program paths to be reloaded.
+         * Only needed when PATH was changed behind this API's back, e.g.
+         * by calling setenv directly.
          */
         static void reload_search_paths();
 
@@ -72,6 +90,78 @@ namespace leatherman { namespace util {
          * @param callback The callback to call for each environment variable (passes the variable name and value).
          */
         static void each(std::function<bool(std::string&, std::string&)> callback);
+
+        /**
+         * A capture of the whole environment taken in one pass.
+         * The variables are stored in a single flat arena, sorted by
+         * name, so capturing does one environment traversal and lookups
+         * are a binary search with no further allocation. The snapshot
+         * does not track later changes to the environment.
+         */
+        class snapshot
+        {
+         public:
+            /**
+             * Captures the current environment.
+             */
+            snapshot();
+
+            /**
+             * Looks up a variable in the snapshot.
+             * @param name The name of the variable to look up.
+             * @param value Returns the value of the variable.
+             * @return Returns true if the variable was present when the snapshot was taken or false if it was not.
+             */
+            bool get(std::string const& name, std::string& value) const;
+
+            /**
+             * Looks up a variable in the snapshot without copying.
+             * @param name The name of the variable to look up.
+             * @param value Returns a view of the variable's value, valid as long as the snapshot exists.
+             * @return Returns true if the variable was present when the snapshot was taken or false if it was not.
+             */
+            bool get(boost::string_ref name, boost::string_ref& value) const;
+
+            /**
+             * @return Returns the number of variables in the snapshot.
+             */
+            std::size_t size() const;
+
+            /**
+             * Enumerates the snapshot's variables in name order.
+             * @param callback The callback to call for each variable; the views are valid as long as the snapshot exists.
+             */
+            void each(std::function<bool(boost::string_ref, boost::string_ref)> callback) const;
+
+         private:
+            struct entry
+            {
+                std::size_t name_offset;
+                std::size_t name_length;
+                std::size_t value_offset;
+                std::size_t value_length;
+            };
+
+            boost::string_ref name_of(entry const& var) const;
+            boost::string_ref value_of(entry const& var) const;
+
+            std::string _arena;
+            std::vector<entry> _entries;
+        };
+
+        /**
+         * Gets the process-wide shared snapshot of the environment.
+         * The snapshot is captured once per environment generation and
+         * then shared, so code reading many variables - startup reading
+         * dozens of settings, say - pays one environment traversal (and,
+         * on Windows, one UTF-16 to UTF-8 conversion of the whole block)
+         * instead of a conversion per access; lookups through the
+         * returned snapshot are allocation-free. Mutations through set()
+         * or clear() cause the next call to capture afresh; changes made
+         * behind this API's back are not seen, as with generation().
+         * @return Returns the shared snapshot; it stays valid as long as the pointer is held, even across recaptures.
+         */
+        static std::shared_ptr<snapshot const> capture();
     };
 
 }}  // namespace leatherman::util
@@ -0,0 +1,167 @@
+/**
+ * @file
+ * Declares a lock-free bounded multi-producer/multi-consumer queue.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace leatherman { namespace util {
+
+    /**
+     * A bounded lock-free multi-producer/multi-consumer queue.
+     * Implements Vyukov's array-based design: each slot carries a
+     * sequence number, so producers and consumers claim slots with one
+     * compare-and-swap each and never take a lock. The enqueue and
+     * dequeue cursors live on separate cache lines to keep producers
+     * and consumers from false sharing. Capacity is rounded up to a
+     * power of two. The blocking push/pop spin briefly, then yield,
+     * then sleep, so a full or empty queue does not burn a core.
+     * @tparam T The type of the queued elements; moved in and out.
+     */
+    template <typename T>
+    class mpmc_queue
+    {
+     public:
+        /**
+         * Constructs a queue with at least the given capacity.
+         * @param capacity The minimum number of elements the queue can hold; rounded up to a power of two.
+         */
+        explicit mpmc_queue(std::size_t capacity)
+        {
+            std::size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            _mask = size - 1;
+            _cells.reset(new cell[size]);
+            for (std::size_t i = 0; i < size; ++i) {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            _enqueue.store(0, std::memory_order_relaxed);
+            _dequeue.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * Attempts to push a value without blocking.
+         * @param value The value to push; moved from only on success.
+         * @return Returns true if the value was queued or false if the queue is full.
+         */
+        bool try_push(T value)
+        {
+            return attempt_push(value);
+        }
+
+        /**
+         * Attempts to pop a value without blocking.
+         * @param value Returns the popped value.
+         * @return Returns true if a value was popped or false if the queue is empty.
+         */
+        bool try_pop(T& value)
+        {
+            auto pos = _dequeue.load(std::memory_order_relaxed);
+            while (true) {
+                auto& slot = _cells[pos & _mask];
+                auto sequence = slot.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (difference == 0) {
+                    if (_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        value = std::move(slot.value);
+                        slot.sequence.store(pos + _mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    pos = _dequeue.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * Pushes a value, blocking while the queue is full.
+         * @param value The value to push.
+         */
+        void push(T value)
+        {
+            std::size_t spins = 0;
+            while (!attempt_push(value)) {
+                backoff(spins);
+            }
+        }
+
+        /**
+         * Pops a value, blocking while the queue is empty.
+         * @param value Returns the popped value.
+         */
+        void pop(T& value)
+        {
+            std::size_t spins = 0;
+            while (!try_pop(value)) {
+                backoff(spins);
+            }
+        }
+
+        /**
+         * @return Returns the queue's capacity.
+         */
+        std::size_t capacity() const
+        {
+            return _mask + 1;
+        }
+
+     private:
+        struct cell
+        {
+            std::atomic<std::size_t> sequence;
+            T value;
+        };
+
+        bool attempt_push(T& value)
+        {
+            auto pos = _enqueue.load(std::memory_order_relaxed);
+            while (true) {
+                auto& slot = _cells[pos & _mask];
+                auto sequence = slot.sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if (difference == 0) {
+                    if (_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        slot.value = std::move(value);
+                        slot.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    pos = _enqueue.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        static void backoff(std::size_t& spins)
+        {
+            ++spins;
+            if (spins < 64) {
+                // Busy wait; the queue usually drains within a few cycles.
+            } else if (spins < 1024) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+
+        std::unique_ptr<cell[]> _cells;
+        std::size_t _mask;
+
+        // Keep the cursors on their own cache lines so producers and
+        // consumers do not false share.
+        alignas(64) std::atomic<std::size_t> _enqueue;
+        alignas(64) std::atomic<std::size_t> _dequeue;
+    };
+
+}}  // namespace leatherman::util
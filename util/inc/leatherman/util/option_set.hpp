@@ -4,9 +4,9 @@
  */
 #pragma once
 
-#include <numeric>
 #include <string>
 #include <initializer_list>
+#include <type_traits>
 
 namespace leatherman { namespace util {
     /**
@@ -30,31 +30,26 @@ namespace leatherman { namespace util {
         /**
          * Constructs an empty option_set.
          */
-        option_set() : option_set(value_type(0))
+        constexpr option_set() : _value(0)
         {
         }
 
         /**
          * Constructs an option_set with the given list of options.
+         * The bitwise OR happens at compile time when the list is a
+         * constant, so defaulted option sets cost nothing to build.
          * @param values The option values to store in the list.
          */
-        option_set(std::initializer_list<enum_type> const& values)
+        constexpr option_set(std::initializer_list<enum_type> const& values) :
+            _value(combine(values.begin(), values.end()))
         {
-            // Simply bitwise OR all the values together.
-            _value = std::accumulate(
-                std::begin(values),
-                std::end(values),
-                value_type(0),
-                [](value_type acc, enum_type value) {
-                    return acc | static_cast<value_type>(value);
-                });
         }
 
         /**
          * Constructs an option_set with an existing bitfield value.
          * @param value
          */
-        explicit option_set(value_type value) : _value(value)
+        explicit constexpr option_set(value_type value) : _value(value)
         {
         }
 
@@ -62,7 +57,7 @@ namespace leatherman { namespace util {
          * Gets the underlying value of the set.
          * @return Returns the underlying value of the set.
          */
-        value_type value() const
+        constexpr value_type value() const
         {
             return _value;
         }
@@ -72,7 +67,7 @@ namespace leatherman { namespace util {
          * @param option The option to check for.
          * @return Returns true if the option is in the set or false if it is not.
          */
-        bool operator [](enum_type option) const
+        constexpr bool operator [](enum_type option) const
         {
            return test(option);
         }
@@ -146,8 +141,9 @@ namespace leatherman { namespace util {
          */
         size_t count() const
         {
-            // Do a simple bit count
-            value_type bits = _value;
+            // Do a simple bit count; use an unsigned copy so clearing the
+            // least significant bit cannot overflow a signed value_type.
+            typename std::make_unsigned<value_type>::type bits = _value;
             size_t total = 0;
             for (; bits != 0; ++total)
             {
@@ -171,21 +167,29 @@ namespace leatherman { namespace util {
          * @param option The option to test for.
          * @return Returns true if the option is in the set or false if it is not.
          */
-        bool test(enum_type option) const
+        constexpr bool test(enum_type option) const
         {
-            return _value & static_cast<value_type>(option);
+            return static_cast<bool>(_value & static_cast<value_type>(option));
         }
 
         /**
          * Checks to see if the option_set is empty.
          * @return Returns true if the set is empty (no options) or false if there are options in the set.
          */
-        bool empty() const
+        constexpr bool empty() const
         {
             return _value == 0;
         }
 
      private:
+        // Folds the list with recursion, which C++11 constexpr allows
+        // where a loop is not.
+        static constexpr value_type combine(enum_type const* begin, enum_type const* end)
+        {
+            return begin == end ? value_type(0) :
+                (static_cast<value_type>(*begin) | combine(begin + 1, end));
+        }
+
         value_type _value;
     };
 
@@ -196,7 +200,7 @@ namespace leatherman { namespace util {
      * @return Returns an option_set that is the bitwise AND of the two given option_sets.
      */
     template<typename T>
-    option_set<T> operator &(option_set<T> const& lhs, option_set<T> const& rhs)
+    constexpr option_set<T> operator &(option_set<T> const& lhs, option_set<T> const& rhs)
     {
         return option_set<T>(lhs.value() & rhs.value());
     }
@@ -208,7 +212,7 @@ namespace leatherman { namespace util {
      * @return Returns an option_set that is the bitwise OR of the two given option_sets.
      */
     template<typename T>
-    option_set<T> operator |(option_set<T> const& lhs, option_set<T> const& rhs)
+    constexpr option_set<T> operator |(option_set<T> const& lhs, option_set<T> const& rhs)
     {
         return option_set<T>(lhs.value() | rhs.value());
     }
@@ -220,7 +224,7 @@ namespace leatherman { namespace util {
      * @return Returns an option_set that is the bitwise XOR of the two given option_sets.
      */
     template<typename T>
-    option_set<T> operator ^(option_set<T> const& lhs, option_set<T> const& rhs)
+    constexpr option_set<T> operator ^(option_set<T> const& lhs, option_set<T> const& rhs)
     {
         return option_set<T>(lhs.value() ^ rhs.value());
     }
@@ -0,0 +1,134 @@
+/**
+ * @file
+ * Declares lightweight scoped profiling hooks.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace leatherman { namespace util { namespace profiler {
+
+    /**
+     * The accumulated cost of one named scope.
+     */
+    struct counters
+    {
+        /**
+         * The number of times the scope was entered.
+         */
+        std::uint64_t count;
+        /**
+         * The total time spent inside the scope, in nanoseconds.
+         */
+        std::uint64_t total_nanoseconds;
+    };
+
+    /**
+     * Whether profiling is currently collecting.
+     * Exposed so the inline gate below compiles down to a single
+     * relaxed load; use enable and disable rather than storing to it.
+     */
+    extern std::atomic<bool> g_collecting;
+
+    /**
+     * @return Returns true if profiling is currently collecting.
+     */
+    inline bool collecting()
+    {
+        return g_collecting.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Turns profiling on. Scopes entered after this call are timed.
+     */
+    void enable();
+
+    /**
+     * Turns profiling off. Already collected data is kept until reset.
+     */
+    void disable();
+
+    /**
+     * Adds a sample to the named scope's per-thread counters.
+     * Prefer the LTH_PROFILE_SCOPE macro over calling this directly.
+     * @param name The scope's name; must be a string literal or otherwise outlive the profiler.
+     * @param nanoseconds The duration of the sample.
+     */
+    void record(char const* name, std::uint64_t nanoseconds);
+
+    /**
+     * Aggregates the counters collected so far across all threads.
+     * @return Returns the collected counters, keyed by scope name.
+     */
+    std::map<std::string, counters> collect();
+
+    /**
+     * Discards all collected counters.
+     */
+    void reset();
+
+    /**
+     * Times the enclosing scope when profiling is enabled.
+     * When profiling is disabled, construction is a single relaxed
+     * load, mirroring the logging level gate.
+     */
+    class scope
+    {
+     public:
+        /**
+         * Starts timing if profiling is enabled.
+         * @param name The scope's name; must be a string literal or otherwise outlive the profiler.
+         */
+        explicit scope(char const* name) : _name(nullptr)
+        {
+            if (collecting()) {
+                _name = name;
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        /**
+         * Records the elapsed time if timing was started.
+         */
+        ~scope()
+        {
+            if (_name) {
+                auto elapsed = std::chrono::steady_clock::now() - _start;
+                record(_name, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+        }
+
+        /**
+         * Scopes cannot be copied.
+         */
+        scope(scope const&) = delete;
+
+        /**
+         * Scopes cannot be assigned.
+         * @return Returns this scope.
+         */
+        scope& operator=(scope const&) = delete;
+
+     private:
+        char const* _name;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+}}}  // namespace leatherman::util::profiler
+
+/** @cond */
+#define LTH_PROFILE_PASTE_IMPL(a, b) a##b
+#define LTH_PROFILE_PASTE(a, b) LTH_PROFILE_PASTE_IMPL(a, b)
+/** @endcond */
+
+/**
+ * Times the enclosing scope under the given name when profiling is
+ * enabled; costs a single relaxed load when it is not.
+ * @param name The scope's name as a string literal.
+ */
+#define LTH_PROFILE_SCOPE(name) \
+    leatherman::util::profiler::scope LTH_PROFILE_PASTE(lth_profile_scope_, __LINE__)(name)
@@ -6,6 +6,7 @@
 
 #include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
+#include <string>
 
 namespace leatherman { namespace util {
 
@@ -77,4 +78,49 @@ namespace leatherman { namespace util {
         return re_search_helper(txt, what, 1, std::forward<Args>(args)...);
     }
 
+    /**
+     * Gets the compiled form of the given pattern from a process-wide cache.
+     * The cache is sharded by pattern hash so concurrent lookups rarely
+     * contend, and entries live for the life of the process, so a
+     * pattern is compiled once no matter how many call sites use it.
+     * @param pattern The pattern to compile.
+     * @return Returns a reference to the compiled pattern, valid for the life of the process.
+     *
+     * Throws boost::regex_error if the pattern is invalid, like constructing a boost::regex does.
+     */
+    boost::regex const& compiled_regex(std::string const& pattern);
+
+    /**
+     * Searches the given text for the given pattern, compiling the pattern
+     * through the process-wide cache, so ad-hoc call sites that pass the
+     * pattern as a string get compile-once semantics automatically.
+     * @tparam Text The type of the text.
+     * @tparam Args The variadic type of the match group arguments.
+     * @param txt The text to search.
+     * @param pattern The pattern to search the text with.
+     * @param args The returned match groups.
+     * @return Returns true if the text matches the given pattern or false if it does not.
+     */
+    template <typename Text, typename... Args>
+    inline bool re_search(Text const& txt, std::string const& pattern, Args&&... args)
+    {
+        return re_search(txt, compiled_regex(pattern), std::forward<Args>(args)...);
+    }
+
+    /**
+     * Searches the given text for the given pattern, compiling the pattern
+     * through the process-wide cache.
+     * @tparam Text The type of the text.
+     * @tparam Args The variadic type of the match group arguments.
+     * @param txt The text to search.
+     * @param pattern The pattern to search the text with.
+     * @param args The returned match groups.
+     * @return Returns true if the text matches the given pattern or false if it does not.
+     */
+    template <typename Text, typename... Args>
+    inline bool re_search(Text const& txt, char const* pattern, Args&&... args)
+    {
+        return re_search(txt, compiled_regex(pattern), std::forward<Args>(args)...);
+    }
+
 }}  // namespace leatherman::util
@@ -5,7 +5,10 @@
 #pragma once
 
 #include <leatherman/util/scoped_resource.hpp>
+#include <initializer_list>
 #include <string>
+#include <utility>
+#include <vector>
 #include <boost/optional.hpp>
 
 namespace leatherman { namespace util {
@@ -32,4 +35,23 @@ namespace leatherman { namespace util {
         static void restore(std::tuple<std::string, boost::optional<std::string>> &);
     };
 
+    /**
+     * An RAII wrapper for temporarily changing several environment
+     * variables at once. The prior values come from one shared
+     * environment snapshot rather than a getenv per variable, and one
+     * destructor restores them all; paths that stack a dozen
+     * scoped_env objects can use a single scoped_envs instead.
+     */
+    struct scoped_envs : scoped_resource<std::vector<std::tuple<std::string, boost::optional<std::string>>>>
+    {
+        /**
+         * Temporarily overrides the values of environment variables.
+         * @param vars The variables to update; a boost::none value unsets the variable.
+         */
+        scoped_envs(std::initializer_list<std::pair<std::string, boost::optional<std::string>>> vars);
+
+     private:
+        static void restore(std::vector<std::tuple<std::string, boost::optional<std::string>>> &);
+    };
+
 }}  // namespace leatherman::util
@@ -9,6 +9,8 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/compare.hpp>
 #pragma GCC diagnostic pop
+#include <boost/utility/string_ref.hpp>
+#include <cstring>
 #include <functional>
 #include <string>
 #include <vector>
@@ -54,4 +56,197 @@ namespace leatherman { namespace util {
          */
         void each_line(std::string const& s, std::function<bool(std::string&)> callback);
 
+        /**
+         * Reads each line from the given text without per-line allocation.
+         * The callback receives a view into the text with the line ending
+         * (including a Windows CR) stripped, so copy the line if it must
+         * outlive the call. A final line without a terminating newline is
+         * delivered as well.
+         * @param s The text to read.
+         * @param callback The callback function that is passed a view of each line in the text.
+         */
+        void each_line_view(boost::string_ref s, std::function<bool(boost::string_ref)> callback);
+
+        /**
+         * Iterates the delimited tokens of a string without allocating.
+         * Dereferencing yields a view into the original text, so the
+         * text must outlive the iterator. Empty tokens are produced for
+         * adjacent delimiters, matching boost::split.
+         */
+        class split_iterator
+        {
+         public:
+            /**
+             * Constructs the past-the-end iterator.
+             */
+            split_iterator() :
+                _delimiter('\0'), _position(boost::string_ref::npos), _next(0) {}
+
+            /**
+             * Constructs an iterator at the first token of the text.
+             * @param text The text to split.
+             * @param delimiter The character separating the tokens.
+             */
+            split_iterator(boost::string_ref text, char delimiter) :
+                _text(text), _delimiter(delimiter), _position(0), _next(0) {
+                advance();
+            }
+
+            /**
+             * @return Returns a view of the current token.
+             */
+            boost::string_ref const& operator*() const { return _token; }
+
+            /**
+             * @return Returns a pointer to a view of the current token.
+             */
+            boost::string_ref const* operator->() const { return &_token; }
+
+            /**
+             * Advances to the next token.
+             * @return Returns this iterator.
+             */
+            split_iterator& operator++() { advance(); return *this; }
+
+            /**
+             * @param other The iterator to compare against.
+             * @return Returns true if both iterators are at the same position in the text.
+             */
+            bool operator==(split_iterator const& other) const { return _position == other._position; }
+
+            /**
+             * @param other The iterator to compare against.
+             * @return Returns true if the iterators are at different positions in the text.
+             */
+            bool operator!=(split_iterator const& other) const { return !(*this == other); }
+
+         private:
+            void advance() {
+                if (_next > _text.size()) {
+                    _position = boost::string_ref::npos;
+                    return;
+                }
+                _position = _next;
+                auto found = std::memchr(_text.data() + _position, _delimiter, _text.size() - _position);
+                auto end = found ? static_cast<std::size_t>(static_cast<char const*>(found) - _text.data()) : _text.size();
+                _token = _text.substr(_position, end - _position);
+                _next = end + 1;
+            }
+
+            boost::string_ref _text;
+            boost::string_ref _token;
+            char _delimiter;
+            std::size_t _position;
+            std::size_t _next;
+        };
+
+        /**
+         * A range of split tokens usable in a range-based for loop.
+         */
+        struct split_range
+        {
+            /**
+             * The text being split.
+             */
+            boost::string_ref text;
+
+            /**
+             * The character separating the tokens.
+             */
+            char delimiter;
+
+            /**
+             * @return Returns an iterator at the first token.
+             */
+            split_iterator begin() const { return split_iterator(text, delimiter); }
+
+            /**
+             * @return Returns the past-the-end iterator.
+             */
+            split_iterator end() const { return split_iterator(); }
+        };
+
+        /**
+         * Splits the given text on the given delimiter without allocating.
+         * The returned range yields views into the text, so the text must
+         * outlive the iteration; copy a token if it must persist.
+         * @param text The text to split.
+         * @param delimiter The character separating the tokens.
+         * @return Returns a range of token views usable in a range-based for loop.
+         */
+        inline split_range split(boost::string_ref text, char delimiter)
+        {
+            return split_range { text, delimiter };
+        }
+
+        /**
+         * Removes the given characters from the start of the view.
+         * @param text The text to trim.
+         * @param chars The set of characters to remove.
+         * @return Returns a view of the text without the leading characters.
+         */
+        inline boost::string_ref trim_left(boost::string_ref text, boost::string_ref chars = " \t\r\n")
+        {
+            auto start = text.find_first_not_of(chars);
+            return start == boost::string_ref::npos ? boost::string_ref() : text.substr(start);
+        }
+
+        /**
+         * Removes the given characters from the end of the view.
+         * @param text The text to trim.
+         * @param chars The set of characters to remove.
+         * @return Returns a view of the text without the trailing characters.
+         */
+        inline boost::string_ref trim_right(boost::string_ref text, boost::string_ref chars = " \t\r\n")
+        {
+            auto end = text.find_last_not_of(chars);
+            return end == boost::string_ref::npos ? boost::string_ref() : text.substr(0, end + 1);
+        }
+
+        /**
+         * Removes the given characters from both ends of the view.
+         * @param text The text to trim.
+         * @param chars The set of characters to remove.
+         * @return Returns a view of the text without the leading and trailing characters.
+         */
+        inline boost::string_ref trim(boost::string_ref text, boost::string_ref chars = " \t\r\n")
+        {
+            return trim_right(trim_left(text, chars), chars);
+        }
+
+        /**
+         * Joins the given parts with the given separator.
+         * The result size is computed up front so the output is built
+         * with a single allocation.
+         * @tparam Sequence A sequence of string-like parts with data() and size().
+         * @param parts The parts to join.
+         * @param separator The separator placed between the parts.
+         * @return Returns the joined string.
+         */
+        template <typename Sequence>
+        std::string join(Sequence const& parts, boost::string_ref separator = " ")
+        {
+            std::size_t total = 0;
+            bool first = true;
+            for (auto const& part : parts) {
+                if (!first) {
+                    total += separator.size();
+                }
+                total += part.size();
+                first = false;
+            }
+
+            std::string result;
+            result.reserve(total);
+            first = true;
+            for (auto const& part : parts) {
+                if (!first) {
+                    result.append(separator.data(), separator.size());
+                }
+                result.append(part.data(), part.size());
+                first = false;
+            }
+            return result;
+        }
+
 }}  // namespace leatherman::util
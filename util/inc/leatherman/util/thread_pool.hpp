@@ -0,0 +1,147 @@
+/**
+ * @file
+ * Declares a general-purpose thread pool.
+ */
+#pragma once
+
+#include <leatherman/util/scope_exit.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace leatherman { namespace util {
+
+    /**
+     * A pool of worker threads executing posted tasks.
+     * Each worker owns a deque: it pops its own work from the back and
+     * steals from the front of the others when idle, so unrelated tasks
+     * rarely contend. Destruction is graceful - queued tasks finish
+     * before the workers are joined.
+     */
+    class thread_pool
+    {
+     public:
+        /**
+         * Constructs a thread pool.
+         * @param threads The number of worker threads, or 0 to size from hardware_concurrency.
+         */
+        explicit thread_pool(std::size_t threads = 0);
+
+        /**
+         * Destructs the thread pool, running any queued tasks and joining the workers.
+         */
+        ~thread_pool();
+
+        /**
+         * Queues a task for execution on the pool.
+         * @param task The task to execute.
+         */
+        void post(std::function<void()> task);
+
+        /**
+         * Blocks until every task posted so far has finished.
+         */
+        void wait();
+
+        /**
+         * @return Returns the number of worker threads in the pool.
+         */
+        std::size_t size() const;
+
+        /**
+         * Gets the process-wide shared pool, created on first use and
+         * sized from hardware_concurrency. Library features that
+         * parallelize internally draw on this pool rather than spinning
+         * up their own threads.
+         * @return Returns the shared pool.
+         */
+        static thread_pool& global();
+
+     private:
+        struct worker
+        {
+            std::mutex queue_mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void run(std::size_t index);
+        bool try_pop(std::size_t index, std::function<void()>& task);
+
+        std::vector<std::unique_ptr<worker>> _workers;
+        std::vector<std::thread> _threads;
+        std::mutex _sleep_mutex;
+        std::condition_variable _sleep;
+        std::condition_variable _drained;
+        std::size_t _queued = 0;
+        std::size_t _running = 0;
+        std::size_t _next = 0;
+        bool _stop = false;
+    };
+
+    /**
+     * Applies a function to every element of a range using the given pool.
+     * Blocks until all applications have finished; the first exception
+     * thrown by the function is rethrown after the range completes. Do
+     * not call from inside a task running on the same pool, as waiting
+     * for the pool from the pool can deadlock.
+     * @tparam Iterator The type of the range's iterators.
+     * @tparam Function The type of the function to apply.
+     * @param begin The start of the range.
+     * @param end The end of the range.
+     * @param function The function to apply to each element.
+     * @param pool The pool to run on; defaults to the shared pool.
+     */
+    template <typename Iterator, typename Function>
+    void parallel_for_each(Iterator begin, Iterator end, Function function, thread_pool& pool = thread_pool::global())
+    {
+        auto total = static_cast<std::size_t>(std::distance(begin, end));
+        if (total == 0) {
+            return;
+        }
+
+        struct state
+        {
+            std::mutex state_mutex;
+            std::condition_variable done;
+            std::size_t remaining;
+            std::exception_ptr error;
+        };
+        auto shared = std::make_shared<state>();
+        shared->remaining = total;
+
+        for (auto it = begin; it != end; ++it) {
+            auto element = &*it;
+            pool.post([element, shared, &function]() {
+                // The counter must drop even if the function throws, or
+                // the caller would wait forever.
+                scope_exit complete([shared]() {
+                    std::lock_guard<std::mutex> lock(shared->state_mutex);
+                    if (--shared->remaining == 0) {
+                        shared->done.notify_all();
+                    }
+                });
+                try {
+                    function(*element);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(shared->state_mutex);
+                    if (!shared->error) {
+                        shared->error = std::current_exception();
+                    }
+                }
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(shared->state_mutex);
+        shared->done.wait(lock, [&]() { return shared->remaining == 0; });
+        if (shared->error) {
+            std::rethrow_exception(shared->error);
+        }
+    }
+
+}}  // namespace leatherman::util
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <cstddef>
 #include <ctime>
 
 namespace leatherman { namespace util {
@@ -26,6 +27,19 @@ namespace leatherman { namespace util {
     /** @return Returns the current datetime string in the %Y%m%d_%H%M%S format */
     std::string get_date_time();
 
+    /**
+     * Formats the given timestamp as "%Y-%m-%dT%H:%M:%SZ" (UTC) into the
+     * caller's buffer without allocating. The formatted date is cached per
+     * thread and only the time-of-day digits are patched on subsequent
+     * calls, so stamping many messages within the same second or day is
+     * much cheaper than strftime.
+     * @param timestamp The time to format.
+     * @param buffer The buffer to write the NUL-terminated result into.
+     * @param size The size of the buffer; must be at least 21 bytes.
+     * @return Returns the number of characters written, excluding the NUL, or 0 if the buffer is too small.
+     */
+    std::size_t format_ISO8601_time(std::time_t timestamp, char* buffer, std::size_t size);
+
     /**
      * Turns a stored time into a local time with correction for timezones.
      *  @param stored_time The time to be converted.
@@ -1,10 +1,13 @@
 /**
  * @file
- * Declares a simple timer class.
+ * Declares a simple timer class and latency-tracking helpers.
  */
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 namespace leatherman { namespace util {
 
@@ -40,4 +43,199 @@ class Timer {
     std::chrono::time_point<std::chrono::steady_clock> start_;
 };
 
+/**
+ * A mergeable point-in-time view of a latency_histogram.
+ * Quantiles are extracted from the bucket counts; values are accurate
+ * to the bucket width, about 3% of the value.
+ */
+struct histogram_snapshot {
+    /** The per-bucket sample counts. */
+    std::vector<uint64_t> counts;
+
+    /** The total number of recorded samples. */
+    uint64_t total = 0;
+
+    /**
+     * Merges another snapshot into this one.
+     * @param other The snapshot to merge; typically from another histogram or process interval.
+     */
+    void merge(histogram_snapshot const& other) {
+        if (counts.size() < other.counts.size()) {
+            counts.resize(other.counts.size(), 0);
+        }
+        for (size_t i = 0; i < other.counts.size(); ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+    }
+
+    /**
+     * Extracts a quantile from the recorded samples.
+     * @param q The quantile to extract, from 0.0 to 1.0 (e.g. 0.95 for p95).
+     * @return Returns the representative sample value in nanoseconds, or 0 if no samples were recorded.
+     */
+    uint64_t value_at(double q) const {
+        if (total == 0) {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(q * total);
+        if (rank >= total) {
+            rank = total - 1;
+        }
+        uint64_t seen = 0;
+        for (size_t index = 0; index < counts.size(); ++index) {
+            seen += counts[index];
+            if (seen > rank) {
+                return bucket_value(index);
+            }
+        }
+        return bucket_value(counts.size() - 1);
+    }
+
+    /**
+     * Computes the lower bound of the given bucket's value range.
+     * @param index The bucket index.
+     * @return Returns the smallest sample value in nanoseconds that lands in the bucket.
+     */
+    static uint64_t bucket_value(size_t index) {
+        auto group = index >> sub_bucket_bits;
+        if (group == 0) {
+            return index;
+        }
+        auto sub = index & (sub_bucket_count - 1);
+        return static_cast<uint64_t>(sub_bucket_count + sub) << (group - 1);
+    }
+
+    /** The number of bits of linear precision within each power-of-two group. */
+    static constexpr size_t sub_bucket_bits = 4;
+
+    /** The number of linear sub-buckets within each power-of-two group. */
+    static constexpr size_t sub_bucket_count = 1 << sub_bucket_bits;
+
+    /** The total number of buckets, covering the full 64-bit nanosecond range. */
+    static constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) << sub_bucket_bits;
+};
+
+/**
+ * Accumulates latency samples into a log-linear histogram.
+ * Buckets are powers of two subdivided linearly, HDR-histogram style,
+ * so a sample costs one bit scan and one relaxed atomic increment with
+ * no locking; counters are sharded so concurrent recorders on
+ * different threads rarely share a cache line. Use snapshot to get a
+ * consistent-enough view for quantile extraction, and merge snapshots
+ * across histograms for fleet-wide statistics.
+ */
+class latency_histogram {
+  public:
+    latency_histogram() : counts_(num_shards * histogram_snapshot::bucket_count) {
+    }
+
+    /**
+     * Records a latency sample.
+     * @param ns The sample value in nanoseconds.
+     */
+    void record(uint64_t ns) {
+        auto index = shard_index() * histogram_snapshot::bucket_count + bucket_index(ns);
+        counts_[index].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Records a latency sample from a duration.
+     * @param elapsed The sample duration.
+     */
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> elapsed) {
+        record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    /**
+     * Takes a snapshot of the recorded samples.
+     * Concurrent recorders are not blocked, so a snapshot taken while
+     * recording may miss in-flight samples.
+     * @return Returns the snapshot with shard counts summed.
+     */
+    histogram_snapshot snapshot() const {
+        histogram_snapshot result;
+        result.counts.assign(histogram_snapshot::bucket_count, 0);
+        for (size_t shard = 0; shard < num_shards; ++shard) {
+            for (size_t index = 0; index < histogram_snapshot::bucket_count; ++index) {
+                auto count = counts_[shard * histogram_snapshot::bucket_count + index].load(std::memory_order_relaxed);
+                result.counts[index] += count;
+                result.total += count;
+            }
+        }
+        return result;
+    }
+
+  private:
+    static size_t bucket_index(uint64_t ns) {
+        auto width = bit_width(ns);
+        if (width <= static_cast<int>(histogram_snapshot::sub_bucket_bits)) {
+            return static_cast<size_t>(ns);
+        }
+        auto shift = width - histogram_snapshot::sub_bucket_bits;
+        auto group = static_cast<size_t>(shift);
+        auto sub = static_cast<size_t>((ns >> (shift - 1)) & (histogram_snapshot::sub_bucket_count - 1));
+        return (group << histogram_snapshot::sub_bucket_bits) + sub;
+    }
+
+    static int bit_width(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return value == 0 ? 0 : 64 - __builtin_clzll(value);
+#else
+        int width = 0;
+        while (value) {
+            ++width;
+            value >>= 1;
+        }
+        return width;
+#endif
+    }
+
+    static size_t shard_index() {
+        static std::atomic<size_t> next_shard {0};
+        static thread_local size_t shard = next_shard.fetch_add(1) % num_shards;
+        return shard;
+    }
+
+    static constexpr size_t num_shards = 8;
+
+    std::vector<std::atomic<uint64_t>> counts_;
+};
+
+/**
+ * Records the lifetime of a scope into a latency_histogram.
+ * Construct one at the top of a hot path; its destructor records the
+ * elapsed nanoseconds.
+ */
+class scoped_timer {
+  public:
+    /**
+     * Constructs a scoped timer recording into the given histogram.
+     * @param histogram The histogram that receives the sample; must outlive the timer.
+     */
+    explicit scoped_timer(latency_histogram& histogram) :
+        histogram_(histogram), start_(std::chrono::steady_clock::now()) {
+    }
+
+    ~scoped_timer() {
+        histogram_.record(std::chrono::steady_clock::now() - start_);
+    }
+
+    /**
+     * Scoped timers cannot be copied.
+     */
+    scoped_timer(scoped_timer const&) = delete;
+
+    /**
+     * Scoped timers cannot be assigned.
+     * @return Returns this scoped timer.
+     */
+    scoped_timer& operator=(scoped_timer const&) = delete;
+
+  private:
+    latency_histogram& histogram_;
+    std::chrono::time_point<std::chrono::steady_clock> start_;
+};
+
 }}  // namespace leatherman::util
@@ -4,6 +4,7 @@
  */
 #pragma once
 
+#include <boost/utility/string_ref.hpp>
 #include <string>
 
 namespace leatherman { namespace util {
@@ -20,4 +21,57 @@ struct uri
 
     std::string str() const;
 };
+
+/**
+ * A parsed URI holding one buffer plus component offsets.
+ * Unlike uri, the components are views into the original text, so
+ * parsing allocates nothing beyond the buffer itself and str() returns
+ * the buffer as given rather than re-concatenating the components.
+ * Component semantics match uri; the views remain valid as long as the
+ * uri_view exists.
+ */
+class uri_view
+{
+ public:
+    /**
+     * Parses the given URI.
+     * @param uri The URI text; taken by value so the caller can move it in.
+     */
+    explicit uri_view(std::string uri);
+
+    /** @return Returns a view of the protocol, without the "://". */
+    boost::string_ref protocol() const { return component(_protocol); }
+
+    /** @return Returns a view of the host. */
+    boost::string_ref host() const { return component(_host); }
+
+    /** @return Returns a view of the port, without the leading ':'. */
+    boost::string_ref port() const { return component(_port); }
+
+    /** @return Returns a view of the path. */
+    boost::string_ref path() const { return component(_path); }
+
+    /** @return Returns a view of the query, including the leading '?'. */
+    boost::string_ref query() const { return component(_query); }
+
+    /** @return Returns the original URI text. */
+    std::string const& str() const { return _buffer; }
+
+ private:
+    struct span
+    {
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    boost::string_ref component(span const& part) const {
+        return boost::string_ref(_buffer.data() + part.offset, part.length);
+    }
+
+    std::string _buffer;
+    span _protocol {}, _host {}, _port {}, _path {}, _query {};
+
+    friend struct uri;
+};
+
 }}  // namespace leatherman::util
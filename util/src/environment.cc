@@ -1,11 +1,20 @@
 #include <leatherman/util/environment.hpp>
 #include <boost/nowide/cenv.hpp>
+#include <algorithm>
+#include <atomic>
 #include <stdexcept>
 
 using namespace std;
 
 namespace leatherman { namespace util {
 
+    static atomic<size_t> environment_generation { 0 };
+
+    size_t environment::generation()
+    {
+        return environment_generation.load();
+    }
+
     int environment::get_int(string const& name, int default_value)
     {
         auto variable = boost::nowide::getenv(name.c_str());
@@ -34,12 +43,103 @@ namespace leatherman { namespace util {
 
     bool environment::set(string const& name, string const& value)
     {
+        ++environment_generation;
         return boost::nowide::setenv(name.c_str(), value.c_str(), 1) == 0;
     }
 
     bool environment::clear(string const& name)
     {
+        ++environment_generation;
         return boost::nowide::unsetenv(name.c_str()) == 0;
     }
 
+    environment::snapshot::snapshot()
+    {
+        environment::each([this](string& name, string& value) {
+            entry var;
+            var.name_offset = _arena.size();
+            var.name_length = name.size();
+            _arena += name;
+            var.value_offset = _arena.size();
+            var.value_length = value.size();
+            _arena += value;
+            _entries.push_back(var);
+            return true;
+        });
+        sort(_entries.begin(), _entries.end(), [this](entry const& a, entry const& b) {
+            return name_of(a) < name_of(b);
+        });
+    }
+
+    bool environment::snapshot::get(string const& name, string& value) const
+    {
+        boost::string_ref found;
+        if (!get(boost::string_ref { name }, found)) {
+            return false;
+        }
+        value.assign(found.data(), found.size());
+        return true;
+    }
+
+    bool environment::snapshot::get(boost::string_ref name, boost::string_ref& value) const
+    {
+        auto it = lower_bound(_entries.begin(), _entries.end(), name, [this](entry const& var, boost::string_ref target) {
+            return name_of(var) < target;
+        });
+        if (it == _entries.end() || name_of(*it) != name) {
+            return false;
+        }
+        value = value_of(*it);
+        return true;
+    }
+
+    size_t environment::snapshot::size() const
+    {
+        return _entries.size();
+    }
+
+    void environment::snapshot::each(function<bool(boost::string_ref, boost::string_ref)> callback) const
+    {
+        for (auto const& var : _entries) {
+            if (!callback(name_of(var), value_of(var))) {
+                break;
+            }
+        }
+    }
+
+    boost::string_ref environment::snapshot::name_of(entry const& var) const
+    {
+        return boost::string_ref(_arena.data() + var.name_offset, var.name_length);
+    }
+
+    boost::string_ref environment::snapshot::value_of(entry const& var) const
+    {
+        return boost::string_ref(_arena.data() + var.value_offset, var.value_length);
+    }
+
+    // The shared snapshot, keyed by the generation it was captured at,
+    // so mutations through set/clear invalidate it automatically. The
+    // current case is one atomic shared_ptr load; holders of an old
+    // snapshot keep it alive across recaptures.
+    struct snapshot_cache
+    {
+        size_t generation;
+        environment::snapshot vars;
+    };
+
+    static shared_ptr<snapshot_cache const> g_snapshot;
+
+    shared_ptr<environment::snapshot const> environment::capture()
+    {
+        auto generation = environment::generation();
+        auto cached = atomic_load(&g_snapshot);
+        if (!cached || cached->generation != generation) {
+            auto entry = make_shared<snapshot_cache>();
+            entry->generation = generation;
+            atomic_store(&g_snapshot, shared_ptr<snapshot_cache const>(entry));
+            cached = move(entry);
+        }
+        return shared_ptr<environment::snapshot const>(cached, &cached->vars);
+    }
+
 }}  // namespace leatherman::util
@@ -0,0 +1,114 @@
+#include <leatherman/util/profiler.hpp>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace leatherman { namespace util { namespace profiler {
+
+    atomic<bool> g_collecting {false};
+
+    namespace {
+
+        struct thread_records;
+
+        // Tracks every thread's records so collect() can aggregate
+        // them; counters from exited threads are folded into retired.
+        struct global_registry
+        {
+            mutex registry_mutex;
+            vector<thread_records*> threads;
+            unordered_map<string, counters> retired;
+        };
+
+        global_registry& registry()
+        {
+            static global_registry instance;
+            return instance;
+        }
+
+        // Each thread accumulates into its own map under its own
+        // mutex, so record() never contends with other threads - only
+        // with a concurrent collect() or reset().
+        struct thread_records
+        {
+            thread_records()
+            {
+                auto& reg = registry();
+                lock_guard<mutex> lock(reg.registry_mutex);
+                reg.threads.push_back(this);
+            }
+
+            ~thread_records()
+            {
+                auto& reg = registry();
+                lock_guard<mutex> lock(reg.registry_mutex);
+                for (auto const& entry : entries) {
+                    auto& total = reg.retired[entry.first];
+                    total.count += entry.second.count;
+                    total.total_nanoseconds += entry.second.total_nanoseconds;
+                }
+                reg.threads.erase(remove(reg.threads.begin(), reg.threads.end(), this), reg.threads.end());
+            }
+
+            mutex entries_mutex;
+            unordered_map<char const*, counters> entries;
+        };
+
+        thread_records& local_records()
+        {
+            static thread_local thread_records records;
+            return records;
+        }
+
+    }  // namespace
+
+    void enable()
+    {
+        g_collecting.store(true);
+    }
+
+    void disable()
+    {
+        g_collecting.store(false);
+    }
+
+    void record(char const* name, uint64_t nanoseconds)
+    {
+        auto& records = local_records();
+        lock_guard<mutex> lock(records.entries_mutex);
+        auto& total = records.entries[name];
+        ++total.count;
+        total.total_nanoseconds += nanoseconds;
+    }
+
+    map<string, counters> collect()
+    {
+        auto& reg = registry();
+        lock_guard<mutex> lock(reg.registry_mutex);
+        map<string, counters> result(reg.retired.begin(), reg.retired.end());
+        for (auto* records : reg.threads) {
+            lock_guard<mutex> entries_lock(records->entries_mutex);
+            for (auto const& entry : records->entries) {
+                auto& total = result[entry.first];
+                total.count += entry.second.count;
+                total.total_nanoseconds += entry.second.total_nanoseconds;
+            }
+        }
+        return result;
+    }
+
+    void reset()
+    {
+        auto& reg = registry();
+        lock_guard<mutex> lock(reg.registry_mutex);
+        reg.retired.clear();
+        for (auto* records : reg.threads) {
+            lock_guard<mutex> entries_lock(records->entries_mutex);
+            records->entries.clear();
+        }
+    }
+
+}}}  // namespace leatherman::util::profiler
@@ -0,0 +1,39 @@
+#include <leatherman/util/regex.hpp>
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace leatherman { namespace util {
+
+    // Compiled patterns are cached in shards selected by pattern hash,
+    // so concurrent callers only contend when their patterns land in
+    // the same shard. Entries are never evicted: the set of patterns a
+    // process uses is small and static in practice, and stable entries
+    // let callers hold references for the life of the process.
+    namespace {
+        constexpr size_t num_shards = 16;
+
+        struct regex_shard
+        {
+            mutex shard_mutex;
+            unordered_map<string, boost::regex> patterns;
+        };
+    }
+
+    boost::regex const& compiled_regex(string const& pattern)
+    {
+        static regex_shard shards[num_shards];
+        auto& shard = shards[hash<string>()(pattern) % num_shards];
+
+        lock_guard<mutex> lock(shard.shard_mutex);
+        auto it = shard.patterns.find(pattern);
+        if (it == shard.patterns.end()) {
+            // unordered_map references are not invalidated by rehashing,
+            // so the returned reference stays valid as the cache grows.
+            it = shard.patterns.emplace(pattern, boost::regex(pattern)).first;
+        }
+        return it->second;
+    }
+
+}}  // namespace leatherman::util
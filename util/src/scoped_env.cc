@@ -34,4 +34,40 @@ namespace leatherman { namespace util {
         }
     }
 
+    scoped_envs::scoped_envs(initializer_list<pair<string, boost::optional<string>>> vars) : scoped_resource()
+    {
+        // One shared snapshot provides all the prior values, so
+        // construction does a single environment traversal instead of
+        // a lookup per variable.
+        auto snapshot = environment::capture();
+
+        vector<tuple<string, boost::optional<string>>> saved;
+        saved.reserve(vars.size());
+        for (auto const& var : vars) {
+            string oldval;
+            bool was_set = snapshot->get(var.first, oldval);
+            saved.emplace_back(var.first, was_set ? boost::optional<string>(move(oldval)) : boost::none);
+
+            if (var.second) {
+                environment::set(var.first, *var.second);
+            } else {
+                environment::clear(var.first);
+            }
+        }
+
+        _resource = std::move(saved);
+        _deleter = scoped_envs::restore;
+    }
+
+    void scoped_envs::restore(vector<tuple<string, boost::optional<string>>> & old)
+    {
+        for (auto& entry : old) {
+            if (get<1>(entry)) {
+                environment::set(get<0>(entry), *get<1>(entry));
+            } else {
+                environment::clear(get<0>(entry));
+            }
+        }
+    }
+
 }}  // namespace leatherman::util
@@ -3,7 +3,7 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 
-#include <sstream>
+#include <cstring>
 
 using namespace std;
 
@@ -19,22 +19,50 @@ namespace leatherman { namespace util {
     }
 
     string get_UUID() {
-        static boost::uuids::random_generator gen;
+        // One generator per thread: constructing one per call reseeds
+        // the RNG each time, and sharing one across threads would race.
+        static thread_local boost::uuids::random_generator gen;
         boost::uuids::uuid uuid = gen();
-        return boost::uuids::to_string(uuid);
+
+        // Format straight into a stack buffer with a nibble table
+        // rather than through a stream.
+        static char const digits[] = "0123456789abcdef";
+        char buffer[36];
+        auto out = buffer;
+        for (size_t i = 0; i < boost::uuids::uuid::static_size(); ++i) {
+            if (i == 4 || i == 6 || i == 8 || i == 10) {
+                *out++ = '-';
+            }
+            *out++ = digits[uuid.data[i] >> 4];
+            *out++ = digits[uuid.data[i] & 0x0f];
+        }
+        return string(buffer, sizeof(buffer));
     }
 
     void each_line(string const& s, function<bool(string&)> callback) {
+        // Compatibility wrapper over the view-based variant; the string
+        // is reused across lines.
         string line;
-        istringstream in(s);
-        while (getline(in, line)) {
-        // Handle Windows CR in the string.
-            if (line.size() && line.back() == '\r') {
-                line.pop_back();
+        each_line_view(s, [&](boost::string_ref view) {
+            line.assign(view.data(), view.size());
+            return callback(line);
+        });
+    }
+
+    void each_line_view(boost::string_ref s, function<bool(boost::string_ref)> callback) {
+        size_t position = 0;
+        while (position < s.size()) {
+            auto found = memchr(s.data() + position, '\n', s.size() - position);
+            auto end = found ? static_cast<size_t>(static_cast<char const*>(found) - s.data()) : s.size();
+            auto line = s.substr(position, end - position);
+            // Handle Windows CR in the string.
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
             }
             if (!callback(line)) {
                 break;
             }
+            position = end + 1;
         }
     }
 
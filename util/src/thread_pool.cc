@@ -0,0 +1,121 @@
+#include <leatherman/util/thread_pool.hpp>
+#include <algorithm>
+
+using namespace std;
+
+namespace leatherman { namespace util {
+
+    thread_pool::thread_pool(size_t threads)
+    {
+        if (threads == 0) {
+            threads = max(1u, thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            _workers.emplace_back(new worker());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            _threads.emplace_back([this, i]() { run(i); });
+        }
+    }
+
+    thread_pool::~thread_pool()
+    {
+        {
+            lock_guard<mutex> lock(_sleep_mutex);
+            _stop = true;
+        }
+        _sleep.notify_all();
+        for (auto& member : _threads) {
+            member.join();
+        }
+    }
+
+    void thread_pool::post(function<void()> task)
+    {
+        size_t index;
+        {
+            lock_guard<mutex> lock(_sleep_mutex);
+            index = _next++ % _workers.size();
+            ++_queued;
+        }
+        {
+            lock_guard<mutex> lock(_workers[index]->queue_mutex);
+            _workers[index]->tasks.emplace_back(move(task));
+        }
+        _sleep.notify_one();
+    }
+
+    void thread_pool::wait()
+    {
+        unique_lock<mutex> lock(_sleep_mutex);
+        _drained.wait(lock, [this]() { return _queued == 0 && _running == 0; });
+    }
+
+    size_t thread_pool::size() const
+    {
+        return _workers.size();
+    }
+
+    thread_pool& thread_pool::global()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    bool thread_pool::try_pop(size_t index, function<void()>& task)
+    {
+        // Own queue from the back; steal from the front of the others
+        // so the owner and a thief touch opposite ends.
+        {
+            auto& own = *_workers[index];
+            lock_guard<mutex> lock(own.queue_mutex);
+            if (!own.tasks.empty()) {
+                task = move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < _workers.size(); ++offset) {
+            auto& victim = *_workers[(index + offset) % _workers.size()];
+            lock_guard<mutex> lock(victim.queue_mutex);
+            if (!victim.tasks.empty()) {
+                task = move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void thread_pool::run(size_t index)
+    {
+        while (true) {
+            function<void()> task;
+            if (try_pop(index, task)) {
+                {
+                    lock_guard<mutex> lock(_sleep_mutex);
+                    --_queued;
+                    ++_running;
+                }
+                task();
+                {
+                    lock_guard<mutex> lock(_sleep_mutex);
+                    --_running;
+                    if (_queued == 0 && _running == 0) {
+                        _drained.notify_all();
+                    }
+                }
+                continue;
+            }
+
+            unique_lock<mutex> lock(_sleep_mutex);
+            if (_stop && _queued == 0) {
+                return;
+            }
+            if (_queued == 0) {
+                _sleep.wait(lock, [this]() { return _queued != 0 || _stop; });
+            }
+        }
+    }
+
+}}  // namespace leatherman::util
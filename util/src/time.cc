@@ -1,5 +1,7 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <leatherman/util/time.hpp>
+#include <cstdio>
+#include <cstring>
 
 namespace leatherman { namespace util {
 
@@ -30,6 +32,55 @@ namespace leatherman { namespace util {
         return boost::posix_time::to_iso_extended_string(t) + "Z";
     }
 
+    std::size_t format_ISO8601_time(std::time_t timestamp, char* buffer, std::size_t size) {
+        static const std::size_t formatted_length = 20;  // "YYYY-MM-DDTHH:MM:SSZ"
+        if (size <= formatted_length) {
+            return 0;
+        }
+
+        // Cache the rendered text per thread: most callers stamp many
+        // messages within the same second, and nearly all within the
+        // same day, so only the time-of-day digits need patching.
+        struct cached_stamp {
+            std::time_t day_start;
+            std::time_t second;
+            char text[21];
+        };
+        static thread_local cached_stamp cache { 0, 0, "" };
+
+        if (timestamp != cache.second || cache.text[0] == '\0') {
+            auto day_start = timestamp - (timestamp % 86400);
+            if (day_start > timestamp) {
+                // Round toward negative infinity for pre-epoch times.
+                day_start -= 86400;
+            }
+            if (day_start != cache.day_start || cache.text[0] == '\0') {
+                // Day rollover: render the date portion. from_time_t is
+                // pure arithmetic on UTC, with no locale or timezone
+                // lookups to serialize on.
+                auto date = boost::posix_time::from_time_t(day_start).date();
+                snprintf(cache.text, sizeof(cache.text), "%04u-%02u-%02uT00:00:00Z",
+                         static_cast<unsigned int>(date.year()),
+                         static_cast<unsigned int>(date.month()),
+                         static_cast<unsigned int>(date.day()));
+                cache.day_start = day_start;
+            }
+
+            auto put_2_digits = [&](std::size_t offset, unsigned int value) {
+                cache.text[offset] = '0' + value / 10;
+                cache.text[offset + 1] = '0' + value % 10;
+            };
+            auto seconds_of_day = static_cast<unsigned int>(timestamp - day_start);
+            put_2_digits(11, seconds_of_day / 3600);
+            put_2_digits(14, (seconds_of_day / 60) % 60);
+            put_2_digits(17, seconds_of_day % 60);
+            cache.second = timestamp;
+        }
+
+        memcpy(buffer, cache.text, formatted_length + 1);
+        return formatted_length;
+    }
+
     std::string get_date_time() {
         struct std::tm now_info;
         std::string now_buffer(80, '\0');
@@ -1,75 +1,89 @@
 #include <leatherman/util/uri.hpp>
 #include <algorithm>
-#include <sstream>
 
 namespace leatherman { namespace util {
-    uri::uri(std::string const& _uri)
+
+    uri_view::uri_view(std::string uri) :
+        _buffer(std::move(uri))
     {
-        if (_uri.length() == 0) {
+        if (_buffer.empty()) {
             return;
         }
 
-        auto uri_end = _uri.end();
+        auto size = _buffer.size();
+        auto npos = std::string::npos;
 
         // get query start
-        auto query_start = std::find(_uri.begin(), uri_end, '?');
+        auto query_start = _buffer.find('?');
 
         // protocol
-        auto protocol_start = _uri.begin();
-        auto protocol_end = std::find(protocol_start, uri_end, ':');
-
-        if (protocol_end != uri_end) {
-            std::string after_prot{protocol_end, uri_end};
-            if ((after_prot.length() > 3) && (after_prot.substr(0, 3) == "://")) {
-                protocol = std::string(protocol_start, protocol_end);
-                protocol_end += 3;
-            } else {
-                protocol_end = _uri.begin();  // no protocol
-            }
-        } else {
-            protocol_end = _uri.begin();  // no protocol
+        std::size_t host_start = 0;
+        auto protocol_end = _buffer.find(':');
+        // A protocol needs "://" plus at least one following character.
+        if (protocol_end != npos && size > protocol_end + 3 &&
+            _buffer.compare(protocol_end, 3, "://") == 0) {
+            _protocol = span { 0, protocol_end };
+            host_start = protocol_end + 3;
         }
 
         // host
-        auto host_start = protocol_end;
-        auto path_start = std::find(host_start, uri_end, '/');
-
-        auto host_end = std::find(protocol_end,
-                                  (path_start != uri_end) ? path_start : query_start,
-                                  ':');  // check for port
-
-        host = std::string(host_start, host_end);
+        auto path_start = _buffer.find('/', host_start);
+        auto host_limit = (path_start != npos) ? path_start : query_start;
+        auto host_end = _buffer.find(':', host_start);
+        if (host_end == npos || (host_limit != npos && host_end > host_limit)) {
+            host_end = (host_limit != npos) ? host_limit : size;
+        }
+        _host = span { host_start, host_end - host_start };
 
         // port
-        if ((host_end != uri_end) && (*host_end == ':')) {
-            auto port_end = (path_start != uri_end) ? path_start : query_start;
-            port = std::string(host_end+1, port_end);
+        if (host_end < size && _buffer[host_end] == ':') {
+            auto port_end = (path_start != npos) ? path_start : query_start;
+            if (port_end == npos) {
+                port_end = size;
+            }
+            _port = span { host_end + 1, port_end - (host_end + 1) };
         }
 
         // path
-        if (path_start != uri_end) {
-            path = std::string(path_start, query_start);
+        if (path_start != npos) {
+            auto path_end = (query_start != npos) ? query_start : size;
+            _path = span { path_start, path_end - path_start };
         }
 
         // query
-        if (query_start != uri_end) {
-            query = std::string(query_start, uri_end);
+        if (query_start != npos) {
+            _query = span { query_start, size - query_start };
         }
     }
 
+    uri::uri(std::string const& _uri)
+    {
+        uri_view view(_uri);
+        protocol.assign(view.protocol().data(), view.protocol().size());
+        host.assign(view.host().data(), view.host().size());
+        port.assign(view.port().data(), view.port().size());
+        path.assign(view.path().data(), view.path().size());
+        query.assign(view.query().data(), view.query().size());
+    }
+
     std::string uri::str() const
     {
-        std::stringstream ss;
+        std::string result;
+        result.reserve(protocol.size() + 3 + host.size() + 1 + port.size() + path.size() + query.size());
         if (!protocol.empty()) {
-            ss << protocol << "://";
+            result += protocol;
+            result += "://";
         }
 
-        ss << host;
+        result += host;
         if (!port.empty()) {
-            ss << ":" << port;
+            result += ":";
+            result += port;
         }
 
-        ss << path << query;
-        return ss.str();
+        result += path;
+        result += query;
+        return result;
     }
+
 }}  // namespace leatherman::util
@@ -3,6 +3,7 @@
 #include <boost/nowide/convert.hpp>
 
 #include <functional>
+#include <memory>
 #include <windows.h>
 
 using namespace std;
@@ -35,16 +36,35 @@ namespace leatherman { namespace util {
         return ';';
     }
 
-    static search_path_helper helper;
+    // The split PATH, keyed by the environment generation it was built
+    // at, so mutations through set/clear invalidate it automatically.
+    // Refreshes swap in a new snapshot, so the no-change case is one
+    // atomic shared_ptr load.
+    struct search_path_cache
+    {
+        size_t generation;
+        search_path_helper helper;
+    };
+
+    static shared_ptr<search_path_cache const> g_search_paths;
 
     vector<string> const& environment::search_paths()
     {
-        return helper.search_paths();
+        auto generation = environment::generation();
+        auto cached = atomic_load(&g_search_paths);
+        if (!cached || cached->generation != generation) {
+            auto entry = make_shared<search_path_cache>();
+            entry->generation = generation;
+            atomic_store(&g_search_paths, shared_ptr<search_path_cache const>(entry));
+            cached = move(entry);
+        }
+        // The reference stays valid until the environment next changes.
+        return cached->helper.search_paths();
     }
 
     void environment::reload_search_paths()
     {
-        helper = search_path_helper();
+        atomic_store(&g_search_paths, shared_ptr<search_path_cache const>());
     }
 
     void environment::each(function<bool(string&, string&)> callback)
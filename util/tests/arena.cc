@@ -0,0 +1,62 @@
+#include <catch.hpp>
+#include <leatherman/util/arena.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::util;
+
+TEST_CASE("util::arena") {
+    arena a(64);
+
+    SECTION("allocations are usable and aligned") {
+        auto first = static_cast<char*>(a.allocate(16));
+        memset(first, 0xab, 16);
+        auto second = static_cast<uint64_t*>(a.allocate(sizeof(uint64_t), alignof(uint64_t)));
+        *second = 42u;
+        REQUIRE(reinterpret_cast<uintptr_t>(second) % alignof(uint64_t) == 0u);
+        REQUIRE(*second == 42u);
+        REQUIRE(a.bytes_allocated() >= 16 + sizeof(uint64_t));
+    }
+
+    SECTION("allocations larger than a block succeed") {
+        auto big = static_cast<char*>(a.allocate(1024));
+        memset(big, 0, 1024);
+        REQUIRE(a.bytes_allocated() >= 1024u);
+    }
+
+    SECTION("reset releases everything at once") {
+        a.allocate(48);
+        a.allocate(48);
+        REQUIRE(a.bytes_allocated() > 0u);
+        a.reset();
+        REQUIRE(a.bytes_allocated() == 0u);
+
+        // The retained block should satisfy the same allocations again.
+        auto again = static_cast<char*>(a.allocate(48));
+        memset(again, 0, 48);
+        REQUIRE(a.bytes_allocated() >= 48u);
+    }
+}
+
+TEST_CASE("util::arena_allocator") {
+    arena a;
+
+    SECTION("backs a std container") {
+        vector<int, arena_allocator<int>> values{arena_allocator<int>(a)};
+        for (int i = 0; i < 100; ++i) {
+            values.push_back(i);
+        }
+        REQUIRE(values.size() == 100u);
+        REQUIRE(values.front() == 0);
+        REQUIRE(values.back() == 99);
+        REQUIRE(a.bytes_allocated() >= 100 * sizeof(int));
+    }
+
+    SECTION("compares by backing arena") {
+        arena other;
+        REQUIRE(arena_allocator<int>(a) == arena_allocator<char>(a));
+        REQUIRE(arena_allocator<int>(a) != arena_allocator<int>(other));
+    }
+}
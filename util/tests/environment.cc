@@ -74,6 +74,28 @@ SCENARIO("clearing an environment variable") {
     REQUIRE_FALSE(boost::nowide::getenv("ENVTEST"));
 }
 
+SCENARIO("tracking the environment generation") {
+    auto generation = environment::generation();
+    GIVEN("a variable set through the API") {
+        REQUIRE(environment::set("ENVTEST", "FOO"));
+        THEN("the generation counter is incremented") {
+            REQUIRE(environment::generation() > generation);
+        }
+        boost::nowide::unsetenv("ENVTEST");
+    }
+    GIVEN("a variable cleared through the API") {
+        REQUIRE(environment::clear("ENVTEST"));
+        THEN("the generation counter is incremented") {
+            REQUIRE(environment::generation() > generation);
+        }
+    }
+    GIVEN("no changes to the environment") {
+        THEN("the generation counter is unchanged") {
+            REQUIRE(environment::generation() == generation);
+        }
+    }
+}
+
 SCENARIO("enumearing enviornment variables") {
     boost::nowide::setenv("ENVTEST1", "FOO", 1);
     boost::nowide::setenv("ENVTEST2", "BAR", 1);
@@ -118,3 +140,75 @@ SCENARIO("enumearing enviornment variables") {
     boost::nowide::unsetenv("ENVTEST2");
     boost::nowide::unsetenv("ENVTEST3");
 }
+
+SCENARIO("taking an environment snapshot") {
+    boost::nowide::setenv("SNAPTEST", "captured", 1);
+    environment::snapshot snap;
+    boost::nowide::unsetenv("SNAPTEST");
+
+    GIVEN("a variable present at capture time") {
+        string value;
+        THEN("it is found even after the environment changed") {
+            REQUIRE(snap.get("SNAPTEST", value));
+            REQUIRE(value == "captured");
+        }
+    }
+    GIVEN("a variable that never existed") {
+        string value;
+        THEN("lookup fails") {
+            REQUIRE_FALSE(snap.get("SNAPTEST_MISSING", value));
+        }
+    }
+    GIVEN("the full snapshot") {
+        THEN("enumeration visits every variable in name order") {
+            size_t count = 0;
+            string previous;
+            snap.each([&](boost::string_ref name, boost::string_ref) {
+                string current(name.data(), name.size());
+                REQUIRE(previous <= current);
+                previous = move(current);
+                count++;
+                return true;
+            });
+            REQUIRE(count == snap.size());
+            REQUIRE(count > 0);
+        }
+    }
+    GIVEN("a view lookup") {
+        boost::string_ref value;
+        THEN("the view points at the captured value") {
+            REQUIRE(snap.get(boost::string_ref { "SNAPTEST" }, value));
+            REQUIRE(value == "captured");
+        }
+        THEN("a missing variable fails without touching the view") {
+            REQUIRE_FALSE(snap.get(boost::string_ref { "SNAPTEST_MISSING" }, value));
+        }
+    }
+}
+
+SCENARIO("capturing the shared environment snapshot") {
+    environment::set("CAPTEST", "one");
+    auto snap = environment::capture();
+
+    GIVEN("no environment changes") {
+        THEN("a second capture returns the same snapshot") {
+            REQUIRE(environment::capture() == snap);
+            string value;
+            REQUIRE(snap->get("CAPTEST", value));
+            REQUIRE(value == "one");
+        }
+    }
+    GIVEN("a mutation through the API") {
+        environment::set("CAPTEST", "two");
+        THEN("the next capture is fresh while the old one stays valid") {
+            auto fresh = environment::capture();
+            REQUIRE(fresh != snap);
+            string value;
+            REQUIRE(fresh->get("CAPTEST", value));
+            REQUIRE(value == "two");
+            REQUIRE(snap->get("CAPTEST", value));
+            REQUIRE(value == "one");
+        }
+    }
+    environment::clear("CAPTEST");
+}
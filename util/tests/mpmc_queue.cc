@@ -0,0 +1,64 @@
+#include <catch.hpp>
+#include <leatherman/util/mpmc_queue.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace leatherman::util;
+
+SCENARIO("using an mpmc_queue") {
+    GIVEN("a small queue") {
+        mpmc_queue<int> queue(4);
+        THEN("capacity is rounded to a power of two") {
+            REQUIRE(queue.capacity() == 4u);
+            REQUIRE(mpmc_queue<int>(5).capacity() == 8u);
+        }
+        THEN("values come out in order") {
+            REQUIRE(queue.try_push(1));
+            REQUIRE(queue.try_push(2));
+            int value = 0;
+            REQUIRE(queue.try_pop(value));
+            REQUIRE(value == 1);
+            REQUIRE(queue.try_pop(value));
+            REQUIRE(value == 2);
+            REQUIRE_FALSE(queue.try_pop(value));
+        }
+        THEN("pushing to a full queue fails without blocking") {
+            for (int i = 0; i < 4; ++i) {
+                REQUIRE(queue.try_push(i));
+            }
+            REQUIRE_FALSE(queue.try_push(4));
+        }
+    }
+
+    GIVEN("concurrent producers and consumers") {
+        const size_t producers = 4, consumers = 4, per_producer = 10000;
+        mpmc_queue<size_t> queue(256);
+        atomic<size_t> sum {0};
+        atomic<size_t> popped {0};
+        vector<thread> threads;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&]() {
+                for (size_t i = 1; i <= per_producer; ++i) {
+                    queue.push(i);
+                }
+            });
+        }
+        for (size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&]() {
+                size_t value;
+                while (popped.fetch_add(1) < producers * per_producer) {
+                    queue.pop(value);
+                    sum += value;
+                }
+            });
+        }
+        for (auto& member : threads) {
+            member.join();
+        }
+        THEN("every value is consumed exactly once") {
+            REQUIRE(sum == producers * (per_producer * (per_producer + 1)) / 2);
+        }
+    }
+}
@@ -232,3 +232,19 @@ SCENARIO("using an option set") {
         }
     }
 }
+
+SCENARIO("using option_set at compile time") {
+    GIVEN("a constexpr option set") {
+        constexpr option_set<options> set { options::foo, options::baz };
+        THEN("its value and tests are compile-time constants") {
+            static_assert(set.value() == (static_cast<int>(options::foo) | static_cast<int>(options::baz)),
+                          "value is folded at compile time");
+            static_assert(set[options::foo], "membership tests fold at compile time");
+            static_assert(!set[options::bar], "absent options fold at compile time");
+            static_assert(!option_set<options>().test(options::foo), "empty sets fold at compile time");
+            static_assert((set & option_set<options> { options::foo }).value() ==
+                          static_cast<int>(options::foo), "bitwise operators fold at compile time");
+            REQUIRE(set.count() == 2u);
+        }
+    }
+}
@@ -33,4 +33,14 @@ SCENARIO("environment search paths") {
         REQUIRE(environment::set("PATH", value));
         environment::reload_search_paths();
     }
+    GIVEN("a path changed through environment::set") {
+        string value;
+        REQUIRE(environment::get("PATH", value));
+        REQUIRE(environment::set("PATH", value + ":/search_paths_cache_test"));
+        THEN("the search paths refresh without an explicit reload") {
+            auto paths = environment::search_paths();
+            REQUIRE(count(paths.begin(), paths.end(), "/search_paths_cache_test") == 1);
+        }
+        REQUIRE(environment::set("PATH", value));
+    }
 }
@@ -0,0 +1,62 @@
+#include <catch.hpp>
+#include <leatherman/util/profiler.hpp>
+#include <thread>
+
+using namespace std;
+using namespace leatherman::util;
+
+TEST_CASE("util::profiler") {
+    profiler::reset();
+
+    SECTION("disabled scopes record nothing") {
+        profiler::disable();
+        {
+            LTH_PROFILE_SCOPE("profiler.test.disabled");
+        }
+        auto collected = profiler::collect();
+        REQUIRE(collected.find("profiler.test.disabled") == collected.end());
+    }
+
+    SECTION("enabled scopes accumulate count and time") {
+        profiler::enable();
+        for (int i = 0; i < 3; ++i) {
+            LTH_PROFILE_SCOPE("profiler.test.enabled");
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        profiler::disable();
+
+        auto collected = profiler::collect();
+        auto it = collected.find("profiler.test.enabled");
+        REQUIRE(it != collected.end());
+        REQUIRE(it->second.count == 3u);
+        REQUIRE(it->second.total_nanoseconds >= 3000000u);
+    }
+
+    SECTION("counters survive thread exit") {
+        profiler::enable();
+        thread worker([]() {
+            LTH_PROFILE_SCOPE("profiler.test.thread");
+        });
+        worker.join();
+        profiler::disable();
+
+        auto collected = profiler::collect();
+        auto it = collected.find("profiler.test.thread");
+        REQUIRE(it != collected.end());
+        REQUIRE(it->second.count == 1u);
+    }
+
+    SECTION("reset discards collected data") {
+        profiler::enable();
+        {
+            LTH_PROFILE_SCOPE("profiler.test.reset");
+        }
+        profiler::disable();
+        profiler::reset();
+        auto collected = profiler::collect();
+        REQUIRE(collected.find("profiler.test.reset") == collected.end());
+    }
+
+    profiler::disable();
+    profiler::reset();
+}
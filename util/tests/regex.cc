@@ -0,0 +1,31 @@
+#include <catch.hpp>
+#include <leatherman/util/regex.hpp>
+
+using namespace std;
+using namespace leatherman::util;
+
+TEST_CASE("util::re_search with string patterns", "[regex]") {
+    string text = "load average: 1.50, 0.75, 0.25";
+
+    SECTION("matches like the boost::regex overload") {
+        REQUIRE(re_search(text, "load average"));
+        REQUIRE_FALSE(re_search(text, "no such thing"));
+    }
+
+    SECTION("match groups are returned") {
+        double one = 0, five = 0;
+        REQUIRE(re_search(text, "load average: ([\\d.]+), ([\\d.]+)", &one, &five));
+        REQUIRE(one == 1.50);
+        REQUIRE(five == 0.75);
+    }
+
+    SECTION("the same pattern compiles to the same cached instance") {
+        auto& first = compiled_regex("cached [0-9]+");
+        auto& second = compiled_regex("cached [0-9]+");
+        REQUIRE(&first == &second);
+    }
+
+    SECTION("an invalid pattern throws") {
+        REQUIRE_THROWS_AS(re_search(text, "(unbalanced"), boost::regex_error const&);
+    }
+}
@@ -50,3 +50,54 @@ SCENARIO("scoping an environment variable") {
         environment::clear("LEATH_ENV_TEST");
     }
 }
+
+SCENARIO("scoping several environment variables at once") {
+    string value;
+    REQUIRE_FALSE(environment::get("LEATH_ENVS_ONE", value));
+    REQUIRE_FALSE(environment::get("LEATH_ENVS_TWO", value));
+
+    WHEN("variables are scoped in bulk") {
+        environment::set("LEATH_ENVS_ONE", "original");
+
+        {
+            scoped_envs envs {
+                { "LEATH_ENVS_ONE", boost::optional<string>("replaced") },
+                { "LEATH_ENVS_TWO", boost::optional<string>("added") },
+                { "LEATH_ENVS_THREE", boost::none }
+            };
+            THEN("all the new values are set") {
+                REQUIRE(environment::get("LEATH_ENVS_ONE", value));
+                REQUIRE(value == "replaced");
+                REQUIRE(environment::get("LEATH_ENVS_TWO", value));
+                REQUIRE(value == "added");
+                REQUIRE_FALSE(environment::get("LEATH_ENVS_THREE", value));
+            }
+        }
+
+        THEN("every variable is restored") {
+            REQUIRE(environment::get("LEATH_ENVS_ONE", value));
+            REQUIRE(value == "original");
+            REQUIRE_FALSE(environment::get("LEATH_ENVS_TWO", value));
+        }
+
+        environment::clear("LEATH_ENVS_ONE");
+    }
+
+    WHEN("a scoped unset is stacked over an existing value") {
+        environment::set("LEATH_ENVS_ONE", "original");
+
+        {
+            scoped_envs envs {{ "LEATH_ENVS_ONE", boost::none }};
+            THEN("the variable is not set") {
+                REQUIRE_FALSE(environment::get("LEATH_ENVS_ONE", value));
+            }
+        }
+
+        THEN("the prior value comes back") {
+            REQUIRE(environment::get("LEATH_ENVS_ONE", value));
+            REQUIRE(value == "original");
+        }
+
+        environment::clear("LEATH_ENVS_ONE");
+    }
+}
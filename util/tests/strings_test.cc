@@ -29,6 +29,18 @@ TEST_CASE("strings::get_UUID", "[strings]") {
             ids.insert(new_id);
         }
     }
+
+    SECTION("matches the canonical format") {
+        auto id = get_UUID();
+        REQUIRE(id.size() == 36u);
+        for (size_t i = 0; i < id.size(); i++) {
+            if (i == 8 || i == 13 || i == 18 || i == 23) {
+                REQUIRE(id[i] == '-');
+            } else {
+                REQUIRE(isxdigit(id[i]));
+            }
+        }
+    }
 }
 
 TEST_CASE("each_line", "[strings]") {
@@ -69,3 +81,91 @@ TEST_CASE("each_line", "[strings]") {
         });
     }
 }
+
+TEST_CASE("strings::each_line_view", "[strings]") {
+    SECTION("lines are delivered as views into the text") {
+        string text = "test1\ntest2\ntest3";
+        int i = 0;
+        each_line_view(text, [&](boost::string_ref line) {
+            i++;
+            REQUIRE(line == ("test" + to_string(i)));
+            REQUIRE(line.data() >= text.data());
+            return true;
+        });
+        REQUIRE(i == 3);
+    }
+
+    SECTION("strips '\r' from line endings") {
+        each_line_view("test\r\n", [](boost::string_ref line) {
+            REQUIRE(line == "test");
+            return true;
+        });
+    }
+
+    SECTION("a false callback stops the iteration") {
+        int i = 0;
+        each_line_view("one\ntwo\n", [&](boost::string_ref) {
+            i++;
+            return false;
+        });
+        REQUIRE(i == 1);
+    }
+}
+
+TEST_CASE("strings::split", "[strings]") {
+    SECTION("tokens are views into the original text") {
+        string text = "a,bb,ccc";
+        vector<string> tokens;
+        for (auto token : split(text, ',')) {
+            REQUIRE(token.data() >= text.data());
+            REQUIRE(token.data() < text.data() + text.size());
+            tokens.emplace_back(token.data(), token.size());
+        }
+        REQUIRE(tokens == vector<string>({"a", "bb", "ccc"}));
+    }
+
+    SECTION("adjacent delimiters produce empty tokens") {
+        vector<string> tokens;
+        for (auto token : split("a,,b,", ',')) {
+            tokens.emplace_back(token.data(), token.size());
+        }
+        REQUIRE(tokens == vector<string>({"a", "", "b", ""}));
+    }
+
+    SECTION("text without the delimiter is a single token") {
+        auto range = split("whole", ',');
+        auto it = range.begin();
+        REQUIRE(*it == "whole");
+        REQUIRE(++it == range.end());
+    }
+}
+
+TEST_CASE("strings::trim", "[strings]") {
+    SECTION("whitespace is trimmed from both ends by default") {
+        REQUIRE(trim("  padded\t\n") == "padded");
+        REQUIRE(trim_left("  padded ") == "padded ");
+        REQUIRE(trim_right("  padded ") == "  padded");
+    }
+
+    SECTION("a custom character set can be trimmed") {
+        REQUIRE(trim("xxcontentxx", "x") == "content");
+    }
+
+    SECTION("a fully trimmed string is empty") {
+        REQUIRE(trim("   ").empty());
+    }
+}
+
+TEST_CASE("strings::join", "[strings]") {
+    SECTION("parts are joined with the separator") {
+        REQUIRE(join(vector<string>({"a", "b", "c"}), ", ") == "a, b, c");
+    }
+
+    SECTION("a single part has no separator") {
+        REQUIRE(join(vector<string>({"only"}), ",") == "only");
+    }
+
+    SECTION("an empty sequence joins to an empty string") {
+        REQUIRE(join(vector<string>(), ",").empty());
+    }
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+#include <leatherman/util/thread_pool.hpp>
+#include <atomic>
+#include <set>
+#include <stdexcept>
+
+using namespace std;
+using namespace leatherman::util;
+
+SCENARIO("using a thread pool") {
+    GIVEN("posted tasks") {
+        thread_pool pool(4);
+        atomic<int> count {0};
+        for (int i = 0; i < 100; ++i) {
+            pool.post([&]() { count++; });
+        }
+        WHEN("waiting on the pool") {
+            pool.wait();
+            THEN("every task has run") {
+                REQUIRE(count == 100);
+            }
+        }
+    }
+
+    GIVEN("tasks queued at destruction") {
+        atomic<int> count {0};
+        {
+            thread_pool pool(2);
+            for (int i = 0; i < 50; ++i) {
+                pool.post([&]() { count++; });
+            }
+        }
+        THEN("shutdown runs them all before joining") {
+            REQUIRE(count == 50);
+        }
+    }
+
+    GIVEN("a pool sized from hardware_concurrency") {
+        THEN("the shared pool has at least one worker") {
+            REQUIRE(thread_pool::global().size() >= 1u);
+        }
+    }
+}
+
+SCENARIO("using parallel_for_each") {
+    GIVEN("a range of elements") {
+        vector<int> values(200);
+        for (int i = 0; i < 200; ++i) {
+            values[i] = i;
+        }
+        WHEN("doubling each element in parallel") {
+            thread_pool pool(4);
+            parallel_for_each(values.begin(), values.end(), [](int& value) {
+                value *= 2;
+            }, pool);
+            THEN("every element was visited exactly once") {
+                for (int i = 0; i < 200; ++i) {
+                    REQUIRE(values[i] == i * 2);
+                }
+            }
+        }
+    }
+
+    GIVEN("a function that throws") {
+        vector<int> values { 1, 2, 3 };
+        thread_pool pool(2);
+        THEN("the exception propagates to the caller") {
+            REQUIRE_THROWS_AS(parallel_for_each(values.begin(), values.end(), [](int value) {
+                if (value == 2) {
+                    throw runtime_error("boom");
+                }
+            }, pool), runtime_error const&);
+        }
+    }
+
+    GIVEN("an empty range") {
+        vector<int> values;
+        THEN("nothing happens") {
+            REQUIRE_NOTHROW(parallel_for_each(values.begin(), values.end(), [](int&) {}));
+        }
+    }
+}
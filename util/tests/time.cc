@@ -0,0 +1,40 @@
+#include <catch.hpp>
+#include <leatherman/util/time.hpp>
+#include <string>
+
+using namespace std;
+using namespace leatherman::util;
+
+static string format(time_t timestamp)
+{
+    char buffer[32];
+    auto length = format_ISO8601_time(timestamp, buffer, sizeof(buffer));
+    return string(buffer, length);
+}
+
+TEST_CASE("util::format_ISO8601_time") {
+    SECTION("formats known timestamps") {
+        REQUIRE(format(0) == "1970-01-01T00:00:00Z");
+        REQUIRE(format(86399) == "1970-01-01T23:59:59Z");
+        REQUIRE(format(86400) == "1970-01-02T00:00:00Z");
+        REQUIRE(format(1000000000) == "2001-09-09T01:46:40Z");
+    }
+
+    SECTION("matches strftime for the current time") {
+        auto now = time(nullptr);
+        char expected[32];
+        strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+        REQUIRE(format(now) == expected);
+    }
+
+    SECTION("repeated same-second calls stay correct") {
+        REQUIRE(format(1000000000) == "2001-09-09T01:46:40Z");
+        REQUIRE(format(1000000000) == "2001-09-09T01:46:40Z");
+        REQUIRE(format(1000000001) == "2001-09-09T01:46:41Z");
+    }
+
+    SECTION("rejects a buffer that is too small") {
+        char buffer[20];
+        REQUIRE(format_ISO8601_time(0, buffer, sizeof(buffer)) == 0u);
+    }
+}
@@ -37,3 +37,45 @@ SCENARIO("Using Timer", "[util]") {
         REQUIRE_NOTHROW(t.elapsed_milliseconds());
     }
 }
+
+SCENARIO("Using latency_histogram", "[util]") {
+    SECTION("an empty histogram yields zero quantiles") {
+        latency_histogram histogram;
+        auto snap = histogram.snapshot();
+        REQUIRE(snap.total == 0u);
+        REQUIRE(snap.value_at(0.5) == 0u);
+    }
+
+    SECTION("quantiles reflect the recorded samples") {
+        latency_histogram histogram;
+        for (uint64_t i = 1; i <= 1000; ++i) {
+            histogram.record(i * 1000);  // 1us .. 1ms
+        }
+        auto snap = histogram.snapshot();
+        REQUIRE(snap.total == 1000u);
+        // Bucket resolution is ~3%, so allow that much slack.
+        auto p50 = snap.value_at(0.5);
+        REQUIRE(p50 >= 470000u);
+        REQUIRE(p50 <= 530000u);
+        auto p999 = snap.value_at(0.999);
+        REQUIRE(p999 >= 940000u);
+        REQUIRE(p999 <= 1000000u);
+    }
+
+    SECTION("snapshots can be merged") {
+        latency_histogram first, second;
+        first.record(uint64_t(100));
+        second.record(uint64_t(200));
+        auto snap = first.snapshot();
+        snap.merge(second.snapshot());
+        REQUIRE(snap.total == 2u);
+    }
+
+    SECTION("a scoped timer records one sample") {
+        latency_histogram histogram;
+        {
+            scoped_timer timing(histogram);
+        }
+        REQUIRE(histogram.snapshot().total == 1u);
+    }
+}
@@ -102,3 +102,51 @@ TEST_CASE("prints a uri") {
         REQUIRE(uri.str() == "https://foo:1234");
     }
 }
+
+TEST_CASE("parses a uri_view") {
+    SECTION("full uri") {
+        auto uri = lth_util::uri_view("https://foo:1234/bar?some=1&other=2");
+        REQUIRE(uri.protocol() == "https");
+        REQUIRE(uri.host() == "foo");
+        REQUIRE(uri.port() == "1234");
+        REQUIRE(uri.path() == "/bar");
+        REQUIRE(uri.query() == "?some=1&other=2");
+    }
+
+    SECTION("without protocol") {
+        auto uri = lth_util::uri_view("foo:1234/bar?some=1&other=2");
+        REQUIRE(uri.protocol() == "");
+        REQUIRE(uri.host() == "foo");
+        REQUIRE(uri.port() == "1234");
+        REQUIRE(uri.path() == "/bar");
+        REQUIRE(uri.query() == "?some=1&other=2");
+    }
+
+    SECTION("host only") {
+        auto uri = lth_util::uri_view("foo");
+        REQUIRE(uri.protocol() == "");
+        REQUIRE(uri.host() == "foo");
+        REQUIRE(uri.port() == "");
+        REQUIRE(uri.path() == "");
+        REQUIRE(uri.query() == "");
+    }
+
+    SECTION("empty uri") {
+        auto uri = lth_util::uri_view("");
+        REQUIRE(uri.host() == "");
+        REQUIRE(uri.str() == "");
+    }
+
+    SECTION("str returns the original text unmodified") {
+        std::string text = "https://foo:1234/bar?some=1&other=2";
+        auto uri = lth_util::uri_view(text);
+        REQUIRE(uri.str() == text);
+    }
+
+    SECTION("components are views into the stored buffer") {
+        auto uri = lth_util::uri_view("https://foo:1234/bar");
+        auto const& buffer = uri.str();
+        REQUIRE(uri.host().data() >= buffer.data());
+        REQUIRE(uri.host().data() < buffer.data() + buffer.size());
+    }
+}
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <stdexcept>
+#include <vector>
 
 namespace leatherman { namespace windows { namespace file_util {
 
@@ -20,4 +21,23 @@ namespace leatherman { namespace windows { namespace file_util {
      */
     std::string get_programdata_dir();
 
+    /**
+     * Resolves a path to its long form via GetLongPathName.
+     * Results are kept in a bounded per-thread cache, since the same
+     * paths are resolved over and over during catalog application;
+     * callers that change a path on disk should expect the cached form
+     * to persist for the lifetime of the thread's cache.
+     * @param path The path to resolve.
+     * @return The long form of the path, or the path unchanged if it cannot be resolved.
+     */
+    std::string get_long_path_name(std::string const& path);
+
+    /**
+     * Resolves several paths to their long forms in one call.
+     * Each path is resolved as by get_long_path_name, sharing its cache.
+     * @param paths The paths to resolve.
+     * @return The long forms of the given paths, in order.
+     */
+    std::vector<std::string> get_long_path_names(std::vector<std::string> const& paths);
+
 }}}  // namespace leatherman::windows::file_util
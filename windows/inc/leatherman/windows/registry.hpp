@@ -4,6 +4,7 @@
  */
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -60,6 +61,21 @@ namespace leatherman { namespace windows {
          *         Returns an empty vector if the value doesn't exist or isn't a composite string type.
          */
         std::vector<std::string> get_registry_strings(HKEY hkey, std::string const& subkey, std::string const& value);
+
+        /**
+         * Reads every value under a registry key in one pass.
+         * The key is opened once and its values enumerated with buffers
+         * sized from RegQueryInfoKey, instead of an open/query/close per
+         * value; readers pulling many values from one subtree should
+         * take a snapshot and look values up in the returned map.
+         * String and integer values are returned in string form and
+         * composite strings are joined with newlines; other types are
+         * skipped.
+         * @param hkey The registry key handle.
+         * @param subkey The name of the registry key.
+         * @return A map of value names to their string representations.
+         */
+        std::map<std::string, std::string> registry_snapshot(HKEY hkey, std::string const& subkey);
     }
 
 }}  // namespace leatherman::windows
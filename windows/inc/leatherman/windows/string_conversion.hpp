@@ -0,0 +1,33 @@
+/**
+ * @file
+ * Declares cached UTF-8/UTF-16 conversion helpers for Windows API boundaries.
+ */
+#pragma once
+
+#include <string>
+
+namespace leatherman { namespace windows {
+
+    namespace conversion {
+        /**
+         * Converts a UTF-8 string to UTF-16.
+         * Short strings are converted through a stack buffer and repeated
+         * inputs (registry subkeys, WMI property names, and the like) are
+         * served from a per-thread cache, avoiding the per-call heap
+         * allocations of converting through boost::nowide directly.
+         * @param text The UTF-8 string to convert.
+         * @return The UTF-16 equivalent of the given string.
+         */
+        std::wstring widen(std::string const& text);
+
+        /**
+         * Converts a UTF-16 string to UTF-8.
+         * Uses the same stack-buffer fast path and per-thread cache as
+         * widen.
+         * @param text The UTF-16 string to convert.
+         * @return The UTF-8 equivalent of the given string.
+         */
+        std::string narrow(std::wstring const& text);
+    }
+
+}}  // namespace leatherman::windows
@@ -4,6 +4,7 @@
  */
 #pragma once
 
+#include <iosfwd>
 #include <string>
 
 namespace leatherman { namespace windows {
@@ -20,4 +21,47 @@ namespace leatherman { namespace windows {
      * @return A formatted string "<error_message> (<error_code>)".
      */
     std::string system_error();
+
+    /**
+     * Holds an error code and defers formatting its message.
+     * Useful on hot error paths: constructing one only records the code,
+     * and FormatMessage runs when the value is streamed or str() is
+     * called, not before.
+     */
+    struct lazy_system_error
+    {
+        /**
+         * Constructs a lazy_system_error from GetLastError.
+         */
+        lazy_system_error();
+
+        /**
+         * Constructs a lazy_system_error from the given error code.
+         * @param err The Windows error code.
+         */
+        explicit lazy_system_error(unsigned long err);
+
+        /**
+         * Formats the error message for the stored code.
+         * @return A formatted string "<error_message> (<error_code>)".
+         */
+        std::string str() const;
+
+        /**
+         * Gets the stored error code.
+         * @return Returns the Windows error code.
+         */
+        unsigned long error_code() const;
+
+     private:
+        unsigned long _err;
+    };
+
+    /**
+     * Writes the formatted error message to the given stream.
+     * @param os The stream to write to.
+     * @param error The error to format.
+     * @return Returns the given stream.
+     */
+    std::ostream& operator<<(std::ostream& os, lazy_system_error const& error);
 }}  // namespace leatherman::windows
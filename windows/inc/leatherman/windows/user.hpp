@@ -11,6 +11,8 @@ namespace leatherman { namespace windows { namespace user {
     /**
      * Determines whether the current process has Administrator privileges and can be expected to succeed at
      * tasks restricted to Administrators.
+     * The determination is cached per process, so repeated calls do not re-query the token; call
+     * invalidate_cache after changing the process token to refresh it.
      * @return True if the current process has Administrator privileges, otherwise false.
      */
     bool is_admin();
@@ -23,8 +25,16 @@ namespace leatherman { namespace windows { namespace user {
 
     /**
      * Finds the user's home directory in a Ruby-compatible way.
+     * The directory is cached per process, so path expansion calling this repeatedly does not
+     * re-query the token and profile APIs; a failed lookup is not cached and is retried.
      * @return The home directory, trying %HOME% > %HOMEDRIVE%%HOMEPATH% > %USERPROFILE%
      */
     std::string home_dir();
 
+    /**
+     * Discards the cached is_admin and home_dir results, so the next call re-queries the system.
+     * Call after impersonation or other changes to the process token.
+     */
+    void invalidate_cache();
+
 }}}  // namespace leatherman::windows::user
@@ -7,6 +7,8 @@
 #include <leatherman/util/scoped_resource.hpp>
 #include <leatherman/util/strings.hpp>
 #include <boost/range/iterator_range.hpp>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <map>
 #include <vector>
@@ -147,6 +149,52 @@ namespace leatherman { namespace windows {
          */
         imaps query(std::string const& group, std::vector<std::string> const& keys, std::string const& extra = "") const;
 
+        /**
+         * Queries a WMI class through a time-bounded result cache.
+         * Intended for classes whose values do not change while the
+         * process runs - Win32_BIOS or Win32_ComputerSystemProduct, for
+         * example - so steady-state consumers skip the WMI round-trip.
+         * Results are shared process-wide; a cached result is reused
+         * until its TTL elapses, after which the next call re-queries.
+         * @param group The class alias to query
+         * @param keys A list of keys to query from the specified class
+         * @param ttl How long a cached result remains valid
+         * @param extra Extra arguments to the WMI query, such as filters
+         * @return A vector of case-insensitive maps of the keys argument and their corresponding values
+         */
+        imaps query_cached(std::string const& group, std::vector<std::string> const& keys,
+                           std::chrono::seconds ttl, std::string const& extra = "") const;
+
+        /**
+         * Describes one class query for query_many.
+         */
+        struct class_query
+        {
+            /**
+             * The class alias to query.
+             */
+            std::string group;
+            /**
+             * The keys to query from the class.
+             */
+            std::vector<std::string> keys;
+            /**
+             * Extra arguments to the WMI query, such as filters.
+             */
+            std::string extra;
+        };
+
+        /**
+         * Queries several WMI classes over the shared connection.
+         * All queries are issued up front with the semi-synchronous
+         * WBEM flags before any results are drained, so the service
+         * processes them concurrently and the total wait approaches
+         * that of the slowest query rather than the sum.
+         * @param queries The class queries to issue.
+         * @return One result set per query, in order; a failed query yields an empty result set.
+         */
+        std::vector<imaps> query_many(std::vector<class_query> const& queries) const;
+
         /**
          * A utility for retrieving a single entry from an imap. It should only be used if
          * it's known that the requested property is not an array.
@@ -185,9 +233,12 @@ namespace leatherman { namespace windows {
         static kv_range get_range(imaps const& kvmaps, std::string const& key);
 
      private:
-        util::scoped_resource<bool> _coInit;
-        util::scoped_resource<IWbemLocator *> _pLoc;
-        util::scoped_resource<IWbemServices *> _pSvc;
+        // The COM/WMI connection is shared by every wmi instance on the
+        // same thread, so repeated construction skips COM setup and
+        // ConnectServer. COM interface pointers are apartment-bound;
+        // the pool is per thread and must not cross threads.
+        struct connection;
+        std::shared_ptr<connection> _conn;
     };
 
 }}  // namespace leatherman::windows
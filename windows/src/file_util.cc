@@ -1,10 +1,13 @@
 #include <leatherman/windows/file_util.hpp>
 #include <leatherman/windows/system_error.hpp>
 #include <leatherman/windows/windows.hpp>
+#include <leatherman/windows/string_conversion.hpp>
+#include <leatherman/logging/logging.hpp>
 #include <leatherman/locale/locale.hpp>
 #include <boost/filesystem.hpp>
 
 #include <shlobj.h>
+#include <unordered_map>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -24,5 +27,49 @@ namespace leatherman { namespace windows { namespace file_util {
                     leatherman::windows::system_error()));
     }
 
+    string get_long_path_name(string const& path) {
+        // The same paths come up repeatedly during catalog application;
+        // keep resolutions in a bounded per-thread cache rather than
+        // round-tripping through GetLongPathName each time. The cache is
+        // cleared when full.
+        static const size_t cache_capacity = 256u;
+        static thread_local unordered_map<string, string> cache;
+        auto it = cache.find(path);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        auto wide = conversion::widen(path);
+        auto needed = GetLongPathNameW(wide.c_str(), nullptr, 0);
+        if (needed == 0u) {
+            LOG_DEBUG("could not resolve long path name for {1}: {2}", path, system_error());
+            return path;
+        }
+
+        wstring buffer(needed, L'\0');
+        auto written = GetLongPathNameW(wide.c_str(), &buffer[0], needed);
+        if (written == 0u || written >= needed) {
+            LOG_DEBUG("could not resolve long path name for {1}: {2}", path, system_error());
+            return path;
+        }
+        buffer.resize(written);
+
+        auto resolved = conversion::narrow(buffer);
+        if (cache.size() >= cache_capacity) {
+            cache.clear();
+        }
+        cache.emplace(path, resolved);
+        return resolved;
+    }
+
+    vector<string> get_long_path_names(vector<string> const& paths) {
+        vector<string> resolved;
+        resolved.reserve(paths.size());
+        for (auto const& path : paths) {
+            resolved.push_back(get_long_path_name(path));
+        }
+        return resolved;
+    }
+
 }}}  // namespace leatherman::windows::file_util
 
@@ -2,12 +2,18 @@
 #include <leatherman/windows/windows.hpp>
 #include <leatherman/util/scoped_resource.hpp>
 #include <leatherman/logging/logging.hpp>
+#include <mutex>
 
 using namespace std;
 
 namespace leatherman { namespace windows { namespace process {
 
-    bool supports_elevated_security()
+    // Neither the OS version nor the process token's elevation can change
+    // for the lifetime of the process, and consumers call these checks as
+    // per-operation guards; compute each answer once and serve the cached
+    // result afterwards.
+
+    static bool query_supports_elevated_security()
     {
         // In the future this can use IsWindowsVistaOrGreater, but as of the initial work versionhelpers.h is only in
         // the master branch of MinGW-w64.
@@ -20,7 +26,15 @@ namespace leatherman { namespace windows { namespace process {
                 VER_SERVICEPACKMAJOR, VER_GREATER_EQUAL));
     }
 
-    bool has_elevated_security()
+    bool supports_elevated_security()
+    {
+        static once_flag queried;
+        static bool result = false;
+        call_once(queried, []() { result = query_supports_elevated_security(); });
+        return result;
+    }
+
+    static bool query_has_elevated_security()
     {
         HANDLE temp_token = INVALID_HANDLE_VALUE;
         if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &temp_token)) {
@@ -39,4 +53,12 @@ namespace leatherman { namespace windows { namespace process {
         return token_elevation.TokenIsElevated;
     }
 
+    bool has_elevated_security()
+    {
+        static once_flag queried;
+        static bool result = false;
+        call_once(queried, []() { result = query_has_elevated_security(); });
+        return result;
+    }
+
 }}}  // namespace leatherman::windows::process
@@ -1,9 +1,11 @@
 #include <leatherman/windows/registry.hpp>
 #include <leatherman/windows/system_error.hpp>
 #include <leatherman/windows/windows.hpp>
+#include <leatherman/windows/string_conversion.hpp>
+#include <leatherman/logging/logging.hpp>
 #include <leatherman/locale/locale.hpp>
 #include <boost/algorithm/string/trim.hpp>
-#include <boost/nowide/convert.hpp>
+#include <cstring>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -39,8 +41,8 @@ namespace leatherman { namespace windows {
     static wstring get_regvalue(registry::HKEY hkey, string const& lpSubKey, string const& lpValue, DWORD flags)
     {
         auto hk = get_hkey(hkey);
-        auto lpSubKeyW = boost::nowide::widen(lpSubKey);
-        auto lpValueW = boost::nowide::widen(lpValue);
+        auto lpSubKeyW = conversion::widen(lpSubKey);
+        auto lpValueW = conversion::widen(lpValue);
 
         // If we're getting a DWORD we don't care about buffer size and other stuff, so we only need
         // to call RegGetValueW once.
@@ -89,7 +91,7 @@ namespace leatherman { namespace windows {
         // From http://msdn.microsoft.com/en-us/library/windows/desktop/ms724868(v=vs.85).aspx
         // "RRF_RT_REG_SZV automatically converts REG_EXPAND_SZ to REG_SZ unless RRF_NOEXPAND is specified."
         // This seems like the desired behavior most of the time.
-        return boost::nowide::narrow(get_regvalue(hkey, subkey, value, RRF_RT_REG_SZ));
+        return conversion::narrow(get_regvalue(hkey, subkey, value, RRF_RT_REG_SZ));
     }
 
     vector<string> registry::get_registry_strings(registry::HKEY hkey, string const& subkey, string const& value)
@@ -101,7 +103,7 @@ namespace leatherman { namespace windows {
         wstring accum;
         for (auto c : buffer) {
             if (c == L'\0') {
-                string val = boost::trim_copy(boost::nowide::narrow(accum));
+                string val = boost::trim_copy(conversion::narrow(accum));
                 if (!val.empty()) {
                     strings.emplace_back(move(val));
                 }
@@ -113,4 +115,92 @@ namespace leatherman { namespace windows {
         return strings;
     }
 
+    map<string, string> registry::registry_snapshot(registry::HKEY hkey, string const& subkey)
+    {
+        auto hk = get_hkey(hkey);
+
+        HKEY key = nullptr;
+        auto err = RegOpenKeyExW(hk, conversion::widen(subkey).c_str(), 0, KEY_READ, &key);
+        if (err != ERROR_SUCCESS) {
+            throw registry_exception(_("error opening registry key {1}: {2}",
+                subkey, windows::system_error(err)));
+        }
+
+        DWORD value_count = 0, max_name_len = 0, max_data_len = 0;
+        err = RegQueryInfoKeyW(key, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                               &value_count, &max_name_len, &max_data_len, nullptr, nullptr);
+        if (err != ERROR_SUCCESS) {
+            RegCloseKey(key);
+            throw registry_exception(_("error querying registry key {1}: {2}",
+                subkey, windows::system_error(err)));
+        }
+
+        map<string, string> values;
+        wstring name(max_name_len + 1u, L'\0');
+        vector<unsigned char> data(max_data_len + sizeof(wchar_t), 0);
+
+        for (DWORD i = 0; i < value_count; ++i) {
+            auto name_len = static_cast<DWORD>(name.size());
+            auto data_len = static_cast<DWORD>(data.size());
+            DWORD type = 0;
+            err = RegEnumValueW(key, i, &name[0], &name_len, nullptr, &type, data.data(), &data_len);
+            if (err != ERROR_SUCCESS) {
+                LOG_DEBUG("skipping registry value {1} of {2}: {3}", i, subkey, windows::system_error(err));
+                continue;
+            }
+
+            auto value_name = conversion::narrow(wstring(name.data(), name_len));
+            switch (type) {
+                case REG_SZ:
+                case REG_EXPAND_SZ: {
+                    wstring text(reinterpret_cast<wchar_t const*>(data.data()), data_len / sizeof(wchar_t));
+                    while (!text.empty() && text.back() == L'\0') {
+                        text.pop_back();
+                    }
+                    values[value_name] = conversion::narrow(text);
+                    break;
+                }
+                case REG_MULTI_SZ: {
+                    wstring text(reinterpret_cast<wchar_t const*>(data.data()), data_len / sizeof(wchar_t));
+                    string joined;
+                    wstring accum;
+                    for (auto c : text) {
+                        if (c == L'\0') {
+                            auto val = boost::trim_copy(conversion::narrow(accum));
+                            if (!val.empty()) {
+                                if (!joined.empty()) {
+                                    joined += '\n';
+                                }
+                                joined += val;
+                            }
+                            accum.clear();
+                        } else {
+                            accum += c;
+                        }
+                    }
+                    values[value_name] = move(joined);
+                    break;
+                }
+                case REG_DWORD: {
+                    DWORD dwValue = 0;
+                    memcpy(&dwValue, data.data(), sizeof(dwValue));
+                    values[value_name] = std::to_string(dwValue);
+                    break;
+                }
+                case REG_QWORD: {
+                    unsigned long long qwValue = 0;
+                    memcpy(&qwValue, data.data(), sizeof(qwValue));
+                    values[value_name] = std::to_string(qwValue);
+                    break;
+                }
+                default:
+                    // Binary and other types have no string form; skip them.
+                    break;
+            }
+        }
+
+        RegCloseKey(key);
+        return values;
+    }
+
 }}  // namespace leatherman::windows
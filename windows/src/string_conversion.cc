@@ -0,0 +1,74 @@
+#include <leatherman/windows/string_conversion.hpp>
+#include <boost/nowide/convert.hpp>
+#include <unordered_map>
+
+using namespace std;
+
+namespace leatherman { namespace windows { namespace conversion {
+
+    // Inputs at the API boundary are overwhelmingly short (MAX_PATH is
+    // 260); anything under this length is converted through a stack
+    // buffer and is eligible for caching.
+    static const size_t short_input = 260u;
+
+    // Keep the per-thread caches bounded; when one fills up it is simply
+    // cleared and repopulated by subsequent conversions.
+    static const size_t cache_capacity = 256u;
+
+    wstring widen(string const& text)
+    {
+        if (text.size() >= short_input) {
+            return boost::nowide::widen(text);
+        }
+
+        static thread_local unordered_map<string, wstring> cache;
+        auto it = cache.find(text);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        // UTF-16 never needs more code units than UTF-8 has bytes.
+        wchar_t buffer[short_input + 1u];
+        wstring converted;
+        if (boost::nowide::widen(buffer, sizeof(buffer) / sizeof(buffer[0]), text.c_str())) {
+            converted = buffer;
+        } else {
+            converted = boost::nowide::widen(text);
+        }
+
+        if (cache.size() >= cache_capacity) {
+            cache.clear();
+        }
+        cache.emplace(text, converted);
+        return converted;
+    }
+
+    string narrow(wstring const& text)
+    {
+        if (text.size() >= short_input) {
+            return boost::nowide::narrow(text);
+        }
+
+        static thread_local unordered_map<wstring, string> cache;
+        auto it = cache.find(text);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        // UTF-8 needs at most three bytes per UTF-16 code unit.
+        char buffer[short_input * 3u + 1u];
+        string converted;
+        if (boost::nowide::narrow(buffer, sizeof(buffer), text.c_str())) {
+            converted = buffer;
+        } else {
+            converted = boost::nowide::narrow(text);
+        }
+
+        if (cache.size() >= cache_capacity) {
+            cache.clear();
+        }
+        cache.emplace(text, converted);
+        return converted;
+    }
+
+}}}  // namespace leatherman::windows::conversion
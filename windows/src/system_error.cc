@@ -2,7 +2,10 @@
 #include <leatherman/windows/system_error.hpp>
 #include <leatherman/windows/windows.hpp>
 #include <leatherman/locale/locale.hpp>
-#include <boost/nowide/convert.hpp>
+#include <leatherman/windows/string_conversion.hpp>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
 
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
@@ -11,8 +14,24 @@ using namespace std;
 
 namespace leatherman { namespace windows {
 
+    // The set of error codes a process actually encounters is tiny, but
+    // retry loops can format the same one thousands of times; keep the
+    // formatted messages around rather than calling FormatMessage again.
+    // The cache is bounded and simply cleared if it ever fills up.
+    static const size_t cache_capacity = 256u;
+    static unordered_map<DWORD, string> message_cache;
+    static mutex message_cache_mutex;
+
     string system_error(DWORD err)
     {
+        {
+            lock_guard<mutex> lock(message_cache_mutex);
+            auto it = message_cache.find(err);
+            if (it != message_cache.end()) {
+                return it->second;
+            }
+        }
+
         LPWSTR buffer = nullptr;
         if (FormatMessageW(
             FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_IGNORE_INSERTS,
@@ -22,7 +41,14 @@ namespace leatherman { namespace windows {
 
         // boost format could throw, so ensure the buffer is freed.
         util::scoped_resource<LPWSTR> guard(buffer, [](LPWSTR ptr) { if (ptr) LocalFree(ptr); });
-        return _("{1} ({2})", boost::nowide::narrow(buffer), err);
+        auto message = _("{1} ({2})", conversion::narrow(buffer), err);
+
+        lock_guard<mutex> lock(message_cache_mutex);
+        if (message_cache.size() >= cache_capacity) {
+            message_cache.clear();
+        }
+        message_cache.emplace(err, message);
+        return message;
     }
 
     string system_error()
@@ -30,4 +56,29 @@ namespace leatherman { namespace windows {
         return system_error(GetLastError());
     }
 
+    lazy_system_error::lazy_system_error() :
+        _err(GetLastError())
+    {
+    }
+
+    lazy_system_error::lazy_system_error(unsigned long err) :
+        _err(err)
+    {
+    }
+
+    string lazy_system_error::str() const
+    {
+        return system_error(_err);
+    }
+
+    unsigned long lazy_system_error::error_code() const
+    {
+        return _err;
+    }
+
+    ostream& operator<<(ostream& os, lazy_system_error const& error)
+    {
+        return os << error.str();
+    }
+
 }}  // namespace leatherman::windows
@@ -4,20 +4,36 @@
 #include <leatherman/windows/windows.hpp>
 #include <leatherman/util/scoped_resource.hpp>
 #include <leatherman/logging/logging.hpp>
-#include <boost/nowide/convert.hpp>
+#include <leatherman/windows/string_conversion.hpp>
 #include <userenv.h>
+#include <memory>
 
 using namespace std;
 
 namespace leatherman { namespace windows { namespace user {
 
+    // Cached per-process results, published as atomic shared_ptr
+    // snapshots so concurrent readers never see a half-written entry; a
+    // null pointer means not yet queried. Both answers only change when
+    // the process token does, which is why invalidation is explicit.
+    static shared_ptr<const bool> g_is_admin;
+    static shared_ptr<const string> g_home_dir;
+
     bool is_admin()
     {
-        if (process::supports_elevated_security()) {
-            return process::has_elevated_security();
+        auto cached = atomic_load(&g_is_admin);
+        if (cached) {
+            return *cached;
         }
 
-        return check_token_membership();
+        bool result;
+        if (process::supports_elevated_security()) {
+            result = process::has_elevated_security();
+        } else {
+            result = check_token_membership();
+        }
+        atomic_store(&g_is_admin, make_shared<const bool>(result));
+        return result;
     }
 
     bool check_token_membership()
@@ -44,7 +60,9 @@ namespace leatherman { namespace windows { namespace user {
         return is_member;
     }
 
-    string home_dir() {
+    // Queries the profile API for the home directory; home_dir caches
+    // the answer.
+    static string query_home_dir() {
         HANDLE temp_token = INVALID_HANDLE_VALUE;
         if (!OpenProcessToken(GetCurrentProcess(), TOKEN_QUERY, &temp_token)) {
             LOG_DEBUG("OpenProcessToken call failed: {1}", system_error());
@@ -69,7 +87,27 @@ namespace leatherman { namespace windows { namespace user {
 
         // Strip the trailing null character.
         buffer.resize(pathLen > 0u ? pathLen - 1u : 0u);
-        return boost::nowide::narrow(buffer);
+        return conversion::narrow(buffer);
+    }
+
+    string home_dir() {
+        auto cached = atomic_load(&g_home_dir);
+        if (cached) {
+            return *cached;
+        }
+
+        auto result = query_home_dir();
+        if (!result.empty()) {
+            // A failed lookup stays uncached, so a transient token or
+            // profile error is retried on the next call.
+            atomic_store(&g_home_dir, make_shared<const string>(result));
+        }
+        return result;
+    }
+
+    void invalidate_cache() {
+        atomic_store(&g_is_admin, shared_ptr<const bool>());
+        atomic_store(&g_home_dir, shared_ptr<const string>());
     }
 
 }}}  // namespace leatherman::windows::user
@@ -1,5 +1,6 @@
 #include <leatherman/util/strings.hpp>
 #include <leatherman/windows/wmi.hpp>
+#include <leatherman/windows/string_conversion.hpp>
 #include <leatherman/logging/logging.hpp>
 #include <leatherman/locale/locale.hpp>
 #include <boost/algorithm/string/join.hpp>
@@ -10,6 +11,9 @@
 // Mark string for translation (alias for leatherman::locale::format)
 using leatherman::locale::_;
 
+#include <chrono>
+#include <mutex>
+
 #define _WIN32_DCOM
 #include <comdef.h>
 #include <wbemidl.h>
@@ -37,7 +41,38 @@ namespace leatherman { namespace windows {
     // doesn't define it, but obscures the Windows Platform SDK version of wbemuuid.lib.
     constexpr static CLSID MyCLSID_WbemLocator = {0x4590f811, 0x1d3a, 0x11d0, 0x89, 0x1f, 0x00, 0xaa, 0x00, 0x4b, 0x2e, 0x24};
 
+    struct wmi::connection
+    {
+        connection();
+
+        /**
+         * Keeps COM initialized while the connection lives.
+         */
+        util::scoped_resource<bool> coInit;
+        /**
+         * The WMI locator used to connect.
+         */
+        util::scoped_resource<IWbemLocator *> pLoc;
+        /**
+         * The connected WMI services proxy.
+         */
+        util::scoped_resource<IWbemServices *> pSvc;
+    };
+
     wmi::wmi()
+    {
+        // Reuse the thread's connection when one is still alive;
+        // otherwise pay COM initialization and ConnectServer once and
+        // share the result with later instances on this thread.
+        static thread_local std::weak_ptr<connection> cached;
+        _conn = cached.lock();
+        if (!_conn) {
+            _conn = std::make_shared<connection>();
+            cached = _conn;
+        }
+    }
+
+    wmi::connection::connection()
     {
         LOG_DEBUG("initializing WMI");
         auto hres = CoInitializeEx(0, COINIT_APARTMENTTHREADED);
@@ -56,7 +91,7 @@ namespace leatherman { namespace windows {
         }
 
         if (SUCCEEDED(hres)) {
-            _coInit = util::scoped_resource<bool>(true, [](bool b) { CoUninitialize(); });
+            coInit = util::scoped_resource<bool>(true, [](bool b) { CoUninitialize(); });
         }
 
         IWbemLocator *pLoc;
@@ -65,18 +100,18 @@ namespace leatherman { namespace windows {
         if (FAILED(hres)) {
             throw wmi_exception(format_hresult(_("failed to create IWbemLocator object"), hres));
         }
-        _pLoc = util::scoped_resource<IWbemLocator *>(pLoc,
+        this->pLoc = util::scoped_resource<IWbemLocator *>(pLoc,
             [](IWbemLocator *loc) { if (loc) loc->Release(); });
 
         IWbemServices *pSvc;
-        hres = (*_pLoc).ConnectServer(_bstr_t(L"ROOT\\CIMV2"), nullptr, nullptr, nullptr, 0, nullptr, nullptr, &pSvc);
+        hres = (*this->pLoc).ConnectServer(_bstr_t(L"ROOT\\CIMV2"), nullptr, nullptr, nullptr, 0, nullptr, nullptr, &pSvc);
         if (FAILED(hres)) {
             throw wmi_exception(format_hresult(_("could not connect to WMI server"), hres));
         }
-        _pSvc = util::scoped_resource<IWbemServices *>(pSvc,
+        this->pSvc = util::scoped_resource<IWbemServices *>(pSvc,
             [](IWbemServices *svc) { if (svc) svc->Release(); });
 
-        hres = CoSetProxyBlanket(_pSvc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL,
+        hres = CoSetProxyBlanket(this->pSvc, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE, NULL,
             RPC_C_AUTHN_LEVEL_CALL, RPC_C_IMP_LEVEL_IMPERSONATE, NULL, EOAC_NONE);
         if (FAILED(hres)) {
             throw wmi_exception(format_hresult(_("could not set proxy blanket"), hres));
@@ -113,24 +148,9 @@ namespace leatherman { namespace windows {
         }
     }
 
-    wmi::imaps wmi::query(string const& group, vector<string> const& keys, string const& extended) const
+    static wmi::imaps drain_query(IEnumWbemClassObject *pEnum, string const& group, vector<string> const& keys)
     {
-        IEnumWbemClassObject *_pEnum = NULL;
-        string qry = "SELECT " + boost::join(keys, ",") + " FROM " + group;
-        if (!extended.empty()) {
-            qry += " " + extended;
-        }
-
-        auto hres = (*_pSvc).ExecQuery(_bstr_t(L"WQL"), _bstr_t(boost::nowide::widen(qry).c_str()),
-            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &_pEnum);
-        if (FAILED(hres)) {
-            LOG_DEBUG("query {1} failed", qry);
-            return {};
-        }
-        util::scoped_resource<IEnumWbemClassObject *> pEnum(_pEnum,
-            [](IEnumWbemClassObject *rsc) { if (rsc) rsc->Release(); });
-
-        imaps array_of_vals;
+        wmi::imaps array_of_vals;
 
         IWbemClassObject *pclsObjs[256];
         ULONG uReturn = 0;
@@ -141,11 +161,11 @@ namespace leatherman { namespace windows {
             }
 
             for (auto pclsObj : boost::make_iterator_range(pclsObjs, pclsObjs+uReturn)) {
-                imap vals;
+                wmi::imap vals;
                 for (auto &s : keys) {
                     VARIANT vtProp;
                     CIMTYPE vtType;
-                    hr = pclsObj->Get(_bstr_t(boost::nowide::widen(s).c_str()), 0, &vtProp, &vtType, 0);
+                    hr = pclsObj->Get(_bstr_t(conversion::widen(s).c_str()), 0, &vtProp, &vtType, 0);
                     if (FAILED(hr)) {
                         LOG_DEBUG("query {1}.{2} could not be found", group, s);
                         break;
@@ -162,6 +182,89 @@ namespace leatherman { namespace windows {
         return array_of_vals;
     }
 
+    static string build_query(string const& group, vector<string> const& keys, string const& extended)
+    {
+        string qry = "SELECT " + boost::join(keys, ",") + " FROM " + group;
+        if (!extended.empty()) {
+            qry += " " + extended;
+        }
+        return qry;
+    }
+
+    wmi::imaps wmi::query(string const& group, vector<string> const& keys, string const& extended) const
+    {
+        IEnumWbemClassObject *_pEnum = NULL;
+        auto qry = build_query(group, keys, extended);
+
+        auto hres = (*_conn->pSvc).ExecQuery(_bstr_t(L"WQL"), _bstr_t(conversion::widen(qry).c_str()),
+            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &_pEnum);
+        if (FAILED(hres)) {
+            LOG_DEBUG("query {1} failed", qry);
+            return {};
+        }
+        util::scoped_resource<IEnumWbemClassObject *> pEnum(_pEnum,
+            [](IEnumWbemClassObject *rsc) { if (rsc) rsc->Release(); });
+
+        return drain_query(pEnum, group, keys);
+    }
+
+    vector<wmi::imaps> wmi::query_many(vector<class_query> const& queries) const
+    {
+        // Issue every query before draining any results; with the
+        // semi-synchronous flags ExecQuery returns immediately, so the
+        // service works on all of the queries while we read them back.
+        vector<util::scoped_resource<IEnumWbemClassObject *>> enumerators;
+        enumerators.reserve(queries.size());
+        for (auto const& q : queries) {
+            auto qry = build_query(q.group, q.keys, q.extra);
+            IEnumWbemClassObject *pEnum = NULL;
+            auto hres = (*_conn->pSvc).ExecQuery(_bstr_t(L"WQL"), _bstr_t(conversion::widen(qry).c_str()),
+                WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY, NULL, &pEnum);
+            if (FAILED(hres)) {
+                LOG_DEBUG("query {1} failed", qry);
+                pEnum = NULL;
+            }
+            enumerators.emplace_back(pEnum,
+                [](IEnumWbemClassObject *rsc) { if (rsc) rsc->Release(); });
+        }
+
+        vector<imaps> results;
+        results.reserve(queries.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            results.push_back(drain_query(enumerators[i], queries[i].group, queries[i].keys));
+        }
+        return results;
+    }
+
+    wmi::imaps wmi::query_cached(string const& group, vector<string> const& keys,
+                                 std::chrono::seconds ttl, string const& extended) const
+    {
+        struct cache_entry
+        {
+            imaps results;
+            std::chrono::steady_clock::time_point expires;
+        };
+        static std::map<string, cache_entry> cache;
+        static std::mutex cache_mutex;
+
+        auto key = group + "|" + boost::join(keys, ",") + "|" + extended;
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            auto it = cache.find(key);
+            if (it != cache.end() && now < it->second.expires) {
+                return it->second.results;
+            }
+        }
+
+        auto results = query(group, keys, extended);
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto& entry = cache[key];
+        entry.results = results;
+        entry.expires = now + ttl;
+        return results;
+    }
+
     string const& wmi::get(wmi::imap const& kvmap, string const& key)
     {
         static const string empty = {};